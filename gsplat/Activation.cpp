@@ -0,0 +1,76 @@
+#include <ATen/TensorUtils.h>
+#include <ATen/core/Tensor.h>
+#include <c10/cuda/CUDAGuard.h> // for DEVICE_GUARD
+#include <tuple>
+
+#include <ATen/Functions.h>
+#include <ATen/NativeFunctions.h>
+
+#include "Activation.h" // where the launch function is declared
+#include "Common.h"     // where all the macros are defined
+#include "Ops.h"        // a collection of all gsplat operators
+
+namespace gsplat {
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor> activation_fwd(
+    const at::Tensor opacities_raw, // [N]
+    const at::Tensor scales_raw,    // [N, 3]
+    const at::Tensor quats_raw,     // [N, 4]
+    const float scaling_modifier
+) {
+    DEVICE_GUARD(opacities_raw);
+    CHECK_INPUT(opacities_raw);
+    CHECK_INPUT(scales_raw);
+    CHECK_INPUT(quats_raw);
+
+    at::Tensor opacities = at::empty_like(opacities_raw);
+    at::Tensor scales = at::empty_like(scales_raw);
+    at::Tensor quats = at::empty_like(quats_raw);
+
+    launch_activation_fwd_kernel(
+        opacities_raw,
+        scales_raw,
+        quats_raw,
+        scaling_modifier,
+        opacities,
+        scales,
+        quats
+    );
+    return std::make_tuple(opacities, scales, quats);
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor> activation_bwd(
+    const at::Tensor opacities,   // [N]
+    const at::Tensor scales,      // [N, 3]
+    const at::Tensor quats_raw,   // [N, 4]
+    const at::Tensor v_opacities, // [N]
+    const at::Tensor v_scales,    // [N, 3]
+    const at::Tensor v_quats      // [N, 4]
+) {
+    DEVICE_GUARD(opacities);
+    CHECK_INPUT(opacities);
+    CHECK_INPUT(scales);
+    CHECK_INPUT(quats_raw);
+    CHECK_INPUT(v_opacities);
+    CHECK_INPUT(v_scales);
+    CHECK_INPUT(v_quats);
+
+    at::Tensor v_opacities_raw = at::empty_like(opacities);
+    at::Tensor v_scales_raw = at::empty_like(scales);
+    at::Tensor v_quats_raw = at::empty_like(quats_raw);
+
+    launch_activation_bwd_kernel(
+        opacities,
+        scales,
+        quats_raw,
+        v_opacities,
+        v_scales,
+        v_quats,
+        v_opacities_raw,
+        v_scales_raw,
+        v_quats_raw
+    );
+    return std::make_tuple(v_opacities_raw, v_scales_raw, v_quats_raw);
+}
+
+} // namespace gsplat
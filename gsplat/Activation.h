@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace at {
+class Tensor;
+}
+
+namespace gsplat {
+
+void launch_activation_fwd_kernel(
+    // inputs
+    const at::Tensor opacities_raw, // [N]
+    const at::Tensor scales_raw,    // [N, 3]
+    const at::Tensor quats_raw,     // [N, 4]
+    const float scaling_modifier,
+    // outputs
+    at::Tensor opacities, // [N]
+    at::Tensor scales,    // [N, 3]
+    at::Tensor quats      // [N, 4]
+);
+
+void launch_activation_bwd_kernel(
+    // fwd outputs / inputs
+    const at::Tensor opacities, // [N]
+    const at::Tensor scales,    // [N, 3]
+    const at::Tensor quats_raw, // [N, 4]
+    // grad outputs
+    const at::Tensor v_opacities, // [N]
+    const at::Tensor v_scales,    // [N, 3]
+    const at::Tensor v_quats,     // [N, 4]
+    // grad inputs
+    at::Tensor v_opacities_raw, // [N]
+    at::Tensor v_scales_raw,    // [N, 3]
+    at::Tensor v_quats_raw      // [N, 4]
+);
+
+} // namespace gsplat
@@ -0,0 +1,205 @@
+#include <ATen/Dispatch.h>
+#include <ATen/core/Tensor.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include "Activation.h"
+#include "Common.h"
+
+namespace gsplat {
+
+// Same epsilon as torch::nn::functional::normalize.
+#define ACTIVATION_NORM_EPS 1e-12f
+
+// One thread per Gaussian: sigmoid(opacity), exp(scale) * modifier and
+// normalize(quat), replacing three separate elementwise passes.
+template <typename scalar_t>
+__global__ void activation_fwd_kernel(
+    const uint32_t N,
+    const scalar_t *__restrict__ opacities_raw, // [N]
+    const scalar_t *__restrict__ scales_raw,    // [N, 3]
+    const scalar_t *__restrict__ quats_raw,     // [N, 4]
+    const float scaling_modifier,
+    scalar_t *__restrict__ opacities, // [N]
+    scalar_t *__restrict__ scales,    // [N, 3]
+    scalar_t *__restrict__ quats      // [N, 4]
+) {
+    uint32_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N) {
+        return;
+    }
+
+    opacities[idx] = 1.f / (1.f + __expf(-(float)opacities_raw[idx]));
+
+    scales_raw += idx * 3;
+    scales += idx * 3;
+#pragma unroll
+    for (uint32_t i = 0; i < 3; ++i) {
+        scales[i] = __expf((float)scales_raw[i]) * scaling_modifier;
+    }
+
+    quats_raw += idx * 4;
+    quats += idx * 4;
+    float w = quats_raw[0], x = quats_raw[1], y = quats_raw[2],
+          z = quats_raw[3];
+    float inv_norm =
+        1.f / fmaxf(sqrtf(w * w + x * x + y * y + z * z), ACTIVATION_NORM_EPS);
+    quats[0] = w * inv_norm;
+    quats[1] = x * inv_norm;
+    quats[2] = y * inv_norm;
+    quats[3] = z * inv_norm;
+}
+
+template <typename scalar_t>
+__global__ void activation_bwd_kernel(
+    const uint32_t N,
+    const scalar_t *__restrict__ opacities,   // [N]
+    const scalar_t *__restrict__ scales,      // [N, 3]
+    const scalar_t *__restrict__ quats_raw,   // [N, 4]
+    const scalar_t *__restrict__ v_opacities, // [N]
+    const scalar_t *__restrict__ v_scales,    // [N, 3]
+    const scalar_t *__restrict__ v_quats,     // [N, 4]
+    scalar_t *__restrict__ v_opacities_raw,   // [N]
+    scalar_t *__restrict__ v_scales_raw,      // [N, 3]
+    scalar_t *__restrict__ v_quats_raw        // [N, 4]
+) {
+    uint32_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N) {
+        return;
+    }
+
+    // d sigmoid(x) / dx = s * (1 - s)
+    float opac = opacities[idx];
+    v_opacities_raw[idx] = v_opacities[idx] * opac * (1.f - opac);
+
+    // d (exp(x) * m) / dx = exp(x) * m, which is the forward output
+    scales += idx * 3;
+    v_scales += idx * 3;
+    v_scales_raw += idx * 3;
+#pragma unroll
+    for (uint32_t i = 0; i < 3; ++i) {
+        v_scales_raw[i] = v_scales[i] * scales[i];
+    }
+
+    // d (q / |q|) / dq = (I - q_n q_n^T) / |q|
+    quats_raw += idx * 4;
+    v_quats += idx * 4;
+    v_quats_raw += idx * 4;
+    float q[4] = {quats_raw[0], quats_raw[1], quats_raw[2], quats_raw[3]};
+    float v[4] = {v_quats[0], v_quats[1], v_quats[2], v_quats[3]};
+    float norm =
+        sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (norm > ACTIVATION_NORM_EPS) {
+        float inv_norm = 1.f / norm;
+        float dot = 0.f;
+#pragma unroll
+        for (uint32_t i = 0; i < 4; ++i) {
+            dot += q[i] * inv_norm * v[i];
+        }
+#pragma unroll
+        for (uint32_t i = 0; i < 4; ++i) {
+            v_quats_raw[i] = (v[i] - q[i] * inv_norm * dot) * inv_norm;
+        }
+    } else {
+#pragma unroll
+        for (uint32_t i = 0; i < 4; ++i) {
+            v_quats_raw[i] = v[i] / ACTIVATION_NORM_EPS;
+        }
+    }
+}
+
+void launch_activation_fwd_kernel(
+    // inputs
+    const at::Tensor opacities_raw, // [N]
+    const at::Tensor scales_raw,    // [N, 3]
+    const at::Tensor quats_raw,     // [N, 4]
+    const float scaling_modifier,
+    // outputs
+    at::Tensor opacities, // [N]
+    at::Tensor scales,    // [N, 3]
+    at::Tensor quats      // [N, 4]
+) {
+    uint32_t N = opacities_raw.size(0);
+
+    int64_t n_elements = N;
+    dim3 threads(256);
+    dim3 grid((n_elements + threads.x - 1) / threads.x);
+    int64_t shmem_size = 0; // No shared memory used in this kernel
+
+    if (n_elements == 0) {
+        // skip the kernel launch if there are no elements
+        return;
+    }
+
+    AT_DISPATCH_FLOATING_TYPES(
+        opacities_raw.scalar_type(),
+        "activation_fwd_kernel",
+        [&]() {
+            activation_fwd_kernel<scalar_t>
+                <<<grid,
+                   threads,
+                   shmem_size,
+                   at::cuda::getCurrentCUDAStream()>>>(
+                    N,
+                    opacities_raw.data_ptr<scalar_t>(),
+                    scales_raw.data_ptr<scalar_t>(),
+                    quats_raw.data_ptr<scalar_t>(),
+                    scaling_modifier,
+                    opacities.data_ptr<scalar_t>(),
+                    scales.data_ptr<scalar_t>(),
+                    quats.data_ptr<scalar_t>()
+                );
+        }
+    );
+}
+
+void launch_activation_bwd_kernel(
+    // fwd outputs / inputs
+    const at::Tensor opacities, // [N]
+    const at::Tensor scales,    // [N, 3]
+    const at::Tensor quats_raw, // [N, 4]
+    // grad outputs
+    const at::Tensor v_opacities, // [N]
+    const at::Tensor v_scales,    // [N, 3]
+    const at::Tensor v_quats,     // [N, 4]
+    // grad inputs
+    at::Tensor v_opacities_raw, // [N]
+    at::Tensor v_scales_raw,    // [N, 3]
+    at::Tensor v_quats_raw      // [N, 4]
+) {
+    uint32_t N = opacities.size(0);
+
+    int64_t n_elements = N;
+    dim3 threads(256);
+    dim3 grid((n_elements + threads.x - 1) / threads.x);
+    int64_t shmem_size = 0; // No shared memory used in this kernel
+
+    if (n_elements == 0) {
+        // skip the kernel launch if there are no elements
+        return;
+    }
+
+    AT_DISPATCH_FLOATING_TYPES(
+        opacities.scalar_type(),
+        "activation_bwd_kernel",
+        [&]() {
+            activation_bwd_kernel<scalar_t>
+                <<<grid,
+                   threads,
+                   shmem_size,
+                   at::cuda::getCurrentCUDAStream()>>>(
+                    N,
+                    opacities.data_ptr<scalar_t>(),
+                    scales.data_ptr<scalar_t>(),
+                    quats_raw.data_ptr<scalar_t>(),
+                    v_opacities.data_ptr<scalar_t>(),
+                    v_scales.data_ptr<scalar_t>(),
+                    v_quats.data_ptr<scalar_t>(),
+                    v_opacities_raw.data_ptr<scalar_t>(),
+                    v_scales_raw.data_ptr<scalar_t>(),
+                    v_quats_raw.data_ptr<scalar_t>()
+                );
+        }
+    );
+}
+
+} // namespace gsplat
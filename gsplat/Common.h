@@ -4,6 +4,9 @@
 #include <cstdint>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <ATen/core/Tensor.h>
+#include <ATen/ops/empty.h>
+
 namespace gsplat {
 
 //
@@ -29,6 +32,34 @@ namespace gsplat {
         func(temp_storage.get(), temp_storage_bytes, __VA_ARGS__);             \
     } while (false)
 
+// Returns the caller's preallocated output after checking it matches, or a
+// fresh uninitialised tensor when none was given.
+inline at::Tensor output_or_empty(
+    const at::optional<at::Tensor> &out,
+    at::IntArrayRef sizes,
+    const at::TensorOptions &options
+) {
+    if (!out.has_value()) {
+        return at::empty(sizes, options);
+    }
+    TORCH_CHECK(
+        out->is_cuda() && out->is_contiguous(),
+        "preallocated output must be a contiguous CUDA tensor"
+    );
+    TORCH_CHECK(
+        out->sizes() == sizes && out->dtype() == options.dtype(),
+        "preallocated output must be ",
+        sizes,
+        " of ",
+        options.dtype(),
+        ", got ",
+        out->sizes(),
+        " of ",
+        out->dtype()
+    );
+    return out.value();
+}
+
 //
 // Convenience typedefs for CUDA types
 //
@@ -22,7 +22,10 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> intersect_tile(
     const uint32_t tile_size,
     const uint32_t tile_width,
     const uint32_t tile_height,
-    const bool sort
+    const bool sort,
+    const at::optional<at::Tensor> tiles_per_gauss_out, // [C, N] or [nnz]
+    const at::optional<at::Tensor> isect_ids_buffer,    // [2, capacity]
+    const at::optional<at::Tensor> flatten_ids_buffer   // [2, capacity]
 ) {
     DEVICE_GUARD(means2d);
     CHECK_INPUT(means2d);
@@ -49,11 +52,19 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> intersect_tile(
     uint32_t cam_n_bits = (uint32_t)floor(log2(C)) + 1;
     // the first 32 bits are used for the camera id and tile id altogether, so
     // check if we have enough bits for them.
-    assert(tile_n_bits + cam_n_bits <= 32);
+    TORCH_CHECK(
+        tile_n_bits + cam_n_bits <= 32,
+        "Too many cameras/tiles to encode intersection ids (C=",
+        C,
+        ", tiles=",
+        n_tiles,
+        "); use a larger tile_size"
+    );
 
     // first pass: compute number of tiles per gaussian
-    at::Tensor tiles_per_gauss =
-        at::empty_like(depths, depths.options().dtype(at::kInt));
+    at::Tensor tiles_per_gauss = output_or_empty(
+        tiles_per_gauss_out, depths.sizes(), depths.options().dtype(at::kInt)
+    );
     int64_t n_isects;
     at::Tensor cum_tiles_per_gauss;
     if (n_elements) {
@@ -80,11 +91,27 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> intersect_tile(
         n_isects = 0;
     }
 
-    // second pass: compute isect_ids and flatten_ids as a packed tensor
+    // second pass: compute isect_ids and flatten_ids as a packed tensor. Row 0
+    // of the caller's buffers takes the unsorted ids, row 1 the sort output.
+    const bool use_buffers =
+        isect_ids_buffer.has_value() && flatten_ids_buffer.has_value() &&
+        isect_ids_buffer->size(1) >= n_isects &&
+        flatten_ids_buffer->size(1) >= n_isects;
+    if (use_buffers) {
+        CHECK_INPUT(isect_ids_buffer.value());
+        CHECK_INPUT(flatten_ids_buffer.value());
+        TORCH_CHECK(
+            isect_ids_buffer->scalar_type() == at::kLong &&
+                flatten_ids_buffer->scalar_type() == at::kInt,
+            "isect buffers must be int64 and int32"
+        );
+    }
     at::Tensor isect_ids =
-        at::empty({n_isects}, depths.options().dtype(at::kLong));
+        use_buffers ? isect_ids_buffer->select(0, 0).narrow(0, 0, n_isects)
+                    : at::empty({n_isects}, depths.options().dtype(at::kLong));
     at::Tensor flatten_ids =
-        at::empty({n_isects}, depths.options().dtype(at::kInt));
+        use_buffers ? flatten_ids_buffer->select(0, 0).narrow(0, 0, n_isects)
+                    : at::empty({n_isects}, depths.options().dtype(at::kInt));
     if (n_isects) {
         launch_intersect_tile_kernel(
             // inputs
@@ -107,8 +134,13 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> intersect_tile(
 
     // optionally sort the Gaussians by isect_ids
     if (n_isects && sort) {
-        at::Tensor isect_ids_sorted = at::empty_like(isect_ids);
-        at::Tensor flatten_ids_sorted = at::empty_like(flatten_ids);
+        at::Tensor isect_ids_sorted =
+            use_buffers ? isect_ids_buffer->select(0, 1).narrow(0, 0, n_isects)
+                        : at::empty_like(isect_ids);
+        at::Tensor flatten_ids_sorted =
+            use_buffers
+                ? flatten_ids_buffer->select(0, 1).narrow(0, 0, n_isects)
+                : at::empty_like(flatten_ids);
         radix_sort_double_buffer(
             n_isects,
             tile_n_bits,
@@ -130,13 +162,16 @@ at::Tensor intersect_offset(
     const at::Tensor isect_ids, // [n_isects]
     const uint32_t C,
     const uint32_t tile_width,
-    const uint32_t tile_height
+    const uint32_t tile_height,
+    const at::optional<at::Tensor> offsets_out // [C, tile_height, tile_width]
 ) {
     DEVICE_GUARD(isect_ids);
     CHECK_INPUT(isect_ids);
 
-    at::Tensor offsets = at::empty(
-        {C, tile_height, tile_width}, isect_ids.options().dtype(at::kInt)
+    at::Tensor offsets = output_or_empty(
+        offsets_out,
+        {C, tile_height, tile_width},
+        isect_ids.options().dtype(at::kInt)
     );
     launch_intersect_offset_kernel(
         isect_ids, C, tile_width, tile_height, offsets
@@ -152,7 +152,14 @@ void launch_intersect_tile_kernel(
     uint32_t cam_n_bits = (uint32_t)floor(log2(C)) + 1;
     // the first 32 bits are used for the camera id and tile id altogether, so
     // check if we have enough bits for them.
-    assert(tile_n_bits + cam_n_bits <= 32);
+    TORCH_CHECK(
+        tile_n_bits + cam_n_bits <= 32,
+        "Too many cameras/tiles to encode intersection ids (C=",
+        C,
+        ", tiles=",
+        n_tiles,
+        "); use a larger tile_size"
+    );
 
     dim3 threads(256);
     dim3 grid((n_elements + threads.x - 1) / threads.x);
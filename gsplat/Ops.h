@@ -2,6 +2,7 @@
 #pragma once
 
 #include <ATen/core/Tensor.h>
+#include <vector>
 
 #include "Cameras.h"
 #include "Common.h"
@@ -60,7 +61,12 @@ projection_ewa_3dgs_fused_fwd(
     const float far_plane,
     const float radius_clip,
     const bool calc_compensations,
-    const CameraModelType camera_model
+    const CameraModelType camera_model,
+    // optional preallocated outputs, written in place when given
+    const at::optional<at::Tensor> radii_out = c10::nullopt,   // [C, N, 2]
+    const at::optional<at::Tensor> means2d_out = c10::nullopt, // [C, N, 2]
+    const at::optional<at::Tensor> depths_out = c10::nullopt,  // [C, N]
+    const at::optional<at::Tensor> conics_out = c10::nullopt   // [C, N, 3]
 );
 std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
 projection_ewa_3dgs_fused_bwd(
@@ -191,13 +197,20 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> intersect_tile(
     const uint32_t tile_size,
     const uint32_t tile_width,
     const uint32_t tile_height,
-    const bool sort
+    const bool sort,
+    // optional preallocated outputs. The isect buffers hold the unsorted and
+    // sorted copies in rows 0 and 1 and are only used if they have room for
+    // all intersections; otherwise fresh tensors are allocated.
+    const at::optional<at::Tensor> tiles_per_gauss_out = c10::nullopt, // [C, N] or [nnz]
+    const at::optional<at::Tensor> isect_ids_buffer = c10::nullopt,    // [2, capacity]
+    const at::optional<at::Tensor> flatten_ids_buffer = c10::nullopt   // [2, capacity]
 );
 at::Tensor intersect_offset(
     const at::Tensor isect_ids, // [n_isects]
     const uint32_t C,
     const uint32_t tile_width,
-    const uint32_t tile_height
+    const uint32_t tile_height,
+    const at::optional<at::Tensor> offsets_out = c10::nullopt // [C, tile_height, tile_width]
 );
 
 // Compute Covariance and Precision Matrices from Quaternion and Scale
@@ -231,7 +244,15 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> rasterize_to_pixels_3dgs_fwd(
     const uint32_t tile_size,
     // intersections
     const at::Tensor tile_offsets, // [C, tile_height, tile_width]
-    const at::Tensor flatten_ids   // [n_isects]
+    const at::Tensor flatten_ids,  // [n_isects]
+    // optional preallocated outputs, written in place when given
+    const at::optional<at::Tensor> renders_out = c10::nullopt, // [C, H, W, channels]
+    const at::optional<at::Tensor> alphas_out = c10::nullopt,  // [C, H, W, 1]
+    const at::optional<at::Tensor> last_ids_out = c10::nullopt, // [C, H, W]
+    // optional per-Gaussian accumulators, added to in place when given:
+    // blending weight summed over pixels and number of pixels blended into
+    const at::optional<at::Tensor> gauss_weights = c10::nullopt, // [C * N] or [nnz]
+    const at::optional<at::Tensor> gauss_hits = c10::nullopt     // [C * N] or [nnz], int64
 );
 std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
 rasterize_to_pixels_3dgs_bwd(
@@ -287,6 +308,36 @@ std::tuple<at::Tensor, at::Tensor> relocation(
     const int n_max
 );
 
+// Row bookkeeping of an MCMC relocation in one pass: copies rows src_ids to
+// dst_ids in every tensor of params and zeroes rows reset_ids in every tensor of
+// moments (the optimizer states). All tensors are contiguous float32 [N, ...]
+// on the device of the ids; src and dst rows must be disjoint. Runs on CUDA and
+// CPU.
+void relocate_rows_(
+    const std::vector<at::Tensor> &params,  // each [N, ...]
+    const std::vector<at::Tensor> &moments, // each [N, ...]
+    const at::Tensor src_ids,               // [M] int64
+    const at::Tensor dst_ids,               // [M] int64
+    const at::Tensor reset_ids              // [R] int64
+);
+
+// Fused activation of the raw Gaussian parameters in a single pass:
+// sigmoid(opacities), exp(scales) * scaling_modifier and normalize(quats).
+std::tuple<at::Tensor, at::Tensor, at::Tensor> activation_fwd(
+    const at::Tensor opacities_raw, // [N]
+    const at::Tensor scales_raw,    // [N, 3]
+    const at::Tensor quats_raw,     // [N, 4]
+    const float scaling_modifier
+);
+std::tuple<at::Tensor, at::Tensor, at::Tensor> activation_bwd(
+    const at::Tensor opacities,   // [N] activated
+    const at::Tensor scales,      // [N, 3] activated (modifier applied)
+    const at::Tensor quats_raw,   // [N, 4]
+    const at::Tensor v_opacities, // [N]
+    const at::Tensor v_scales,    // [N, 3]
+    const at::Tensor v_quats      // [N, 4]
+);
+
 // Use uncented transform to project 3D gaussians to 2D. (none differentiable)
 // https://arxiv.org/abs/2412.12507
 std::tuple<
@@ -108,7 +108,11 @@ projection_ewa_3dgs_fused_fwd(
     const float far_plane,
     const float radius_clip,
     const bool calc_compensations,
-    const CameraModelType camera_model
+    const CameraModelType camera_model,
+    const at::optional<at::Tensor> radii_out,   // [C, N, 2]
+    const at::optional<at::Tensor> means2d_out, // [C, N, 2]
+    const at::optional<at::Tensor> depths_out,  // [C, N]
+    const at::optional<at::Tensor> conics_out   // [C, N, 3]
 ) {
     DEVICE_GUARD(means);
     CHECK_INPUT(means);
@@ -125,10 +129,11 @@ projection_ewa_3dgs_fused_fwd(
     uint32_t N = means.size(0);    // number of gaussians
     uint32_t C = viewmats.size(0); // number of cameras
 
-    at::Tensor radii = at::empty({C, N, 2}, means.options().dtype(at::kInt));
-    at::Tensor means2d = at::empty({C, N, 2}, means.options());
-    at::Tensor depths = at::empty({C, N}, means.options());
-    at::Tensor conics = at::empty({C, N, 3}, means.options());
+    at::Tensor radii =
+        output_or_empty(radii_out, {C, N, 2}, means.options().dtype(at::kInt));
+    at::Tensor means2d = output_or_empty(means2d_out, {C, N, 2}, means.options());
+    at::Tensor depths = output_or_empty(depths_out, {C, N}, means.options());
+    at::Tensor conics = output_or_empty(conics_out, {C, N, 3}, means.options());
     at::Tensor compensations = {};
     if (calc_compensations) {
         // we dont want NaN to appear in this tensor, so we zero intialize it
@@ -31,7 +31,12 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> rasterize_to_pixels_3dgs_fwd(
     const uint32_t tile_size,
     // intersections
     const at::Tensor tile_offsets, // [C, tile_height, tile_width]
-    const at::Tensor flatten_ids   // [n_isects]
+    const at::Tensor flatten_ids,  // [n_isects]
+    const at::optional<at::Tensor> renders_out, // [C, H, W, channels]
+    const at::optional<at::Tensor> alphas_out,  // [C, H, W, 1]
+    const at::optional<at::Tensor> last_ids_out, // [C, H, W]
+    const at::optional<at::Tensor> gauss_weights, // [C * N] or [nnz]
+    const at::optional<at::Tensor> gauss_hits     // [C * N] or [nnz]
 ) {
     DEVICE_GUARD(means2d);
     CHECK_INPUT(means2d);
@@ -46,16 +51,38 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> rasterize_to_pixels_3dgs_fwd(
     if (masks.has_value()) {
         CHECK_INPUT(masks.value());
     }
+    if (gauss_weights.has_value() || gauss_hits.has_value()) {
+        TORCH_CHECK(
+            gauss_weights.has_value() && gauss_hits.has_value(),
+            "gauss_weights and gauss_hits must be given together"
+        );
+        CHECK_INPUT(gauss_weights.value());
+        CHECK_INPUT(gauss_hits.value());
+        TORCH_CHECK(
+            gauss_weights.value().numel() == opacities.numel() &&
+                gauss_hits.value().numel() == opacities.numel(),
+            "gauss_weights and gauss_hits must have one entry per Gaussian"
+        );
+        TORCH_CHECK(
+            gauss_weights.value().scalar_type() == at::kFloat &&
+                gauss_hits.value().scalar_type() == at::kLong,
+            "gauss_weights must be float32 and gauss_hits int64"
+        );
+    }
 
     uint32_t C = tile_offsets.size(0); // number of cameras
     uint32_t channels = colors.size(-1);
 
-    at::Tensor renders =
-        at::empty({C, image_height, image_width, channels}, means2d.options());
-    at::Tensor alphas =
-        at::empty({C, image_height, image_width, 1}, means2d.options());
-    at::Tensor last_ids = at::empty(
-        {C, image_height, image_width}, means2d.options().dtype(at::kInt)
+    at::Tensor renders = output_or_empty(
+        renders_out, {C, image_height, image_width, channels}, means2d.options()
+    );
+    at::Tensor alphas = output_or_empty(
+        alphas_out, {C, image_height, image_width, 1}, means2d.options()
+    );
+    at::Tensor last_ids = output_or_empty(
+        last_ids_out,
+        {C, image_height, image_width},
+        means2d.options().dtype(at::kInt)
     );
 
 #define __LAUNCH_KERNEL__(N)                                                   \
@@ -74,7 +101,9 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> rasterize_to_pixels_3dgs_fwd(
             flatten_ids,                                                       \
             renders,                                                           \
             alphas,                                                            \
-            last_ids                                                           \
+            last_ids,                                                          \
+            gauss_weights,                                                     \
+            gauss_hits                                                         \
         );                                                                     \
         break;
 
@@ -32,7 +32,10 @@ void launch_rasterize_to_pixels_3dgs_fwd_kernel(
     // outputs
     at::Tensor renders, // [C, image_height, image_width, channels]
     at::Tensor alphas,  // [C, image_height, image_width]
-    at::Tensor last_ids // [C, image_height, image_width]
+    at::Tensor last_ids, // [C, image_height, image_width]
+    // optional per-Gaussian accumulators
+    const at::optional<at::Tensor> gauss_weights, // [C * N] or [nnz]
+    const at::optional<at::Tensor> gauss_hits     // [C * N] or [nnz]
 );
 
 template <uint32_t CDIM>
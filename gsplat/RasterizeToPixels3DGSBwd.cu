@@ -1,9 +1,15 @@
+#include <ATen/Context.h>
 #include <ATen/Dispatch.h>
 #include <ATen/core/Tensor.h>
 #include <ATen/cuda/Atomic.cuh>
+#include <ATen/ops/zeros.h>
 #include <c10/cuda/CUDAStream.h>
 #include <cooperative_groups.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include "Common.h"
 #include "Rasterization.h"
 #include "Utils.cuh"
@@ -12,6 +18,58 @@ namespace gsplat {
 
 namespace cg = cooperative_groups;
 
+// Deterministic mode (at::globalContext().deterministicAlgorithms()) sums the
+// gradients in int64 fixed point: integer atomics are associative, so the
+// result no longer depends on the order in which tiles finish. The kernel runs
+// twice. The first pass only records, per output, the largest warp
+// contribution and, per Gaussian, the number of contributions. Both are
+// order-independent. The second pass then accumulates with the largest
+// power-of-two scale that keeps every sum below 2^62, so nothing wraps and
+// small gradients keep their resolution.
+enum FixedPointSlot {
+    kSlotMeans2dAbs,
+    kSlotMeans2d,
+    kSlotConics,
+    kSlotColors,
+    kSlotOpacities,
+    kNumFixedPointSlots
+};
+
+// int64 accumulators for the gradients below, all null outside deterministic mode
+struct FixedPointGrads {
+    int64_t *means2d_abs; // [C, N, 2] or [nnz, 2], may be null
+    int64_t *means2d;     // [C, N, 2] or [nnz, 2]
+    int64_t *conics;      // [C, N, 3] or [nnz, 3]
+    int64_t *colors;      // [C, N, CDIM] or [nnz, CDIM]
+    int64_t *opacities;   // [C, N] or [nnz]
+    int32_t *counts;      // [C * N] or [nnz], contributions per Gaussian
+    int32_t *max_abs;     // [kNumFixedPointSlots], largest |contribution| as float bits
+    bool bounds_only;     // first pass: record counts and max_abs only
+    float scale[kNumFixedPointSlots];
+};
+
+inline __device__ void accumulate_grad(
+    float *dst,
+    int64_t *fixed_dst,
+    const FixedPointGrads &fixed,
+    const int slot,
+    const float val
+) {
+    if (fixed_dst == nullptr) {
+        gpuAtomicAdd(dst, val);
+    } else if (fixed.bounds_only) {
+        // Non-negative floats order like their bits; NaN sorts above inf
+        atomicMax(fixed.max_abs + slot, __float_as_int(fabsf(val)));
+    } else {
+        atomicAdd(
+            reinterpret_cast<unsigned long long *>(fixed_dst),
+            static_cast<unsigned long long>(
+                __float2ll_rn(val * fixed.scale[slot])
+            )
+        );
+    }
+}
+
 template <uint32_t CDIM, typename scalar_t>
 __global__ void rasterize_to_pixels_3dgs_bwd_kernel(
     const uint32_t C,
@@ -45,8 +103,9 @@ __global__ void rasterize_to_pixels_3dgs_bwd_kernel(
     vec2 *__restrict__ v_means2d_abs,  // [C, N, 2] or [nnz, 2]
     vec2 *__restrict__ v_means2d,      // [C, N, 2] or [nnz, 2]
     vec3 *__restrict__ v_conics,       // [C, N, 3] or [nnz, 3]
-    scalar_t *__restrict__ v_colors,   // [C, N, CDIM] or [nnz, CDIM]
-    scalar_t *__restrict__ v_opacities // [C, N] or [nnz]
+    scalar_t *__restrict__ v_colors,    // [C, N, CDIM] or [nnz, CDIM]
+    scalar_t *__restrict__ v_opacities, // [C, N] or [nnz]
+    const FixedPointGrads fixed
 ) {
     auto block = cg::this_thread_block();
     uint32_t camera_id = block.group_index().x;
@@ -250,28 +309,84 @@ __global__ void rasterize_to_pixels_3dgs_bwd_kernel(
             warpSum(v_opacity_local, warp);
             if (warp.thread_rank() == 0) {
                 int32_t g = id_batch[t]; // flatten index in [C * N] or [nnz]
+                const bool det = fixed.means2d != nullptr;
+                if (det && fixed.bounds_only) {
+                    atomicAdd(fixed.counts + g, 1);
+                }
+
                 float *v_rgb_ptr = (float *)(v_colors) + CDIM * g;
+                int64_t *v_rgb_fixed = det ? fixed.colors + CDIM * g : nullptr;
 #pragma unroll
                 for (uint32_t k = 0; k < CDIM; ++k) {
-                    gpuAtomicAdd(v_rgb_ptr + k, v_rgb_local[k]);
+                    accumulate_grad(
+                        v_rgb_ptr + k,
+                        det ? v_rgb_fixed + k : nullptr,
+                        fixed,
+                        kSlotColors,
+                        v_rgb_local[k]
+                    );
                 }
 
                 float *v_conic_ptr = (float *)(v_conics) + 3 * g;
-                gpuAtomicAdd(v_conic_ptr, v_conic_local.x);
-                gpuAtomicAdd(v_conic_ptr + 1, v_conic_local.y);
-                gpuAtomicAdd(v_conic_ptr + 2, v_conic_local.z);
+                int64_t *v_conic_fixed = det ? fixed.conics + 3 * g : nullptr;
+                accumulate_grad(
+                    v_conic_ptr, v_conic_fixed, fixed, kSlotConics, v_conic_local.x
+                );
+                accumulate_grad(
+                    v_conic_ptr + 1,
+                    det ? v_conic_fixed + 1 : nullptr,
+                    fixed,
+                    kSlotConics,
+                    v_conic_local.y
+                );
+                accumulate_grad(
+                    v_conic_ptr + 2,
+                    det ? v_conic_fixed + 2 : nullptr,
+                    fixed,
+                    kSlotConics,
+                    v_conic_local.z
+                );
 
                 float *v_xy_ptr = (float *)(v_means2d) + 2 * g;
-                gpuAtomicAdd(v_xy_ptr, v_xy_local.x);
-                gpuAtomicAdd(v_xy_ptr + 1, v_xy_local.y);
+                int64_t *v_xy_fixed = det ? fixed.means2d + 2 * g : nullptr;
+                accumulate_grad(
+                    v_xy_ptr, v_xy_fixed, fixed, kSlotMeans2d, v_xy_local.x
+                );
+                accumulate_grad(
+                    v_xy_ptr + 1,
+                    det ? v_xy_fixed + 1 : nullptr,
+                    fixed,
+                    kSlotMeans2d,
+                    v_xy_local.y
+                );
 
                 if (v_means2d_abs != nullptr) {
                     float *v_xy_abs_ptr = (float *)(v_means2d_abs) + 2 * g;
-                    gpuAtomicAdd(v_xy_abs_ptr, v_xy_abs_local.x);
-                    gpuAtomicAdd(v_xy_abs_ptr + 1, v_xy_abs_local.y);
+                    int64_t *v_xy_abs_fixed =
+                        det ? fixed.means2d_abs + 2 * g : nullptr;
+                    accumulate_grad(
+                        v_xy_abs_ptr,
+                        v_xy_abs_fixed,
+                        fixed,
+                        kSlotMeans2dAbs,
+                        v_xy_abs_local.x
+                    );
+                    accumulate_grad(
+                        v_xy_abs_ptr + 1,
+                        det ? v_xy_abs_fixed + 1 : nullptr,
+                        fixed,
+                        kSlotMeans2dAbs,
+                        v_xy_abs_local.y
+                    );
                 }
 
-                gpuAtomicAdd(v_opacities + g, v_opacity_local);
+                accumulate_grad(
+                    v_opacities + g,
+                    det ? fixed.opacities + g : nullptr,
+                    fixed,
+                    kSlotOpacities,
+                    v_opacity_local
+                );
             }
         }
     }
@@ -328,6 +443,36 @@ void launch_rasterize_to_pixels_3dgs_bwd_kernel(
         return;
     }
 
+    // Fixed-point accumulators replace the float atomics in deterministic mode
+    FixedPointGrads fixed{};
+    at::Tensor fixed_means2d_abs, fixed_means2d, fixed_conics, fixed_colors,
+        fixed_opacities, fixed_counts, fixed_max_abs;
+    const bool deterministic = at::globalContext().deterministicAlgorithms();
+    if (deterministic) {
+        auto fixed_like = [](const at::Tensor &t) {
+            return at::zeros(t.sizes(), t.options().dtype(at::kLong));
+        };
+        if (v_means2d_abs.has_value()) {
+            fixed_means2d_abs = fixed_like(v_means2d_abs.value());
+            fixed.means2d_abs = fixed_means2d_abs.data_ptr<int64_t>();
+        }
+        fixed_means2d = fixed_like(v_means2d);
+        fixed_conics = fixed_like(v_conics);
+        fixed_colors = fixed_like(v_colors);
+        fixed_opacities = fixed_like(v_opacities);
+        fixed_counts =
+            at::zeros({v_opacities.numel()}, v_opacities.options().dtype(at::kInt));
+        fixed_max_abs =
+            at::zeros({kNumFixedPointSlots}, v_opacities.options().dtype(at::kInt));
+        fixed.means2d = fixed_means2d.data_ptr<int64_t>();
+        fixed.conics = fixed_conics.data_ptr<int64_t>();
+        fixed.colors = fixed_colors.data_ptr<int64_t>();
+        fixed.opacities = fixed_opacities.data_ptr<int64_t>();
+        fixed.counts = fixed_counts.data_ptr<int32_t>();
+        fixed.max_abs = fixed_max_abs.data_ptr<int32_t>();
+        fixed.bounds_only = true;
+    }
+
     // TODO: an optimization can be done by passing the actual number of
     // channels into the kernel functions and avoid necessary global memory
     // writes. This requires moving the channel padding from python to C side.
@@ -343,40 +488,95 @@ void launch_rasterize_to_pixels_3dgs_bwd_kernel(
         );
     }
 
-    rasterize_to_pixels_3dgs_bwd_kernel<CDIM, float>
-        <<<grid, threads, shmem_size, at::cuda::getCurrentCUDAStream()>>>(
-            C,
-            N,
-            n_isects,
-            packed,
-            reinterpret_cast<vec2 *>(means2d.data_ptr<float>()),
-            reinterpret_cast<vec3 *>(conics.data_ptr<float>()),
-            colors.data_ptr<float>(),
-            opacities.data_ptr<float>(),
-            backgrounds.has_value() ? backgrounds.value().data_ptr<float>()
-                                    : nullptr,
-            masks.has_value() ? masks.value().data_ptr<bool>() : nullptr,
-            image_width,
-            image_height,
-            tile_size,
-            tile_width,
-            tile_height,
-            tile_offsets.data_ptr<int32_t>(),
-            flatten_ids.data_ptr<int32_t>(),
-            render_alphas.data_ptr<float>(),
-            last_ids.data_ptr<int32_t>(),
-            v_render_colors.data_ptr<float>(),
-            v_render_alphas.data_ptr<float>(),
-            v_means2d_abs.has_value()
-                ? reinterpret_cast<vec2 *>(
-                      v_means2d_abs.value().data_ptr<float>()
-                  )
-                : nullptr,
-            reinterpret_cast<vec2 *>(v_means2d.data_ptr<float>()),
-            reinterpret_cast<vec3 *>(v_conics.data_ptr<float>()),
-            v_colors.data_ptr<float>(),
-            v_opacities.data_ptr<float>()
-        );
+    auto launch = [&](const FixedPointGrads &grads) {
+        rasterize_to_pixels_3dgs_bwd_kernel<CDIM, float>
+            <<<grid, threads, shmem_size, at::cuda::getCurrentCUDAStream()>>>(
+                C,
+                N,
+                n_isects,
+                packed,
+                reinterpret_cast<vec2 *>(means2d.data_ptr<float>()),
+                reinterpret_cast<vec3 *>(conics.data_ptr<float>()),
+                colors.data_ptr<float>(),
+                opacities.data_ptr<float>(),
+                backgrounds.has_value() ? backgrounds.value().data_ptr<float>()
+                                        : nullptr,
+                masks.has_value() ? masks.value().data_ptr<bool>() : nullptr,
+                image_width,
+                image_height,
+                tile_size,
+                tile_width,
+                tile_height,
+                tile_offsets.data_ptr<int32_t>(),
+                flatten_ids.data_ptr<int32_t>(),
+                render_alphas.data_ptr<float>(),
+                last_ids.data_ptr<int32_t>(),
+                v_render_colors.data_ptr<float>(),
+                v_render_alphas.data_ptr<float>(),
+                v_means2d_abs.has_value()
+                    ? reinterpret_cast<vec2 *>(
+                          v_means2d_abs.value().data_ptr<float>()
+                      )
+                    : nullptr,
+                reinterpret_cast<vec2 *>(v_means2d.data_ptr<float>()),
+                reinterpret_cast<vec3 *>(v_conics.data_ptr<float>()),
+                v_colors.data_ptr<float>(),
+                v_opacities.data_ptr<float>(),
+                grads
+            );
+    };
+    launch(fixed);
+
+    if (deterministic) {
+        // Every sum has at most max_count terms of at most max_abs each
+        const double max_count =
+            static_cast<double>(fixed_counts.max().item<int32_t>());
+        const auto max_abs_bits = fixed_max_abs.cpu();
+        bool finite = true;
+        for (int slot = 0; slot < kNumFixedPointSlots; ++slot) {
+            float max_abs;
+            const int32_t bits = max_abs_bits.data_ptr<int32_t>()[slot];
+            std::memcpy(&max_abs, &bits, sizeof(max_abs));
+            const double bound = max_count * static_cast<double>(max_abs);
+            finite = finite && std::isfinite(bound);
+            // Largest power of two with bound * scale <= 2^62, within float range
+            const int exponent =
+                bound > 0.0 && std::isfinite(bound)
+                    ? std::min(
+                          100, 62 - static_cast<int>(std::ceil(std::log2(bound)))
+                      )
+                    : 0;
+            fixed.scale[slot] = std::ldexp(1.0f, exponent);
+        }
+
+        if (!finite) {
+            // inf/NaN gradients have no fixed-point form: keep them visible
+            TORCH_WARN_ONCE(
+                "rasterize_to_pixels_3dgs_bwd: non-finite gradients, "
+                "accumulating with float atomics despite deterministic mode"
+            );
+            launch(FixedPointGrads{});
+            return;
+        }
+
+        fixed.bounds_only = false;
+        launch(fixed);
+
+        auto add_fixed = [](at::Tensor &out, const at::Tensor &acc, float scale) {
+            out.add_(acc.to(at::kDouble).div_(scale).to(out.dtype()));
+        };
+        if (v_means2d_abs.has_value()) {
+            add_fixed(
+                v_means2d_abs.value(),
+                fixed_means2d_abs,
+                fixed.scale[kSlotMeans2dAbs]
+            );
+        }
+        add_fixed(v_means2d, fixed_means2d, fixed.scale[kSlotMeans2d]);
+        add_fixed(v_conics, fixed_conics, fixed.scale[kSlotConics]);
+        add_fixed(v_colors, fixed_colors, fixed.scale[kSlotColors]);
+        add_fixed(v_opacities, fixed_opacities, fixed.scale[kSlotOpacities]);
+    }
 }
 
 // Explicit Instantiation: this should match how it is being called in .cpp
@@ -36,7 +36,9 @@ __global__ void rasterize_to_pixels_3dgs_fwd_kernel(
     scalar_t
         *__restrict__ render_colors, // [C, image_height, image_width, CDIM]
     scalar_t *__restrict__ render_alphas, // [C, image_height, image_width, 1]
-    int32_t *__restrict__ last_ids        // [C, image_height, image_width]
+    int32_t *__restrict__ last_ids,       // [C, image_height, image_width]
+    float *__restrict__ gauss_weights,    // [C * N] or [nnz], optional
+    unsigned long long *__restrict__ gauss_hits // [C * N] or [nnz], optional
 ) {
     // each thread draws one pixel, but also timeshares caching gaussians in a
     // shared tile
@@ -163,6 +165,10 @@ __global__ void rasterize_to_pixels_3dgs_fwd_kernel(
             for (uint32_t k = 0; k < CDIM; ++k) {
                 pix_out[k] += c_ptr[k] * vis;
             }
+            if (gauss_weights != nullptr) {
+                atomicAdd(gauss_weights + g, vis);
+                atomicAdd(gauss_hits + g, 1ull);
+            }
             cur_idx = batch_start + t;
 
             T = next_T;
@@ -206,7 +212,10 @@ void launch_rasterize_to_pixels_3dgs_fwd_kernel(
     // outputs
     at::Tensor renders, // [C, image_height, image_width, channels]
     at::Tensor alphas,  // [C, image_height, image_width]
-    at::Tensor last_ids // [C, image_height, image_width]
+    at::Tensor last_ids, // [C, image_height, image_width]
+    // optional per-Gaussian accumulators
+    const at::optional<at::Tensor> gauss_weights, // [C * N] or [nnz]
+    const at::optional<at::Tensor> gauss_hits     // [C * N] or [nnz]
 ) {
     bool packed = means2d.dim() == 2;
 
@@ -261,7 +270,14 @@ void launch_rasterize_to_pixels_3dgs_fwd_kernel(
             flatten_ids.data_ptr<int32_t>(),
             renders.data_ptr<float>(),
             alphas.data_ptr<float>(),
-            last_ids.data_ptr<int32_t>()
+            last_ids.data_ptr<int32_t>(),
+            gauss_weights.has_value() ? gauss_weights.value().data_ptr<float>()
+                                      : nullptr,
+            gauss_hits.has_value()
+                ? reinterpret_cast<unsigned long long *>(
+                      gauss_hits.value().data_ptr<int64_t>()
+                  )
+                : nullptr
         );
 }
 
@@ -283,7 +299,9 @@ void launch_rasterize_to_pixels_3dgs_fwd_kernel(
         const at::Tensor flatten_ids,                                          \
         at::Tensor renders,                                                    \
         at::Tensor alphas,                                                     \
-        at::Tensor last_ids                                                    \
+        at::Tensor last_ids,                                                   \
+        const at::optional<at::Tensor> gauss_weights,                          \
+        const at::optional<at::Tensor> gauss_hits                              \
     );
 
 __INS__(1)
@@ -1,6 +1,8 @@
+#include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/core/Tensor.h>
 #include <c10/cuda/CUDAGuard.h> // for DEVICE_GUARD
+#include <cstring>
 #include <tuple>
 
 #include <ATen/Functions.h>
@@ -33,4 +35,127 @@ std::tuple<at::Tensor, at::Tensor> relocation(
     return std::make_tuple(new_opacities, new_scales);
 }
 
+namespace {
+
+void check_relocate_rows_tensor(
+    const at::Tensor &t,
+    const at::Tensor &ids,
+    const int64_t N,
+    const char *what
+) {
+    TORCH_CHECK(
+        t.device() == ids.device(),
+        what,
+        " must be on the same device as the row ids"
+    );
+    TORCH_CHECK(t.is_contiguous(), what, " must be contiguous");
+    TORCH_CHECK(
+        t.scalar_type() == at::kFloat, what, " must be a float32 tensor"
+    );
+    TORCH_CHECK(
+        t.dim() >= 1 && t.size(0) == N,
+        what,
+        " must have ",
+        N,
+        " rows, got ",
+        t.sizes()
+    );
+}
+
+void relocate_rows_cpu(
+    const std::vector<at::Tensor> &params,
+    const std::vector<at::Tensor> &moments,
+    const at::Tensor &src_ids,
+    const at::Tensor &dst_ids,
+    const at::Tensor &reset_ids
+) {
+    const int64_t *src = src_ids.data_ptr<int64_t>();
+    const int64_t *dst = dst_ids.data_ptr<int64_t>();
+    const int64_t *reset = reset_ids.data_ptr<int64_t>();
+
+    // rows are disjoint, so threads never touch the same memory; empty rows
+    // (shN at SH degree 0) are skipped, their data_ptr may be null
+    at::parallel_for(0, src_ids.numel(), 256, [&](int64_t begin, int64_t end) {
+        for (const auto &param : params) {
+            const int64_t width = param.numel() / param.size(0);
+            if (width == 0)
+                continue;
+            float *data = param.data_ptr<float>();
+            for (int64_t i = begin; i < end; ++i) {
+                std::memcpy(
+                    data + dst[i] * width,
+                    data + src[i] * width,
+                    width * sizeof(float)
+                );
+            }
+        }
+    });
+    at::parallel_for(
+        0, reset_ids.numel(), 256, [&](int64_t begin, int64_t end) {
+            for (const auto &moment : moments) {
+                const int64_t width = moment.numel() / moment.size(0);
+                if (width == 0)
+                    continue;
+                float *data = moment.data_ptr<float>();
+                for (int64_t i = begin; i < end; ++i) {
+                    std::fill_n(data + reset[i] * width, width, 0.0f);
+                }
+            }
+        }
+    );
+}
+
+} // namespace
+
+void relocate_rows_(
+    const std::vector<at::Tensor> &params,  // each [N, ...]
+    const std::vector<at::Tensor> &moments, // each [N, ...]
+    const at::Tensor src_ids,               // [M] int64
+    const at::Tensor dst_ids,               // [M] int64
+    const at::Tensor reset_ids              // [R] int64
+) {
+    for (const auto *ids : {&src_ids, &dst_ids, &reset_ids}) {
+        TORCH_CHECK(
+            ids->dim() == 1 && ids->scalar_type() == at::kLong &&
+                ids->is_contiguous(),
+            "row ids must be contiguous 1D int64 tensors"
+        );
+        TORCH_CHECK(
+            ids->device() == src_ids.device(),
+            "row ids must be on the same device"
+        );
+    }
+    TORCH_CHECK(
+        src_ids.numel() == dst_ids.numel(),
+        "src_ids and dst_ids must have the same length"
+    );
+    TORCH_CHECK(
+        params.size() + moments.size() <= kMaxRelocateTensors,
+        "relocate_rows_ handles at most ",
+        kMaxRelocateTensors,
+        " tensors"
+    );
+    if (params.empty() && moments.empty()) {
+        return;
+    }
+
+    const int64_t N =
+        params.empty() ? moments.front().size(0) : params.front().size(0);
+    for (const auto &param : params) {
+        check_relocate_rows_tensor(param, src_ids, N, "param");
+    }
+    for (const auto &moment : moments) {
+        check_relocate_rows_tensor(moment, src_ids, N, "moment");
+    }
+
+    if (src_ids.is_cpu()) {
+        relocate_rows_cpu(params, moments, src_ids, dst_ids, reset_ids);
+        return;
+    }
+
+    DEVICE_GUARD(src_ids);
+    CHECK_INPUT(src_ids);
+    launch_relocate_rows_kernel(params, moments, src_ids, dst_ids, reset_ids);
+}
+
 } // namespace gsplat
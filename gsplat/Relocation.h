@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 namespace at {
 class Tensor;
@@ -20,4 +21,17 @@ void launch_relocation_kernel(
     at::Tensor new_scales     // [N, 3]
 );
 
-}
\ No newline at end of file
+// Upper bound on params + moments handled by one relocate_rows_ launch
+constexpr int kMaxRelocateTensors = 32;
+
+void launch_relocate_rows_kernel(
+    // inputs / outputs
+    const std::vector<at::Tensor> &params,  // each [N, ...]
+    const std::vector<at::Tensor> &moments, // each [N, ...]
+    // rows
+    const at::Tensor src_ids,  // [M]
+    const at::Tensor dst_ids,  // [M]
+    const at::Tensor reset_ids // [R]
+);
+
+} // namespace gsplat
\ No newline at end of file
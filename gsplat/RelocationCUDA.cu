@@ -88,4 +88,90 @@ void launch_relocation_kernel(
     );
 }
 
+// Flattened view of the tensors touched by one relocate_rows_ launch, passed by
+// value as a kernel argument. Tensor j owns threads [offset[j], offset[j + 1]):
+// one per element of the rows it copies (params) or zeroes (moments).
+struct RelocateRowsTable {
+    float *data[kMaxRelocateTensors];
+    int64_t width[kMaxRelocateTensors];
+    int64_t offset[kMaxRelocateTensors + 1];
+    bool reset[kMaxRelocateTensors];
+    int n;
+};
+
+__global__ void relocate_rows_kernel(
+    const RelocateRowsTable table,
+    const int64_t *__restrict__ src_ids,  // [M]
+    const int64_t *__restrict__ dst_ids,  // [M]
+    const int64_t *__restrict__ reset_ids // [R]
+) {
+    const int64_t idx =
+        static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (idx >= table.offset[table.n])
+        return;
+
+    int j = 0;
+    while (idx >= table.offset[j + 1])
+        ++j;
+
+    const int64_t width = table.width[j];
+    const int64_t local = idx - table.offset[j];
+    const int64_t row = local / width;
+    const int64_t col = local - row * width;
+    float *data = table.data[j];
+    if (table.reset[j]) {
+        data[reset_ids[row] * width + col] = 0.0f;
+    } else {
+        data[dst_ids[row] * width + col] = data[src_ids[row] * width + col];
+    }
+}
+
+void launch_relocate_rows_kernel(
+    // inputs / outputs
+    const std::vector<at::Tensor> &params,  // each [N, ...]
+    const std::vector<at::Tensor> &moments, // each [N, ...]
+    // rows
+    const at::Tensor src_ids,  // [M]
+    const at::Tensor dst_ids,  // [M]
+    const at::Tensor reset_ids // [R]
+) {
+    RelocateRowsTable table{};
+    table.offset[0] = 0;
+    auto add = [&](const at::Tensor &t, int64_t rows, bool reset) {
+        const int64_t width = t.size(0) == 0 ? 0 : t.numel() / t.size(0);
+        if (width == 0 || rows == 0)
+            return;
+        table.data[table.n] = t.data_ptr<float>();
+        table.width[table.n] = width;
+        table.reset[table.n] = reset;
+        table.offset[table.n + 1] = table.offset[table.n] + rows * width;
+        ++table.n;
+    };
+    for (const auto &param : params)
+        add(param, src_ids.numel(), false);
+    for (const auto &moment : moments)
+        add(moment, reset_ids.numel(), true);
+
+    int64_t n_elements = table.offset[table.n];
+    dim3 threads(256);
+    dim3 grid((n_elements + threads.x - 1) / threads.x);
+    int64_t shmem_size = 0; // No shared memory used in this kernel
+
+    if (n_elements == 0) {
+        // skip the kernel launch if there are no elements
+        return;
+    }
+
+    relocate_rows_kernel<<<
+        grid,
+        threads,
+        shmem_size,
+        at::cuda::getCurrentCUDAStream()>>>(
+        table,
+        src_ids.data_ptr<int64_t>(),
+        dst_ids.data_ptr<int64_t>(),
+        reset_ids.data_ptr<int64_t>()
+    );
+}
+
 } // namespace gsplat
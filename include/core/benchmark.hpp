@@ -0,0 +1,123 @@
+#pragma once
+
+#include "core/profiler.hpp"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gs::bench {
+
+    // One point of the parameter grid. Parameters a stage does not depend on
+    // are -1.
+    struct BenchConfig {
+        int64_t num_gaussians = -1;
+        int width = -1;
+        int height = -1;
+        int sh_degree = -1;
+    };
+
+    // Parameters a stage depends on
+    enum Uses : unsigned {
+        UsesGaussians = 1u << 0,
+        UsesResolution = 1u << 1,
+        UsesShDegree = 1u << 2
+    };
+
+    // Cartesian product, Gaussian counts varying slowest
+    std::vector<BenchConfig> make_grid(const std::vector<int64_t>& gaussians,
+                                       const std::vector<std::pair<int, int>>& resolutions,
+                                       const std::vector<int>& sh_degrees);
+
+    // The distinct configurations of grid once the unused parameters are
+    // cleared, in grid order
+    std::vector<BenchConfig> stage_grid(const std::vector<BenchConfig>& grid, unsigned uses);
+
+    // "100000,1e6" and "1920x1080,1280x720"; throw std::invalid_argument
+    std::vector<int64_t> parse_counts(const std::string& list);
+    std::vector<std::pair<int, int>> parse_resolutions(const std::string& list);
+    std::vector<std::string> split_list(const std::string& list);
+
+    struct TimingOptions {
+        int warmup = 2;             // untimed calls before measuring
+        int min_iterations = 5;
+        int max_iterations = 1000;
+        double min_time_ms = 200.0; // keep timing until this much wall time has passed
+    };
+
+    struct Timing {
+        int iterations = 0;
+        double mean_ms = 0.0;
+        double stddev_ms = 0.0;
+        double min_ms = 0.0;
+        double p50_ms = 0.0;
+        double p90_ms = 0.0;
+        double max_ms = 0.0;
+    };
+
+    // Timing of an already measured sample
+    Timing summarize(std::vector<double> samples_ms);
+
+    // Calls fn warmup times, then times calls until both min_iterations and
+    // min_time_ms are reached, or max_iterations. With a device timer every
+    // call is measured between two device marks, which are read once at the
+    // end, so device work is timed without a host sync per call.
+    Timing measure(const std::function<void()>& fn, const TimingOptions& options, DeviceTimer* device_timer = nullptr);
+
+    struct BenchResult {
+        std::string stage;  // e.g. "rasterize_bwd"
+        std::string device; // "cuda" or "cpu"
+        BenchConfig config;
+        Timing timing;
+        std::map<std::string, double> counters; // stage specific sizes, e.g. "n_isects"
+        std::string skipped;                    // why the stage did not run, empty when measured
+    };
+
+    // A benchmarked stage. setup() prepares the inputs of one configuration
+    // outside the timing, may fill stage specific counters and returns the
+    // call to time. Host pipeline stages only have a CPU implementation.
+    struct Stage {
+        using Counters = std::map<std::string, double>;
+        using Setup = std::function<std::function<void()>(const BenchConfig& config, bool cuda, Counters& counters)>;
+
+        std::string name;
+        unsigned uses = 0; // Uses flags
+        bool has_cuda = false;
+        bool has_cpu = true;
+        Setup setup;
+    };
+
+    // The gsplat ops on synthetic scenes and the host pipeline stages
+    // (benchmark_stages.cpp)
+    std::vector<Stage> default_stages();
+
+    struct RunOptions {
+        std::vector<std::string> devices = {"cuda"}; // for stages with both implementations
+        bool cuda_available = false;
+        TimingOptions timing;
+    };
+
+    // Runs every stage over its part of grid. A stage that cannot run on a
+    // requested device, or throws, is reported as skipped with the reason.
+    // device_timer times the CUDA runs; progress, if set, sees each result.
+    std::vector<BenchResult> run_stages(const std::vector<Stage>& stages,
+                                        const std::vector<BenchConfig>& grid,
+                                        const RunOptions& options,
+                                        DeviceTimer* device_timer = nullptr,
+                                        const std::function<void(const BenchResult&)>& progress = {});
+
+    // Key identifying a result across runs, e.g. "sh/cuda/n=100000/sh=3"
+    std::string result_id(const BenchResult& result);
+
+    // Stable layout for tracking over time: schema_version, the run context
+    // and the results sorted by stage, device and parameters, all with fixed
+    // keys. Unused parameters are null, timings of skipped stages are absent.
+    nlohmann::json results_to_json(std::vector<BenchResult> results, const nlohmann::json& context);
+
+    // Human-readable table of the results
+    std::string format_results(const std::vector<BenchResult>& results);
+
+} // namespace gs::bench
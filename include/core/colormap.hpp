@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace image_io {
+
+    enum class Colormap {
+        Jet,
+        Turbo,
+        Viridis,
+        Inferno,
+        Gray
+    };
+
+    // Accepts "jet", "turbo", "viridis", "inferno" and "gray"
+    Colormap colormap_from_string(const std::string& name);
+    std::string to_string(Colormap colormap);
+
+    // 256-entry RGB8 lookup table of a palette, built once on first use
+    using ColormapLUT = std::array<std::array<uint8_t, 3>, 256>;
+    const ColormapLUT& colormap_lut(Colormap colormap);
+
+    // Smallest and largest finite value (0, 0 when there is none)
+    std::pair<float, float> finite_range(const float* values, size_t count);
+
+    // Maps a row-major height x width float image linearly from [lo, hi] onto
+    // the palette and writes interleaved RGB8 pixels to `out`, whose rows are
+    // `out_row_stride` bytes apart, so the result can land directly inside a
+    // larger composed image. Values outside the range are clamped and NaN maps
+    // to the first entry. The per-pixel index computation runs over fixed-size
+    // chunks the compiler vectorizes; the table lookup is a 3-byte copy.
+    void apply_colormap(const float* values,
+                        int height,
+                        int width,
+                        float lo,
+                        float hi,
+                        Colormap colormap,
+                        uint8_t* out,
+                        size_t out_row_stride);
+
+} // namespace image_io
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "core/camera.hpp"
+#include "core/istrategy.hpp"
+#include <string>
+#include <torch/torch.h>
+#include <vector>
+
+namespace gs {
+
+    // Blending weight T * alpha of every Gaussian summed over all pixels of the
+    // given views, i.e. how many pixels' worth of colour it contributes. Gaussians
+    // that are never visible score 0. Collected by ContributionStats during one
+    // forward render per view, on both the CUDA and the CPU backend.
+    torch::Tensor contribution_scores(SplatData& model, const std::vector<Camera*>& views, int tile_size = 16);
+
+    // Gaussians to drop: opacity <= min_opacity or a score below min_weight
+    torch::Tensor low_contribution_mask(const SplatData& model, const torch::Tensor& scores,
+                                        float min_opacity, float min_weight);
+
+    // Mean forward render time over the views, in milliseconds
+    double mean_render_ms(SplatData& model, const std::vector<Camera*>& views, int tile_size = 16);
+
+    struct CompactionReport {
+        int64_t gaussians_before = 0;
+        int64_t gaussians_after = 0;
+        size_t bytes_before = 0;
+        size_t bytes_after = 0;
+        double render_ms_before = 0.0;
+        double render_ms_after = 0.0;
+
+        std::string to_string() const;
+    };
+
+    // Scores the strategy's model over the views and removes low-contribution
+    // Gaussians through the strategy, which keeps its optimizer state in sync so
+    // training can continue on the compacted model
+    CompactionReport compact(IStrategy& strategy, const std::vector<Camera*>& views,
+                             float min_opacity, float min_weight, int tile_size = 16);
+
+} // namespace gs
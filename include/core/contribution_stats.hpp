@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <torch/torch.h>
+
+namespace gs {
+
+    // Per-Gaussian contribution to the rendered pixels, accumulated by the
+    // rasterizer's forward pass while collection is enabled:
+    //   weight_sum   [N] float  sum of blending weights T * alpha over all pixels
+    //   hit_count    [N] int64  number of pixels the Gaussian was blended into
+    //   last_visible [N] int32  last iteration with radii > 0, -1 if never
+    // Rows follow the model: strategies call select/append/reset whenever they
+    // remove, add or replace Gaussians, and new rows start from zero.
+    class ContributionStats {
+    public:
+        // Makes stats current on this thread, like RasterWorkspace::Scope
+        class Scope {
+        public:
+            explicit Scope(ContributionStats* stats);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            ContributionStats* previous_;
+        };
+
+        // Stats of the innermost Scope on this thread, or nullptr
+        static ContributionStats* current();
+
+        // Starts collecting for n Gaussians on device, clearing earlier stats
+        void enable(int64_t n, const torch::Device& device);
+        void disable();
+        bool enabled() const { return weight_sum_.defined(); }
+        int64_t size() const { return enabled() ? weight_sum_.size(0) : 0; }
+
+        // Accumulators the forward pass adds into for a render of n Gaussians.
+        // Undefined when disabled or when n does not match the tracked rows.
+        torch::Tensor weight_buffer(int64_t n) const;
+        torch::Tensor hit_buffer(int64_t n) const;
+
+        // Stamps iter on the Gaussians where visibility [N] is true
+        void mark_visible(const torch::Tensor& visibility, int iter);
+
+        // Row bookkeeping mirroring the strategies' edits
+        void select(const torch::Tensor& indices); // keep these rows, in this order
+        void append(int64_t n);                    // n new Gaussians at the end
+        void reset(const torch::Tensor& indices);  // rows reused for new Gaussians
+
+        const torch::Tensor& weight_sum() const { return weight_sum_; }
+        const torch::Tensor& hit_count() const { return hit_count_; }
+        const torch::Tensor& last_visible() const { return last_visible_; }
+
+        // Host copies, as saved next to the model
+        ContributionStats cpu() const;
+
+        // torch::save archive with the three tensors; load replaces the current stats
+        void save(const std::filesystem::path& path) const;
+        void load(const std::filesystem::path& path, const torch::Device& device);
+
+    private:
+        torch::Tensor weight_sum_;
+        torch::Tensor hit_count_;
+        torch::Tensor last_visible_;
+    };
+
+} // namespace gs
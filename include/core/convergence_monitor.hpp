@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+
+namespace gs {
+
+    // Decides when training stops improving. At every check a quality score in
+    // dB is recorded (higher is better): held-out PSNR, or the smoothed training
+    // loss as -10 log10(loss) when there is no validation set. A check improves
+    // on the best score only by at least min_gain_db; after patience checks in a
+    // row without such an improvement, training has converged.
+    class ConvergenceMonitor {
+    public:
+        struct Config {
+            int check_every = 1000;     // iterations between checks
+            int min_iterations = 0;     // never converged before this iteration
+            int patience = 3;           // checks without improvement before stopping
+            double min_gain_db = 0.05;  // smallest improvement that counts
+            double loss_smoothing = 0.99; // EMA decay of the training loss per iteration
+        };
+
+        explicit ConvergenceMonitor(Config config);
+
+        // Feeds the loss of every training iteration
+        void observe_loss(float loss);
+
+        bool is_check(int iter) const;
+
+        // Records the score of the check at iter; returns true once converged
+        bool check(int iter, double score_db);
+        // Same, scored by the smoothed training loss
+        bool check_loss(int iter) { return check(iter, smoothed_loss_db()); }
+
+        double smoothed_loss_db() const;
+        bool converged() const { return converged_; }
+        double best_db() const { return best_db_; }
+        int last_gain_iteration() const { return gain_iter_; }
+        int stale_checks() const { return stale_; }
+
+        // One line for the log, e.g. "converged at 12000: 27.30 dB, best 27.31 dB, ..."
+        std::string summary() const;
+
+    private:
+        Config config_;
+        double loss_ema_ = 0.0;
+        int loss_count_ = 0;
+        double best_db_ = 0.0;
+        int gain_iter_ = -1; // last check that improved by min_gain_db
+        int last_iter_ = -1;
+        double last_db_ = 0.0;
+        int stale_ = 0;
+        bool converged_ = false;
+    };
+
+} // namespace gs
@@ -74,6 +74,11 @@ public:
         return _cameras;
     }
 
+    // Camera of the index-th example of this split, without loading its image
+    Camera* get_camera(size_t index) const {
+        return _cameras.at(_indices.at(index)).get();
+    }
+
     Split get_split() const { return _split; }
 
 private:
@@ -122,9 +127,12 @@ inline std::tuple<std::shared_ptr<CameraDataset>, torch::Tensor> create_dataset_
     return {dataset, scene_center};
 }
 
+// The sampler draws from torch's global CPU generator; with enforce_ordering the
+// batches also arrive in sampler order, making the sequence reproducible
 inline auto create_dataloader_from_dataset(
     std::shared_ptr<CameraDataset> dataset,
-    int num_workers = 4) {
+    int num_workers = 4,
+    bool enforce_ordering = false) {
 
     const size_t dataset_size = dataset->size().value();
 
@@ -134,5 +142,22 @@ inline auto create_dataloader_from_dataset(
         torch::data::DataLoaderOptions()
             .batch_size(1)
             .workers(num_workers)
-            .enforce_ordering(false));
+            .enforce_ordering(enforce_ordering));
+}
+
+// Views in dataset order, loaded by the worker threads ahead of the consumer.
+// get() only touches the camera of its own index, so workers never share one.
+inline auto create_sequential_dataloader_from_dataset(
+    std::shared_ptr<CameraDataset> dataset,
+    int num_workers = 1) {
+
+    const size_t dataset_size = dataset->size().value();
+
+    return torch::data::make_data_loader(
+        *dataset,
+        torch::data::samplers::SequentialSampler(dataset_size),
+        torch::data::DataLoaderOptions()
+            .batch_size(1)
+            .workers(num_workers)
+            .enforce_ordering(true));
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "core/istrategy.hpp"
+#include "core/strategy_utils.hpp"
+#include <memory>
+#include <torch/torch.h>
+
+// Densification of the original 3DGS paper: Gaussians with large screen-space
+// position gradients are cloned (small ones) or split (large ones), transparent
+// and oversized ones are pruned, and opacities are reset periodically.
+class DefaultStrategy : public IStrategy {
+public:
+    DefaultStrategy() = delete;
+    // Parameters and optimizer state live on device (CUDA by default, CPU for the CPU backend)
+    DefaultStrategy(SplatData&& splat_data, torch::Device device = torch::kCUDA);
+
+    DefaultStrategy(const DefaultStrategy&) = delete;
+    DefaultStrategy& operator=(const DefaultStrategy&) = delete;
+    DefaultStrategy(DefaultStrategy&&) = default;
+    DefaultStrategy& operator=(DefaultStrategy&&) = default;
+
+    // IStrategy interface implementation
+    void initialize(const gs::param::OptimizationParameters& optimParams) override;
+    void post_backward(int iter, gs::RenderOutput& render_output) override;
+    bool is_refining(int iter) const override;
+    void step(int iter) override;
+    void remove_gaussians(const torch::Tensor& mask) override;
+    void report_memory(gs::MemoryReport& report) const override;
+    SplatData& get_model() override { return _splat_data; }
+    const SplatData& get_model() const override { return _splat_data; }
+
+    // Refinement steps, public so they can be driven directly
+    void update_state(const gs::RenderOutput& render_output);
+    // Returns the number of cloned and split Gaussians
+    std::pair<int, int> grow_gs();
+    int prune_gs(int iter);
+    void reset_opacity();
+
+private:
+    void duplicate(const torch::Tensor& mask);
+    void split(const torch::Tensor& mask);
+
+    // Member variables
+    std::unique_ptr<torch::optim::Optimizer> _optimizer;
+    std::unique_ptr<gs::LRScheduler> _scheduler;
+    SplatData _splat_data;
+    torch::Device _device;
+    std::unique_ptr<const gs::param::OptimizationParameters> _params;
+
+    // Running sums of the screen-space gradient norm and of the visible count
+    torch::Tensor _grad2d;
+    torch::Tensor _count;
+    at::Generator _generator; // seeded from OptimizationParameters::seed in initialize()
+
+    // SelectiveAdam support
+    torch::Tensor _last_visibility_mask;
+};
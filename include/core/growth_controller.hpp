@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace gs {
+
+    // What bounds the number of Gaussians MCMC adds per refine
+    enum class GrowthMode {
+        Fixed,          // +5% per refine up to max_cap (MCMC paper)
+        MemoryBudget,   // stay below a fraction of device memory
+        StepTimeBudget, // stay below a per-iteration time
+        FinalCount      // geometric schedule reaching max_cap at stop_refine
+    };
+
+    // "fixed", "vram", "step_time" or "count"; throws std::invalid_argument otherwise
+    GrowthMode growth_mode_from_string(const std::string& name);
+    std::string to_string(GrowthMode mode);
+
+    // Resource use observed between two refines
+    struct GrowthSample {
+        int64_t num_gaussians = 0;
+        double peak_bytes = 0.0; // peak device memory allocated by training
+        double step_ms = 0.0;    // mean iteration time
+    };
+
+    struct GrowthDecision {
+        int64_t n_new = 0;    // Gaussians to add at this refine
+        int64_t limit = 0;    // estimated count that still fits the budget
+        std::string reason;   // what bounded n_new, e.g. "memory budget"
+    };
+
+    // Picks the per-refine growth from measured memory use and iteration time.
+    // Both are modelled as linear in the Gaussian count (y = a + b * n), fitted
+    // by least squares over all samples, so the limit of a budget is
+    // (safety * budget - a) / b. Growth never exceeds max_rate per refine, which
+    // leaves the model time to correct itself before the budget is reached.
+    class GrowthController {
+    public:
+        struct Config {
+            GrowthMode mode = GrowthMode::Fixed;
+            int64_t max_cap = 1'000'000;
+            double max_rate = 0.05;            // largest relative growth per refine
+            double memory_budget_bytes = 0.0;  // MemoryBudget
+            double step_time_budget_ms = 0.0;  // StepTimeBudget
+            double safety = 0.95;              // fraction of a budget that may be planned for
+        };
+
+        explicit GrowthController(Config config);
+
+        void observe(const GrowthSample& sample);
+
+        // Growth for a model of current_n Gaussians with refines_left refines
+        // remaining, this one included
+        GrowthDecision decide(int64_t current_n, int refines_left) const;
+
+        // Fitted marginal cost of one Gaussian, 0 before the first sample
+        double bytes_per_gaussian() const { return memory_.slope(); }
+        double ms_per_gaussian() const { return time_.slope(); }
+
+        const Config& config() const { return config_; }
+
+    private:
+        // Running least-squares fit of y = a + b * n
+        struct LinearFit {
+            double count = 0, sn = 0, sy = 0, snn = 0, sny = 0;
+            double last_n = 0, last_y = 0;
+
+            void add(double n, double y);
+            double slope() const;
+            double intercept() const;
+            // Largest n with a + b * n <= y_max
+            double solve(double y_max) const;
+        };
+
+        Config config_;
+        LinearFit memory_;
+        LinearFit time_;
+    };
+
+} // namespace gs
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <filesystem>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 #include <torch/torch.h>
 #include <vector>
@@ -13,6 +15,8 @@
 // Existing functions
 std::tuple<unsigned char*, int, int, int>
 load_image(std::filesystem::path p, int res_div = -1);
+// Float images are in [0, 1], [C, H, W] or [H, W, C]; uint8 images are [H, W, C] and written unchanged.
+// The format follows the extension (.png, .jpg/.jpeg).
 void save_image(const std::filesystem::path& path, torch::Tensor image);
 void save_image(const std::filesystem::path& path,
                 const std::vector<torch::Tensor>& images,
@@ -23,6 +27,51 @@ void free_image(unsigned char* image);
 // Batch image saving functionality
 namespace image_io {
 
+    enum class ImageFormat {
+        Auto, // from the file extension (.png, .jpg/.jpeg)
+        PNG,
+        JPEG,
+        Raw // uncompressed binary PGM/PPM/PAM, no encoding cost
+    };
+
+    // Accepts "auto", "png", "jpg"/"jpeg" and "raw"
+    ImageFormat image_format_from_string(const std::string& name);
+
+    struct ImageWriterConfig {
+        size_t num_workers = 4;
+        size_t max_queue = 16; // queued images before producers block
+        ImageFormat format = ImageFormat::Auto;
+        int png_compression_level = 8; // zlib level 0-9; low levels encode several times faster
+        int jpeg_quality = 95;
+    };
+
+    // [H, W, C] uint8 CPU image of a float image in [0, 1] given as [C, H, W],
+    // [H, W, C] or with a leading batch of one. The conversion runs on the
+    // image's device, so CUDA images are copied back at a quarter of the size.
+    // uint8 inputs are taken as [H, W, C]; contiguous CPU ones are returned as is.
+    torch::Tensor to_rgb8(const torch::Tensor& image);
+
+    // Images of equal channel count next to (or below) each other with white
+    // separators, converted into one [H, W, C] uint8 CPU buffer
+    torch::Tensor compose_rgb8(const std::vector<torch::Tensor>& images, bool horizontal, int separator_width);
+
+    // White [H, panels * W + (panels - 1) * separator_width, 3] uint8 CPU image
+    // that equally sized panels are written into in place
+    torch::Tensor make_side_by_side_canvas(int64_t height, int64_t panel_width, int panels, int separator_width);
+
+    // [H, W, 3] view of one panel of such a canvas (rows keep the canvas stride)
+    torch::Tensor canvas_panel(const torch::Tensor& canvas, int panel, int64_t panel_width, int separator_width);
+
+    // Encodes an [H, W, C] uint8 CPU image. Unless the format is Auto, the
+    // extension of `path` is replaced to match it; the written path is returned.
+    std::filesystem::path write_rgb8(const std::filesystem::path& path,
+                                     const torch::Tensor& rgb8,
+                                     ImageFormat format = ImageFormat::Auto,
+                                     int jpeg_quality = 95);
+
+    // stb keeps the PNG zlib level in a process-wide variable
+    void set_png_compression_level(int level);
+
     class BatchImageSaver {
     public:
         // Singleton pattern to ensure cleanup on exit
@@ -37,8 +86,15 @@ namespace image_io {
         BatchImageSaver(BatchImageSaver&&) = delete;
         BatchImageSaver& operator=(BatchImageSaver&&) = delete;
 
-        // Queue image for asynchronous saving
-        void queue_save(const std::filesystem::path& path, torch::Tensor image);
+        // Drains the queue and restarts the workers with the new settings.
+        // Must not race with other threads queueing images.
+        void configure(const ImageWriterConfig& config);
+        ImageWriterConfig config() const;
+
+        // Queue image for asynchronous saving. The image is converted to uint8
+        // on the calling thread; blocks while the queue is full. uint8 CPU
+        // buffers are queued without a copy and must not be modified afterwards.
+        void queue_save(const std::filesystem::path& path, const torch::Tensor& image);
 
         // Queue multiple images for side-by-side saving
         void queue_save_multiple(const std::filesystem::path& path,
@@ -60,34 +116,34 @@ namespace image_io {
         bool is_enabled() const { return enabled_; }
 
     private:
-        BatchImageSaver(size_t num_workers = 4);
+        BatchImageSaver();
         ~BatchImageSaver();
 
         struct SaveTask {
             std::filesystem::path path;
-            torch::Tensor image;
-            std::vector<torch::Tensor> images;
-            bool is_multi;
-            bool horizontal;
-            int separator_width;
+            torch::Tensor rgb8; // [H, W, C] uint8 on the CPU
         };
 
+        void enqueue(SaveTask task);
+        void start_workers();
+        void stop_workers();
         void worker_thread();
-        void process_task(const SaveTask& task);
+        void process_task(const SaveTask& task) const;
 
+        ImageWriterConfig config_;
         std::vector<std::thread> workers_;
         std::queue<SaveTask> task_queue_;
         mutable std::mutex queue_mutex_;
         std::condition_variable cv_;
+        std::condition_variable cv_space_;
         std::condition_variable cv_finished_;
         std::atomic<bool> stop_{false};
         std::atomic<size_t> active_tasks_{0};
         std::atomic<bool> enabled_{true};
-        size_t num_workers_;
     };
 
     // Convenience functions that use the singleton
-    inline void save_image_async(const std::filesystem::path& path, torch::Tensor image) {
+    inline void save_image_async(const std::filesystem::path& path, const torch::Tensor& image) {
         BatchImageSaver::instance().queue_save(path, image);
     }
 
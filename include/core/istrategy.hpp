@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/memory_report.hpp"
 #include "core/parameters.hpp"
 #include "core/splat_data.hpp"
 
@@ -15,6 +16,13 @@ public:
     virtual void post_backward(int iter, gs::RenderOutput& render_output) = 0;
     virtual void step(int iter) = 0;
     virtual bool is_refining(int iter) const = 0;
+    // The time until the next post_backward includes work outside the training
+    // step (eval, save, compaction, a pause); strategies that measure step time skip it
+    virtual void skip_next_step_time() {}
+    // Drops the Gaussians where mask [N] is true, with their optimizer state
+    virtual void remove_gaussians(const torch::Tensor& mask) = 0;
+    // Adds the model, its optimizer state and the strategy's own buffers to report
+    virtual void report_memory(gs::MemoryReport& report) const = 0;
     // Get the underlying Gaussian model for rendering
     virtual SplatData& get_model() = 0;
     virtual const SplatData& get_model() const = 0;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <torch/torch.h>
+#include <vector>
+
+namespace gs {
+
+    enum class LRSchedule {
+        Constant,
+        Exponential, // final_factor^(t / T)
+        Cosine,      // final_factor + (1 - final_factor) * (1 + cos(pi * t / T)) / 2
+        Step         // exponential evaluated at multiples of step_size only
+    };
+
+    // "constant", "exponential", "cosine" or "step"; throws std::invalid_argument otherwise
+    LRSchedule lr_schedule_from_string(const std::string& name);
+    std::string to_string(LRSchedule schedule);
+
+    // Learning rate of one param group relative to its initial value.
+    // Exponential and cosine reach final_factor at the last step. Step holds the
+    // value of the last multiple of step_size, so it only lands on final_factor
+    // when step_size divides the step count. A linear warmup from warmup_start
+    // to 1 over the first warmup_steps multiplies on top.
+    struct LRScheduleConfig {
+        LRSchedule type = LRSchedule::Constant;
+        double final_factor = 1.0;
+        int step_size = 1; // Step only
+        int warmup_steps = 0;
+        double warmup_start = 0.0;
+    };
+
+    // Closed-form multiplier at step t of total_steps, t clamped to [0, total_steps]
+    double lr_factor(const LRScheduleConfig& config, int step, int total_steps);
+
+    // Sets lr = initial lr * factor(step) on every scheduled param group of an
+    // Adam or SelectiveAdam optimizer. Factors are tabulated once per group
+    // and the options of each group are resolved at construction, so step()
+    // is a table lookup and a store per group.
+    class LRScheduler {
+    public:
+        // The current learning rates become the initial ones
+        LRScheduler(torch::optim::Optimizer& optimizer, int total_steps);
+
+        // Schedules group, or replaces its schedule, and applies the factor of the current step
+        void set_schedule(int group, const LRScheduleConfig& config);
+
+        // Advances one optimizer step
+        void step();
+
+        int current_step() const { return step_; }
+        int total_steps() const { return total_steps_; }
+        double factor(int group, int step) const;
+
+        // Step counter, initial learning rates and factor tables, for checkpoints.
+        // load() expects an optimizer with the same param groups and applies the restored rates.
+        void save(torch::serialize::OutputArchive& archive) const;
+        void load(torch::serialize::InputArchive& archive);
+
+    private:
+        void apply();
+
+        int total_steps_;
+        int step_ = 0;
+        std::vector<double> base_lrs_;
+        std::vector<std::vector<double>> tables_; // [group][step], empty when unscheduled
+        std::vector<std::function<void(double)>> set_lr_;
+    };
+
+} // namespace gs
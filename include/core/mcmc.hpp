@@ -1,14 +1,19 @@
 #pragma once
 
+#include "core/growth_controller.hpp"
 #include "core/istrategy.hpp"
 #include "core/selective_adam.hpp"
+#include "core/strategy_utils.hpp"
+#include <chrono>
 #include <memory>
 #include <torch/torch.h>
+#include <vector>
 
 class MCMC : public IStrategy {
 public:
     MCMC() = delete;
-    MCMC(SplatData&& splat_data);
+    // Parameters and optimizer state live on device (CUDA by default, CPU for the CPU backend)
+    MCMC(SplatData&& splat_data, torch::Device device = torch::kCUDA);
 
     MCMC(const MCMC&) = delete;
     MCMC& operator=(const MCMC&) = delete;
@@ -20,40 +25,27 @@ public:
     void post_backward(int iter, gs::RenderOutput& render_output) override;
     bool is_refining(int iter) const override;
     void step(int iter) override;
+    void skip_next_step_time() override { _skip_next_step_time = true; }
+    void remove_gaussians(const torch::Tensor& mask) override;
+    void report_memory(gs::MemoryReport& report) const override;
     SplatData& get_model() override { return _splat_data; }
     const SplatData& get_model() const override { return _splat_data; }
 
 private:
-    // Simple ExponentialLR implementation since C++ API is different
-    class ExponentialLR {
-    public:
-        ExponentialLR(torch::optim::Optimizer& optimizer, double gamma, int param_group_index = -1)
-            : optimizer_(optimizer),
-              gamma_(gamma),
-              param_group_index_(param_group_index) {}
-
-        void step();
-
-    private:
-        torch::optim::Optimizer& optimizer_;
-        double gamma_;
-        int param_group_index_;
-    };
-
     // Helper functions
-    torch::Tensor multinomial_sample(const torch::Tensor& weights, int n, bool replacement = true);
     int relocate_gs();
-    int add_new_gs();
+    int add_new_gs(int iter);
     void inject_noise();
-    void update_optimizer_for_relocate(torch::optim::Optimizer* optimizer,
-                                       const torch::Tensor& sampled_indices,
-                                       const torch::Tensor& dead_indices,
-                                       int param_position);
+    // Feeds the memory and step time measured since the last refine to _growth
+    void observe_growth_sample();
+    // Adam moments of all parameter groups that have optimizer state
+    std::vector<torch::Tensor> optimizer_moments() const;
 
     // Member variables
     std::unique_ptr<torch::optim::Optimizer> _optimizer;
-    std::unique_ptr<ExponentialLR> _scheduler;
+    std::unique_ptr<gs::LRScheduler> _scheduler;
     SplatData _splat_data;
+    torch::Device _device;
     std::unique_ptr<const gs::param::OptimizationParameters> _params;
 
     // MCMC specific parameters
@@ -61,7 +53,16 @@ private:
 
     // State variables
     torch::Tensor _binoms;
+    at::Generator _generator; // seeded from OptimizationParameters::seed in initialize()
 
     // SelectiveAdam support
     torch::Tensor _last_visibility_mask;
+
+    // Growth schedule and the measurements it is fed
+    std::unique_ptr<gs::GrowthController> _growth;
+    std::string _last_growth_reason;
+    std::chrono::steady_clock::time_point _last_post_backward;
+    double _step_ms_sum = 0.0;
+    int _step_count = 0;
+    bool _skip_next_step_time = true; // set after a refine and by the trainer around non-training work
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gs {
+
+    // Categories shared by measured and predicted reports
+    namespace memory_category {
+        inline constexpr const char* Parameters = "parameters";
+        inline constexpr const char* Gradients = "gradients";
+        inline constexpr const char* AdamMoments = "adam moments";
+        inline constexpr const char* StrategyState = "strategy state";
+        inline constexpr const char* BilateralGrid = "bilateral grid";
+        inline constexpr const char* Rasterizer = "rasterizer";   // workspace buffers reused across steps
+        inline constexpr const char* Activations = "activations"; // live only during a step
+        inline constexpr const char* DatasetImages = "dataset images";
+    } // namespace memory_category
+
+    struct MemoryEntry {
+        std::string category;
+        std::string name; // e.g. the param group
+        int64_t bytes = 0;
+    };
+
+    // Device memory of training broken down by owner
+    class MemoryReport {
+    public:
+        // Adds to an existing entry of the same category and name
+        void add(const std::string& category, const std::string& name, int64_t bytes);
+
+        int64_t total() const;
+        int64_t category_bytes(const std::string& category) const;
+        const std::vector<MemoryEntry>& entries() const { return entries_; }
+
+        // Caching allocator counters the entries are compared against, -1 if unknown
+        int64_t allocated_bytes = -1;
+        int64_t peak_allocated_bytes = -1;
+        int64_t reserved_bytes = -1;
+
+        // One line per category with its entries indented below
+        std::string to_string() const;
+
+    private:
+        std::vector<MemoryEntry> entries_; // in insertion order
+    };
+
+    // "512 B", "1.50 KiB", "2.25 GiB"
+    std::string format_bytes(double bytes);
+
+    // Inputs of the analytic footprint model
+    struct MemoryModelConfig {
+        int64_t num_gaussians = 0;
+        int sh_degree = 3;
+        bool default_strategy = false;     // keeps screen-space gradient statistics per Gaussian
+        bool contribution_stats = false;
+        int64_t image_width = 0;           // largest training image, after downscaling
+        int64_t image_height = 0;
+        int tile_size = 16;
+        double isects_per_gaussian = 8.0;  // tile intersections per Gaussian, measured once training runs
+        int64_t num_images = 0;            // bilateral grid holds one grid per image
+        bool bilateral_grid = false;
+        int grid_X = 16;
+        int grid_Y = 16;
+        int grid_W = 8;
+        int prefetched_images = 9;         // ground truth images on the device at once
+    };
+
+    // Expected peak footprint of a training step with the same categories as a
+    // measured report. Parameters, gradients and moments are exact for float32;
+    // rasterizer and activation sizes follow the kernels' buffer layouts with
+    // the intersection count estimated from isects_per_gaussian.
+    MemoryReport predict_memory(const MemoryModelConfig& config);
+
+    // Largest Gaussian count whose predicted footprint fits into budget_bytes, 0 if none does
+    int64_t max_gaussians_for_budget(MemoryModelConfig config, int64_t budget_bytes);
+
+} // namespace gs
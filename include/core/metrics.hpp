@@ -1,12 +1,15 @@
 #pragma once
 
+#include "core/colormap.hpp"
 #include "core/dataset.hpp"
+#include "core/metrics_diff.hpp"
 #include "core/parameters.hpp"
 #include "core/rasterizer.hpp"
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <torch/script.h>
@@ -27,38 +30,75 @@ namespace gs {
             explicit PSNR(const float data_range = 1.0f) : data_range_(data_range) {}
 
             float compute(const torch::Tensor& pred, const torch::Tensor& target) const;
+            // PSNR of every image in the batch as a [B] tensor, without a host sync
+            torch::Tensor compute_per_image(const torch::Tensor& pred, const torch::Tensor& target) const;
 
         private:
             const float data_range_;
         };
 
-        // Structural Similarity Index
+        // Structural Similarity Index with a Gaussian window (sigma 1.5) and zero
+        // padding. CUDA inputs use the fused training kernel, CPU inputs the
+        // separable ssim_map_cpu on the intra-op thread pool.
         class SSIM {
         public:
             SSIM(const int window_size = 11, const int channel = 3);
 
             float compute(const torch::Tensor& pred, const torch::Tensor& target);
+            torch::Tensor compute_per_image(const torch::Tensor& pred, const torch::Tensor& target);
 
         private:
+            torch::Tensor ssim_map(const torch::Tensor& pred, const torch::Tensor& target);
+
             const int window_size_;
             const int channel_;
-            torch::Tensor window_;
+            const std::vector<float> window_1d_;
+            torch::Tensor window_; // window_1d_ on the device of the last input
             static constexpr float C1 = 0.01f * 0.01f;
             static constexpr float C2 = 0.03f * 0.03f;
         };
 
+        enum class LPIPSPrecision {
+            Float32,
+            Float16, // CUDA only
+            BFloat16
+        };
+
+        // "fp32", "fp16", "bf16"; throws std::invalid_argument otherwise
+        LPIPSPrecision lpips_precision_from_string(const std::string& name);
+        std::string to_string(LPIPSPrecision precision);
+
+        // Learned perceptual distance (VGG, TorchScript). The model is loaded and
+        // checked once per path, device and precision, and shared by all instances.
+        // On the CPU it is optimized for inference and fed channels-last inputs.
         class LPIPS {
         public:
-            explicit LPIPS(const std::string& model_path = "");
+            explicit LPIPS(const std::string& model_path = "",
+                           LPIPSPrecision precision = LPIPSPrecision::Float32,
+                           std::optional<torch::Device> device = std::nullopt, // CUDA if available
+                           int max_batch = 8);
 
             float compute(const torch::Tensor& pred, const torch::Tensor& target);
-            bool is_loaded() const { return model_loaded_; }
+            // Distance of every image pair as a [B] float tensor on the device of pred
+            torch::Tensor compute_per_image(const torch::Tensor& pred, const torch::Tensor& target);
+            bool is_loaded() const { return model_ != nullptr; }
+            const torch::Device& device() const { return device_; }
+            LPIPSPrecision precision() const { return precision_; }
 
         private:
-            torch::jit::script::Module model_;
-            bool model_loaded_ = false;
-
-            void load_model(const std::string& model_path);
+            struct Model {
+                torch::jit::script::Module module;
+                bool per_item = true; // false if the export averages over the batch
+            };
+
+            std::shared_ptr<const Model> model_;
+            torch::Device device_;
+            LPIPSPrecision precision_;
+            int max_batch_; // image pairs per forward pass
+
+            static std::shared_ptr<const Model> load_model(const std::string& model_path,
+                                                           const torch::Device& device,
+                                                           LPIPSPrecision precision);
         };
 
         // Evaluation result structure
@@ -104,6 +144,8 @@ namespace gs {
             explicit MetricsReporter(const std::filesystem::path& output_dir);
 
             void add_metrics(const EvalMetrics& metrics);
+            // Appends one row per view to metrics_per_view.csv (see metrics_diff.hpp)
+            void add_view_metrics(const std::vector<ViewRecord>& views) const;
             void save_report() const;
 
         private:
@@ -111,6 +153,7 @@ namespace gs {
             std::vector<EvalMetrics> all_metrics_;
             const std::filesystem::path csv_path_;
             const std::filesystem::path txt_path_;
+            const std::filesystem::path per_view_csv_path_;
         };
 
         // Main evaluator class that handles all metrics computation and visualization
@@ -151,14 +194,11 @@ namespace gs {
             std::unique_ptr<SSIM> _ssim_metric;
             std::unique_ptr<LPIPS> _lpips_metric;
             std::unique_ptr<MetricsReporter> _reporter;
+            image_io::Colormap _depth_colormap = image_io::Colormap::Jet;
 
             // Helper functions
-            torch::Tensor apply_depth_colormap(const torch::Tensor& depth_normalized) const;
             bool has_rgb() const;
             bool has_depth() const;
-
-            // Create dataloader from dataset
-            auto make_dataloader(std::shared_ptr<CameraDataset> dataset, const int workers = 1) const;
         };
 
     } // namespace metrics
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace gs {
+    namespace metrics {
+
+        // One evaluated view, as stored in metrics_per_view.csv. Missing values
+        // (e.g. LPIPS when it was skipped) are NaN.
+        struct ViewRecord {
+            int iteration = 0;
+            std::string image;
+            double psnr = 0.0;
+            double ssim = 0.0;
+            double lpips = 0.0;
+            double render_ms = 0.0;
+        };
+
+        // Appends records to a per-view CSV, writing the header if the file is new:
+        // iteration,image,psnr,ssim,lpips,render_ms
+        void append_per_view_csv(const std::filesystem::path& path, const std::vector<ViewRecord>& records);
+
+        // Reads the records of one iteration (-1 = the last one in the file)
+        std::vector<ViewRecord> read_per_view_csv(const std::filesystem::path& path, int iteration = -1);
+
+        struct DiffOptions {
+            double alpha = 0.01;          // one-sided significance level
+            double min_psnr_drop = 0.05;  // dB
+            double min_ssim_drop = 0.001;
+            double min_lpips_rise = 0.001;
+            double min_time_rise = 0.05;  // relative, per view
+        };
+
+        // Comparison of one metric over the views present in both runs.
+        // Degradation is measured so that positive is worse: baseline - candidate
+        // for PSNR/SSIM, candidate - baseline for LPIPS, and the relative increase
+        // for render time.
+        struct MetricDiff {
+            std::string metric;
+            size_t views = 0;
+            double baseline_mean = 0.0;
+            double candidate_mean = 0.0;
+            double mean_degradation = 0.0;
+            double p_value = 1.0;          // Wilcoxon signed-rank, H1: views got worse
+            size_t worse_views = 0;        // views degrading by more than the threshold
+            std::vector<std::string> worst; // up to three most degraded views
+            bool regression = false;       // significant and larger than the threshold
+        };
+
+        struct DiffReport {
+            size_t matched_views = 0;
+            size_t baseline_only = 0;
+            size_t candidate_only = 0;
+            std::vector<MetricDiff> metrics;
+
+            bool has_regression() const;
+            std::string to_string() const;
+        };
+
+        DiffReport diff_runs(const std::vector<ViewRecord>& baseline,
+                             const std::vector<ViewRecord>& candidate,
+                             const DiffOptions& options = {});
+
+        // One-sided p-value that the degradations are centered above zero
+        // (normal approximation with tie and continuity correction; zeros dropped)
+        double wilcoxon_signed_rank_p(const std::vector<double>& degradations);
+
+    } // namespace metrics
+} // namespace gs
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <torch/torch.h>
+
+namespace gs {
+
+    // Draws n indices from the unnormalized, non-negative weights [N] and returns
+    // them as int64 on the weights' device. Up to 2^24 weights this is
+    // torch::multinomial; beyond its limit the sampler stays exact and on-device:
+    //   - with replacement, uniforms are inverted through the float64 CDF. CUDA
+    //     uses searchsorted, the CPU path merges sorted uniforms (exponential
+    //     spacings) with the CDF in O(N + n) across threads.
+    //   - without replacement, the n largest Gumbel-perturbed log-weights are taken
+    //     (Efraimidis-Spirakis), which needs n <= number of non-zero weights.
+    // Results depend only on the state of the generator (the default one when
+    // none is given), so runs are reproducible under a seed.
+    torch::Tensor multinomial_sample(const torch::Tensor& weights,
+                                     int64_t n,
+                                     bool replacement = true,
+                                     c10::optional<at::Generator> generator = c10::nullopt);
+
+} // namespace gs
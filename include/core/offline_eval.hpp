@@ -0,0 +1,77 @@
+#pragma once
+
+#include "core/metrics_diff.hpp"
+#include "core/parameters.hpp"
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace gs {
+    namespace metrics {
+
+        // Evaluation of a saved model against the held-out split of its dataset,
+        // without training: image metrics plus render speed and memory.
+        struct OfflineEvalConfig {
+            std::filesystem::path ply_path;
+            param::DatasetConfig dataset; // data_path, images, resolution, test_every
+            std::string render_mode = "RGB";
+            bool all_views = false;    // evaluate every camera instead of the test split
+            bool compute_lpips = true; // needs weights/lpips_vgg.pt
+            std::string lpips_precision = "fp32";
+            int warmup_frames = 5;     // untimed renders before measuring
+            int timing_repeats = 10;   // timed renders per view
+            int tile_size = 16;
+        };
+
+        // Distribution of per-frame render times in milliseconds
+        struct FrameTimeStats {
+            int64_t samples = 0;
+            double mean_ms = 0.0;
+            double min_ms = 0.0;
+            double p50_ms = 0.0;
+            double p90_ms = 0.0;
+            double p99_ms = 0.0;
+            double max_ms = 0.0;
+
+            nlohmann::json to_json() const;
+        };
+
+        // Linear-interpolated percentiles of frame_times_ms (order does not matter)
+        FrameTimeStats summarize_frame_times(std::vector<double> frame_times_ms);
+
+        struct ViewEvalResult {
+            std::string image_name;
+            int width = 0;
+            int height = 0;
+            float psnr = 0.f;
+            float ssim = 0.f;
+            float lpips = 0.f;
+            double render_ms = 0.0; // median over the timed repeats
+        };
+
+        struct OfflineEvalResult {
+            std::string ply_path;
+            std::string data_path;
+            int64_t num_gaussians = 0;
+            int sh_degree = 0;
+            bool has_lpips = false;
+            float psnr = 0.f;
+            float ssim = 0.f;
+            float lpips = 0.f;
+            FrameTimeStats frame_times;
+            int64_t model_bytes = 0;          // parameter tensors on the device
+            int64_t peak_allocated_bytes = 0; // allocator peak over the timed renders; metrics load afterwards
+            int64_t peak_reserved_bytes = 0;
+            std::vector<ViewEvalResult> views;
+
+            nlohmann::json to_json() const;
+            // Per-view rows for the metrics_per_view.csv format
+            std::vector<ViewRecord> view_records() const;
+        };
+
+        // Loads the PLY and the COLMAP cameras, then renders and scores every view
+        OfflineEvalResult run_offline_eval(const OfflineEvalConfig& config);
+
+    } // namespace metrics
+} // namespace gs
@@ -16,6 +16,10 @@ namespace gs {
             float opacity_lr = 0.05f;
             float scaling_lr = 0.005f;
             float rotation_lr = 0.001f;
+            std::string lr_schedule = "exponential"; // Means LR schedule: constant, exponential, cosine, step
+            float lr_final_factor = 0.01f;           // Means LR at the last iteration, relative to means_lr
+            size_t lr_step_every = 10'000;           // step schedule: iterations between LR drops
+            size_t lr_warmup_steps = 0;              // Linear LR warmup of every param group
             float lambda_dssim = 0.2f;
             float min_opacity = 0.005f;
             size_t refine_every = 100;
@@ -28,12 +32,27 @@ namespace gs {
             float init_opacity = 0.5f;
             float init_scaling = 0.1f;
             int max_cap = 1000000;
+            std::string growth_mode = "fixed";  // MCMC growth per refine: fixed, vram, step_time, count
+            float vram_budget = 0.9f;           // vram mode: fraction of device memory to fill
+            float step_time_budget_ms = 0.0f;   // step_time mode: target iteration time
+            std::string strategy = "mcmc";      // Densification strategy: mcmc, default
+            size_t opacity_reset_every = 3'000; // Default strategy: opacity reset interval
+            float grow_scale3d = 0.01f;         // Default strategy: clone below, split above (x scene scale)
+            float prune_scale3d = 0.1f;         // Default strategy: prune above (x scene scale)
             std::vector<size_t> eval_steps = {7'000, 30'000}; // Steps to evaluate the model
             std::vector<size_t> save_steps = {7'000, 30'000}; // Steps to save the model
             bool enable_eval = false;                         // Only evaluate when explicitly enabled
             bool enable_save_eval_images = false;             // Save during evaluation images
+            int eval_batch_size = 4;                          // Views of equal size scored together during evaluation
+            std::string lpips_precision = "fp32";             // LPIPS network precision: fp32, fp16, bf16
+            std::string depth_colormap = "jet";               // Saved depth maps: jet, turbo, viridis, inferno, gray
+            std::string eval_image_format = "png";            // Saved evaluation images: png, jpg, raw
+            int png_compression_level = 1;                    // zlib level 0-9 of saved PNGs; 1 is fast and still lossless
+            int image_writer_threads = 4;                     // Threads encoding saved images
+            int image_writer_queue = 16;                      // Images queued before evaluation waits for the writers
             bool enable_viz = false;                          // Enable visualization during training
             std::string render_mode = "RGB";                  // Render mode: RGB, D, ED, RGB_D, RGB_ED
+            int tile_size = 16;                               // Rasterizer tile size, 0 = auto-tune
 
             // Bilateral grid parameters
             bool use_bilateral_grid = false;
@@ -45,6 +64,26 @@ namespace gs {
 
             int steps_scaler = 1;
             bool selective_adam = false; // Use Selective Adam optimizer
+            int seed = 42;               // Seed for every RNG used in training
+            bool deterministic = false;  // Deterministic kernels and data order, bitwise reproducible runs
+
+            // End-of-training compaction
+            bool enable_compaction = false;    // Remove low-contribution Gaussians before the final save
+            float compaction_min_weight = 1.0f; // Keep Gaussians blending at least this many pixels over all views
+            int compaction_finetune_steps = 0; // Compact this many iterations before the end and keep training
+            bool collect_contribution_stats = false; // Accumulate per-Gaussian contribution, saved with each PLY
+
+            // Early stopping
+            bool enable_early_stopping = false; // Stop once validation PSNR (or the smoothed loss) plateaus
+            size_t early_stop_every = 1'000;    // Iterations between convergence checks
+            int early_stop_patience = 3;        // Checks without improvement before stopping
+            float early_stop_min_gain = 0.05f;  // Smallest improvement in dB that counts
+            int early_stop_views = 4;           // Validation views rendered per check, rotating
+
+            // Profiling
+            bool enable_profiling = false; // Per-stage timings, printed after training
+            std::string profile_trace;     // Chrome trace JSON path; implies enable_profiling
+            bool memory_report = false;    // Memory breakdown before training and at refine steps
         };
 
         struct DatasetConfig {
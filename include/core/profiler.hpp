@@ -0,0 +1,162 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace gs {
+
+    // Device-side clock for profiler spans. Marks are recorded in stream order
+    // and read back once the device has passed them, so timing adds no host
+    // synchronization.
+    class DeviceTimer {
+    public:
+        virtual ~DeviceTimer() = default;
+        virtual int record() = 0;                        // new mark at the current stream position
+        virtual bool ready(int mark) = 0;                // the device has passed the mark
+        virtual double elapsed_ms(int from, int to) = 0; // both marks must be ready
+        virtual void release(int mark) = 0;              // the mark may be reused
+        virtual void synchronize() = 0;
+    };
+
+    // CUDA events on the current stream (profiler_cuda.cpp)
+    std::unique_ptr<DeviceTimer> make_cuda_event_timer();
+
+    // Linearly interpolated q-quantile (q in [0, 1]) of non-empty, ascending samples.
+    // Shared by the profiler, the benchmarks and the offline evaluation.
+    double percentile(const std::vector<double>& sorted, double q);
+
+    // Distribution of one stage's durations. With a device timer these are
+    // device times; host_mean_ms is the wall time the host spent in the stage.
+    struct StageStats {
+        std::string name;
+        int depth = 0; // nesting level where the stage was first seen
+        int64_t count = 0;
+        double total_ms = 0.0;
+        double mean_ms = 0.0;
+        double p50_ms = 0.0;
+        double p90_ms = 0.0;
+        double p99_ms = 0.0;
+        double max_ms = 0.0;
+        double host_mean_ms = 0.0;
+    };
+
+    // Named stage timings of the training loop. Timers report to the profiler
+    // made current on their thread by a Scope (see RasterWorkspace::Scope);
+    // without one they cost a thread-local load, so they stay in place when
+    // profiling is off.
+    // A profiler is used from one thread.
+    class Profiler {
+    public:
+        class Scope {
+        public:
+            explicit Scope(Profiler* profiler);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Profiler* previous_;
+        };
+
+        // Profiler of the innermost Scope on this thread, or nullptr
+        static Profiler* current();
+
+        // Times its lifetime (or until stop()) as stage `name`, which must be
+        // a string literal
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(const char* name)
+                : profiler_(current()) {
+                if (profiler_) {
+                    span_ = profiler_->begin(name);
+                }
+            }
+            ~ScopedTimer() { stop(); }
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            void stop() {
+                if (profiler_) {
+                    profiler_->end(span_);
+                    profiler_ = nullptr;
+                }
+            }
+
+        private:
+            Profiler* profiler_;
+            uint64_t span_ = 0;
+        };
+
+        // Without a device timer, spans are measured with the wall clock only.
+        // Trace events are kept up to max_trace_events when keep_trace is set.
+        explicit Profiler(std::unique_ptr<DeviceTimer> device_timer = nullptr,
+                          bool keep_trace = false,
+                          size_t max_trace_events = 1'000'000);
+        ~Profiler();
+
+        // Folds closed spans whose device marks are done into the statistics;
+        // cheap enough to call once per iteration
+        void collect();
+        // Waits for the device and folds in every closed span
+        void flush();
+
+        // Stages in the order they were first seen
+        std::vector<StageStats> summary();
+        std::string format_summary();
+
+        // Chrome trace (chrome://tracing, Perfetto) with a host and a device track
+        nlohmann::json chrome_trace();
+        void write_chrome_trace(const std::filesystem::path& path);
+
+    private:
+        struct Span {
+            const char* name;
+            int depth;
+            double host_start_us;
+            double host_end_us = -1.0; // < 0 while open
+            int start_mark = -1;
+            int end_mark = -1;
+        };
+        struct Stage {
+            std::string name;
+            int depth;
+            std::vector<double> durations_ms;
+            double host_total_ms = 0.0;
+        };
+        struct TraceEvent {
+            const char* name;
+            double start_us;
+            double duration_us;
+            bool device;
+        };
+
+        uint64_t begin(const char* name);
+        void end(uint64_t span);
+        double now_us() const;
+        void fold(const Span& span);
+
+        std::unique_ptr<DeviceTimer> device_timer_;
+        const bool keep_trace_;
+        const size_t max_trace_events_;
+        const std::chrono::steady_clock::time_point origin_;
+
+        std::deque<Span> pending_; // pending_[i] is span first_pending_ + i
+        uint64_t first_pending_ = 0;
+        int open_depth_ = 0;
+
+        // Device timestamps are placed on the host timeline through this mark
+        int base_mark_ = -1;
+        double base_host_us_ = 0.0;
+
+        std::vector<Stage> stages_;
+        std::vector<TraceEvent> trace_;
+        bool trace_truncated_ = false;
+    };
+
+} // namespace gs
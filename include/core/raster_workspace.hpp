@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <torch/torch.h>
+
+namespace gs {
+
+    // Grow-only device buffers for the rasterizer's per-call intermediates
+    // (projection outputs, tile intersections, rendered images). Buffers are
+    // sized for the largest Gaussian count and resolution seen so far and reused
+    // for anything smaller, so steady-state rendering allocates nothing.
+    //
+    // Tensors handed out alias the buffers: they are only valid until the next
+    // render through the same workspace. One workspace per render loop (trainer,
+    // viewer) keeps that true, since backward always finishes before the next
+    // forward.
+    class RasterWorkspace {
+    public:
+        // Makes a workspace current on this thread while a render runs, for the
+        // autograd functions whose apply() signatures cannot carry it. Scopes
+        // nest and restore the previous one on exit. ContributionStats and
+        // Profiler are made current the same way.
+        class Scope {
+        public:
+            explicit Scope(RasterWorkspace* workspace);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            RasterWorkspace* previous_;
+        };
+
+        // Workspace of the innermost Scope on this thread, or nullptr
+        static RasterWorkspace* current();
+
+        enum class Slot {
+            Radii,
+            Means2d,
+            Depths,
+            Conics,
+            TilesPerGauss,
+            IsectIds,   // [2, capacity], unsorted and sorted rows
+            FlattenIds, // [2, capacity], unsorted and sorted rows
+            IsectOffsets,
+            Renders,
+            Alphas,
+            LastIds,
+            Count
+        };
+
+        // Tensor of the given shape backed by the slot's buffer, grown if needed
+        torch::Tensor get(Slot slot, c10::IntArrayRef sizes, const torch::TensorOptions& options);
+
+        // Intersection buffers for gsplat::intersect_tile. The count is unknown
+        // until the op runs, so capacity follows the previous call with headroom.
+        torch::Tensor isect_ids_buffer(const torch::Device& device);
+        torch::Tensor flatten_ids_buffer(const torch::Device& device);
+
+        // Reports the intersection count of the last call. An overflow means the
+        // op fell back to allocating, which is counted like a buffer growth.
+        void record_isects(int64_t n_isects);
+
+        // Resets the per-step allocation counter
+        void begin_step() { step_allocations_ = 0; }
+
+        // Drops all buffers, e.g. after compaction shrank the model for good
+        void release();
+
+        // Called with the model size after each training step. Keeps the buffers
+        // through ordinary refines and releases them only once the count falls
+        // below half of the largest one seen since the last release.
+        void fit(int64_t n_gaussians);
+
+        int64_t step_allocations() const { return step_allocations_; }
+        int64_t total_allocations() const { return total_allocations_; }
+        int64_t total_reuses() const { return total_reuses_; } // requests served without allocating
+        size_t reserved_bytes() const;
+
+        // e.g. "raster workspace: 120 reuses, 14 allocations (0 this step), 85.3 MB reserved"
+        std::string summary() const;
+
+    private:
+        torch::Tensor& reserve(Slot slot, int64_t numel, const torch::TensorOptions& options);
+
+        std::array<torch::Tensor, static_cast<size_t>(Slot::Count)> buffers_;
+        int64_t isect_capacity_ = 0;
+        int64_t peak_gaussians_ = 0;
+        int64_t step_allocations_ = 0;
+        int64_t total_allocations_ = 0;
+        int64_t total_reuses_ = 0;
+    };
+
+} // namespace gs
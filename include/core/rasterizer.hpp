@@ -2,6 +2,7 @@
 
 #include "Ops.h"
 #include "core/camera.hpp"
+#include "core/raster_workspace.hpp"
 #include "core/splat_data.hpp"
 #include <torch/torch.h>
 
@@ -15,6 +16,9 @@ namespace gs {
         torch::Tensor depths;     // [..., N] - per-gaussian depths
         torch::Tensor radii;      // [..., N]
         torch::Tensor visibility; // [..., N]
+        torch::Tensor isect_offsets; // [C, tile_height, tile_width] - start of each tile's list
+        int64_t n_isects = 0;
+        int tile_size = 0;
         int width;
         int height;
     };
@@ -54,7 +58,9 @@ namespace gs {
             throw std::runtime_error("Invalid render mode: " + mode);
     }
 
-    // Wrapper function to use gsplat backend for rendering
+    // Wrapper function to use gsplat backend for rendering. With a workspace,
+    // CUDA intermediates and outputs live in its buffers (see RasterWorkspace).
+    // tile_size is raised by fit_tile_size when the tile grid is too large.
     RenderOutput rasterize(
         Camera& viewpoint_camera,
         const SplatData& gaussian_model,
@@ -62,6 +68,22 @@ namespace gs {
         float scaling_modifier = 1.0,
         bool packed = false,
         bool antialiased = false,
-        RenderMode render_mode = RenderMode::RGB);
+        RenderMode render_mode = RenderMode::RGB,
+        RasterWorkspace* workspace = nullptr,
+        int tile_size = 16);
+
+    // Forward-only render for the viewer and evaluation. Calls the gsplat forward
+    // kernels directly, so nothing is saved for backward and means2d has no grad.
+    // When reuse is given, its image/alpha/depth buffers are overwritten in place
+    // if the shapes still match, and it is updated to hold the new output.
+    RenderOutput rasterize_inference(
+        Camera& viewpoint_camera,
+        const SplatData& gaussian_model,
+        torch::Tensor& bg_color,
+        float scaling_modifier = 1.0,
+        RenderMode render_mode = RenderMode::RGB,
+        RenderOutput* reuse = nullptr,
+        RasterWorkspace* workspace = nullptr,
+        int tile_size = 16);
 
 } // namespace gs
\ No newline at end of file
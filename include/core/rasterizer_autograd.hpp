@@ -7,6 +7,24 @@
 
 namespace gs {
 
+    // Autograd function for the fused parameter activation:
+    // sigmoid(opacity_raw).squeeze(-1), exp(scaling_raw) * scaling_modifier and
+    // normalize(rotation_raw) computed in one kernel launch (CUDA) or with the
+    // equivalent closed-form expressions (CPU).
+    class FusedActivationFunction : public torch::autograd::Function<FusedActivationFunction> {
+    public:
+        static torch::autograd::tensor_list forward(
+            torch::autograd::AutogradContext* ctx,
+            torch::Tensor opacity_raw,  // [N, 1] or [N]
+            torch::Tensor scaling_raw,  // [N, 3]
+            torch::Tensor rotation_raw, // [N, 4]
+            double scaling_modifier);
+
+        static torch::autograd::tensor_list backward(
+            torch::autograd::AutogradContext* ctx,
+            torch::autograd::tensor_list grad_outputs);
+    };
+
     // Autograd function for projection
     class ProjectionFunction : public torch::autograd::Function<ProjectionFunction> {
     public:
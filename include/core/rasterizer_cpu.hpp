@@ -0,0 +1,127 @@
+#pragma once
+
+#include <torch/torch.h>
+#include <tuple>
+
+namespace gs {
+
+    // CPU backend for rasterize(). It is selected automatically when the Gaussians
+    // live on the CPU and mirrors the gsplat CUDA kernels closely enough to be used
+    // as a reference for them. Projection and SH are differentiable torch ops; tile
+    // binning and alpha compositing are hand-written, threaded across tiles and
+    // vectorized over the pixels of a tile.
+    namespace cpu {
+
+        // Rotation matrices [N, 3, 3] from wxyz quats [N, 4] (normalized here)
+        torch::Tensor quat_to_rotmat(const torch::Tensor& quats);
+
+        // Covariances [N, 3, 3] from quats [N, 4] (normalized here) and scales [N, 3],
+        // matching gsplat::quat_scale_to_covar_preci_fwd
+        torch::Tensor quat_scale_to_covar(const torch::Tensor& quats, const torch::Tensor& scales);
+
+        // MCMC opacity/scale split matching gsplat::relocation.
+        // Returns new_opacities [N] and new_scales [N, 3].
+        std::tuple<torch::Tensor, torch::Tensor> relocation(
+            const torch::Tensor& opacities, // [N]
+            const torch::Tensor& scales,    // [N, 3]
+            const torch::Tensor& ratios,    // [N] int
+            const torch::Tensor& binoms,    // [n_max, n_max]
+            int n_max);
+
+        // EWA projection matching gsplat::projection_ewa_3dgs_fused_fwd (pinhole).
+        // Returns radii [C, N, 2] (int32), means2d [C, N, 2], depths [C, N], conics [C, N, 3].
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor> projection(
+            const torch::Tensor& means,     // [N, 3]
+            const torch::Tensor& quats,     // [N, 4]
+            const torch::Tensor& scales,    // [N, 3]
+            const torch::Tensor& opacities, // [N] optional
+            const torch::Tensor& viewmats,  // [C, 4, 4]
+            const torch::Tensor& Ks,        // [C, 3, 3]
+            int width,
+            int height,
+            float eps2d,
+            float near_plane,
+            float far_plane,
+            float radius_clip);
+
+        // SH evaluation matching gsplat::spherical_harmonics_fwd; masked entries are zero.
+        torch::Tensor spherical_harmonics(
+            int sh_degree,
+            const torch::Tensor& dirs,    // [..., 3]
+            const torch::Tensor& coeffs,  // [..., K, 3]
+            const torch::Tensor& masks);  // [...] optional
+
+        // Tile binning with the same id encoding and ordering as gsplat::intersect_tile.
+        // Returns tiles_per_gauss [C, N], isect_ids [n_isects], flatten_ids [n_isects].
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> intersect_tile(
+            const torch::Tensor& means2d, // [C, N, 2]
+            const torch::Tensor& radii,   // [C, N, 2]
+            const torch::Tensor& depths,  // [C, N]
+            int tile_size,
+            int tile_width,
+            int tile_height);
+
+        // Same layout as gsplat::intersect_offset: [C, tile_height, tile_width]
+        torch::Tensor intersect_offset(
+            const torch::Tensor& isect_ids, // [n_isects]
+            int C,
+            int tile_width,
+            int tile_height);
+
+        // Returns renders [C, H, W, channels], alphas [C, H, W, 1], last_ids [C, H, W].
+        // When gauss_weights and gauss_hits are given, each Gaussian's blending weight
+        // summed over pixels and its pixel count are added to them in place.
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> rasterize_to_pixels_fwd(
+            const torch::Tensor& means2d,      // [C, N, 2]
+            const torch::Tensor& conics,       // [C, N, 3]
+            const torch::Tensor& colors,       // [C, N, channels]
+            const torch::Tensor& opacities,    // [C, N]
+            const torch::Tensor& backgrounds,  // [C, channels] optional
+            int width,
+            int height,
+            int tile_size,
+            const torch::Tensor& tile_offsets, // [C, tile_height, tile_width]
+            const torch::Tensor& flatten_ids,  // [n_isects]
+            const torch::Tensor& gauss_weights = {}, // [C * N] float, optional
+            const torch::Tensor& gauss_hits = {});   // [C * N] int64, optional
+
+        // Returns v_means2d, v_conics, v_colors, v_opacities.
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor> rasterize_to_pixels_bwd(
+            const torch::Tensor& means2d,         // [C, N, 2]
+            const torch::Tensor& conics,          // [C, N, 3]
+            const torch::Tensor& colors,          // [C, N, channels]
+            const torch::Tensor& opacities,       // [C, N]
+            const torch::Tensor& backgrounds,     // [C, channels] optional
+            int width,
+            int height,
+            int tile_size,
+            const torch::Tensor& tile_offsets,    // [C, tile_height, tile_width]
+            const torch::Tensor& flatten_ids,     // [n_isects]
+            const torch::Tensor& render_alphas,   // [C, H, W, 1]
+            const torch::Tensor& last_ids,        // [C, H, W]
+            const torch::Tensor& v_render_colors, // [C, H, W, channels]
+            const torch::Tensor& v_render_alphas); // [C, H, W, 1]
+
+        // Autograd wrapper around the CPU compositing pass
+        class RasterizationFunction : public torch::autograd::Function<RasterizationFunction> {
+        public:
+            static torch::autograd::tensor_list forward(
+                torch::autograd::AutogradContext* ctx,
+                torch::Tensor means2d,       // [C, N, 2]
+                torch::Tensor conics,        // [C, N, 3]
+                torch::Tensor colors,        // [C, N, channels]
+                torch::Tensor opacities,     // [C, N]
+                torch::Tensor bg_color,      // [C, channels], may be empty
+                torch::Tensor isect_offsets, // [C, tile_height, tile_width]
+                torch::Tensor flatten_ids,   // [n_isects]
+                int64_t width,
+                int64_t height,
+                int64_t tile_size);
+
+            static torch::autograd::tensor_list backward(
+                torch::autograd::AutogradContext* ctx,
+                torch::autograd::tensor_list grad_outputs);
+        };
+
+    } // namespace cpu
+} // namespace gs
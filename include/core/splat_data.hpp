@@ -1,6 +1,7 @@
 // Updated splat_data.hpp
 #pragma once
 
+#include "core/contribution_stats.hpp"
 #include "core/point_cloud.hpp"
 #include <filesystem>
 #include <mutex>
@@ -36,6 +37,11 @@ public:
     // Static factory method to create from PointCloud
     static SplatData init_model_from_pointcloud(const gs::param::TrainingParameters& params, torch::Tensor scene_center);
 
+    // Loads a model written by save_ply onto the CPU. The SH degree follows from
+    // the number of f_rest properties and is fully active; the scene scale is
+    // not stored in the PLY and is set to 1.
+    static SplatData load_ply(const std::filesystem::path& path);
+
     // Computed getters (implemented in cpp)
     torch::Tensor get_means() const;
     torch::Tensor get_opacity() const;
@@ -45,6 +51,7 @@ public:
 
     // Simple inline getters
     inline int get_active_sh_degree() const { return _active_sh_degree; }
+    inline int get_max_sh_degree() const { return _max_sh_degree; }
     inline float get_scene_scale() const { return _scene_scale; }
     inline int64_t size() const { return _means.size(0); }
 
@@ -57,7 +64,22 @@ public:
     inline torch::Tensor& shN() { return _shN; }
     inline torch::Tensor& max_radii2D() { return _max_radii2D; }
 
-    // Utility methods
+    // Per-Gaussian contribution, collected only when enabled; saved with the PLY
+    inline gs::ContributionStats& contribution_stats() { return _contribution_stats; }
+    inline const gs::ContributionStats& contribution_stats() const { return _contribution_stats; }
+
+    // Read-only raw access, used by the fused activation in the rasterizer
+    inline const torch::Tensor& opacity_raw() const { return _opacity; }
+    inline const torch::Tensor& rotation_raw() const { return _rotation; }
+    inline const torch::Tensor& scaling_raw() const { return _scaling; }
+    inline const torch::Tensor& max_radii2D() const { return _max_radii2D; }
+
+    // Number of shN coefficients needed to evaluate SH up to degree
+    static int64_t shN_coeffs(int degree) { return (degree + 1) * (degree + 1) - 1; }
+
+    // Utility methods. shN may hold fewer than shN_coeffs(max degree) coefficients;
+    // the missing ones are zero and strategies widen it as the degree goes up
+    // (gs::strategy::increment_sh_degree).
     void increment_sh_degree();
 
     // Export methods - clean public interface
@@ -78,6 +100,7 @@ private:
     torch::Tensor _rotation;
     torch::Tensor _opacity;
     torch::Tensor _max_radii2D;
+    gs::ContributionStats _contribution_stats;
 
     // Thread management for async saves
     mutable std::vector<std::thread> _save_threads;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace gs {
+    namespace metrics {
+
+        // Normalized 1D Gaussian window, centered on window_size / 2
+        std::vector<float> gaussian_window(int window_size, float sigma);
+
+        // SSIM map of `planes` single-channel H x W images (e.g. B*C planes of a
+        // contiguous [B, C, H, W] tensor), matching a 2D convolution with the
+        // outer product of `window` and zero padding ("same" output size).
+        // The window is applied as a horizontal and a vertical 1D pass, and all
+        // five moments are accumulated in the same sweep. Planes are split into
+        // row bands that run on torch's intra-op thread pool (at::parallel_for).
+        void ssim_map_cpu(const float* img1,
+                          const float* img2,
+                          float* ssim_map,
+                          int64_t planes,
+                          int64_t H,
+                          int64_t W,
+                          const std::vector<float>& window,
+                          float C1,
+                          float C2);
+
+    } // namespace metrics
+} // namespace gs
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "core/istrategy.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gs {
+
+    // Creates a densification strategy owning the given model
+    using StrategyFactory = std::function<std::unique_ptr<IStrategy>(SplatData&&)>;
+
+    // Strategies selectable by name (--strategy). "mcmc" and "default" are built in.
+    // Throws std::invalid_argument for unknown names.
+    std::unique_ptr<IStrategy> create_strategy(const std::string& name, SplatData&& splat_data);
+
+    // Adds or replaces a strategy
+    void register_strategy(const std::string& name, StrategyFactory factory);
+
+    bool has_strategy(const std::string& name);
+
+    // Registered names, sorted
+    std::vector<std::string> available_strategies();
+
+} // namespace gs
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "core/lr_scheduler.hpp"
+#include "core/memory_report.hpp"
+#include "core/parameters.hpp"
+#include "core/splat_data.hpp"
+#include <array>
+#include <functional>
+#include <memory>
+#include <torch/torch.h>
+#include <vector>
+
+// Building blocks shared by the densification strategies (MCMC, Default)
+namespace gs::strategy {
+
+    // Optimizer param group of each Gaussian parameter, one group per tensor
+    enum ParamGroup : int {
+        Means = 0,
+        Sh0,
+        ShN,
+        Scaling,
+        Rotation,
+        Opacity,
+        NumParamGroups
+    };
+
+    // The raw tensors of splat_data in ParamGroup order
+    std::array<torch::Tensor*, NumParamGroups> parameters(SplatData& splat_data);
+
+    // Moves all parameters to device as leaf tensors that require grad
+    void to_device(SplatData& splat_data, const torch::Device& device);
+
+    // Adam or SelectiveAdam (params.selective_adam) with one group per parameter
+    std::unique_ptr<torch::optim::Optimizer> create_optimizer(SplatData& splat_data,
+                                                              const param::OptimizationParameters& params);
+
+    // Replaces parameters, and the optimizer states that belong to them, by
+    // param_fn(group, param) and state_fn(group, state) for every state tensor
+    // (exp_avg, exp_avg_sq, max_exp_avg_sq). The new parameters become leaves
+    // registered with the optimizer and stored back into splat_data.
+    using TensorFn = std::function<torch::Tensor(int group, const torch::Tensor& tensor)>;
+    void update_param_with_optimizer(SplatData& splat_data,
+                                     torch::optim::Optimizer& optimizer,
+                                     const TensorFn& param_fn,
+                                     const TensorFn& state_fn,
+                                     const std::vector<int>& groups = {Means, Sh0, ShN, Scaling, Rotation, Opacity});
+
+    // Raises the active SH degree and, when the new degree needs more shN
+    // coefficients than are stored, appends zero coefficients with zero
+    // optimizer moments (and zero gradient). Dormant coefficients would stay
+    // exactly zero under Adam anyway, so this matches full-width storage.
+    void increment_sh_degree(SplatData& splat_data, torch::optim::Optimizer& optimizer);
+
+    // Learning rate schedules over params.iterations: lr_schedule for the means,
+    // constant for the other groups, and the lr_warmup_steps warmup for all
+    std::unique_ptr<LRScheduler> create_scheduler(torch::optim::Optimizer& optimizer,
+                                                  const param::OptimizationParameters& params);
+
+    // Current learning rate of a param group for either optimizer type
+    double learning_rate(torch::optim::Optimizer& optimizer, int group);
+
+    // Bytes of a tensor's storage, 0 if undefined
+    int64_t tensor_bytes(const torch::Tensor& tensor);
+
+    // Bytes held by the parameters of every group
+    int64_t parameter_bytes(SplatData& splat_data);
+
+    // Name of a param group in logs and reports, e.g. "shN"
+    const char* param_group_name(int group);
+
+    // Bytes of the moments either optimizer type keeps for a param group,
+    // 0 before the group's first step
+    int64_t optimizer_state_bytes(const torch::optim::Optimizer& optimizer, int group);
+
+    // Adds the parameters, gradients and optimizer moments of every group and
+    // the per-Gaussian buffers of splat_data to report
+    void report_model_memory(const SplatData& splat_data,
+                             const torch::optim::Optimizer& optimizer,
+                             MemoryReport& report);
+
+} // namespace gs::strategy
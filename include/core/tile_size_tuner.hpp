@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <torch/torch.h>
+#include <vector>
+
+namespace gs {
+
+    // Largest tile the rasterization kernels can launch (one thread per pixel)
+    constexpr int kMaxTileSize = 32;
+
+    // Smallest tile size >= tile_size, found by doubling, whose tile grid fits the
+    // 32 bits gsplat reserves for camera and tile ids. Throws if none up to kMaxTileSize.
+    int fit_tile_size(int tile_size, int image_width, int image_height, int num_cameras = 1);
+
+    // Picks the rasterizer tile size from the intersections-per-tile histograms of
+    // the first training renders. During warm-up the candidates are used in turn;
+    // afterwards the one with the lowest estimated cost is kept.
+    //
+    // Cost model, in units of one pixel-Gaussian evaluation: every intersection
+    // pays a fixed binning/sort/backward cost plus one evaluation per tile pixel,
+    // and every tile pays a launch overhead. Smaller tiles composite less but
+    // create more intersections once splats span several tiles; the observed
+    // histogram tells which effect dominates for the scene at hand. On top, the
+    // tail of the histogram (the 99th percentile list length) is charged as the
+    // time the longest blocks keep the device busy after the rest finished, so a
+    // scene with a few very long tile lists scores worse than a uniform one.
+    class TileSizeTuner {
+    public:
+        explicit TileSizeTuner(std::vector<int> candidates = {8, 16, 32}, int rounds = 3);
+
+        // Tile size to use for the next render
+        int next_tile_size() const;
+
+        // Records the binning of a render made with tile_size. Only warm-up renders
+        // are inspected; this syncs with the device once per call while tuning.
+        void observe(int tile_size, const torch::Tensor& isect_offsets, int64_t n_isects);
+
+        bool is_tuned() const { return chosen_ > 0; }
+        int chosen_tile_size() const { return chosen_; }
+
+        // Estimated cost of a candidate from its observations so far (0 if unseen)
+        double estimated_cost(int tile_size) const;
+
+        // One line per candidate with its histogram summary and estimated cost
+        std::string summary() const;
+
+    private:
+        struct Stats {
+            int renders = 0;
+            double isects = 0.0;       // summed over renders
+            double tiles = 0.0;        // summed over renders
+            double max_per_tile = 0.0; // largest tile list seen
+            double tail = 0.0;         // 99th percentile list length, summed over renders
+            std::vector<int64_t> histogram; // log2 buckets of list length
+        };
+
+        int index_of(int tile_size) const;
+
+        std::vector<int> candidates_;
+        std::vector<Stats> stats_;
+        int rounds_;
+        int observed_ = 0;
+        int chosen_ = 0;
+    };
+
+} // namespace gs
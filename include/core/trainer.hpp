@@ -1,10 +1,15 @@
 #pragma once
 
 #include "core/bilateral_grid.hpp"
+#include "core/convergence_monitor.hpp"
 #include "core/dataset.hpp"
 #include "core/istrategy.hpp"
+#include "core/memory_report.hpp"
 #include "core/metrics.hpp"
 #include "core/parameters.hpp"
+#include "core/profiler.hpp"
+#include "core/raster_workspace.hpp"
+#include "core/tile_size_tuner.hpp"
 #include "core/training_progress.hpp"
 #include <atomic>
 #include <memory>
@@ -55,6 +60,14 @@ namespace gs {
         // just for viewer to get model
         const IStrategy& get_strategy() const { return *strategy_; }
 
+        // Rasterizer buffers and their allocation counters
+        const RasterWorkspace& get_raster_workspace() const { return raster_workspace_; }
+
+        // Device memory held by the model, optimizers, rasterizer and prefetched images
+        MemoryReport memory_report() const;
+        // Footprint predicted for num_gaussians with this run's images and settings
+        MemoryReport predict_memory(int64_t num_gaussians) const;
+
     private:
         // Protected method for processing a single training step
         // Returns true if training should continue
@@ -71,6 +84,22 @@ namespace gs {
         // Handle control requests
         void handle_control_requests(int iter);
 
+        // Removes low-contribution Gaussians (enable_compaction) and reports the savings
+        void compact_model(int iter);
+
+        // Mean PSNR over the next early_stop_views validation views
+        double validation_psnr();
+
+        // Scores the check at iter (enable_early_stopping); returns true once converged
+        bool check_convergence(int iter);
+
+        // Inputs of the memory model; measured intersection density and image
+        // size replace the defaults once training has run
+        MemoryModelConfig memory_model_config(int64_t num_gaussians) const;
+
+        // Prints the prediction at max_cap, with the full breakdown when memory_report is on
+        void print_memory_prediction() const;
+
         // Member variables
         std::shared_ptr<CameraDataset> train_dataset_;
         std::shared_ptr<CameraDataset> val_dataset_;
@@ -80,6 +109,8 @@ namespace gs {
         std::unique_ptr<GSViewer> viewer_;
 
         torch::Tensor background_{};
+        RasterWorkspace raster_workspace_;
+        std::unique_ptr<TileSizeTuner> tile_tuner_; // set when tile_size is 0 (auto)
         std::unique_ptr<TrainingProgress> progress_;
         size_t train_dataset_size_;
 
@@ -90,6 +121,18 @@ namespace gs {
         // Metrics evaluator - handles all evaluation logic
         std::unique_ptr<metrics::MetricsEvaluator> evaluator_;
 
+        // Early stopping, set when enable_early_stopping is on
+        std::unique_ptr<ConvergenceMonitor> convergence_;
+        size_t convergence_view_ = 0; // next validation view to score
+
+        // Stage timings, set when enable_profiling is on
+        std::unique_ptr<Profiler> profiler_;
+
+        // Last training step, for the memory model
+        int64_t last_n_isects_ = 0;
+        int64_t last_image_width_ = 0;
+        int64_t last_image_height_ = 0;
+
         // Control flags for thread communication
         std::atomic<bool> pause_requested_{false};
         std::atomic<bool> save_requested_{false};
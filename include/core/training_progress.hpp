@@ -12,11 +12,13 @@ private:
     std::chrono::steady_clock::time_point start_time_;
     int total_iterations_;
     int update_frequency_;
+    bool early_stopping_;
 
 public:
     TrainingProgress(int total_iterations, int update_frequency = 100, bool enable_early_stopping = false)
         : total_iterations_(total_iterations),
-          update_frequency_(update_frequency) {
+          update_frequency_(update_frequency),
+          early_stopping_(enable_early_stopping) {
 
         // Create progress bar with proper syntax for your indicators version
         progress_bar_ = std::make_unique<indicators::ProgressBar>();
@@ -102,6 +104,11 @@ public:
                   << std::endl
                   << "✓ Final splats: " << final_splats
                   << std::endl;
+
+        if (early_stopping_ && iterations_used < total_iterations_) {
+            std::cout << "✓ Converged after " << iterations_used << " of "
+                      << total_iterations_ << " iterations" << std::endl;
+        }
     }
 
     // Destructor ensures completion
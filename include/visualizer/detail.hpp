@@ -156,6 +156,10 @@ namespace gs {
 
         Trainer* trainer_;
 
+        // Render buffers reused across frames by rasterize_inference
+        RenderOutput frame_output_;
+        RasterWorkspace frame_workspace_;
+
         // Control button states
         bool show_control_panel_ = true;
         bool save_in_progress_ = false;
@@ -1,7 +1,10 @@
 // Copyright (c) 2023 Janusch Patas.
 
 #include "core/argument_parser.hpp"
+#include "core/growth_controller.hpp"
+#include "core/lr_scheduler.hpp"
 #include "core/parameters.hpp"
+#include "core/strategy_registry.hpp"
 #include <args.hxx>
 #include <filesystem>
 #include <iostream>
@@ -14,6 +17,9 @@ namespace {
     constexpr int SUCCESS_EXIT_CODE = 1;
 
     const std::set<std::string> VALID_RENDER_MODES = {"RGB", "D", "ED", "RGB_D", "RGB_ED"};
+    const std::set<std::string> VALID_LPIPS_PRECISIONS = {"fp32", "fp16", "bf16"};
+    const std::set<std::string> VALID_DEPTH_COLORMAPS = {"jet", "turbo", "viridis", "inferno", "gray"};
+    const std::set<std::string> VALID_IMAGE_FORMATS = {"png", "jpg", "raw"};
 
     void scale_steps_vector(std::vector<size_t>& steps, size_t scaler) {
         std::set<size_t> unique_steps(steps.begin(), steps.end());
@@ -49,6 +55,29 @@ namespace {
         ::args::ValueFlag<int> steps_scaler(parser, "steps_scaler", "Scale training steps by factor", {"steps-scaler"});
         ::args::ValueFlag<int> sh_degree_interval(parser, "sh_degree_interval", "SH degree interval", {"sh-degree-interval"});
         ::args::ValueFlag<std::string> render_mode(parser, "render_mode", "Render mode: RGB, D, ED, RGB_D, RGB_ED", {"render-mode"});
+        ::args::ValueFlag<int> tile_size(parser, "tile_size", "Rasterizer tile size (0 = auto-tune)", {"tile-size"});
+        ::args::ValueFlag<int> seed(parser, "seed", "Random seed", {"seed"});
+        ::args::ValueFlag<std::string> growth_mode(parser, "growth_mode", "MCMC growth: fixed, vram, step_time, count", {"growth-mode"});
+        ::args::ValueFlag<float> vram_budget(parser, "vram_budget", "Fraction of device memory for vram growth", {"vram-budget"});
+        ::args::ValueFlag<float> step_time_budget(parser, "step_time_budget", "Iteration time in ms for step_time growth", {"step-time-budget"});
+        ::args::ValueFlag<float> compact_min_weight(parser, "compact_min_weight", "Min. blending weight in pixels to survive compaction", {"compact-min-weight"});
+        ::args::ValueFlag<int> compact_finetune(parser, "compact_finetune", "Iterations to train after compaction", {"compact-finetune"});
+        ::args::ValueFlag<std::string> strategy(parser, "strategy", "Densification strategy: mcmc, default", {"strategy"});
+        ::args::ValueFlag<std::string> lr_schedule(parser, "lr_schedule", "Means LR schedule: constant, exponential, cosine, step", {"lr-schedule"});
+        ::args::ValueFlag<float> lr_final_factor(parser, "lr_final_factor", "Final means LR relative to the initial one", {"lr-final-factor"});
+        ::args::ValueFlag<int> lr_step_every(parser, "lr_step_every", "Iterations between LR drops for the step schedule", {"lr-step-every"});
+        ::args::ValueFlag<int> lr_warmup(parser, "lr_warmup", "Linear LR warmup iterations", {"lr-warmup"});
+        ::args::ValueFlag<int> early_stop_every(parser, "early_stop_every", "Iterations between convergence checks", {"early-stop-every"});
+        ::args::ValueFlag<int> early_stop_patience(parser, "early_stop_patience", "Checks without improvement before stopping", {"early-stop-patience"});
+        ::args::ValueFlag<float> early_stop_min_gain(parser, "early_stop_min_gain", "Smallest PSNR/loss improvement in dB that counts", {"early-stop-min-gain"});
+        ::args::ValueFlag<int> early_stop_views(parser, "early_stop_views", "Validation views rendered per check", {"early-stop-views"});
+        ::args::ValueFlag<int> eval_batch_size(parser, "eval_batch_size", "Views scored together during evaluation", {"eval-batch-size"});
+        ::args::ValueFlag<std::string> lpips_precision(parser, "lpips_precision", "LPIPS precision: fp32, fp16, bf16", {"lpips-precision"});
+        ::args::ValueFlag<std::string> profile_trace(parser, "profile_trace", "Write a Chrome trace of the training stages (implies --profile)", {"profile-trace"});
+        ::args::ValueFlag<std::string> depth_colormap(parser, "depth_colormap", "Colormap of saved depth maps: jet, turbo, viridis, inferno, gray", {"depth-colormap"});
+        ::args::ValueFlag<std::string> eval_image_format(parser, "eval_image_format", "Format of saved evaluation images: png, jpg, raw", {"image-format"});
+        ::args::ValueFlag<int> png_compression_level(parser, "png_compression_level", "zlib level of saved PNGs (0-9)", {"png-level"});
+        ::args::ValueFlag<int> image_writer_threads(parser, "image_writer_threads", "Threads encoding saved images", {"image-threads"});
 
         // Optional flag arguments
         ::args::Flag use_bilateral_grid(parser, "bilateral_grid", "Enable bilateral grid filtering", {"bilateral-grid"});
@@ -56,6 +85,12 @@ namespace {
         ::args::Flag enable_viz(parser, "viz", "Enable visualization during training", {'v', "viz"});
         ::args::Flag selective_adam(parser, "selective_adam", "Enable selective adam", {"selective-adam"});
         ::args::Flag enable_save_eval_images(parser, "save_eval_images", "Save eval images and depth maps", {"save-eval-images"});
+        ::args::Flag deterministic(parser, "deterministic", "Bitwise reproducible training (slower)", {"deterministic"});
+        ::args::Flag enable_compaction(parser, "compact", "Remove low-contribution Gaussians at the end of training", {"compact"});
+        ::args::Flag enable_early_stopping(parser, "early_stop", "Stop training once quality stops improving", {"early-stop"});
+        ::args::Flag enable_profiling(parser, "profile", "Time the training stages and print a summary", {"profile"});
+        ::args::Flag memory_report(parser, "memory_report", "Print the memory breakdown before training and at refine steps", {"memory-report"});
+        ::args::Flag collect_contribution_stats(parser, "contribution_stats", "Collect per-Gaussian contribution statistics during training", {"contribution-stats"});
         ::args::Flag save_depth(parser, "save_depth", "Save depth maps during training", {"save-depth"});
 
         // Parse arguments
@@ -123,6 +158,19 @@ namespace {
         setVal(test_every, ds.test_every);
         setVal(steps_scaler, opt.steps_scaler);
         setVal(sh_degree_interval, opt.sh_degree_interval);
+        setVal(seed, opt.seed);
+        setVal(vram_budget, opt.vram_budget);
+        setVal(step_time_budget, opt.step_time_budget_ms);
+        setVal(compact_min_weight, opt.compaction_min_weight);
+        setVal(compact_finetune, opt.compaction_finetune_steps);
+        setVal(lr_final_factor, opt.lr_final_factor);
+        setVal(lr_step_every, opt.lr_step_every);
+        setVal(lr_warmup, opt.lr_warmup_steps);
+        setVal(early_stop_every, opt.early_stop_every);
+        setVal(early_stop_patience, opt.early_stop_patience);
+        setVal(early_stop_min_gain, opt.early_stop_min_gain);
+        setVal(early_stop_views, opt.early_stop_views);
+        setVal(eval_batch_size, opt.eval_batch_size);
 
         // Flag arguments
         setFlag(use_bilateral_grid, opt.use_bilateral_grid);
@@ -130,6 +178,16 @@ namespace {
         setFlag(enable_viz, opt.enable_viz);
         setFlag(selective_adam, opt.selective_adam);
         setFlag(enable_save_eval_images, opt.enable_save_eval_images);
+        setFlag(deterministic, opt.deterministic);
+        setFlag(enable_compaction, opt.enable_compaction);
+        setFlag(collect_contribution_stats, opt.collect_contribution_stats);
+        setFlag(enable_early_stopping, opt.enable_early_stopping);
+        setFlag(enable_profiling, opt.enable_profiling);
+        setFlag(memory_report, opt.memory_report);
+        if (profile_trace) {
+            opt.profile_trace = ::args::get(profile_trace);
+            opt.enable_profiling = true;
+        }
 
         // Special case: validate render mode
         if (render_mode) {
@@ -142,6 +200,131 @@ namespace {
             opt.render_mode = mode;
         }
 
+        if (lpips_precision) {
+            const auto precision = ::args::get(lpips_precision);
+            if (VALID_LPIPS_PRECISIONS.find(precision) == VALID_LPIPS_PRECISIONS.end()) {
+                std::cerr << "ERROR: Invalid LPIPS precision '" << precision
+                          << "'. Valid precisions are: fp32, fp16, bf16\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.lpips_precision = precision;
+        }
+
+        if (depth_colormap) {
+            const auto colormap = ::args::get(depth_colormap);
+            if (VALID_DEPTH_COLORMAPS.find(colormap) == VALID_DEPTH_COLORMAPS.end()) {
+                std::cerr << "ERROR: Invalid depth colormap '" << colormap
+                          << "'. Valid colormaps are: jet, turbo, viridis, inferno, gray
+";
+                return ERROR_EXIT_CODE;
+            }
+            opt.depth_colormap = colormap;
+        }
+
+        if (eval_image_format) {
+            const auto format = ::args::get(eval_image_format);
+            if (VALID_IMAGE_FORMATS.find(format) == VALID_IMAGE_FORMATS.end()) {
+                std::cerr << "ERROR: Invalid image format '" << format
+                          << "'. Valid formats are: png, jpg, raw\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.eval_image_format = format;
+        }
+
+        if (png_compression_level) {
+            const int level = ::args::get(png_compression_level);
+            if (level < 0 || level > 9) {
+                std::cerr << "ERROR: --png-level must be between 0 and 9, got " << level << "\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.png_compression_level = level;
+        }
+
+        if (image_writer_threads) {
+            const int threads = ::args::get(image_writer_threads);
+            if (threads <= 0) {
+                std::cerr << "ERROR: --image-threads must be positive, got " << threads << "\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.image_writer_threads = threads;
+        }
+
+        if (tile_size) {
+            const int size = ::args::get(tile_size);
+            if (size < 0 || size > 32) {
+                std::cerr << "ERROR: --tile-size must be 0 (auto) or between 1 and 32, got " << size << "\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.tile_size = size;
+        }
+
+        if (growth_mode) {
+            const auto mode = ::args::get(growth_mode);
+            try {
+                gs::growth_mode_from_string(mode);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << "ERROR: " << e.what() << "\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.growth_mode = mode;
+        }
+
+        if (opt.vram_budget <= 0.0f || opt.vram_budget > 1.0f) {
+            std::cerr << "ERROR: --vram-budget must be in (0, 1], got " << opt.vram_budget << "\n";
+            return ERROR_EXIT_CODE;
+        }
+        if (opt.growth_mode == "step_time" && opt.step_time_budget_ms <= 0.0f) {
+            std::cerr << "ERROR: --growth-mode step_time needs a positive --step-time-budget\n";
+            return ERROR_EXIT_CODE;
+        }
+
+        if (opt.compaction_finetune_steps < 0 || opt.compaction_finetune_steps >= static_cast<int>(opt.iterations)) {
+            std::cerr << "ERROR: --compact-finetune must be in [0, iterations), got " << opt.compaction_finetune_steps << "\n";
+            return ERROR_EXIT_CODE;
+        }
+
+        if (lr_schedule) {
+            const auto name = ::args::get(lr_schedule);
+            try {
+                gs::lr_schedule_from_string(name);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << "ERROR: " << e.what() << "\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.lr_schedule = name;
+        }
+        if (opt.lr_final_factor <= 0.0f) {
+            std::cerr << "ERROR: --lr-final-factor must be positive, got " << opt.lr_final_factor << "\n";
+            return ERROR_EXIT_CODE;
+        }
+        if (opt.lr_step_every == 0) {
+            std::cerr << "ERROR: --lr-step-every must be positive\n";
+            return ERROR_EXIT_CODE;
+        }
+
+        if (opt.early_stop_every == 0 || opt.early_stop_patience <= 0 || opt.early_stop_views <= 0) {
+            std::cerr << "ERROR: --early-stop-every, --early-stop-patience and --early-stop-views must be positive\n";
+            return ERROR_EXIT_CODE;
+        }
+
+        if (opt.eval_batch_size <= 0) {
+            std::cerr << "ERROR: --eval-batch-size must be positive\n";
+            return ERROR_EXIT_CODE;
+        }
+
+        if (strategy) {
+            const auto name = ::args::get(strategy);
+            if (!gs::has_strategy(name)) {
+                std::cerr << "ERROR: Unknown strategy '" << name << "'. Valid strategies are:";
+                for (const auto& known : gs::available_strategies()) {
+                    std::cerr << " " << known;
+                }
+                std::cerr << "\n";
+                return ERROR_EXIT_CODE;
+            }
+            opt.strategy = name;
+        }
+
         return SUCCESS_EXIT_CODE;
     }
 
@@ -156,6 +339,11 @@ namespace {
             opt.start_refine *= scaler;
             opt.stop_refine *= scaler;
             opt.refine_every *= scaler;
+            opt.opacity_reset_every *= scaler;
+            opt.compaction_finetune_steps *= scaler;
+            opt.lr_step_every *= scaler;
+            opt.lr_warmup_steps *= scaler;
+            opt.early_stop_every *= scaler;
             opt.sh_degree_interval *= scaler;
 
             scale_steps_vector(opt.eval_steps, scaler);
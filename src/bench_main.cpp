@@ -0,0 +1,156 @@
+#include "core/benchmark.hpp"
+#include <algorithm>
+#include <args.hxx>
+#include <chrono>
+#include <ctime>
+#include <cuda_runtime_api.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <torch/torch.h>
+#include <torch/version.h>
+
+namespace {
+    std::string utc_timestamp() {
+        const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm tm{};
+        gmtime_r(&now, &tm);
+        std::ostringstream ss;
+        ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+        return ss.str();
+    }
+
+    std::string cuda_device_name() {
+        int device = 0;
+        cudaDeviceProp props{};
+        if (cudaGetDevice(&device) != cudaSuccess || cudaGetDeviceProperties(&props, device) != cudaSuccess) {
+            return "unknown";
+        }
+        return props.name;
+    }
+} // namespace
+
+// Times the gsplat ops on synthetic scenes and the host pipeline stages over a
+// grid of Gaussian counts, resolutions and SH degrees, and writes the results
+// as JSON for tracking over time.
+int main(int argc, char* argv[]) {
+    ::args::ArgumentParser parser(
+        "Microbenchmarks of the gsplat ops and host pipeline stages\n",
+        "Stages: projection, sh, intersect_tile, rasterize_fwd, rasterize_bwd, quat_scale_to_covar, relocation, adam "
+        "(CUDA and CPU), colmap_parse, image_decode_jpeg, image_decode_png, ply_write (CPU). "
+        "Without a GPU only the CPU implementations run.");
+    ::args::HelpFlag help(parser, "help", "Display help menu", {'h', "help"});
+    ::args::ValueFlag<std::string> gaussians(parser, "list", "Gaussian counts (default: 100000,1000000)", {"gaussians"});
+    ::args::ValueFlag<std::string> resolutions(parser, "list", "Resolutions WIDTHxHEIGHT (default: 1920x1080)", {"resolutions"});
+    ::args::ValueFlag<std::string> sh_degrees(parser, "list", "SH degrees (default: 0,3)", {"sh-degrees"});
+    ::args::ValueFlag<std::string> stages_filter(parser, "list", "Only run these stages (default: all)", {"stages"});
+    ::args::ValueFlag<std::string> device(parser, "device", "auto, cuda, cpu or all (default: auto, CUDA when available)", {"device"});
+    ::args::ValueFlag<int> warmup(parser, "n", "Untimed calls per benchmark (default: 2)", {"warmup"});
+    ::args::ValueFlag<int> min_iters(parser, "n", "Minimum timed calls per benchmark (default: 5)", {"min-iters"});
+    ::args::ValueFlag<double> min_time(parser, "ms", "Minimum timed wall time per benchmark (default: 200)", {"min-time-ms"});
+    ::args::ValueFlag<std::string> output(parser, "path", "JSON output (default: benchmark.json)", {'o', "output"});
+    ::args::ValueFlag<std::string> tag(parser, "tag", "Label stored in the JSON context, e.g. a commit hash", {"tag"});
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const ::args::Help&) {
+        std::cout << parser;
+        return 0;
+    } catch (const ::args::ParseError& e) {
+        std::cerr << "ERROR: " << e.what() << "\n\n"
+                  << parser;
+        return -1;
+    }
+
+    try {
+        const auto grid = gs::bench::make_grid(
+            gs::bench::parse_counts(gaussians ? ::args::get(gaussians) : "100000,1000000"),
+            gs::bench::parse_resolutions(resolutions ? ::args::get(resolutions) : "1920x1080"),
+            [&] {
+                std::vector<int> degrees;
+                for (const auto& item : gs::bench::split_list(sh_degrees ? ::args::get(sh_degrees) : "0,3")) {
+                    const int degree = std::stoi(item);
+                    if (degree < 0 || degree > 3) {
+                        throw std::invalid_argument("SH degree must be in [0, 3], got " + item);
+                    }
+                    degrees.push_back(degree);
+                }
+                return degrees;
+            }());
+
+        auto stages = gs::bench::default_stages();
+        if (stages_filter) {
+            const auto wanted = gs::bench::split_list(::args::get(stages_filter));
+            for (const auto& name : wanted) {
+                if (std::none_of(stages.begin(), stages.end(), [&](const auto& s) { return s.name == name; })) {
+                    throw std::invalid_argument("Unknown stage '" + name + "'");
+                }
+            }
+            stages.erase(std::remove_if(stages.begin(), stages.end(), [&](const auto& s) {
+                             return std::find(wanted.begin(), wanted.end(), s.name) == wanted.end();
+                         }),
+                         stages.end());
+        }
+
+        gs::bench::RunOptions options;
+        options.cuda_available = torch::cuda::is_available();
+        const std::string device_mode = device ? ::args::get(device) : "auto";
+        if (device_mode == "auto") {
+            options.devices = {options.cuda_available ? "cuda" : "cpu"};
+        } else if (device_mode == "all") {
+            options.devices = {"cuda", "cpu"};
+        } else if (device_mode == "cuda" || device_mode == "cpu") {
+            options.devices = {device_mode};
+        } else {
+            throw std::invalid_argument("Unknown device '" + device_mode + "'");
+        }
+        if (warmup)
+            options.timing.warmup = ::args::get(warmup);
+        if (min_iters)
+            options.timing.min_iterations = ::args::get(min_iters);
+        if (min_time)
+            options.timing.min_time_ms = ::args::get(min_time);
+
+        nlohmann::json context = {{"timestamp", utc_timestamp()},
+                                  {"tag", tag ? ::args::get(tag) : ""},
+                                  {"torch_version", TORCH_VERSION},
+                                  {"cuda_device", nullptr},
+                                  {"timing", {{"warmup", options.timing.warmup},
+                                              {"min_iterations", options.timing.min_iterations},
+                                              {"min_time_ms", options.timing.min_time_ms}}}};
+
+        std::unique_ptr<gs::DeviceTimer> device_timer;
+        if (options.cuda_available) {
+            device_timer = gs::make_cuda_event_timer();
+            context["cuda_device"] = cuda_device_name();
+        }
+
+        const auto results = gs::bench::run_stages(
+            stages, grid, options, device_timer.get(), [](const gs::bench::BenchResult& r) {
+                std::cout << gs::bench::result_id(r) << ": ";
+                if (r.skipped.empty()) {
+                    std::cout << std::fixed << std::setprecision(3) << r.timing.p50_ms << " ms\n";
+                } else {
+                    std::cout << "skipped (" << r.skipped << ")\n";
+                }
+            });
+
+        std::cout << "\n"
+                  << gs::bench::format_results(results);
+
+        const std::string path = output ? ::args::get(output) : "benchmark.json";
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Failed to open " + path);
+        }
+        out << gs::bench::results_to_json(results, context).dump(2) << "\n";
+        std::cout << "Results written to " << path << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
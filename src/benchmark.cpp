@@ -0,0 +1,315 @@
+#include "core/benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace gs::bench {
+
+    namespace {
+        constexpr int kSchemaVersion = 1;
+
+        auto sort_key(const BenchResult& r) {
+            return std::tie(r.stage, r.device, r.config.num_gaussians, r.config.width, r.config.height,
+                            r.config.sh_degree);
+        }
+
+        std::string trim(const std::string& s) {
+            const auto begin = s.find_first_not_of(" \t");
+            if (begin == std::string::npos) {
+                return {};
+            }
+            const auto end = s.find_last_not_of(" \t");
+            return s.substr(begin, end - begin + 1);
+        }
+
+        // Positive integer, also written as 1e6
+        int64_t parse_positive(const std::string& item) {
+            size_t used = 0;
+            double value = 0.0;
+            try {
+                value = std::stod(item, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used != item.size() || !(value >= 1.0) || value != std::floor(value) || value > 9.0e15) {
+                throw std::invalid_argument("Expected a positive integer, got '" + item + "'");
+            }
+            return static_cast<int64_t>(value);
+        }
+
+        // JSON null for an unused parameter
+        nlohmann::json param(int64_t value) {
+            return value < 0 ? nlohmann::json(nullptr) : nlohmann::json(value);
+        }
+    } // namespace
+
+    std::vector<BenchConfig> make_grid(const std::vector<int64_t>& gaussians,
+                                       const std::vector<std::pair<int, int>>& resolutions,
+                                       const std::vector<int>& sh_degrees) {
+        std::vector<BenchConfig> grid;
+        for (const auto n : gaussians) {
+            for (const auto& [width, height] : resolutions) {
+                for (const auto degree : sh_degrees) {
+                    grid.push_back({n, width, height, degree});
+                }
+            }
+        }
+        return grid;
+    }
+
+    std::vector<BenchConfig> stage_grid(const std::vector<BenchConfig>& grid, unsigned uses) {
+        std::vector<BenchConfig> configs;
+        for (auto config : grid) {
+            if (!(uses & UsesGaussians)) {
+                config.num_gaussians = -1;
+            }
+            if (!(uses & UsesResolution)) {
+                config.width = -1;
+                config.height = -1;
+            }
+            if (!(uses & UsesShDegree)) {
+                config.sh_degree = -1;
+            }
+            const bool seen = std::any_of(configs.begin(), configs.end(), [&](const BenchConfig& c) {
+                return c.num_gaussians == config.num_gaussians && c.width == config.width &&
+                       c.height == config.height && c.sh_degree == config.sh_degree;
+            });
+            if (!seen) {
+                configs.push_back(config);
+            }
+        }
+        return configs;
+    }
+
+    std::vector<std::string> split_list(const std::string& list) {
+        std::vector<std::string> items;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item = trim(item);
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    std::vector<int64_t> parse_counts(const std::string& list) {
+        std::vector<int64_t> counts;
+        for (const auto& item : split_list(list)) {
+            counts.push_back(parse_positive(item));
+        }
+        if (counts.empty()) {
+            throw std::invalid_argument("Empty list '" + list + "'");
+        }
+        return counts;
+    }
+
+    std::vector<std::pair<int, int>> parse_resolutions(const std::string& list) {
+        std::vector<std::pair<int, int>> resolutions;
+        for (const auto& item : split_list(list)) {
+            const auto x = item.find('x');
+            if (x == std::string::npos) {
+                throw std::invalid_argument("Expected WIDTHxHEIGHT, got '" + item + "'");
+            }
+            const auto width = parse_positive(item.substr(0, x));
+            const auto height = parse_positive(item.substr(x + 1));
+            if (width > 65536 || height > 65536) {
+                throw std::invalid_argument("Resolution too large: '" + item + "'");
+            }
+            resolutions.emplace_back(static_cast<int>(width), static_cast<int>(height));
+        }
+        if (resolutions.empty()) {
+            throw std::invalid_argument("Empty list '" + list + "'");
+        }
+        return resolutions;
+    }
+
+    Timing summarize(std::vector<double> samples_ms) {
+        Timing timing;
+        if (samples_ms.empty()) {
+            return timing;
+        }
+        std::sort(samples_ms.begin(), samples_ms.end());
+        const double n = static_cast<double>(samples_ms.size());
+        timing.iterations = static_cast<int>(samples_ms.size());
+        timing.mean_ms = std::accumulate(samples_ms.begin(), samples_ms.end(), 0.0) / n;
+        if (samples_ms.size() > 1) {
+            double sq = 0.0;
+            for (const double s : samples_ms) {
+                sq += (s - timing.mean_ms) * (s - timing.mean_ms);
+            }
+            timing.stddev_ms = std::sqrt(sq / (n - 1.0));
+        }
+        timing.min_ms = samples_ms.front();
+        timing.p50_ms = percentile(samples_ms, 0.50);
+        timing.p90_ms = percentile(samples_ms, 0.90);
+        timing.max_ms = samples_ms.back();
+        return timing;
+    }
+
+    Timing measure(const std::function<void()>& fn, const TimingOptions& options, DeviceTimer* device_timer) {
+        using clock = std::chrono::steady_clock;
+        for (int i = 0; i < options.warmup; ++i) {
+            fn();
+        }
+        if (device_timer) {
+            device_timer->synchronize();
+        }
+
+        std::vector<double> samples;
+        std::vector<std::pair<int, int>> marks;
+        const auto start = clock::now();
+        for (int i = 0; i < options.max_iterations; ++i) {
+            const double elapsed_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            if (i >= options.min_iterations && elapsed_ms >= options.min_time_ms) {
+                break;
+            }
+            if (device_timer) {
+                const int begin = device_timer->record();
+                try {
+                    fn();
+                } catch (...) {
+                    // Hand the marks back before the error leaves
+                    device_timer->synchronize();
+                    device_timer->release(begin);
+                    for (const auto& [b, e] : marks) {
+                        device_timer->release(b);
+                        device_timer->release(e);
+                    }
+                    throw;
+                }
+                marks.emplace_back(begin, device_timer->record());
+            } else {
+                const auto t0 = clock::now();
+                fn();
+                samples.push_back(std::chrono::duration<double, std::milli>(clock::now() - t0).count());
+            }
+        }
+
+        if (device_timer) {
+            device_timer->synchronize();
+            for (const auto& [begin, end] : marks) {
+                samples.push_back(device_timer->elapsed_ms(begin, end));
+                device_timer->release(begin);
+                device_timer->release(end);
+            }
+        }
+        return summarize(std::move(samples));
+    }
+
+    std::vector<BenchResult> run_stages(const std::vector<Stage>& stages,
+                                        const std::vector<BenchConfig>& grid,
+                                        const RunOptions& options,
+                                        DeviceTimer* device_timer,
+                                        const std::function<void(const BenchResult&)>& progress) {
+        std::vector<BenchResult> results;
+        for (const auto& stage : stages) {
+            std::vector<std::string> devices;
+            if (!stage.has_cuda) {
+                devices = {"cpu"};
+            } else {
+                devices = options.devices;
+            }
+
+            for (const auto& config : stage_grid(grid, stage.uses)) {
+                for (const auto& device : devices) {
+                    BenchResult result;
+                    result.stage = stage.name;
+                    result.device = device;
+                    result.config = config;
+
+                    const bool cuda = device == "cuda";
+                    if (cuda && !options.cuda_available) {
+                        result.skipped = "no CUDA device";
+                    } else if (!cuda && !stage.has_cpu) {
+                        result.skipped = "no CPU implementation";
+                    } else {
+                        try {
+                            const auto fn = stage.setup(config, cuda, result.counters);
+                            result.timing = measure(fn, options.timing, cuda ? device_timer : nullptr);
+                        } catch (const std::exception& e) {
+                            result.skipped = e.what();
+                            result.counters.clear();
+                        }
+                    }
+                    if (progress) {
+                        progress(result);
+                    }
+                    results.push_back(std::move(result));
+                }
+            }
+        }
+        return results;
+    }
+
+    std::string result_id(const BenchResult& result) {
+        std::ostringstream ss;
+        ss << result.stage << "/" << result.device;
+        if (result.config.num_gaussians >= 0) {
+            ss << "/n=" << result.config.num_gaussians;
+        }
+        if (result.config.width >= 0) {
+            ss << "/" << result.config.width << "x" << result.config.height;
+        }
+        if (result.config.sh_degree >= 0) {
+            ss << "/sh=" << result.config.sh_degree;
+        }
+        return ss.str();
+    }
+
+    nlohmann::json results_to_json(std::vector<BenchResult> results, const nlohmann::json& context) {
+        std::stable_sort(results.begin(), results.end(), [](const BenchResult& a, const BenchResult& b) {
+            return sort_key(a) < sort_key(b);
+        });
+
+        auto entries = nlohmann::json::array();
+        for (const auto& r : results) {
+            nlohmann::json timing = nullptr;
+            if (r.skipped.empty()) {
+                timing = {{"iterations", r.timing.iterations},
+                          {"mean_ms", r.timing.mean_ms},
+                          {"stddev_ms", r.timing.stddev_ms},
+                          {"min_ms", r.timing.min_ms},
+                          {"p50_ms", r.timing.p50_ms},
+                          {"p90_ms", r.timing.p90_ms},
+                          {"max_ms", r.timing.max_ms}};
+            }
+            entries.push_back({{"id", result_id(r)},
+                               {"stage", r.stage},
+                               {"device", r.device},
+                               {"num_gaussians", param(r.config.num_gaussians)},
+                               {"width", param(r.config.width)},
+                               {"height", param(r.config.height)},
+                               {"sh_degree", param(r.config.sh_degree)},
+                               {"skipped", r.skipped},
+                               {"timing", timing},
+                               {"counters", r.counters}});
+        }
+        return {{"schema_version", kSchemaVersion}, {"context", context}, {"results", std::move(entries)}};
+    }
+
+    std::string format_results(const std::vector<BenchResult>& results) {
+        std::ostringstream ss;
+        ss << std::left << std::setw(44) << "benchmark" << std::right << std::setw(7) << "iters"
+           << std::setw(11) << "mean ms" << std::setw(11) << "p50" << std::setw(11) << "p90"
+           << std::setw(11) << "min" << "\n";
+        for (const auto& r : results) {
+            ss << std::left << std::setw(44) << result_id(r) << std::right;
+            if (!r.skipped.empty()) {
+                ss << "  skipped: " << r.skipped << "\n";
+                continue;
+            }
+            ss << std::setw(7) << r.timing.iterations << std::fixed << std::setprecision(3)
+               << std::setw(11) << r.timing.mean_ms << std::setw(11) << r.timing.p50_ms
+               << std::setw(11) << r.timing.p90_ms << std::setw(11) << r.timing.min_ms << "\n";
+        }
+        return ss.str();
+    }
+
+} // namespace gs::bench
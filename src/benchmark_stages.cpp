@@ -0,0 +1,417 @@
+#include "Ops.h"
+#include "core/benchmark.hpp"
+#include "core/colmap_reader.hpp"
+#include "core/image_io.hpp"
+#include "core/rasterizer_cpu.hpp"
+#include "core/splat_data.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <torch/torch.h>
+
+namespace gs::bench {
+
+    namespace {
+        constexpr int kTileSize = 16;
+        constexpr int kBinomMax = 51;     // MCMC's n_max
+        constexpr int kColmapImages = 200; // images of the synthetic COLMAP model
+        constexpr int kPointsPerImage = 2000;
+        constexpr int kTrackLength = 4;
+
+        // Gaussians spread through the frustum of a pinhole camera at the
+        // origin looking down +z, with a focal length of one image width so the
+        // projected footprint scales with the resolution
+        struct Scene {
+            torch::Tensor means;     // [N, 3]
+            torch::Tensor quats;     // [N, 4]
+            torch::Tensor scales;    // [N, 3] activated
+            torch::Tensor opacities; // [N] activated
+            torch::Tensor colors;    // [1, N, 3]
+            torch::Tensor viewmats;  // [1, 4, 4]
+            torch::Tensor Ks;        // [1, 3, 3]
+            int width = 0;
+            int height = 0;
+        };
+
+        Scene make_scene(const BenchConfig& config, const torch::Device& device) {
+            torch::manual_seed(0);
+            const int64_t n = config.num_gaussians;
+            const float w = static_cast<float>(config.width), h = static_cast<float>(config.height);
+
+            const auto z = torch::rand({n}) * 8.0f + 2.0f;
+            const auto x = (torch::rand({n}) - 0.5f) * z;
+            const auto y = (torch::rand({n}) - 0.5f) * z * (h / w);
+
+            Scene scene;
+            scene.means = torch::stack({x, y, z}, -1).to(device);
+            scene.quats = torch::nn::functional::normalize(torch::randn({n, 4}),
+                                                           torch::nn::functional::NormalizeFuncOptions().dim(-1))
+                              .to(device);
+            scene.scales = torch::exp(torch::rand({n, 3}) * 2.0f - 6.0f).to(device);
+            scene.opacities = (torch::rand({n}) * 0.9f + 0.05f).to(device);
+            scene.colors = torch::rand({1, n, 3}).to(device);
+            scene.viewmats = torch::eye(4).unsqueeze(0).to(device);
+            scene.Ks = torch::tensor({{w, 0.0f, w / 2.0f}, {0.0f, w, h / 2.0f}, {0.0f, 0.0f, 1.0f}})
+                           .unsqueeze(0)
+                           .to(device);
+            scene.width = config.width;
+            scene.height = config.height;
+            return scene;
+        }
+
+        struct Projected {
+            torch::Tensor radii;   // [1, N, 2]
+            torch::Tensor means2d; // [1, N, 2]
+            torch::Tensor depths;  // [1, N]
+            torch::Tensor conics;  // [1, N, 3]
+        };
+
+        Projected project(const Scene& s, bool cuda) {
+            if (cuda) {
+                auto [radii, means2d, depths, conics, compensations] = gsplat::projection_ewa_3dgs_fused_fwd(
+                    s.means, c10::nullopt, s.quats, s.scales, s.opacities, s.viewmats, s.Ks,
+                    s.width, s.height, 0.3f, 0.01f, 1e10f, 0.0f, false, gsplat::CameraModelType::PINHOLE);
+                return {radii, means2d, depths, conics};
+            }
+            auto [radii, means2d, depths, conics] = cpu::projection(
+                s.means, s.quats, s.scales, s.opacities, s.viewmats, s.Ks,
+                s.width, s.height, 0.3f, 0.01f, 1e10f, 0.0f);
+            return {radii, means2d, depths, conics};
+        }
+
+        struct Binned {
+            torch::Tensor offsets;     // [1, tile_height, tile_width]
+            torch::Tensor flatten_ids; // [n_isects]
+            int64_t n_isects = 0;
+        };
+
+        int tiles(int pixels) { return (pixels + kTileSize - 1) / kTileSize; }
+
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> intersect(const Projected& p, const Scene& s, bool cuda) {
+            if (cuda) {
+                return gsplat::intersect_tile(p.means2d, p.radii, p.depths, c10::nullopt, c10::nullopt,
+                                              1, kTileSize, tiles(s.width), tiles(s.height), true);
+            }
+            return cpu::intersect_tile(p.means2d, p.radii, p.depths, kTileSize, tiles(s.width), tiles(s.height));
+        }
+
+        Binned bin(const Projected& p, const Scene& s, bool cuda) {
+            auto [tiles_per_gauss, isect_ids, flatten_ids] = intersect(p, s, cuda);
+            Binned b;
+            b.offsets = cuda ? gsplat::intersect_offset(isect_ids, 1, tiles(s.width), tiles(s.height))
+                             : cpu::intersect_offset(isect_ids, 1, tiles(s.width), tiles(s.height));
+            b.flatten_ids = flatten_ids;
+            b.n_isects = flatten_ids.numel();
+            return b;
+        }
+
+        torch::Tensor binomials(const torch::Device& device) {
+            auto binoms = torch::zeros({kBinomMax, kBinomMax}, torch::kFloat32);
+            auto acc = binoms.accessor<float, 2>();
+            for (int n = 0; n < kBinomMax; ++n) {
+                for (int k = 0; k <= n; ++k) {
+                    float binom = 1.0f;
+                    for (int i = 0; i < k; ++i) {
+                        binom *= static_cast<float>(n - i) / static_cast<float>(i + 1);
+                    }
+                    acc[n][k] = binom;
+                }
+            }
+            return binoms.to(device);
+        }
+
+        torch::Device device_of(bool cuda) { return cuda ? torch::Device(torch::kCUDA) : torch::Device(torch::kCPU); }
+
+        // Fresh scratch directory under the system temp directory
+        std::filesystem::path scratch_dir(const std::string& name) {
+            auto dir = std::filesystem::temp_directory_path() / ("gs_bench_" + name);
+            std::filesystem::remove_all(dir);
+            std::filesystem::create_directories(dir);
+            return dir;
+        }
+
+        template <typename T>
+        void put(std::ofstream& out, T value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        // Binary COLMAP model with one pinhole camera, kColmapImages images and n points
+        void write_colmap_model(const std::filesystem::path& root, int64_t n) {
+            const auto sparse = root / "sparse" / "0";
+            std::filesystem::create_directories(sparse);
+            std::filesystem::create_directories(root / "images");
+
+            std::ofstream cameras(sparse / "cameras.bin", std::ios::binary);
+            put<uint64_t>(cameras, 1);
+            put<uint32_t>(cameras, 1);
+            put<int32_t>(cameras, 1); // PINHOLE
+            put<uint64_t>(cameras, 1920);
+            put<uint64_t>(cameras, 1080);
+            for (const double v : {1500.0, 1500.0, 960.0, 540.0}) {
+                put<double>(cameras, v);
+            }
+
+            std::ofstream images(sparse / "images.bin", std::ios::binary);
+            put<uint64_t>(images, kColmapImages);
+            for (uint32_t i = 1; i <= kColmapImages; ++i) {
+                put<uint32_t>(images, i);
+                for (const double v : {1.0, 0.0, 0.0, 0.0, 0.1 * i, 0.0, 0.0}) { // qvec, tvec
+                    put<double>(images, v);
+                }
+                put<uint32_t>(images, 1);
+                const auto name = "frame_" + std::to_string(i) + ".jpg";
+                images.write(name.c_str(), static_cast<std::streamsize>(name.size() + 1));
+                put<uint64_t>(images, kPointsPerImage);
+                for (int k = 0; k < kPointsPerImage; ++k) {
+                    put<double>(images, 10.0 * k);
+                    put<double>(images, 5.0 * k);
+                    put<uint64_t>(images, static_cast<uint64_t>(k));
+                }
+            }
+
+            std::ofstream points(sparse / "points3D.bin", std::ios::binary);
+            put<uint64_t>(points, static_cast<uint64_t>(n));
+            for (int64_t i = 0; i < n; ++i) {
+                put<uint64_t>(points, static_cast<uint64_t>(i));
+                for (int k = 0; k < 3; ++k) {
+                    put<double>(points, 0.001 * static_cast<double>((i * 7 + k * 13) % 10007));
+                }
+                for (int k = 0; k < 3; ++k) {
+                    put<uint8_t>(points, static_cast<uint8_t>((i + k) & 0xff));
+                }
+                put<double>(points, 0.5);
+                put<uint64_t>(points, kTrackLength);
+                for (int k = 0; k < kTrackLength; ++k) {
+                    put<uint32_t>(points, static_cast<uint32_t>(1 + (i + k) % kColmapImages));
+                    put<uint32_t>(points, static_cast<uint32_t>(k));
+                }
+            }
+        }
+
+        // Smooth gradients with some noise, closer to a photo than pure noise
+        torch::Tensor synthetic_photo(int width, int height) {
+            torch::manual_seed(0);
+            const auto ys = torch::linspace(0.0f, 1.0f, height).view({height, 1, 1});
+            const auto xs = torch::linspace(0.0f, 1.0f, width).view({1, width, 1});
+            const auto tint = torch::tensor({0.9f, 0.6f, 0.3f}).view({1, 1, 3});
+            auto image = 0.5f + 0.25f * torch::sin(12.0f * xs * tint) * torch::cos(8.0f * ys) +
+                         0.05f * torch::randn({height, width, 3});
+            return (image.clamp(0.0f, 1.0f) * 255.0f).to(torch::kUInt8).contiguous();
+        }
+
+        Stage::Setup image_decode(image_io::ImageFormat format, const std::string& name) {
+            return [format, name](const BenchConfig& config, bool, Stage::Counters& counters) {
+                const auto dir = scratch_dir(name);
+                const auto path = image_io::write_rgb8(dir / "frame", synthetic_photo(config.width, config.height), format);
+                counters["file_bytes"] = static_cast<double>(std::filesystem::file_size(path));
+                return std::function<void()>([path] {
+                    auto [data, w, h, c] = load_image(path);
+                    free_image(data);
+                });
+            };
+        }
+
+        // Silences std::cout, which read_colmap_cameras_and_images reports to
+        class QuietCout {
+        public:
+            QuietCout()
+                : previous_(std::cout.rdbuf(sink_.rdbuf())) {}
+            ~QuietCout() { std::cout.rdbuf(previous_); }
+
+        private:
+            std::ostringstream sink_;
+            std::streambuf* previous_;
+        };
+    } // namespace
+
+    std::vector<Stage> default_stages() {
+        std::vector<Stage> stages;
+
+        stages.push_back({"projection", UsesGaussians | UsesResolution, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters& counters) {
+                              const auto scene = make_scene(config, device_of(cuda));
+                              counters["visible"] = static_cast<double>(
+                                  (project(scene, cuda).radii > 0).all(-1).sum().item<int64_t>());
+                              return std::function<void()>([scene, cuda] { project(scene, cuda); });
+                          }});
+
+        stages.push_back({"sh", UsesGaussians | UsesShDegree, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters&) {
+                              torch::manual_seed(0);
+                              const int64_t n = config.num_gaussians;
+                              const int64_t K = static_cast<int64_t>(config.sh_degree + 1) * (config.sh_degree + 1);
+                              const auto dirs = torch::nn::functional::normalize(
+                                                    torch::randn({n, 3}), torch::nn::functional::NormalizeFuncOptions().dim(-1))
+                                                    .to(device_of(cuda));
+                              const auto coeffs = (torch::randn({n, K, 3}) * 0.1f).to(device_of(cuda));
+                              const int degree = config.sh_degree;
+                              return std::function<void()>([dirs, coeffs, degree, cuda] {
+                                  if (cuda) {
+                                      gsplat::spherical_harmonics_fwd(degree, dirs, coeffs, c10::nullopt);
+                                  } else {
+                                      cpu::spherical_harmonics(degree, dirs, coeffs, torch::Tensor());
+                                  }
+                              });
+                          }});
+
+        stages.push_back({"intersect_tile", UsesGaussians | UsesResolution, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters& counters) {
+                              const auto scene = make_scene(config, device_of(cuda));
+                              const auto projected = project(scene, cuda);
+                              counters["n_isects"] = static_cast<double>(bin(projected, scene, cuda).n_isects);
+                              return std::function<void()>([scene, projected, cuda] { intersect(projected, scene, cuda); });
+                          }});
+
+        stages.push_back({"rasterize_fwd", UsesGaussians | UsesResolution, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters& counters) {
+                              const auto s = make_scene(config, device_of(cuda));
+                              const auto p = project(s, cuda);
+                              const auto b = bin(p, s, cuda);
+                              counters["n_isects"] = static_cast<double>(b.n_isects);
+                              const auto opacities = s.opacities.unsqueeze(0);
+                              return std::function<void()>([s, p, b, opacities, cuda] {
+                                  if (cuda) {
+                                      gsplat::rasterize_to_pixels_3dgs_fwd(
+                                          p.means2d, p.conics, s.colors, opacities, c10::nullopt, c10::nullopt,
+                                          s.width, s.height, kTileSize, b.offsets, b.flatten_ids);
+                                  } else {
+                                      cpu::rasterize_to_pixels_fwd(p.means2d, p.conics, s.colors, opacities, torch::Tensor(),
+                                                                   s.width, s.height, kTileSize, b.offsets, b.flatten_ids);
+                                  }
+                              });
+                          }});
+
+        stages.push_back({"rasterize_bwd", UsesGaussians | UsesResolution, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters& counters) {
+                              const auto s = make_scene(config, device_of(cuda));
+                              const auto p = project(s, cuda);
+                              const auto b = bin(p, s, cuda);
+                              counters["n_isects"] = static_cast<double>(b.n_isects);
+                              const auto opacities = s.opacities.unsqueeze(0);
+
+                              torch::Tensor alphas, last_ids;
+                              if (cuda) {
+                                  std::tie(std::ignore, alphas, last_ids) = gsplat::rasterize_to_pixels_3dgs_fwd(
+                                      p.means2d, p.conics, s.colors, opacities, c10::nullopt, c10::nullopt,
+                                      s.width, s.height, kTileSize, b.offsets, b.flatten_ids);
+                              } else {
+                                  std::tie(std::ignore, alphas, last_ids) = cpu::rasterize_to_pixels_fwd(
+                                      p.means2d, p.conics, s.colors, opacities, torch::Tensor(),
+                                      s.width, s.height, kTileSize, b.offsets, b.flatten_ids);
+                              }
+                              const auto v_colors = torch::randn({1, s.height, s.width, 3}, alphas.options()) * 1e-3f;
+                              const auto v_alphas = torch::randn({1, s.height, s.width, 1}, alphas.options()) * 1e-3f;
+
+                              return std::function<void()>([s, p, b, opacities, alphas, last_ids, v_colors, v_alphas, cuda] {
+                                  if (cuda) {
+                                      gsplat::rasterize_to_pixels_3dgs_bwd(
+                                          p.means2d, p.conics, s.colors, opacities, c10::nullopt, c10::nullopt,
+                                          s.width, s.height, kTileSize, b.offsets, b.flatten_ids,
+                                          alphas, last_ids, v_colors, v_alphas, false);
+                                  } else {
+                                      cpu::rasterize_to_pixels_bwd(p.means2d, p.conics, s.colors, opacities, torch::Tensor(),
+                                                                   s.width, s.height, kTileSize, b.offsets, b.flatten_ids,
+                                                                   alphas, last_ids, v_colors, v_alphas);
+                                  }
+                              });
+                          }});
+
+        stages.push_back({"quat_scale_to_covar", UsesGaussians, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters&) {
+                              const auto scene = make_scene({config.num_gaussians, 64, 64, 0}, device_of(cuda));
+                              const auto quats = scene.quats, scales = scene.scales;
+                              return std::function<void()>([quats, scales, cuda] {
+                                  if (cuda) {
+                                      gsplat::quat_scale_to_covar_preci_fwd(quats, scales, true, false, false);
+                                  } else {
+                                      cpu::quat_scale_to_covar(quats, scales);
+                                  }
+                              });
+                          }});
+
+        stages.push_back({"relocation", UsesGaussians, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters&) {
+                              torch::manual_seed(0);
+                              const auto device = device_of(cuda);
+                              const int64_t n = config.num_gaussians;
+                              const auto opacities = (torch::rand({n}) * 0.8f + 0.1f).to(device);
+                              const auto scales = (torch::rand({n, 3}) * 0.5f + 0.1f).to(device);
+                              const auto ratios = torch::randint(1, kBinomMax, {n}, torch::kInt32).to(device);
+                              const auto binoms = binomials(device);
+                              return std::function<void()>([opacities, scales, ratios, binoms, cuda] {
+                                  if (cuda) {
+                                      gsplat::relocation(opacities, scales, ratios, binoms, kBinomMax);
+                                  } else {
+                                      cpu::relocation(opacities, scales, ratios, binoms, kBinomMax);
+                                  }
+                              });
+                          }});
+
+        // All parameters of a Gaussian in one [N, D] tensor. The CUDA path is the
+        // fused kernel behind SelectiveAdam, the CPU path torch's Adam.
+        stages.push_back({"adam", UsesGaussians | UsesShDegree, true, true,
+                          [](const BenchConfig& config, bool cuda, Stage::Counters& counters) {
+                              torch::manual_seed(0);
+                              const auto device = device_of(cuda);
+                              const int64_t D = 14 + 3 * SplatData::shN_coeffs(config.sh_degree);
+                              counters["params"] = static_cast<double>(config.num_gaussians * D);
+                              auto param = torch::randn({config.num_gaussians, D}).to(device);
+                              const auto grad = torch::randn_like(param) * 1e-3f;
+                              if (cuda) {
+                                  auto exp_avg = torch::zeros_like(param);
+                                  auto exp_avg_sq = torch::zeros_like(param);
+                                  return std::function<void()>([param, grad, exp_avg, exp_avg_sq]() mutable {
+                                      gsplat::adam(param, grad, exp_avg, exp_avg_sq, c10::nullopt, 1e-3f, 0.9f, 0.999f, 1e-15f);
+                                  });
+                              }
+                              param.set_requires_grad(true);
+                              param.mutable_grad() = grad;
+                              auto optimizer = std::make_shared<torch::optim::Adam>(
+                                  std::vector<torch::Tensor>{param}, torch::optim::AdamOptions(1e-3).eps(1e-15));
+                              return std::function<void()>([optimizer] { optimizer->step(); });
+                          }});
+
+        stages.push_back({"colmap_parse", UsesGaussians, false, true,
+                          [](const BenchConfig& config, bool, Stage::Counters& counters) {
+                              const auto dir = scratch_dir("colmap");
+                              write_colmap_model(dir, config.num_gaussians);
+                              counters["images"] = kColmapImages;
+                              counters["file_bytes"] = static_cast<double>(
+                                  std::filesystem::file_size(dir / "sparse/0/images.bin") +
+                                  std::filesystem::file_size(dir / "sparse/0/points3D.bin"));
+                              return std::function<void()>([dir] {
+                                  QuietCout quiet;
+                                  read_colmap_cameras_and_images(dir);
+                                  read_colmap_point_cloud(dir);
+                              });
+                          }});
+
+        stages.push_back({"image_decode_jpeg", UsesResolution, false, true,
+                          image_decode(image_io::ImageFormat::JPEG, "jpeg")});
+        stages.push_back({"image_decode_png", UsesResolution, false, true,
+                          image_decode(image_io::ImageFormat::PNG, "png")});
+
+        stages.push_back({"ply_write", UsesGaussians | UsesShDegree, false, true,
+                          [](const BenchConfig& config, bool, Stage::Counters& counters) {
+                              const auto scene = make_scene({config.num_gaussians, 64, 64, 0}, torch::kCPU);
+                              const int64_t n = config.num_gaussians;
+                              auto model = std::make_shared<SplatData>(
+                                  config.sh_degree,
+                                  scene.means,
+                                  torch::rand({n, 1, 3}),
+                                  torch::randn({n, SplatData::shN_coeffs(config.sh_degree), 3}) * 0.1f,
+                                  torch::log(scene.scales),
+                                  scene.quats,
+                                  torch::logit(scene.opacities).unsqueeze(-1),
+                                  1.0f);
+                              const auto dir = scratch_dir("ply");
+                              model->save_ply(dir, 0, /*join=*/true);
+                              counters["file_bytes"] = static_cast<double>(std::filesystem::file_size(dir / "splat_0.ply"));
+                              return std::function<void()>([model, dir] { model->save_ply(dir, 0, /*join=*/true); });
+                          }});
+
+        return stages;
+    }
+
+} // namespace gs::bench
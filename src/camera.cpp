@@ -13,7 +13,8 @@ static torch::Tensor world_to_view(const torch::Tensor& R, const torch::Tensor&
 
     Rt.index_put_({3, torch::indexing::Slice(0, 3)}, t);
 
-    auto pinned_options = torch::TensorOptions().dtype(torch::kFloat32).pinned_memory(true);
+    // Pinned memory needs a CUDA context; plain host memory keeps the CPU backend usable without a GPU
+    auto pinned_options = torch::TensorOptions().dtype(torch::kFloat32).pinned_memory(torch::cuda::is_available());
     return Rt.t().unsqueeze(0).to(pinned_options);
 }
 
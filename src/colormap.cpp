@@ -0,0 +1,169 @@
+#include "core/colormap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace image_io {
+
+    namespace {
+        using RGB = std::array<float, 3>;
+
+        // Piecewise-linear fit through nine evenly spaced samples of the
+        // matplotlib palettes
+        constexpr RGB kViridis[] = {
+            {68, 1, 84}, {71, 44, 122}, {59, 81, 139}, {44, 113, 142}, {33, 145, 140}, {39, 173, 129}, {92, 200, 99}, {170, 220, 50}, {253, 231, 37}};
+        constexpr RGB kInferno[] = {
+            {0, 0, 4}, {31, 12, 72}, {85, 15, 109}, {136, 34, 106}, {186, 54, 85}, {227, 89, 51}, {249, 140, 10}, {249, 201, 50}, {252, 255, 164}};
+
+        RGB sample_anchors(const RGB (&anchors)[9], float t) {
+            const float pos = t * 8.0f;
+            const int i = std::min(static_cast<int>(pos), 7);
+            const float f = pos - static_cast<float>(i);
+            RGB rgb;
+            for (int c = 0; c < 3; ++c) {
+                rgb[c] = (anchors[i][c] + f * (anchors[i + 1][c] - anchors[i][c])) / 255.0f;
+            }
+            return rgb;
+        }
+
+        // Same breakpoints as the previous mask-based implementation
+        RGB jet(float t) {
+            if (t < 0.25f)
+                return {0.0f, 4.0f * t, 1.0f};
+            if (t < 0.5f)
+                return {0.0f, 1.0f, 1.0f - 4.0f * (t - 0.25f)};
+            if (t < 0.75f)
+                return {4.0f * (t - 0.5f), 1.0f, 0.0f};
+            return {1.0f, 1.0f - 4.0f * (t - 0.75f), 0.0f};
+        }
+
+        // Polynomial approximation of Google's Turbo
+        RGB turbo(float t) {
+            const double x = t;
+            const double r = 0.13572138 + x * (4.61539260 + x * (-42.66032258 + x * (132.13108234 + x * (-152.94239396 + x * 59.28637943))));
+            const double g = 0.09140261 + x * (2.19418839 + x * (4.84296658 + x * (-14.18503333 + x * (4.27729857 + x * 2.82956604))));
+            const double b = 0.10667330 + x * (12.64194608 + x * (-60.58204836 + x * (110.36276771 + x * (-89.90310912 + x * 27.34824973))));
+            return {static_cast<float>(r), static_cast<float>(g), static_cast<float>(b)};
+        }
+
+        RGB sample(Colormap colormap, float t) {
+            switch (colormap) {
+            case Colormap::Jet: return jet(t);
+            case Colormap::Turbo: return turbo(t);
+            case Colormap::Viridis: return sample_anchors(kViridis, t);
+            case Colormap::Inferno: return sample_anchors(kInferno, t);
+            case Colormap::Gray: return {t, t, t};
+            }
+            return {t, t, t};
+        }
+
+        ColormapLUT build_lut(Colormap colormap) {
+            ColormapLUT lut;
+            for (int i = 0; i < 256; ++i) {
+                const auto rgb = sample(colormap, static_cast<float>(i) / 255.0f);
+                for (int c = 0; c < 3; ++c) {
+                    lut[i][c] = static_cast<uint8_t>(std::lround(std::clamp(rgb[c], 0.0f, 1.0f) * 255.0f));
+                }
+            }
+            return lut;
+        }
+
+        constexpr int kChunk = 256;
+    } // namespace
+
+    Colormap colormap_from_string(const std::string& name) {
+        if (name == "jet")
+            return Colormap::Jet;
+        if (name == "turbo")
+            return Colormap::Turbo;
+        if (name == "viridis")
+            return Colormap::Viridis;
+        if (name == "inferno")
+            return Colormap::Inferno;
+        if (name == "gray")
+            return Colormap::Gray;
+        throw std::invalid_argument("Unknown colormap: " + name);
+    }
+
+    std::string to_string(Colormap colormap) {
+        switch (colormap) {
+        case Colormap::Jet: return "jet";
+        case Colormap::Turbo: return "turbo";
+        case Colormap::Viridis: return "viridis";
+        case Colormap::Inferno: return "inferno";
+        case Colormap::Gray: return "gray";
+        }
+        return "unknown";
+    }
+
+    const ColormapLUT& colormap_lut(Colormap colormap) {
+        // Function-local statics are initialized once, even with concurrent callers
+        static const ColormapLUT jet_lut = build_lut(Colormap::Jet);
+        static const ColormapLUT turbo_lut = build_lut(Colormap::Turbo);
+        static const ColormapLUT viridis_lut = build_lut(Colormap::Viridis);
+        static const ColormapLUT inferno_lut = build_lut(Colormap::Inferno);
+        static const ColormapLUT gray_lut = build_lut(Colormap::Gray);
+        switch (colormap) {
+        case Colormap::Jet: return jet_lut;
+        case Colormap::Turbo: return turbo_lut;
+        case Colormap::Viridis: return viridis_lut;
+        case Colormap::Inferno: return inferno_lut;
+        case Colormap::Gray: return gray_lut;
+        }
+        return gray_lut;
+    }
+
+    std::pair<float, float> finite_range(const float* values, size_t count) {
+        float lo = std::numeric_limits<float>::infinity();
+        float hi = -std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < count; ++i) {
+            const float v = values[i];
+            if (std::isfinite(v)) {
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+            }
+        }
+        return lo <= hi ? std::make_pair(lo, hi) : std::make_pair(0.0f, 0.0f);
+    }
+
+    void apply_colormap(const float* values,
+                        int height,
+                        int width,
+                        float lo,
+                        float hi,
+                        Colormap colormap,
+                        uint8_t* out,
+                        size_t out_row_stride) {
+        if (height < 0 || width < 0) {
+            throw std::invalid_argument("apply_colormap: negative image size");
+        }
+        if (width > 0 && out_row_stride < static_cast<size_t>(width) * 3) {
+            throw std::invalid_argument("apply_colormap: row stride is smaller than a row");
+        }
+        const auto& lut = colormap_lut(colormap);
+        // A flat image maps to the first entry, as the old (max - min).clamp_min(1e-10) did
+        const float scale = hi > lo ? 255.0f / (hi - lo) : 0.0f;
+
+        int32_t index[kChunk];
+        for (int y = 0; y < height; ++y) {
+            const float* row = values + static_cast<size_t>(y) * width;
+            uint8_t* dst = out + static_cast<size_t>(y) * out_row_stride;
+            for (int x0 = 0; x0 < width; x0 += kChunk) {
+                const int n = std::min(kChunk, width - x0);
+                // Branch-free: max(0, NaN) is 0, so NaN lands on the first entry
+                for (int i = 0; i < n; ++i) {
+                    float t = (row[x0 + i] - lo) * scale + 0.5f;
+                    t = std::min(255.0f, std::max(0.0f, t));
+                    index[i] = static_cast<int32_t>(t);
+                }
+                uint8_t* px = dst + static_cast<size_t>(x0) * 3;
+                for (int i = 0; i < n; ++i) {
+                    std::memcpy(px + 3 * i, lut[index[i]].data(), 3);
+                }
+            }
+        }
+    }
+
+} // namespace image_io
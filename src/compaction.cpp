@@ -0,0 +1,98 @@
+#include "core/compaction.hpp"
+#include "core/contribution_stats.hpp"
+#include "core/rasterizer.hpp"
+#include "core/strategy_utils.hpp"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace gs {
+
+    namespace {
+        // Number of views timed for the render speed report
+        constexpr size_t kTimedViews = 8;
+
+        void synchronize(const torch::Device& device) {
+            if (device.is_cuda()) {
+                torch::cuda::synchronize(device.index());
+            }
+        }
+    } // namespace
+
+    torch::Tensor contribution_scores(SplatData& model, const std::vector<Camera*>& views, int tile_size) {
+        torch::NoGradGuard no_grad;
+        ContributionStats stats;
+        stats.enable(model.size(), model.means().device());
+        ContributionStats::Scope scope(&stats);
+
+        auto bg = torch::zeros({3}, model.means().options().requires_grad(false));
+        for (Camera* view : views) {
+            rasterize(*view, model, bg, 1.0f, false, false, RenderMode::RGB, nullptr, tile_size);
+        }
+        return stats.weight_sum();
+    }
+
+    torch::Tensor low_contribution_mask(const SplatData& model, const torch::Tensor& scores,
+                                        float min_opacity, float min_weight) {
+        torch::NoGradGuard no_grad;
+        TORCH_CHECK(scores.dim() == 1 && scores.size(0) == model.size(),
+                    "scores must be [N] with N = ", model.size(), ", got ", scores.sizes());
+        const auto opacities = model.get_opacity().reshape({-1});
+        return (opacities <= min_opacity) | (scores.to(opacities.device()) < min_weight);
+    }
+
+    double mean_render_ms(SplatData& model, const std::vector<Camera*>& views, int tile_size) {
+        if (views.empty()) {
+            return 0.0;
+        }
+        torch::NoGradGuard no_grad;
+        const auto device = model.means().device();
+        auto bg = torch::zeros({3}, model.means().options().requires_grad(false));
+        const size_t n = std::min(views.size(), kTimedViews);
+
+        // One untimed render to warm up kernels and the allocator
+        rasterize_inference(*views[0], model, bg, 1.0f, RenderMode::RGB, nullptr, nullptr, tile_size);
+        synchronize(device);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            rasterize_inference(*views[i], model, bg, 1.0f, RenderMode::RGB, nullptr, nullptr, tile_size);
+        }
+        synchronize(device);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::milli>(elapsed).count() / static_cast<double>(n);
+    }
+
+    std::string CompactionReport::to_string() const {
+        const auto ratio = [](double before, double after) { return before > 0.0 ? after / before : 1.0; };
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(2)
+           << "Compaction: " << gaussians_before << " -> " << gaussians_after << " Gaussians ("
+           << 100.0 * ratio(gaussians_before, gaussians_after) << "%), "
+           << bytes_before / 1048576.0 << " -> " << bytes_after / 1048576.0 << " MB, render "
+           << render_ms_before << " -> " << render_ms_after << " ms/view";
+        return ss.str();
+    }
+
+    CompactionReport compact(IStrategy& strategy, const std::vector<Camera*>& views,
+                             float min_opacity, float min_weight, int tile_size) {
+        auto& model = strategy.get_model();
+
+        CompactionReport report;
+        report.gaussians_before = model.size();
+        report.bytes_before = static_cast<size_t>(strategy::parameter_bytes(model));
+        report.render_ms_before = mean_render_ms(model, views, tile_size);
+
+        const auto scores = contribution_scores(model, views, tile_size);
+        const auto mask = low_contribution_mask(model, scores, min_opacity, min_weight);
+        if (mask.any().item<bool>()) {
+            strategy.remove_gaussians(mask);
+        }
+
+        report.gaussians_after = model.size();
+        report.bytes_after = static_cast<size_t>(strategy::parameter_bytes(model));
+        report.render_ms_after = mean_render_ms(model, views, tile_size);
+        return report;
+    }
+
+} // namespace gs
@@ -0,0 +1,109 @@
+#include "core/contribution_stats.hpp"
+#include <stdexcept>
+
+namespace gs {
+
+    namespace {
+        thread_local ContributionStats* current_stats = nullptr;
+    } // namespace
+
+    ContributionStats::Scope::Scope(ContributionStats* stats)
+        : previous_(current_stats) {
+        current_stats = stats;
+    }
+
+    ContributionStats::Scope::~Scope() {
+        current_stats = previous_;
+    }
+
+    ContributionStats* ContributionStats::current() {
+        return current_stats;
+    }
+
+    void ContributionStats::enable(int64_t n, const torch::Device& device) {
+        const auto options = torch::TensorOptions().device(device);
+        weight_sum_ = torch::zeros({n}, options.dtype(torch::kFloat32));
+        hit_count_ = torch::zeros({n}, options.dtype(torch::kInt64));
+        last_visible_ = torch::full({n}, -1, options.dtype(torch::kInt32));
+    }
+
+    void ContributionStats::disable() {
+        weight_sum_ = torch::Tensor();
+        hit_count_ = torch::Tensor();
+        last_visible_ = torch::Tensor();
+    }
+
+    torch::Tensor ContributionStats::weight_buffer(int64_t n) const {
+        return size() == n ? weight_sum_ : torch::Tensor();
+    }
+
+    torch::Tensor ContributionStats::hit_buffer(int64_t n) const {
+        return size() == n ? hit_count_ : torch::Tensor();
+    }
+
+    void ContributionStats::mark_visible(const torch::Tensor& visibility, int iter) {
+        if (!enabled() || visibility.numel() != size()) {
+            return;
+        }
+        torch::NoGradGuard no_grad;
+        last_visible_.masked_fill_(visibility.reshape({-1}).to(last_visible_.device()), iter);
+    }
+
+    void ContributionStats::select(const torch::Tensor& indices) {
+        if (!enabled()) {
+            return;
+        }
+        const auto idx = indices.to(weight_sum_.device());
+        weight_sum_ = weight_sum_.index_select(0, idx);
+        hit_count_ = hit_count_.index_select(0, idx);
+        last_visible_ = last_visible_.index_select(0, idx);
+    }
+
+    void ContributionStats::append(int64_t n) {
+        if (!enabled() || n <= 0) {
+            return;
+        }
+        weight_sum_ = torch::cat({weight_sum_, torch::zeros({n}, weight_sum_.options())});
+        hit_count_ = torch::cat({hit_count_, torch::zeros({n}, hit_count_.options())});
+        last_visible_ = torch::cat({last_visible_, torch::full({n}, -1, last_visible_.options())});
+    }
+
+    void ContributionStats::reset(const torch::Tensor& indices) {
+        if (!enabled()) {
+            return;
+        }
+        const auto idx = indices.to(weight_sum_.device());
+        weight_sum_.index_fill_(0, idx, 0.0);
+        hit_count_.index_fill_(0, idx, 0);
+        last_visible_.index_fill_(0, idx, -1);
+    }
+
+    ContributionStats ContributionStats::cpu() const {
+        ContributionStats copy;
+        if (enabled()) {
+            copy.weight_sum_ = weight_sum_.cpu();
+            copy.hit_count_ = hit_count_.cpu();
+            copy.last_visible_ = last_visible_.cpu();
+        }
+        return copy;
+    }
+
+    void ContributionStats::save(const std::filesystem::path& path) const {
+        if (!enabled()) {
+            throw std::runtime_error("No contribution stats to save");
+        }
+        torch::save(std::vector<torch::Tensor>{weight_sum_.cpu(), hit_count_.cpu(), last_visible_.cpu()}, path.string());
+    }
+
+    void ContributionStats::load(const std::filesystem::path& path, const torch::Device& device) {
+        std::vector<torch::Tensor> tensors;
+        torch::load(tensors, path.string());
+        if (tensors.size() != 3 || tensors[0].size(0) != tensors[1].size(0) || tensors[0].size(0) != tensors[2].size(0)) {
+            throw std::runtime_error("Malformed contribution stats file: " + path.string());
+        }
+        weight_sum_ = tensors[0].to(device);
+        hit_count_ = tensors[1].to(device);
+        last_visible_ = tensors[2].to(device);
+    }
+
+} // namespace gs
@@ -0,0 +1,72 @@
+#include "core/convergence_monitor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace gs {
+
+    ConvergenceMonitor::ConvergenceMonitor(Config config)
+        : config_(config) {
+        if (config_.check_every <= 0) {
+            throw std::invalid_argument("ConvergenceMonitor: check_every must be positive");
+        }
+        if (config_.patience <= 0) {
+            throw std::invalid_argument("ConvergenceMonitor: patience must be positive");
+        }
+    }
+
+    void ConvergenceMonitor::observe_loss(float loss) {
+        if (!std::isfinite(loss)) {
+            return;
+        }
+        // Bias-corrected EMA, so early values are not pulled towards zero
+        loss_ema_ = config_.loss_smoothing * loss_ema_ + (1.0 - config_.loss_smoothing) * loss;
+        ++loss_count_;
+    }
+
+    double ConvergenceMonitor::smoothed_loss_db() const {
+        if (loss_count_ == 0) {
+            return 0.0;
+        }
+        const double correction = 1.0 - std::pow(config_.loss_smoothing, loss_count_);
+        const double loss = loss_ema_ / std::max(correction, 1e-12);
+        return -10.0 * std::log10(std::max(loss, 1e-12));
+    }
+
+    bool ConvergenceMonitor::is_check(int iter) const {
+        return iter > 0 && iter % config_.check_every == 0;
+    }
+
+    bool ConvergenceMonitor::check(int iter, double score_db) {
+        last_iter_ = iter;
+        last_db_ = score_db;
+        if (gain_iter_ < 0 || score_db >= best_db_ + config_.min_gain_db) {
+            best_db_ = score_db;
+            gain_iter_ = iter;
+            stale_ = 0;
+        } else {
+            // Small gains still move the reference up, so a slow climb is not
+            // mistaken for a regression later on
+            best_db_ = std::max(best_db_, score_db);
+            ++stale_;
+        }
+        converged_ = stale_ >= config_.patience && iter >= config_.min_iterations;
+        return converged_;
+    }
+
+    std::string ConvergenceMonitor::summary() const {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(2);
+        if (converged_) {
+            ss << "converged at " << last_iter_ << ": ";
+        } else {
+            ss << "check at " << last_iter_ << ": ";
+        }
+        ss << last_db_ << " dB, best " << best_db_ << " dB, last gain of " << config_.min_gain_db
+           << " dB at " << gain_iter_ << " (" << stale_ << "/" << config_.patience << " checks without)";
+        return ss.str();
+    }
+
+} // namespace gs
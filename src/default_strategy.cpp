@@ -0,0 +1,255 @@
+#include "core/default_strategy.hpp"
+#include "core/parameters.hpp"
+#include "core/rasterizer.hpp"
+#include "core/rasterizer_cpu.hpp"
+#include "core/selective_adam.hpp"
+#include <ATen/Context.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    // Rows of t at idx, repeated n times along dim 0
+    torch::Tensor repeat_rows(const torch::Tensor& t, const torch::Tensor& idx, int64_t n) {
+        std::vector<int64_t> reps(t.dim(), 1);
+        reps[0] = n;
+        return t.index_select(0, idx).repeat(reps);
+    }
+
+    // Zero optimizer state for n appended rows
+    torch::Tensor zero_rows(const torch::Tensor& v, int64_t n) {
+        auto shape = v.sizes().vec();
+        shape[0] = n;
+        return torch::zeros(shape, v.options());
+    }
+} // namespace
+
+DefaultStrategy::DefaultStrategy(SplatData&& splat_data, torch::Device device)
+    : _splat_data(std::move(splat_data)),
+      _device(device) {
+}
+
+void DefaultStrategy::update_state(const gs::RenderOutput& render_output) {
+    torch::NoGradGuard no_grad;
+    const auto n = _splat_data.size();
+    if (!_grad2d.defined() || _grad2d.size(0) != n) {
+        _grad2d = torch::zeros({n}, _splat_data.means().options());
+        _count = torch::zeros({n}, _splat_data.means().options());
+    }
+
+    const auto& means2d = render_output.means2d;
+    if (!means2d.defined() || !means2d.grad().defined()) {
+        return;
+    }
+
+    // Gradients w.r.t. NDC-like coordinates, so the threshold does not depend on resolution
+    auto grads = means2d.grad().reshape({-1, 2}).clone();
+    grads.select(-1, 0).mul_(render_output.width / 2.0f);
+    grads.select(-1, 1).mul_(render_output.height / 2.0f);
+
+    const auto visible = (render_output.radii.reshape({-1}) > 0).nonzero().squeeze(-1);
+    _grad2d.index_add_(0, visible, grads.index_select(0, visible).norm(2, -1));
+    _count.index_add_(0, visible, torch::ones({visible.size(0)}, _count.options()));
+}
+
+void DefaultStrategy::duplicate(const torch::Tensor& mask) {
+    const auto sel = mask.nonzero().squeeze(-1);
+    gs::strategy::update_param_with_optimizer(
+        _splat_data, *_optimizer,
+        [&sel](int, const torch::Tensor& p) {
+            return torch::cat({p, p.index_select(0, sel)}, 0);
+        },
+        [&sel](int, const torch::Tensor& v) {
+            return torch::cat({v, zero_rows(v, sel.size(0))}, 0);
+        });
+    _splat_data.contribution_stats().append(sel.size(0));
+    if (_last_visibility_mask.defined()) {
+        _last_visibility_mask = torch::cat({_last_visibility_mask, _last_visibility_mask.index_select(0, sel)});
+    }
+}
+
+void DefaultStrategy::split(const torch::Tensor& mask) {
+    const auto sel = mask.nonzero().squeeze(-1);
+    const auto rest = (~mask).nonzero().squeeze(-1);
+    const int64_t n_split = sel.size(0);
+
+    // Two samples per split Gaussian, drawn from the Gaussian itself
+    const auto scales = _splat_data.get_scaling().index_select(0, sel);                    // [S, 3]
+    const auto rotmats = gs::cpu::quat_to_rotmat(_splat_data.rotation_raw().index_select(0, sel)); // [S, 3, 3]
+    const auto noise = torch::randn({2, n_split, 3}, _generator, scales.options());
+    const auto samples = torch::einsum("nij,nj,bnj->bni", {rotmats, scales, noise}).reshape({-1, 3}); // [2S, 3]
+
+    gs::strategy::update_param_with_optimizer(
+        _splat_data, *_optimizer,
+        [&](int group, const torch::Tensor& p) {
+            torch::Tensor added;
+            if (group == gs::strategy::Means) {
+                added = p.index_select(0, sel).repeat({2, 1}) + samples;
+            } else if (group == gs::strategy::Scaling) {
+                added = torch::log(scales / 1.6f).repeat({2, 1});
+            } else {
+                added = repeat_rows(p, sel, 2);
+            }
+            return torch::cat({p.index_select(0, rest), added}, 0);
+        },
+        [&](int, const torch::Tensor& v) {
+            return torch::cat({v.index_select(0, rest), zero_rows(v, 2 * n_split)}, 0);
+        });
+    _splat_data.contribution_stats().select(rest);
+    _splat_data.contribution_stats().append(2 * n_split);
+    if (_last_visibility_mask.defined()) {
+        _last_visibility_mask = torch::cat({_last_visibility_mask.index_select(0, rest),
+                                            _last_visibility_mask.index_select(0, sel).repeat({2})});
+    }
+}
+
+void DefaultStrategy::remove_gaussians(const torch::Tensor& mask) {
+    const auto keep = (~mask).nonzero().squeeze(-1);
+    const auto select = [&keep](int, const torch::Tensor& t) { return t.index_select(0, keep); };
+    gs::strategy::update_param_with_optimizer(_splat_data, *_optimizer, select, select);
+    _splat_data.contribution_stats().select(keep);
+
+    // Accumulated statistics no longer match the rows; the visibility mask
+    // follows them, since step() runs after the prune
+    _grad2d = torch::Tensor();
+    _count = torch::Tensor();
+    if (_last_visibility_mask.defined()) {
+        _last_visibility_mask = _last_visibility_mask.index_select(0, keep);
+    }
+}
+
+void DefaultStrategy::report_memory(gs::MemoryReport& report) const {
+    gs::strategy::report_model_memory(_splat_data, *_optimizer, report);
+    for (const auto& [name, tensor] : {std::pair{"grad2d", &_grad2d},
+                                       std::pair{"count", &_count},
+                                       std::pair{"visibility mask", &_last_visibility_mask}}) {
+        if (tensor->defined()) {
+            report.add(gs::memory_category::StrategyState, name, static_cast<int64_t>(tensor->nbytes()));
+        }
+    }
+}
+
+std::pair<int, int> DefaultStrategy::grow_gs() {
+    torch::NoGradGuard no_grad;
+    if (!_grad2d.defined() || _grad2d.size(0) != _splat_data.size()) {
+        return {0, 0};
+    }
+
+    const auto avg_grad = _grad2d / _count.clamp_min(1);
+    const auto is_grad_high = avg_grad > _params->grad_threshold;
+    const auto max_scale = std::get<0>(_splat_data.get_scaling().max(-1));
+    const auto is_small = max_scale <= _params->grow_scale3d * _splat_data.get_scene_scale();
+
+    const auto is_dupli = is_grad_high & is_small;
+    const int n_dupli = is_dupli.sum().item<int>();
+    auto is_split = is_grad_high & ~is_small;
+    const int n_split = is_split.sum().item<int>();
+
+    if (n_dupli > 0) {
+        duplicate(is_dupli);
+        // Duplicates are appended and never split in the same round
+        is_split = torch::cat({is_split, torch::zeros({n_dupli}, is_split.options())});
+    }
+    if (n_split > 0) {
+        split(is_split);
+    }
+    return {n_dupli, n_split};
+}
+
+int DefaultStrategy::prune_gs(int iter) {
+    torch::NoGradGuard no_grad;
+    auto is_prune = _splat_data.get_opacity().reshape({-1}) < _params->min_opacity;
+    if (iter > static_cast<int>(_params->opacity_reset_every)) {
+        const auto max_scale = std::get<0>(_splat_data.get_scaling().max(-1));
+        is_prune = is_prune | (max_scale > _params->prune_scale3d * _splat_data.get_scene_scale());
+    }
+
+    const int n_prune = is_prune.sum().item<int>();
+    if (n_prune > 0) {
+        remove_gaussians(is_prune);
+    }
+    return n_prune;
+}
+
+void DefaultStrategy::reset_opacity() {
+    const float max_logit = std::log(2.0f * _params->min_opacity / (1.0f - 2.0f * _params->min_opacity));
+    gs::strategy::update_param_with_optimizer(
+        _splat_data, *_optimizer,
+        [max_logit](int, const torch::Tensor& p) { return torch::clamp_max(p, max_logit); },
+        [](int, const torch::Tensor& v) { return torch::zeros_like(v); },
+        {gs::strategy::Opacity});
+}
+
+void DefaultStrategy::post_backward(int iter, gs::RenderOutput& render_output) {
+    // Store visibility mask for selective adam
+    if (_params->selective_adam) {
+        _last_visibility_mask = render_output.visibility;
+    }
+
+    // Increment SH degree every 1000 iterations
+    torch::NoGradGuard no_grad;
+    if (iter % _params->sh_degree_interval == 0) {
+        gs::strategy::increment_sh_degree(_splat_data, *_optimizer);
+    }
+
+    if (iter >= static_cast<int>(_params->stop_refine)) {
+        return;
+    }
+
+    update_state(render_output);
+
+    if (is_refining(iter)) {
+        grow_gs();
+        prune_gs(iter);
+
+        // Statistics restart after every refinement
+        _grad2d = torch::Tensor();
+        _count = torch::Tensor();
+
+        if (_device.is_cuda()) {
+            c10::cuda::CUDACachingAllocator::emptyCache();
+        }
+    }
+
+    if (iter > 0 && iter % _params->opacity_reset_every == 0) {
+        reset_opacity();
+    }
+}
+
+void DefaultStrategy::step(int iter) {
+    if (iter < _params->iterations) {
+        if (auto* selective_adam = dynamic_cast<gs::SelectiveAdam*>(_optimizer.get())) {
+            // Without a mask of the current size every Gaussian counts as visible
+            const auto n = _splat_data.size();
+            if (_last_visibility_mask.defined() && _last_visibility_mask.size(0) == n) {
+                selective_adam->step(_last_visibility_mask);
+            } else {
+                selective_adam->step(torch::ones({n}, torch::TensorOptions().dtype(torch::kBool).device(_device)));
+            }
+        } else {
+            _optimizer->step();
+        }
+        _optimizer->zero_grad(true);
+        _scheduler->step();
+    }
+}
+
+void DefaultStrategy::initialize(const gs::param::OptimizationParameters& optimParams) {
+    _params = std::make_unique<const gs::param::OptimizationParameters>(optimParams);
+
+    gs::strategy::to_device(_splat_data, _device);
+
+    // Private generator for the split samples
+    _generator = at::globalContext().defaultGenerator(_device).clone();
+    _generator.set_current_seed(static_cast<uint64_t>(_params->seed));
+
+    _optimizer = gs::strategy::create_optimizer(_splat_data, *_params);
+
+    _scheduler = gs::strategy::create_scheduler(*_optimizer, *_params);
+}
+
+bool DefaultStrategy::is_refining(int iter) const {
+    return (iter < _params->stop_refine &&
+            iter > _params->start_refine &&
+            iter % _params->refine_every == 0);
+}
@@ -0,0 +1,91 @@
+#include "core/offline_eval.hpp"
+#include <args.hxx>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// Scores a trained PLY on the test split of its COLMAP dataset and writes the
+// quality, render timing and memory figures as JSON.
+int main(int argc, char* argv[]) {
+    ::args::ArgumentParser parser(
+        "Offline evaluation of a trained 3D Gaussian Splatting model\n",
+        "Renders the held-out views and reports PSNR/SSIM/LPIPS, render FPS and peak memory as JSON.");
+    ::args::HelpFlag help(parser, "help", "Display help menu", {'h', "help"});
+    ::args::ValueFlag<std::string> ply_path(parser, "ply", "Path to the trained model (.ply)", {'p', "ply"});
+    ::args::ValueFlag<std::string> data_path(parser, "data_path", "Path to the COLMAP dataset", {'d', "data-path"});
+    ::args::ValueFlag<std::string> output(parser, "output", "JSON report path (default: <ply>_eval.json next to the PLY)", {'o', "output"});
+    ::args::ValueFlag<std::string> images(parser, "images", "Images folder name", {"images"});
+    ::args::ValueFlag<int> resolution(parser, "resolution", "Set resolution", {'r', "resolution"});
+    ::args::ValueFlag<int> test_every(parser, "test_every", "Every N-th image is a test image", {"test-every"});
+    ::args::ValueFlag<std::string> render_mode(parser, "render_mode", "Render mode: RGB, RGB_D, RGB_ED", {"render-mode"});
+    ::args::ValueFlag<int> warmup(parser, "warmup", "Untimed renders before measuring", {"warmup"});
+    ::args::ValueFlag<int> repeats(parser, "repeats", "Timed renders per view", {"repeats"});
+    ::args::ValueFlag<int> tile_size(parser, "tile_size", "Rasterization tile size", {"tile-size"});
+    ::args::Flag all_views(parser, "all_views", "Evaluate all views, not only the test split", {"all-views"});
+    ::args::ValueFlag<std::string> lpips_precision(parser, "lpips_precision", "LPIPS precision: fp32, fp16, bf16", {"lpips-precision"});
+    ::args::Flag no_lpips(parser, "no_lpips", "Skip LPIPS (no weights needed)", {"no-lpips"});
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const ::args::Help&) {
+        std::cout << parser;
+        return 0;
+    } catch (const ::args::ParseError& e) {
+        std::cerr << "ERROR: " << e.what() << "\n\n"
+                  << parser;
+        return -1;
+    }
+
+    if (!ply_path || !data_path) {
+        std::cerr << "ERROR: Both --ply and --data-path are required\n\n"
+                  << parser;
+        return -1;
+    }
+
+    try {
+        gs::metrics::OfflineEvalConfig config;
+        config.ply_path = ::args::get(ply_path);
+        config.dataset.data_path = ::args::get(data_path);
+        if (images)
+            config.dataset.images = ::args::get(images);
+        if (resolution)
+            config.dataset.resolution = ::args::get(resolution);
+        if (test_every)
+            config.dataset.test_every = ::args::get(test_every);
+        if (render_mode)
+            config.render_mode = ::args::get(render_mode);
+        if (warmup)
+            config.warmup_frames = ::args::get(warmup);
+        if (repeats)
+            config.timing_repeats = ::args::get(repeats);
+        if (tile_size)
+            config.tile_size = ::args::get(tile_size);
+        config.all_views = static_cast<bool>(all_views);
+        config.compute_lpips = !no_lpips;
+        if (lpips_precision)
+            config.lpips_precision = ::args::get(lpips_precision);
+
+        std::filesystem::path report_path = config.ply_path.parent_path() / (config.ply_path.stem().string() + "_eval.json");
+        if (output)
+            report_path = ::args::get(output);
+
+        const auto result = gs::metrics::run_offline_eval(config);
+        std::ofstream file(report_path);
+        if (!file) {
+            throw std::runtime_error("Failed to open " + report_path.string());
+        }
+        file << result.to_json().dump(2) << std::endl;
+        std::cout << "Evaluation report saved to: " << report_path << std::endl;
+
+        // Per-view rows for metrics_diff; replaced rather than appended on each run
+        const auto views_path = report_path.parent_path() / (report_path.stem().string() + "_views.csv");
+        std::filesystem::remove(views_path);
+        gs::metrics::append_per_view_csv(views_path, result.view_records());
+        std::cout << "Per-view metrics saved to: " << views_path << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
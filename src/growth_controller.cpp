@@ -0,0 +1,144 @@
+#include "core/growth_controller.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gs {
+
+    GrowthMode growth_mode_from_string(const std::string& name) {
+        if (name == "fixed")
+            return GrowthMode::Fixed;
+        if (name == "vram")
+            return GrowthMode::MemoryBudget;
+        if (name == "step_time")
+            return GrowthMode::StepTimeBudget;
+        if (name == "count")
+            return GrowthMode::FinalCount;
+        throw std::invalid_argument("Unknown growth mode '" + name + "'. Valid modes are: fixed, vram, step_time, count");
+    }
+
+    std::string to_string(GrowthMode mode) {
+        switch (mode) {
+        case GrowthMode::Fixed: return "fixed";
+        case GrowthMode::MemoryBudget: return "vram";
+        case GrowthMode::StepTimeBudget: return "step_time";
+        case GrowthMode::FinalCount: return "count";
+        }
+        return "unknown";
+    }
+
+    void GrowthController::LinearFit::add(double n, double y) {
+        count += 1;
+        sn += n;
+        sy += y;
+        snn += n * n;
+        sny += n * y;
+        last_n = n;
+        last_y = y;
+    }
+
+    double GrowthController::LinearFit::slope() const {
+        if (count == 0 || last_n <= 0) {
+            return 0.0;
+        }
+        // Until the count has varied enough to fit, assume y is proportional to
+        // n, which overestimates the slope and so errs on the safe side
+        const double proportional = last_y / last_n;
+        const double var = snn - sn * sn / count;
+        if (count < 2 || var <= 1e-6 * snn) {
+            return proportional;
+        }
+        const double b = (sny - sn * sy / count) / var;
+        return b > 0.0 ? b : proportional;
+    }
+
+    double GrowthController::LinearFit::intercept() const {
+        // Anchored at the latest sample, which reflects the current state best
+        return last_y - slope() * last_n;
+    }
+
+    double GrowthController::LinearFit::solve(double y_max) const {
+        const double b = slope();
+        if (b <= 0.0) {
+            return 0.0;
+        }
+        return std::max(0.0, (y_max - intercept()) / b);
+    }
+
+    GrowthController::GrowthController(Config config)
+        : config_(config) {
+        if (config_.max_rate < 0.0) {
+            throw std::invalid_argument("max_rate must be non-negative");
+        }
+        if (config_.mode == GrowthMode::MemoryBudget && config_.memory_budget_bytes <= 0.0) {
+            throw std::invalid_argument("vram growth mode needs a positive memory budget");
+        }
+        if (config_.mode == GrowthMode::StepTimeBudget && config_.step_time_budget_ms <= 0.0) {
+            throw std::invalid_argument("step_time growth mode needs a positive step time budget");
+        }
+    }
+
+    void GrowthController::observe(const GrowthSample& sample) {
+        if (sample.num_gaussians <= 0) {
+            return;
+        }
+        const auto n = static_cast<double>(sample.num_gaussians);
+        if (sample.peak_bytes > 0.0) {
+            memory_.add(n, sample.peak_bytes);
+        }
+        if (sample.step_ms > 0.0) {
+            time_.add(n, sample.step_ms);
+        }
+    }
+
+    GrowthDecision GrowthController::decide(int64_t current_n, int refines_left) const {
+        GrowthDecision decision;
+        const auto cap = config_.max_cap;
+        const auto rate_limit = static_cast<int64_t>(current_n * (1.0 + config_.max_rate));
+        bool budgeted = false;
+
+        switch (config_.mode) {
+        case GrowthMode::Fixed:
+            decision.limit = cap;
+            decision.reason = "fixed rate";
+            break;
+        case GrowthMode::FinalCount: {
+            // Equal relative growth at every remaining refine ends exactly at max_cap
+            const int steps = std::max(1, refines_left);
+            const double rate = std::pow(static_cast<double>(cap) / std::max<int64_t>(1, current_n), 1.0 / steps);
+            decision.limit = cap;
+            decision.n_new = static_cast<int64_t>(std::ceil(current_n * (rate - 1.0)));
+            decision.n_new = std::max<int64_t>(0, std::min(decision.n_new, cap - current_n));
+            decision.reason = "final count";
+            return decision;
+        }
+        case GrowthMode::MemoryBudget:
+        case GrowthMode::StepTimeBudget: {
+            const bool memory = config_.mode == GrowthMode::MemoryBudget;
+            const auto& fit = memory ? memory_ : time_;
+            if (fit.count == 0) {
+                // Nothing measured yet: grow at the base rate
+                decision.limit = cap;
+                decision.reason = "warm-up";
+                break;
+            }
+            const double budget = config_.safety * (memory ? config_.memory_budget_bytes : config_.step_time_budget_ms);
+            decision.limit = std::min<int64_t>(cap, static_cast<int64_t>(fit.solve(budget)));
+            decision.reason = memory ? "memory budget" : "step time budget";
+            budgeted = true;
+            break;
+        }
+        }
+
+        const int64_t target = std::min({decision.limit, rate_limit, cap});
+        decision.n_new = std::max<int64_t>(0, target - current_n);
+        if (budgeted && target == rate_limit && rate_limit < decision.limit) {
+            decision.reason = "max rate";
+        }
+        if (target == cap && current_n >= cap) {
+            decision.reason = "max cap";
+        }
+        return decision;
+    }
+
+} // namespace gs
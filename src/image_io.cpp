@@ -9,7 +9,9 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 // Existing implementations...
@@ -34,49 +36,12 @@ load_image(std::filesystem::path p, int res_div) {
 }
 
 void save_image(const std::filesystem::path& path, torch::Tensor image) {
-    // Clone to avoid modifying original
-    image = image.clone();
-
-    // Ensure CPU and float
-    image = image.to(torch::kCPU).to(torch::kFloat32);
-
-    // Handle different input formats
-    if (image.dim() == 4) { // [B, C, H, W] or [B, H, W, C]
-        image = image.squeeze(0);
-    }
-
-    // Convert [C, H, W] to [H, W, C]
-    if (image.dim() == 3 && image.size(0) <= 4) {
-        image = image.permute({1, 2, 0});
-    }
-
-    // Make contiguous after permute
-    image = image.contiguous();
-
-    int height = image.size(0);
-    int width = image.size(1);
-    int channels = image.size(2);
+    const auto rgb8 = image_io::to_rgb8(image);
 
     // Debug print
-    std::cout << "Saving image: " << path << " shape: [" << height << ", " << width << ", " << channels << "]\n";
+    std::cout << "Saving image: " << path << " shape: [" << rgb8.size(0) << ", " << rgb8.size(1) << ", " << rgb8.size(2) << "]\n";
 
-    // Convert to uint8
-    auto img_uint8 = (image.clamp(0, 1) * 255).to(torch::kUInt8).contiguous();
-
-    auto ext = path.extension().string();
-    bool success = false;
-
-    if (ext == ".png") {
-        success = stbi_write_png(path.string().c_str(), width, height, channels,
-                                 img_uint8.data_ptr<uint8_t>(), width * channels);
-    } else if (ext == ".jpg" || ext == ".jpeg") {
-        success = stbi_write_jpg(path.string().c_str(), width, height, channels,
-                                 img_uint8.data_ptr<uint8_t>(), 95);
-    }
-
-    if (!success) {
-        throw std::runtime_error("Failed to save image: " + path.string());
-    }
+    image_io::write_rgb8(path, rgb8);
 }
 
 void save_image(const std::filesystem::path& path,
@@ -86,103 +51,234 @@ void save_image(const std::filesystem::path& path,
     if (images.empty()) {
         throw std::runtime_error("No images provided");
     }
+    save_image(path, image_io::compose_rgb8(images, horizontal, separator_width));
+}
 
-    if (images.size() == 1) {
-        save_image(path, images[0]);
-        return;
-    }
+void free_image(unsigned char* img) {
+    stbi_image_free(img);
+}
 
-    // Prepare all images to same format
-    std::vector<torch::Tensor> processed_images;
-    for (auto img : images) {
-        // Clone to avoid modifying original
-        img = img.clone().to(torch::kCPU).to(torch::kFloat32);
+// Batch image saver implementation
+namespace image_io {
 
-        // Handle different input formats
-        if (img.dim() == 4) {
-            img = img.squeeze(0);
+    namespace {
+        // uint8 [H, W, C] on the image's own device
+        torch::Tensor to_rgb8_on_device(const torch::Tensor& image) {
+            auto img = image;
+            if (img.dim() == 4) {
+                img = img.squeeze(0);
+            }
+            if (img.dim() == 2) {
+                img = img.unsqueeze(-1);
+            }
+            if (img.scalar_type() != torch::kUInt8) {
+                // Convert [C, H, W] to [H, W, C]
+                if (img.dim() == 3 && img.size(0) <= 4) {
+                    img = img.permute({1, 2, 0});
+                }
+                img = (img.to(torch::kFloat32).clamp(0, 1) * 255).to(torch::kUInt8);
+            }
+            TORCH_CHECK(img.dim() == 3 && img.size(2) >= 1 && img.size(2) <= 4,
+                        "Expected an [H, W, C] image with 1 to 4 channels, got ", image.sizes());
+            return img;
         }
 
-        // Convert [C, H, W] to [H, W, C]
-        if (img.dim() == 3 && img.size(0) <= 4) {
-            img = img.permute({1, 2, 0});
+        void write_netpbm(const std::filesystem::path& path, const uint8_t* data, int width, int height, int channels) {
+            std::ofstream file(path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("Failed to save image: " + path.string());
+            }
+            if (channels == 1 || channels == 3) {
+                file << (channels == 1 ? "P5" : "P6") << "\n"
+                     << width << " " << height << "\n255\n";
+            } else {
+                file << "P7\nWIDTH " << width << "\nHEIGHT " << height << "\nDEPTH " << channels
+                     << "\nMAXVAL 255\nTUPLTYPE " << (channels == 2 ? "GRAYSCALE_ALPHA" : "RGB_ALPHA") << "\nENDHDR\n";
+            }
+            file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(width) * height * channels);
+            if (!file) {
+                throw std::runtime_error("Failed to save image: " + path.string());
+            }
         }
+    } // namespace
+
+    ImageFormat image_format_from_string(const std::string& name) {
+        if (name == "auto")
+            return ImageFormat::Auto;
+        if (name == "png")
+            return ImageFormat::PNG;
+        if (name == "jpg" || name == "jpeg")
+            return ImageFormat::JPEG;
+        if (name == "raw")
+            return ImageFormat::Raw;
+        throw std::invalid_argument("Unknown image format: " + name);
+    }
 
-        processed_images.push_back(img.contiguous());
+    torch::Tensor to_rgb8(const torch::Tensor& image) {
+        return to_rgb8_on_device(image).contiguous().to(torch::kCPU);
     }
 
-    // Create separator (white by default)
-    torch::Tensor separator;
-    if (separator_width > 0) {
-        auto first_img = processed_images[0];
-        if (horizontal) {
-            separator = torch::ones({first_img.size(0), separator_width, first_img.size(2)},
-                                    first_img.options());
-        } else {
-            separator = torch::ones({separator_width, first_img.size(1), first_img.size(2)},
-                                    first_img.options());
+    torch::Tensor compose_rgb8(const std::vector<torch::Tensor>& images, bool horizontal, int separator_width) {
+        TORCH_CHECK(!images.empty(), "No images provided");
+        TORCH_CHECK(separator_width >= 0, "separator_width must not be negative");
+
+        std::vector<torch::Tensor> panels;
+        panels.reserve(images.size());
+        for (const auto& image : images) {
+            panels.push_back(to_rgb8_on_device(image));
+        }
+        if (panels.size() == 1) {
+            return panels[0].contiguous().to(torch::kCPU);
         }
+
+        const int axis = horizontal ? 1 : 0;
+        const int other = horizontal ? 0 : 1;
+        int64_t length = separator_width * static_cast<int64_t>(panels.size() - 1);
+        for (const auto& panel : panels) {
+            TORCH_CHECK(panel.size(other) == panels[0].size(other) && panel.size(2) == panels[0].size(2),
+                        "Composed images must share ", horizontal ? "height" : "width", " and channel count");
+            length += panel.size(axis);
+        }
+
+        // Each panel is copied straight from its device into the canvas
+        auto shape = panels[0].sizes().vec();
+        shape[axis] = length;
+        auto canvas = torch::full(shape, 255, torch::TensorOptions().dtype(torch::kUInt8));
+        int64_t offset = 0;
+        for (const auto& panel : panels) {
+            canvas.narrow(axis, offset, panel.size(axis)).copy_(panel);
+            offset += panel.size(axis) + separator_width;
+        }
+        return canvas;
     }
 
-    // Concatenate images with separators
-    torch::Tensor combined;
-    for (size_t i = 0; i < processed_images.size(); ++i) {
-        if (i == 0) {
-            combined = processed_images[i];
-        } else {
-            if (separator_width > 0) {
-                combined = torch::cat({combined, separator, processed_images[i]},
-                                      horizontal ? 1 : 0);
+    torch::Tensor make_side_by_side_canvas(int64_t height, int64_t panel_width, int panels, int separator_width) {
+        TORCH_CHECK(panels > 0 && separator_width >= 0, "Invalid canvas layout");
+        const int64_t width = panels * panel_width + (panels - 1) * separator_width;
+        return torch::full({height, width, 3}, 255, torch::TensorOptions().dtype(torch::kUInt8));
+    }
+
+    torch::Tensor canvas_panel(const torch::Tensor& canvas, int panel, int64_t panel_width, int separator_width) {
+        return canvas.narrow(1, panel * (panel_width + separator_width), panel_width);
+    }
+
+    std::filesystem::path write_rgb8(const std::filesystem::path& path,
+                                     const torch::Tensor& rgb8,
+                                     ImageFormat format,
+                                     int jpeg_quality) {
+        TORCH_CHECK(rgb8.scalar_type() == torch::kUInt8 && rgb8.dim() == 3 && rgb8.device().is_cpu(),
+                    "write_rgb8 expects an [H, W, C] uint8 CPU tensor");
+        const auto image = rgb8.contiguous();
+        const int height = static_cast<int>(image.size(0));
+        const int width = static_cast<int>(image.size(1));
+        const int channels = static_cast<int>(image.size(2));
+        const uint8_t* data = image.data_ptr<uint8_t>();
+
+        auto out_path = path;
+        if (format == ImageFormat::Auto) {
+            const auto ext = path.extension().string();
+            if (ext == ".png") {
+                format = ImageFormat::PNG;
+            } else if (ext == ".jpg" || ext == ".jpeg") {
+                format = ImageFormat::JPEG;
             } else {
-                combined = torch::cat({combined, processed_images[i]},
-                                      horizontal ? 1 : 0);
+                throw std::runtime_error("Failed to save image: " + path.string());
             }
+        } else if (format == ImageFormat::PNG) {
+            out_path.replace_extension(".png");
+        } else if (format == ImageFormat::JPEG) {
+            out_path.replace_extension(".jpg");
+        } else {
+            out_path.replace_extension(channels == 1 ? ".pgm" : channels == 3 ? ".ppm"
+                                                                               : ".pam");
+        }
+
+        bool success = true;
+        if (format == ImageFormat::PNG) {
+            success = stbi_write_png(out_path.string().c_str(), width, height, channels, data, width * channels);
+        } else if (format == ImageFormat::JPEG) {
+            success = stbi_write_jpg(out_path.string().c_str(), width, height, channels, data, jpeg_quality);
+        } else {
+            write_netpbm(out_path, data, width, height, channels);
+        }
+
+        if (!success) {
+            throw std::runtime_error("Failed to save image: " + out_path.string());
         }
+        return out_path;
     }
 
-    // Save the combined image
-    save_image(path, combined);
-}
+    void set_png_compression_level(int level) {
+        TORCH_CHECK(level >= 0 && level <= 9, "PNG compression level must be in [0, 9], got ", level);
+        stbi_write_png_compression_level = level;
+    }
 
-void free_image(unsigned char* img) {
-    stbi_image_free(img);
-}
+    BatchImageSaver::BatchImageSaver() {
+        start_workers();
+    }
 
-// Batch image saver implementation
-namespace image_io {
+    BatchImageSaver::~BatchImageSaver() {
+        shutdown();
+    }
 
-    BatchImageSaver::BatchImageSaver(size_t num_workers)
-        : num_workers_(std::min(num_workers, std::min(size_t(8), size_t(std::thread::hardware_concurrency())))) {
+    void BatchImageSaver::start_workers() {
+        const size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+        const size_t num_workers = std::clamp<size_t>(config_.num_workers, 1, hardware);
+        stop_ = false;
 
-        std::cout << "[BatchImageSaver] Starting with " << num_workers_ << " worker threads" << std::endl;
+        std::cout << "[BatchImageSaver] Starting with " << num_workers << " worker threads" << std::endl;
 
-        for (size_t i = 0; i < num_workers_; ++i) {
+        for (size_t i = 0; i < num_workers; ++i) {
             workers_.emplace_back(&BatchImageSaver::worker_thread, this);
         }
     }
 
-    BatchImageSaver::~BatchImageSaver() {
-        shutdown();
-    }
-
-    void BatchImageSaver::shutdown() {
-        // Signal stop
+    void BatchImageSaver::stop_workers() {
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
-            if (stop_)
-                return; // Already stopped
-
             stop_ = true;
-            std::cout << "[BatchImageSaver] Shutting down..." << std::endl;
         }
         cv_.notify_all();
+        cv_space_.notify_all();
 
-        // Wait for all workers to finish
+        // Workers drain the queue before they exit
         for (auto& worker : workers_) {
             if (worker.joinable()) {
                 worker.join();
             }
         }
+        workers_.clear();
+    }
+
+    void BatchImageSaver::configure(const ImageWriterConfig& config) {
+        TORCH_CHECK(config.max_queue > 0, "The image queue needs room for at least one image");
+        TORCH_CHECK(config.jpeg_quality >= 1 && config.jpeg_quality <= 100, "JPEG quality must be in [1, 100]");
+        TORCH_CHECK(config.png_compression_level >= 0 && config.png_compression_level <= 9,
+                    "PNG compression level must be in [0, 9]");
+
+        wait_all();
+        stop_workers();
+        set_png_compression_level(config.png_compression_level); // no encoder is running now
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            config_ = config;
+        }
+        start_workers();
+    }
+
+    ImageWriterConfig BatchImageSaver::config() const {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        return config_;
+    }
+
+    void BatchImageSaver::shutdown() {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            if (stop_)
+                return; // Already stopped
+        }
+        std::cout << "[BatchImageSaver] Shutting down..." << std::endl;
+        stop_workers();
 
         // Process any remaining tasks synchronously
         while (!task_queue_.empty()) {
@@ -193,60 +289,32 @@ namespace image_io {
         std::cout << "[BatchImageSaver] Shutdown complete" << std::endl;
     }
 
-    void BatchImageSaver::queue_save(const std::filesystem::path& path, torch::Tensor image) {
-        if (!enabled_) {
-            save_image(path, image);
-            return;
-        }
-
-        SaveTask task;
-        task.path = path;
-        task.image = image.clone(); // Clone to avoid data races
-        task.is_multi = false;
-
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            if (stop_) {
-                // If stopped, save synchronously
-                save_image(path, image);
-                return;
-            }
-            task_queue_.push(std::move(task));
-            active_tasks_++;
-        }
-        cv_.notify_one();
+    void BatchImageSaver::queue_save(const std::filesystem::path& path, const torch::Tensor& image) {
+        enqueue({path, to_rgb8(image)});
     }
 
     void BatchImageSaver::queue_save_multiple(const std::filesystem::path& path,
                                               const std::vector<torch::Tensor>& images,
                                               bool horizontal,
                                               int separator_width) {
-        if (!enabled_) {
-            save_image(path, images, horizontal, separator_width);
-            return;
-        }
-
-        SaveTask task;
-        task.path = path;
-        task.images.reserve(images.size());
-        for (const auto& img : images) {
-            task.images.push_back(img.clone());
-        }
-        task.is_multi = true;
-        task.horizontal = horizontal;
-        task.separator_width = separator_width;
+        enqueue({path, compose_rgb8(images, horizontal, separator_width)});
+    }
 
+    void BatchImageSaver::enqueue(SaveTask task) {
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
-            if (stop_) {
-                // If stopped, save synchronously
-                save_image(path, images, horizontal, separator_width);
+            // Back-pressure: wait for a free slot instead of buffering every image
+            cv_space_.wait(lock, [this] { return stop_ || task_queue_.size() < config_.max_queue; });
+            if (enabled_ && !stop_) {
+                task_queue_.push(std::move(task));
+                active_tasks_++;
+                lock.unlock();
+                cv_.notify_one();
                 return;
             }
-            task_queue_.push(std::move(task));
-            active_tasks_++;
         }
-        cv_.notify_one();
+        // Disabled or stopped: save synchronously
+        process_task(task);
     }
 
     void BatchImageSaver::wait_all() {
@@ -258,7 +326,7 @@ namespace image_io {
 
     size_t BatchImageSaver::pending_count() const {
         std::unique_lock<std::mutex> lock(queue_mutex_);
-        return task_queue_.size() + active_tasks_;
+        return active_tasks_;
     }
 
     void BatchImageSaver::worker_thread() {
@@ -272,13 +340,10 @@ namespace image_io {
                     break;
                 }
 
-                if (!task_queue_.empty()) {
-                    task = std::move(task_queue_.front());
-                    task_queue_.pop();
-                } else {
-                    continue;
-                }
+                task = std::move(task_queue_.front());
+                task_queue_.pop();
             }
+            cv_space_.notify_one();
 
             process_task(task);
 
@@ -290,16 +355,12 @@ namespace image_io {
         }
     }
 
-    void BatchImageSaver::process_task(const SaveTask& task) {
+    void BatchImageSaver::process_task(const SaveTask& task) const {
         try {
-            if (task.is_multi) {
-                save_image(task.path, task.images, task.horizontal, task.separator_width);
-            } else {
-                save_image(task.path, task.image);
-            }
+            write_rgb8(task.path, task.rgb8, config_.format, config_.jpeg_quality);
         } catch (const std::exception& e) {
             std::cerr << "[BatchImageSaver] Error saving " << task.path << ": " << e.what() << std::endl;
         }
     }
 
-} // namespace image_io
\ No newline at end of file
+} // namespace image_io
@@ -0,0 +1,144 @@
+#include "core/lr_scheduler.hpp"
+#include "core/selective_adam.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gs {
+
+    LRSchedule lr_schedule_from_string(const std::string& name) {
+        if (name == "constant")
+            return LRSchedule::Constant;
+        if (name == "exponential")
+            return LRSchedule::Exponential;
+        if (name == "cosine")
+            return LRSchedule::Cosine;
+        if (name == "step")
+            return LRSchedule::Step;
+        throw std::invalid_argument("Unknown LR schedule '" + name +
+                                    "'. Valid schedules are: constant, exponential, cosine, step");
+    }
+
+    std::string to_string(LRSchedule schedule) {
+        switch (schedule) {
+        case LRSchedule::Constant: return "constant";
+        case LRSchedule::Exponential: return "exponential";
+        case LRSchedule::Cosine: return "cosine";
+        case LRSchedule::Step: return "step";
+        }
+        return "unknown";
+    }
+
+    double lr_factor(const LRScheduleConfig& config, int step, int total_steps) {
+        const int T = std::max(total_steps, 1);
+        const int t = std::clamp(step, 0, T);
+        const double progress = static_cast<double>(t) / T;
+
+        double factor = 1.0;
+        switch (config.type) {
+        case LRSchedule::Constant:
+            break;
+        case LRSchedule::Exponential:
+            factor = std::pow(config.final_factor, progress);
+            break;
+        case LRSchedule::Cosine:
+            factor = config.final_factor + (1.0 - config.final_factor) * 0.5 * (1.0 + std::cos(M_PI * progress));
+            break;
+        case LRSchedule::Step: {
+            const int step_size = std::max(config.step_size, 1);
+            factor = std::pow(config.final_factor, static_cast<double>(t / step_size * step_size) / T);
+            break;
+        }
+        }
+
+        if (t < config.warmup_steps) {
+            factor *= config.warmup_start + (1.0 - config.warmup_start) * t / config.warmup_steps;
+        }
+        return factor;
+    }
+
+    LRScheduler::LRScheduler(torch::optim::Optimizer& optimizer, int total_steps)
+        : total_steps_(std::max(total_steps, 1)) {
+        for (auto& group : optimizer.param_groups()) {
+            auto& options = group.options();
+            if (auto* selective_adam_options = dynamic_cast<gs::SelectiveAdam::Options*>(&options)) {
+                base_lrs_.push_back(selective_adam_options->lr());
+                set_lr_.emplace_back([selective_adam_options](double lr) { selective_adam_options->lr(lr); });
+            } else if (auto* adam_options = dynamic_cast<torch::optim::AdamOptions*>(&options)) {
+                base_lrs_.push_back(adam_options->lr());
+                set_lr_.emplace_back([adam_options](double lr) { adam_options->lr(lr); });
+            } else {
+                throw std::invalid_argument("LRScheduler supports Adam and SelectiveAdam param groups only");
+            }
+        }
+        tables_.resize(base_lrs_.size());
+    }
+
+    void LRScheduler::set_schedule(int group, const LRScheduleConfig& config) {
+        if (group < 0 || group >= static_cast<int>(tables_.size())) {
+            throw std::out_of_range("Invalid parameter group " + std::to_string(group));
+        }
+        auto& table = tables_[group];
+        table.resize(total_steps_ + 1);
+        for (int t = 0; t <= total_steps_; ++t) {
+            table[t] = lr_factor(config, t, total_steps_);
+        }
+        set_lr_[group](base_lrs_[group] * table[std::min(step_, total_steps_)]);
+    }
+
+    void LRScheduler::step() {
+        ++step_;
+        apply();
+    }
+
+    double LRScheduler::factor(int group, int step) const {
+        const auto& table = tables_.at(group);
+        return table.empty() ? 1.0 : table[std::clamp(step, 0, total_steps_)];
+    }
+
+    void LRScheduler::apply() {
+        const int t = std::min(step_, total_steps_);
+        for (size_t group = 0; group < tables_.size(); ++group) {
+            if (!tables_[group].empty()) {
+                set_lr_[group](base_lrs_[group] * tables_[group][t]);
+            }
+        }
+    }
+
+    void LRScheduler::save(torch::serialize::OutputArchive& archive) const {
+        const auto f64 = torch::TensorOptions().dtype(torch::kFloat64);
+        archive.write("step", torch::tensor(static_cast<int64_t>(step_)));
+        archive.write("total_steps", torch::tensor(static_cast<int64_t>(total_steps_)));
+        archive.write("base_lrs", torch::tensor(base_lrs_, f64));
+        for (size_t group = 0; group < tables_.size(); ++group) {
+            archive.write("table_" + std::to_string(group), torch::tensor(tables_[group], f64));
+        }
+    }
+
+    void LRScheduler::load(torch::serialize::InputArchive& archive) {
+        torch::Tensor step, total_steps, base_lrs;
+        archive.read("step", step);
+        archive.read("total_steps", total_steps);
+        archive.read("base_lrs", base_lrs);
+        if (base_lrs.numel() != static_cast<int64_t>(base_lrs_.size())) {
+            throw std::runtime_error("LR scheduler state has " + std::to_string(base_lrs.numel()) +
+                                     " param groups, the optimizer has " + std::to_string(base_lrs_.size()));
+        }
+
+        std::vector<std::vector<double>> tables(base_lrs_.size());
+        for (size_t group = 0; group < tables.size(); ++group) {
+            torch::Tensor table;
+            archive.read("table_" + std::to_string(group), table);
+            table = table.contiguous();
+            tables[group].assign(table.data_ptr<double>(), table.data_ptr<double>() + table.numel());
+        }
+
+        step_ = static_cast<int>(step.item<int64_t>());
+        total_steps_ = static_cast<int>(total_steps.item<int64_t>());
+        base_lrs = base_lrs.contiguous();
+        base_lrs_.assign(base_lrs.data_ptr<double>(), base_lrs.data_ptr<double>() + base_lrs.numel());
+        tables_ = std::move(tables);
+        apply();
+    }
+
+} // namespace gs
@@ -1,7 +1,7 @@
 #include "core/argument_parser.hpp"
 #include "core/dataset.hpp"
-#include "core/mcmc.hpp"
 #include "core/parameters.hpp"
+#include "core/strategy_registry.hpp"
 #include "core/trainer.hpp"
 #include "visualizer/detail.hpp"
 #include <iostream>
@@ -33,7 +33,7 @@ int main(int argc, char* argv[]) {
         //----------------------------------------------------------------------
         // 5. Create strategy
         //----------------------------------------------------------------------
-        auto strategy = std::make_unique<MCMC>(std::move(splat_data));
+        auto strategy = gs::create_strategy(params.optimization.strategy, std::move(splat_data));
 
         //----------------------------------------------------------------------
         // 6. Create trainer
@@ -0,0 +1,190 @@
+#include "core/memory_report.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace gs {
+
+    namespace {
+        constexpr int64_t kFloat = 4;
+        constexpr int64_t kInt32 = 4;
+        constexpr int64_t kInt64 = 8;
+
+        // Intersection buffers grow with the same headroom as RasterWorkspace
+        constexpr double kIsectHeadroom = 1.25;
+
+        int64_t shN_coeffs(int degree) { return static_cast<int64_t>(degree + 1) * (degree + 1) - 1; }
+    } // namespace
+
+    void MemoryReport::add(const std::string& category, const std::string& name, int64_t bytes) {
+        auto it = std::find_if(entries_.begin(), entries_.end(), [&](const MemoryEntry& e) {
+            return e.category == category && e.name == name;
+        });
+        if (it != entries_.end()) {
+            it->bytes += bytes;
+        } else {
+            entries_.push_back({category, name, bytes});
+        }
+    }
+
+    int64_t MemoryReport::total() const {
+        int64_t sum = 0;
+        for (const auto& e : entries_) {
+            sum += e.bytes;
+        }
+        return sum;
+    }
+
+    int64_t MemoryReport::category_bytes(const std::string& category) const {
+        int64_t sum = 0;
+        for (const auto& e : entries_) {
+            if (e.category == category) {
+                sum += e.bytes;
+            }
+        }
+        return sum;
+    }
+
+    std::string MemoryReport::to_string() const {
+        std::ostringstream ss;
+        ss << "Memory: " << format_bytes(static_cast<double>(total())) << " accounted";
+        if (allocated_bytes >= 0) {
+            ss << ", " << format_bytes(static_cast<double>(allocated_bytes)) << " allocated";
+        }
+        if (peak_allocated_bytes >= 0) {
+            ss << ", " << format_bytes(static_cast<double>(peak_allocated_bytes)) << " peak";
+        }
+        if (reserved_bytes >= 0) {
+            ss << ", " << format_bytes(static_cast<double>(reserved_bytes)) << " reserved";
+        }
+        ss << "\n";
+
+        std::vector<std::string> categories;
+        for (const auto& e : entries_) {
+            if (std::find(categories.begin(), categories.end(), e.category) == categories.end()) {
+                categories.push_back(e.category);
+            }
+        }
+        for (const auto& category : categories) {
+            ss << "  " << std::left << std::setw(24) << category << std::right << std::setw(12)
+               << format_bytes(static_cast<double>(category_bytes(category))) << "\n";
+            for (const auto& e : entries_) {
+                if (e.category == category) {
+                    ss << "    " << std::left << std::setw(22) << e.name << std::right << std::setw(12)
+                       << format_bytes(static_cast<double>(e.bytes)) << "\n";
+                }
+            }
+        }
+        return ss.str();
+    }
+
+    std::string format_bytes(double bytes) {
+        static const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+        int unit = 0;
+        while (std::abs(bytes) >= 1024.0 && unit < 4) {
+            bytes /= 1024.0;
+            ++unit;
+        }
+        std::ostringstream ss;
+        if (unit == 0) {
+            ss << static_cast<int64_t>(bytes) << " B";
+        } else {
+            ss << std::fixed << std::setprecision(2) << bytes << " " << units[unit];
+        }
+        return ss.str();
+    }
+
+    MemoryReport predict_memory(const MemoryModelConfig& config) {
+        namespace cat = memory_category;
+        const int64_t n = config.num_gaussians;
+        const int64_t pixels = config.image_width * config.image_height;
+        const int64_t sh_coeffs = 1 + shN_coeffs(config.sh_degree);
+
+        // Parameter tensors in param group order, float32 each
+        const std::pair<const char*, int64_t> groups[] = {
+            {"means", 3},
+            {"sh0", 3},
+            {"shN", 3 * shN_coeffs(config.sh_degree)},
+            {"scaling", 3},
+            {"rotation", 4},
+            {"opacity", 1}};
+
+        MemoryReport report;
+        for (const auto& [name, floats] : groups) {
+            report.add(cat::Parameters, name, n * floats * kFloat);
+        }
+        for (const auto& [name, floats] : groups) {
+            report.add(cat::Gradients, name, n * floats * kFloat);
+        }
+        for (const auto& [name, floats] : groups) {
+            report.add(cat::AdamMoments, name, 2 * n * floats * kFloat); // exp_avg and exp_avg_sq
+        }
+
+        report.add(cat::StrategyState, "max_radii2D", n * kFloat);
+        if (config.default_strategy) {
+            report.add(cat::StrategyState, "grad2d", n * kFloat);
+            report.add(cat::StrategyState, "count", n * kFloat);
+        }
+        if (config.contribution_stats) {
+            report.add(cat::StrategyState, "contribution stats", n * (kFloat + kInt64 + kInt32));
+        }
+
+        if (config.bilateral_grid) {
+            const int64_t grid = config.num_images * 12 * config.grid_W * config.grid_Y * config.grid_X * kFloat;
+            report.add(cat::BilateralGrid, "grids", grid);
+            report.add(cat::BilateralGrid, "gradient", grid);
+            report.add(cat::BilateralGrid, "adam moments", 2 * grid);
+        }
+
+        // Workspace slots: radii (2 x int32), means2d (2), depths (1), conics (3), tiles per Gaussian
+        report.add(cat::Rasterizer, "per gaussian", n * (2 * kInt32 + 6 * kFloat + kInt32));
+        // Sorted and unsorted isect_ids (int64) and flatten_ids (int32)
+        const auto isects = static_cast<int64_t>(std::ceil(static_cast<double>(n) * config.isects_per_gaussian *
+                                                           kIsectHeadroom));
+        report.add(cat::Rasterizer, "intersections", isects * 2 * (kInt64 + kInt32));
+        const int64_t tile = std::max(config.tile_size, 1);
+        const int64_t tiles = ((config.image_width + tile - 1) / tile) * ((config.image_height + tile - 1) / tile);
+        // Renders (RGB), alphas and last ids per pixel, offsets per tile
+        report.add(cat::Rasterizer, "per pixel", pixels * (4 * kFloat + kInt32) + tiles * kInt32);
+
+        // Forward: activated scales, rotations and opacities, concatenated SH
+        // coefficients, view directions and colors. Backward: their gradients
+        // plus those of the projected means, conics and depths.
+        const int64_t forward_floats = 3 + 4 + 1 + 3 * sh_coeffs + 3 + 3;
+        const int64_t backward_floats = forward_floats + 2 + 3 + 1;
+        report.add(cat::Activations, "per gaussian", n * (forward_floats + backward_floats) * kFloat);
+        // Rendered image and its gradient, the L1 difference, the three SSIM
+        // maps kept for backward, render and alpha gradients, the grid output
+        int64_t pixel_floats = 3 + 3 + 3 + 9 + 3 + 1;
+        if (config.bilateral_grid) {
+            pixel_floats += 3;
+        }
+        report.add(cat::Activations, "per pixel", pixels * pixel_floats * kFloat);
+
+        report.add(cat::DatasetImages, "prefetched", config.prefetched_images * pixels * 3 * kFloat);
+        return report;
+    }
+
+    int64_t max_gaussians_for_budget(MemoryModelConfig config, int64_t budget_bytes) {
+        // The footprint grows monotonically with the count
+        int64_t lo = 0, hi = 1;
+        auto fits = [&](int64_t n) {
+            config.num_gaussians = n;
+            return predict_memory(config).total() <= budget_bytes;
+        };
+        if (!fits(0)) {
+            return 0;
+        }
+        while (fits(hi) && hi < (int64_t{1} << 40)) {
+            lo = hi;
+            hi *= 2;
+        }
+        while (hi - lo > 1) {
+            const int64_t mid = lo + (hi - lo) / 2;
+            (fits(mid) ? lo : hi) = mid;
+        }
+        return lo;
+    }
+
+} // namespace gs
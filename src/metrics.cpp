@@ -1,20 +1,24 @@
 #include "core/metrics.hpp"
 #include "core/image_io.hpp"
 #include "core/splat_data.hpp"
+#include "core/ssim_cpu.hpp"
+#include "kernels/ssim.cuh"
+#include <ATen/cuda/CUDAEvent.h>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <iostream>
-#include <numeric>
+#include <limits>
+#include <map>
+#include <mutex>
 
 namespace gs {
     namespace metrics {
 
         // 1D Gaussian kernel
         torch::Tensor gaussian(const int window_size, const float sigma) {
-            torch::Tensor gauss = torch::empty(window_size);
-            for (int x = 0; x < window_size; ++x) {
-                gauss[x] = std::exp(-(std::pow(std::floor(static_cast<float>(x - window_size) / 2.f), 2)) / (2.f * sigma * sigma));
-            }
+            const auto x = torch::arange(window_size, torch::kFloat32) - static_cast<float>(window_size / 2);
+            const auto gauss = torch::exp(-x.pow(2) / (2.f * sigma * sigma));
             return gauss / gauss.sum();
         }
 
@@ -26,6 +30,10 @@ namespace gs {
 
         // PSNR Implementation
         float PSNR::compute(const torch::Tensor& pred, const torch::Tensor& target) const {
+            return compute_per_image(pred, target).mean().item<float>();
+        }
+
+        torch::Tensor PSNR::compute_per_image(const torch::Tensor& pred, const torch::Tensor& target) const {
             TORCH_CHECK(pred.sizes() == target.sizes(),
                         "Prediction and target must have the same shape");
 
@@ -37,77 +45,119 @@ namespace gs {
             const torch::Tensor squared_diff = (pred_cont - target_cont).pow(2);
 
             // Use reshape instead of view to handle non-contiguous tensors
-            torch::Tensor mse_val = squared_diff.reshape({pred.size(0), -1}).mean(1, true);
+            torch::Tensor mse_val = squared_diff.reshape({pred.size(0), -1}).mean(1);
 
             // Avoid log(0)
             mse_val = torch::clamp_min(mse_val, 1e-10);
 
             // PSNR = 20 * log10(data_range / sqrt(MSE))
-            return (20.f * torch::log10(data_range_ / mse_val.sqrt())).mean().item<float>();
+            return 20.f * torch::log10(data_range_ / mse_val.sqrt());
         }
 
         // SSIM Implementation
         SSIM::SSIM(const int window_size, const int channel)
             : window_size_(window_size),
-              channel_(channel) {
-            window_ = create_window(window_size, channel).to(torch::kFloat32);
+              channel_(channel),
+              window_1d_(gaussian_window(window_size, 1.5f)) {
+            window_ = torch::tensor(window_1d_, torch::kFloat32);
         }
 
         float SSIM::compute(const torch::Tensor& pred, const torch::Tensor& target) {
+            return ssim_map(pred, target).mean().item<float>();
+        }
+
+        torch::Tensor SSIM::compute_per_image(const torch::Tensor& pred, const torch::Tensor& target) {
+            return ssim_map(pred, target).mean({1, 2, 3});
+        }
+
+        torch::Tensor SSIM::ssim_map(const torch::Tensor& pred, const torch::Tensor& target) {
             TORCH_CHECK(pred.dim() == 4, "Expected 4D tensor [B, C, H, W]");
             TORCH_CHECK(pred.sizes() == target.sizes(),
                         "Prediction and target must have the same shape");
+            TORCH_CHECK(pred.size(1) == channel_, "Expected ", channel_, " channels, got ", pred.size(1));
 
-            // Ensure window is on the same device as input
-            if (window_.device() != pred.device()) {
-                window_ = window_.to(pred.device());
+            auto img1 = pred.to(torch::kFloat32).contiguous();
+            auto img2 = target.to(img1.device(), torch::kFloat32).contiguous();
+
+            // The training kernel computes the same map with the 11x11, sigma 1.5 window
+            if (img1.is_cuda() && window_size_ == 11) {
+                return std::get<0>(fusedssim(C1, C2, img1, img2, /*train=*/false));
             }
 
-            const int pad = window_size_ / 2;
+            if (img1.is_cpu()) {
+                auto map = torch::empty_like(img1);
+                ssim_map_cpu(img1.data_ptr<float>(), img2.data_ptr<float>(), map.data_ptr<float>(),
+                             img1.size(0) * img1.size(1), img1.size(2), img1.size(3),
+                             window_1d_, C1, C2);
+                return map;
+            }
 
-            // Compute local means
-            const auto mu1 = torch::nn::functional::conv2d(pred, window_,
-                                                           torch::nn::functional::Conv2dFuncOptions()
-                                                               .padding(pad)
-                                                               .groups(channel_));
-            const auto mu2 = torch::nn::functional::conv2d(target, window_,
-                                                           torch::nn::functional::Conv2dFuncOptions()
-                                                               .padding(pad)
-                                                               .groups(channel_));
-
-            const auto mu1_sq = mu1.pow(2);
-            const auto mu2_sq = mu2.pow(2);
-            const auto mu1_mu2 = mu1 * mu2;
-
-            // Compute local variances and covariance
-            const auto sigma1_sq = torch::nn::functional::conv2d(pred * pred, window_,
-                                                                 torch::nn::functional::Conv2dFuncOptions()
-                                                                     .padding(pad)
-                                                                     .groups(channel_)) -
-                                   mu1_sq;
-            const auto sigma2_sq = torch::nn::functional::conv2d(target * target, window_,
-                                                                 torch::nn::functional::Conv2dFuncOptions()
-                                                                     .padding(pad)
-                                                                     .groups(channel_)) -
-                                   mu2_sq;
-            const auto sigma12 = torch::nn::functional::conv2d(pred * target, window_,
-                                                               torch::nn::functional::Conv2dFuncOptions()
-                                                                   .padding(pad)
-                                                                   .groups(channel_)) -
-                                 mu1_mu2;
+            // Other devices: both passes as grouped 1D convolutions over all five moments
+            if (window_.device() != img1.device()) {
+                window_ = window_.to(img1.device());
+            }
+            const int64_t groups = 5 * channel_;
+            const int pad = window_size_ / 2;
+            namespace F = torch::nn::functional;
+            auto moments = torch::cat({img1, img2, img1 * img1, img2 * img2, img1 * img2}, 1);
+            moments = F::conv2d(moments, window_.view({1, 1, 1, -1}).expand({groups, 1, 1, window_size_}),
+                                F::Conv2dFuncOptions().padding({0, pad}).groups(groups));
+            moments = F::conv2d(moments, window_.view({1, 1, -1, 1}).expand({groups, 1, window_size_, 1}),
+                                F::Conv2dFuncOptions().padding({pad, 0}).groups(groups));
+            const auto m = moments.chunk(5, 1);
+
+            const auto mu1_sq = m[0].pow(2);
+            const auto mu2_sq = m[1].pow(2);
+            const auto mu1_mu2 = m[0] * m[1];
+            const auto sigma1_sq = m[2] - mu1_sq;
+            const auto sigma2_sq = m[3] - mu2_sq;
+            const auto sigma12 = m[4] - mu1_mu2;
 
             // SSIM formula
-            const auto ssim_map = ((2.f * mu1_mu2 + C1) * (2.f * sigma12 + C2)) /
-                                  ((mu1_sq + mu2_sq + C1) * (sigma1_sq + sigma2_sq + C2));
-
-            return ssim_map.mean().item<float>();
+            return ((2.f * mu1_mu2 + C1) * (2.f * sigma12 + C2)) /
+                   ((mu1_sq + mu2_sq + C1) * (sigma1_sq + sigma2_sq + C2));
         }
 
         // LPIPS Implementation
-        LPIPS::LPIPS(const std::string& model_path) {
-            if (!model_path.empty()) {
-                load_model(model_path);
-            } else {
+        LPIPSPrecision lpips_precision_from_string(const std::string& name) {
+            if (name == "fp32")
+                return LPIPSPrecision::Float32;
+            if (name == "fp16")
+                return LPIPSPrecision::Float16;
+            if (name == "bf16")
+                return LPIPSPrecision::BFloat16;
+            throw std::invalid_argument("Unknown LPIPS precision '" + name + "'. Valid precisions are: fp32, fp16, bf16");
+        }
+
+        std::string to_string(LPIPSPrecision precision) {
+            switch (precision) {
+            case LPIPSPrecision::Float32: return "fp32";
+            case LPIPSPrecision::Float16: return "fp16";
+            case LPIPSPrecision::BFloat16: return "bf16";
+            }
+            return "unknown";
+        }
+
+        namespace {
+            torch::ScalarType lpips_dtype(LPIPSPrecision precision) {
+                switch (precision) {
+                case LPIPSPrecision::Float16: return torch::kFloat16;
+                case LPIPSPrecision::BFloat16: return torch::kBFloat16;
+                default: return torch::kFloat32;
+                }
+            }
+        } // namespace
+
+        LPIPS::LPIPS(const std::string& model_path, LPIPSPrecision precision,
+                     std::optional<torch::Device> device, int max_batch)
+            : device_(device.value_or(torch::cuda::is_available() ? torch::Device(torch::kCUDA) : torch::Device(torch::kCPU))),
+              precision_(precision),
+              max_batch_(std::max(max_batch, 1)) {
+            TORCH_CHECK(!(device_.is_cpu() && precision_ == LPIPSPrecision::Float16),
+                        "fp16 LPIPS needs a CUDA device; use bf16 on the CPU");
+
+            std::string path = model_path;
+            if (path.empty()) {
                 // Try default paths
                 const std::vector<std::string> default_paths = {
                     "weights/lpips_vgg.pt",
@@ -115,67 +165,135 @@ namespace gs {
                     "../../weights/lpips_vgg.pt",
                     std::string(std::getenv("HOME") ? std::getenv("HOME") : "") + "/.cache/gaussian_splatting/lpips_vgg.pt"};
 
-                for (const auto& path : default_paths) {
-                    if (std::filesystem::exists(path)) {
-                        load_model(path);
+                for (const auto& candidate : default_paths) {
+                    if (std::filesystem::exists(candidate)) {
+                        path = candidate;
                         break;
                     }
                 }
             }
 
-            if (!model_loaded_) {
+            if (path.empty()) {
                 throw std::runtime_error(
                     "LPIPS model not found! \n"
                     "Searched paths: weights/lpips_vgg.pt, ../weights/lpips_vgg.pt");
             }
+            model_ = load_model(path, device_, precision_);
         }
 
-        void LPIPS::load_model(const std::string& model_path) {
+        std::shared_ptr<const LPIPS::Model> LPIPS::load_model(const std::string& model_path,
+                                                              const torch::Device& device,
+                                                              LPIPSPrecision precision) {
+            // Every evaluator in the process shares one verified copy per configuration
+            static std::mutex cache_mutex;
+            static std::map<std::string, std::shared_ptr<const Model>> cache;
+
+            const std::string key = std::filesystem::weakly_canonical(model_path).string() + "|" +
+                                    device.str() + "|" + to_string(precision);
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            if (const auto it = cache.find(key); it != cache.end()) {
+                return it->second;
+            }
+
+            const auto dtype = lpips_dtype(precision);
+            torch::jit::script::Module module;
             try {
-                model_ = torch::jit::load(model_path);
-                model_.eval();
-                model_.to(torch::kCUDA);
-                model_loaded_ = true;
-                std::cout << "LPIPS model loaded from: " << model_path << std::endl;
+                module = torch::jit::load(model_path, device);
+                module.eval();
+                module.to(dtype);
             } catch (const c10::Error& e) {
                 throw std::runtime_error(
                     "Failed to load LPIPS model from " + model_path + ": " + e.what());
             }
+
+            if (device.is_cpu()) {
+                // Folds the network into oneDNN-friendly ops; the plain module still works if this fails
+                try {
+                    module = torch::jit::optimize_for_inference(module);
+                } catch (const c10::Error& e) {
+                    std::cerr << "Warning: LPIPS inference optimization failed, using the plain model: " << e.what() << std::endl;
+                }
+            }
+
+            // Preflight: two pairs of identical images must give finite, near-zero distances,
+            // either per pair ([2] or a [2, ...] spatial map) or averaged over the batch
+            auto model = std::make_shared<Model>();
+            {
+                const torch::NoGradGuard no_grad;
+                const auto images = torch::rand({2, 3, 64, 64}, torch::TensorOptions().device(device).dtype(dtype)) * 2.0f - 1.0f;
+                torch::Tensor output;
+                try {
+                    output = module.forward({images, images}).toTensor().to(torch::kFloat32);
+                } catch (const c10::Error& e) {
+                    throw std::runtime_error("LPIPS model from " + model_path + " failed its preflight: " + e.what());
+                }
+                const int64_t batch = output.dim() == 0 ? 1 : output.size(0);
+                if (batch != 1 && batch != 2) {
+                    throw std::runtime_error("LPIPS model from " + model_path + " failed its preflight: output batch size " +
+                                             std::to_string(batch) + " for 2 input pairs");
+                }
+                const auto distances = output.reshape({batch, -1}).mean(1);
+                if (!torch::isfinite(distances).all().item<bool>() || distances.abs().max().item<float>() > 1e-2f) {
+                    throw std::runtime_error("LPIPS model from " + model_path +
+                                             " failed its preflight: expected near-zero distances for identical images");
+                }
+                model->per_item = batch == 2;
+            }
+            model->module = std::move(module);
+
+            std::cout << "LPIPS model loaded from: " << model_path << " (" << device << ", " << to_string(precision) << ")" << std::endl;
+            cache.emplace(key, model);
+            return model;
         }
 
         float LPIPS::compute(const torch::Tensor& pred, const torch::Tensor& target) {
+            return compute_per_image(pred, target).mean().item<float>();
+        }
+
+        torch::Tensor LPIPS::compute_per_image(const torch::Tensor& pred, const torch::Tensor& target) {
             TORCH_CHECK(pred.dim() == 4, "Expected 4D tensor [B, C, H, W]");
             TORCH_CHECK(pred.sizes() == target.sizes(),
                         "Prediction and target must have the same shape");
-            TORCH_CHECK(model_loaded_, "LPIPS model not loaded!");
+            TORCH_CHECK(model_, "LPIPS model not loaded!");
 
             const torch::NoGradGuard no_grad;
+            const auto dtype = lpips_dtype(precision_);
+            // Channels-last is the native layout of oneDNN and of the tensor-core convolutions
+            const auto memory_format = device_.is_cpu() || precision_ != LPIPSPrecision::Float32
+                                           ? torch::MemoryFormat::ChannelsLast
+                                           : torch::MemoryFormat::Contiguous;
 
             // LPIPS expects inputs in range [-1, 1], but our inputs are in [0, 1]
-            // Convert from [0, 1] to [-1, 1]
-            auto pred_normalized = 2.0f * pred - 1.0f;
-            auto target_normalized = 2.0f * target - 1.0f;
-
-            // Ensure inputs are on CUDA and contiguous
-            pred_normalized = pred_normalized.to(torch::kCUDA).contiguous();
-            target_normalized = target_normalized.to(torch::kCUDA).contiguous();
-
-            // Forward pass through LPIPS model
-            std::vector<torch::jit::IValue> inputs;
-            inputs.push_back(pred_normalized);
-            inputs.push_back(target_normalized);
-
-            const auto output = model_.forward(inputs).toTensor();
-
-            // LPIPS returns a single value per batch item
-            return output.mean().item<float>();
+            auto prepare = [&](const torch::Tensor& image) {
+                return (2.0f * image.to(device_, torch::kFloat32) - 1.0f).to(dtype).contiguous(memory_format);
+            };
+
+            // Forward in chunks of max_batch_ to bound the VGG activations; a model that
+            // averages over the batch is run one pair at a time
+            const int64_t chunk = model_->per_item ? max_batch_ : 1;
+            auto module = model_->module; // shallow handle copy; forward() is non-const
+            std::vector<torch::Tensor> distances;
+            for (int64_t start = 0; start < pred.size(0); start += chunk) {
+                const int64_t count = std::min<int64_t>(chunk, pred.size(0) - start);
+                std::vector<torch::jit::IValue> inputs;
+                inputs.push_back(prepare(pred.narrow(0, start, count)));
+                inputs.push_back(prepare(target.narrow(0, start, count)));
+                const auto output = module.forward(inputs).toTensor();
+
+                // One value or spatial map per batch item, averaged to a distance
+                const int64_t output_batch = output.dim() == 0 ? 1 : output.size(0);
+                TORCH_CHECK(output_batch == count, "LPIPS output has batch size ", output_batch, ", expected ", count);
+                distances.push_back(output.reshape({count, -1}).to(torch::kFloat32).mean(1));
+            }
+            return torch::cat(distances).to(pred.device());
         }
 
         // MetricsReporter Implementation
         MetricsReporter::MetricsReporter(const std::filesystem::path& output_dir)
             : output_dir_(output_dir),
               csv_path_(output_dir_ / "metrics.csv"),
-              txt_path_(output_dir_ / "metrics_report.txt") {
+              txt_path_(output_dir_ / "metrics_report.txt"),
+              per_view_csv_path_(output_dir_ / "metrics_per_view.csv") {
 
             // Create CSV header if file doesn't exist
             if (!std::filesystem::exists(csv_path_)) {
@@ -198,6 +316,10 @@ namespace gs {
             }
         }
 
+        void MetricsReporter::add_view_metrics(const std::vector<ViewRecord>& views) const {
+            append_per_view_csv(per_view_csv_path_, views);
+        }
+
         void MetricsReporter::save_report() const {
             std::ofstream report_file(txt_path_);
             if (!report_file.is_open()) {
@@ -268,6 +390,7 @@ namespace gs {
             report_file.close();
             std::cout << "Evaluation report saved to: " << txt_path_ << std::endl;
             std::cout << "Metrics CSV saved to: " << csv_path_ << std::endl;
+            std::cout << "Per-view metrics saved to: " << per_view_csv_path_ << std::endl;
         }
 
         // MetricsEvaluator Implementation
@@ -287,10 +410,23 @@ namespace gs {
             if (!std::filesystem::exists(lpips_path)) {
                 lpips_path = "weights/lpips_vgg.pt";
             }
-            _lpips_metric = std::make_unique<LPIPS>(lpips_path.string());
+            _lpips_metric = std::make_unique<LPIPS>(lpips_path.string(),
+                                                    lpips_precision_from_string(params.optimization.lpips_precision),
+                                                    std::nullopt, // CUDA when available, else the CPU
+                                                    params.optimization.eval_batch_size);
 
             // Initialize reporter
             _reporter = std::make_unique<MetricsReporter>(params.dataset.output_path);
+            _depth_colormap = image_io::colormap_from_string(params.optimization.depth_colormap);
+
+            if (params.optimization.enable_save_eval_images) {
+                image_io::ImageWriterConfig writer;
+                writer.num_workers = static_cast<size_t>(std::max(1, params.optimization.image_writer_threads));
+                writer.max_queue = static_cast<size_t>(std::max(1, params.optimization.image_writer_queue));
+                writer.format = image_io::image_format_from_string(params.optimization.eval_image_format);
+                writer.png_compression_level = params.optimization.png_compression_level;
+                image_io::BatchImageSaver::instance().configure(writer);
+            }
         }
 
         bool MetricsEvaluator::should_evaluate(const int iteration) const {
@@ -311,64 +447,6 @@ namespace gs {
             return stringToRenderMode(_params.optimization.render_mode) != RenderMode::RGB;
         }
 
-        torch::Tensor MetricsEvaluator::apply_depth_colormap(const torch::Tensor& depth_normalized) const {
-            // depth_normalized should be [H, W] with values in [0, 1]
-            TORCH_CHECK(depth_normalized.dim() == 2, "Expected 2D tensor for depth_normalized");
-
-            // Create output tensor [3, H, W] for RGB
-            auto colormap = torch::zeros({3, depth_normalized.size(0), depth_normalized.size(1)},
-                                         torch::TensorOptions().dtype(torch::kFloat32).device(depth_normalized.device()));
-
-            // Get individual channel views
-            auto r = colormap[0];
-            auto g = colormap[1];
-            auto b = colormap[2];
-
-            // Create masks for different value ranges
-            const auto mask1 = depth_normalized < 0.25f;
-            const auto mask2 = (depth_normalized >= 0.25f) & (depth_normalized < 0.5f);
-            const auto mask3 = (depth_normalized >= 0.5f) & (depth_normalized < 0.75f);
-            const auto mask4 = depth_normalized >= 0.75f;
-
-            // Apply jet colormap using vectorized operations
-
-            // Range [0, 0.25): Blue to Cyan
-            // R = 0, G = 4*val, B = 1
-            r.masked_fill_(mask1, 0.0f);
-            g.masked_scatter_(mask1, 4.0f * depth_normalized.masked_select(mask1));
-            b.masked_fill_(mask1, 1.0f);
-
-            // Range [0.25, 0.5): Cyan to Green
-            // R = 0, G = 1, B = 1 - 4*(val-0.25)
-            r.masked_fill_(mask2, 0.0f);
-            g.masked_fill_(mask2, 1.0f);
-            const auto vals2 = depth_normalized.masked_select(mask2);
-            b.masked_scatter_(mask2, 1.0f - 4.0f * (vals2 - 0.25f));
-
-            // Range [0.5, 0.75): Green to Yellow
-            // R = 4*(val-0.5), G = 1, B = 0
-            const auto vals3 = depth_normalized.masked_select(mask3);
-            r.masked_scatter_(mask3, 4.0f * (vals3 - 0.5f));
-            g.masked_fill_(mask3, 1.0f);
-            b.masked_fill_(mask3, 0.0f);
-
-            // Range [0.75, 1.0]: Yellow to Red
-            // R = 1, G = 1 - 4*(val-0.75), B = 0
-            r.masked_fill_(mask4, 1.0f);
-            const auto vals4 = depth_normalized.masked_select(mask4);
-            g.masked_scatter_(mask4, 1.0f - 4.0f * (vals4 - 0.75f));
-            b.masked_fill_(mask4, 0.0f);
-
-            // Clamp values to ensure they're in [0, 1]
-            colormap = colormap.clamp(0.0f, 1.0f);
-
-            return colormap;
-        }
-
-        auto MetricsEvaluator::make_dataloader(std::shared_ptr<CameraDataset> dataset, const int workers) const {
-            return create_dataloader_from_dataset(dataset, workers);
-        }
-
         EvalMetrics MetricsEvaluator::evaluate(const int iteration,
                                                const SplatData& splatData,
                                                std::shared_ptr<CameraDataset> val_dataset,
@@ -381,9 +459,7 @@ namespace gs {
             result.num_gaussians = static_cast<int>(splatData.size());
             result.iteration = iteration;
 
-            const auto val_dataloader = make_dataloader(val_dataset);
-
-            std::vector<float> psnr_values, ssim_values, lpips_values;
+            std::vector<torch::Tensor> psnr_batches, ssim_batches, lpips_batches;
             const auto start_time = std::chrono::steady_clock::now();
 
             // Create directory for evaluation images
@@ -403,88 +479,133 @@ namespace gs {
             int image_idx = 0;
             const size_t val_dataset_size = val_dataset->size().value();
 
+            // Output buffers shared by all views of the same resolution
+            RenderOutput render_buffers;
+
+            // Renders and ground truths of equal size are scored together, and the
+            // per-image scores stay on the device until the end of the pass
+            const int64_t batch_size = std::max(_params.optimization.eval_batch_size, 1);
+            torch::Tensor pred_batch, gt_batch;
+            int64_t batch_fill = 0;
+            auto score_batch = [&]() {
+                if (batch_fill == 0)
+                    return;
+                const auto pred = pred_batch.narrow(0, 0, batch_fill);
+                const auto gt = gt_batch.narrow(0, 0, batch_fill);
+                psnr_batches.push_back(_psnr_metric->compute_per_image(pred, gt));
+                ssim_batches.push_back(_ssim_metric->compute_per_image(pred, gt));
+                lpips_batches.push_back(_lpips_metric->compute_per_image(pred, gt));
+                batch_fill = 0;
+            };
+
+            // Per-view render times come from CUDA events, read once the pass is done
+            std::vector<std::string> image_names;
+            std::vector<at::cuda::CUDAEvent> render_start, render_end;
+            const bool time_renders = background.is_cuda();
+
+            // The loader worker reads the next ground truths while the current view renders
+            auto val_dataloader = create_sequential_dataloader_from_dataset(val_dataset);
+
             for (auto& batch : *val_dataloader) {
                 auto camera_with_image = batch[0].data;
                 Camera* cam = camera_with_image.camera; // rasterize needs non-const Camera&
                 torch::Tensor gt_image = std::move(camera_with_image.image);
+                image_names.push_back(cam->image_name());
 
-                // Render with configured mode
-                auto r_output = gs::rasterize(
+                // Render with configured mode; no gradients are needed here
+                if (time_renders) {
+                    render_start.emplace_back(cudaEventDefault).record();
+                }
+                auto r_output = gs::rasterize_inference(
                     *cam,
                     splatData,
                     background,
                     1.0f,
-                    false,
-                    false,
-                    stringToRenderMode(_params.optimization.render_mode));
+                    stringToRenderMode(_params.optimization.render_mode),
+                    &render_buffers);
+                if (time_renders) {
+                    render_end.emplace_back(cudaEventDefault).record();
+                }
 
                 // Only compute metrics if we have RGB output
                 if (has_rgb()) {
-                    // Ensure correct dimensions
-                    if (r_output.image.dim() == 3)
-                        r_output.image = r_output.image.unsqueeze(0);
-                    if (gt_image.dim() == 3)
-                        gt_image = gt_image.unsqueeze(0);
-
-                    // Clamp rendered image to [0, 1]
-                    r_output.image = torch::clamp(r_output.image, 0.0, 1.0);
-
-                    // Compute metrics
-                    const float psnr = _psnr_metric->compute(r_output.image, gt_image);
-                    const float ssim = _ssim_metric->compute(r_output.image, gt_image);
-                    const float lpips = _lpips_metric->compute(r_output.image, gt_image);
-
-                    psnr_values.push_back(psnr);
-                    ssim_values.push_back(ssim);
-                    lpips_values.push_back(lpips);
+                    // Clamp rendered image to [0, 1]; this also copies it out of the reused buffers
+                    const auto image = torch::clamp(r_output.image.dim() == 4 ? r_output.image.squeeze(0) : r_output.image, 0.0, 1.0);
+                    if (gt_image.dim() == 4)
+                        gt_image = gt_image.squeeze(0);
+                    TORCH_CHECK(image.sizes() == gt_image.sizes(),
+                                "Rendered and ground truth images must have the same shape");
+
+                    if (!pred_batch.defined() || pred_batch.sizes().slice(1) != image.sizes()) {
+                        score_batch();
+                        auto batch_shape = image.sizes().vec();
+                        batch_shape.insert(batch_shape.begin(), batch_size);
+                        pred_batch = torch::empty(batch_shape, image.options());
+                        gt_batch = torch::empty(batch_shape, image.options());
+                    }
+                    pred_batch[batch_fill].copy_(image);
+                    gt_batch[batch_fill].copy_(gt_image);
+                    if (++batch_fill == batch_size) {
+                        score_batch();
+                    }
 
                     // Save side-by-side RGB images asynchronously
                     if (_params.optimization.enable_save_eval_images) {
-                        const std::vector<torch::Tensor> rgb_images = {gt_image.squeeze(0), r_output.image.squeeze(0)};
+                        const std::vector<torch::Tensor> rgb_images = {gt_image, image};
                         image_io::save_images_async(
                             eval_dir / (std::to_string(image_idx) + ".png"),
                             rgb_images,
                             true, // horizontal
                             4);   // separator width
                     }
+                    r_output.image = image;
                 }
 
                 // Only save depth if enabled and render mode includes depth
                 if (has_depth() && _params.optimization.enable_save_eval_images) {
                     if (r_output.depth.defined()) {
-                        auto depth_vis = r_output.depth.clone().squeeze(0).to(torch::kCPU); // [H, W]
-
-                        // Normalize depth
-                        const auto min_depth = depth_vis.min();
-                        const auto max_depth = depth_vis.max();
-                        const auto depth_normalized = (depth_vis - min_depth) / (max_depth - min_depth).clamp_min(1e-10);
-
-                        // Apply colormap
-                        const auto depth_colormap = apply_depth_colormap(depth_normalized);
+                        const auto depth = r_output.depth.squeeze(0).to(torch::kCPU, torch::kFloat32).contiguous(); // [H, W]
+                        TORCH_CHECK(depth.dim() == 2, "Expected a 2D depth map");
+                        const int H = static_cast<int>(depth.size(0));
+                        const int W = static_cast<int>(depth.size(1));
+                        const float* depth_data = depth.data_ptr<float>();
+
+                        // Min/max normalization is folded into the colormap lookup
+                        const auto [min_depth, max_depth] = image_io::finite_range(depth_data, depth.numel());
+                        auto colorize = [&](const torch::Tensor& panel, image_io::Colormap colormap) {
+                            image_io::apply_colormap(depth_data, H, W, min_depth, max_depth, colormap,
+                                                     panel.data_ptr<uint8_t>(), static_cast<size_t>(panel.stride(0)));
+                        };
 
                         // Optionally save RGB + Depth side by side (only if we have RGB)
                         if (has_rgb()) {
-                            const std::vector<torch::Tensor> rgb_depth_images = {r_output.image.squeeze(0), depth_colormap};
-                            image_io::save_images_async(
+                            constexpr int separator_width = 4;
+                            auto canvas = image_io::make_side_by_side_canvas(H, W, 2, separator_width);
+                            image_io::canvas_panel(canvas, 0, W, separator_width)
+                                .copy_((r_output.image.permute({1, 2, 0}) * 255).to(torch::kUInt8));
+                            colorize(image_io::canvas_panel(canvas, 1, W, separator_width), _depth_colormap);
+                            image_io::save_image_async(
                                 depth_dir / (std::to_string(image_idx) + "_rgb_depth.png"),
-                                rgb_depth_images,
-                                true, // horizontal
-                                4);   // separator width
+                                canvas);
                         } else {
                             // Save depth alone if no RGB
-                            const auto depth_gray_rgb = depth_normalized.unsqueeze(0).repeat({3, 1, 1});
+                            auto gray = image_io::make_side_by_side_canvas(H, W, 1, 0);
+                            colorize(gray, image_io::Colormap::Gray);
                             image_io::save_image_async(
                                 depth_dir / (std::to_string(image_idx) + "_gray.png"),
-                                depth_gray_rgb);
+                                gray);
+                            auto color = image_io::make_side_by_side_canvas(H, W, 1, 0);
+                            colorize(color, _depth_colormap);
                             image_io::save_image_async(
                                 depth_dir / (std::to_string(image_idx) + "_color.png"),
-                                depth_colormap);
+                                color);
                         }
                     }
                 }
 
                 image_idx++;
             }
+            score_batch();
 
             // Wait for all images to be saved before computing final timing
             if (_params.optimization.enable_save_eval_images) {
@@ -494,24 +615,55 @@ namespace gs {
                 }
             }
 
-            const auto end_time = std::chrono::steady_clock::now();
-            const auto elapsed = std::chrono::duration<float>(end_time - start_time).count();
+            std::vector<ViewRecord> views(image_names.size());
+            for (size_t i = 0; i < views.size(); ++i) {
+                views[i].iteration = iteration;
+                views[i].image = image_names[i];
+                views[i].psnr = views[i].ssim = views[i].lpips = std::numeric_limits<double>::quiet_NaN();
+                views[i].render_ms = std::numeric_limits<double>::quiet_NaN();
+            }
 
-            // Compute averages only if we have RGB metrics
-            if (has_rgb() && !psnr_values.empty()) {
-                result.psnr = std::accumulate(psnr_values.begin(), psnr_values.end(), 0.0f) / psnr_values.size();
-                result.ssim = std::accumulate(ssim_values.begin(), ssim_values.end(), 0.0f) / ssim_values.size();
-                result.lpips = std::accumulate(lpips_values.begin(), lpips_values.end(), 0.0f) / lpips_values.size();
+            // Compute averages only if we have RGB metrics; this is the only host sync
+            if (has_rgb() && !psnr_batches.empty()) {
+                const auto per_image = torch::stack({torch::cat(psnr_batches),
+                                                     torch::cat(ssim_batches),
+                                                     torch::cat(lpips_batches)})
+                                           .to(torch::kCPU);
+                const auto values = per_image.accessor<float, 2>();
+                double sums[3] = {0.0, 0.0, 0.0};
+                for (int64_t i = 0; i < per_image.size(1); ++i) {
+                    views[i].psnr = values[0][i];
+                    views[i].ssim = values[1][i];
+                    views[i].lpips = values[2][i];
+                    for (int m = 0; m < 3; ++m)
+                        sums[m] += values[m][i];
+                }
+                const double n = static_cast<double>(per_image.size(1));
+                result.psnr = static_cast<float>(sums[0] / n);
+                result.ssim = static_cast<float>(sums[1] / n);
+                result.lpips = static_cast<float>(sums[2] / n);
             } else {
                 // Set default values for depth-only modes
                 result.psnr = 0.0f;
                 result.ssim = 0.0f;
                 result.lpips = 0.0f;
             }
+
+            const auto end_time = std::chrono::steady_clock::now();
+            const auto elapsed = std::chrono::duration<float>(end_time - start_time).count();
             result.elapsed_time = elapsed / val_dataset_size;
 
+            // Depth-only passes have no read-back, so wait on the last event explicitly
+            if (!render_end.empty()) {
+                render_end.back().synchronize();
+            }
+            for (size_t i = 0; i < render_end.size(); ++i) {
+                views[i].render_ms = render_start[i].elapsed_time(render_end[i]);
+            }
+
             // Add metrics to reporter
             _reporter->add_metrics(result);
+            _reporter->add_view_metrics(views);
 
             if (_params.optimization.enable_save_eval_images) {
                 std::cout << "Saved " << image_idx << " evaluation images to: " << eval_dir << std::endl;
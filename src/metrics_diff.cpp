@@ -0,0 +1,272 @@
+#include "core/metrics_diff.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace gs {
+    namespace metrics {
+
+        namespace {
+            constexpr const char* kHeader = "iteration,image,psnr,ssim,lpips,render_ms";
+
+            std::vector<std::string> split_csv_line(const std::string& line) {
+                std::vector<std::string> fields;
+                std::stringstream ss(line);
+                std::string field;
+                while (std::getline(ss, field, ',')) {
+                    fields.push_back(field);
+                }
+                if (!line.empty() && line.back() == ',') {
+                    fields.emplace_back();
+                }
+                return fields;
+            }
+
+            double parse_value(const std::string& field) {
+                if (field.empty() || field == "nan") {
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+                return std::stod(field);
+            }
+
+            void write_value(std::ostream& out, double value) {
+                if (std::isfinite(value)) {
+                    out << value;
+                }
+            }
+        } // namespace
+
+        void append_per_view_csv(const std::filesystem::path& path, const std::vector<ViewRecord>& records) {
+            const bool write_header = !std::filesystem::exists(path);
+            std::ofstream file(path, std::ios::app);
+            if (!file) {
+                throw std::runtime_error("Failed to open " + path.string());
+            }
+            if (write_header) {
+                file << kHeader << "\n";
+            }
+            file << std::setprecision(8);
+            for (const auto& record : records) {
+                if (record.image.find(',') != std::string::npos) {
+                    throw std::invalid_argument("Image name contains a comma: " + record.image);
+                }
+                file << record.iteration << "," << record.image << ",";
+                write_value(file, record.psnr);
+                file << ",";
+                write_value(file, record.ssim);
+                file << ",";
+                write_value(file, record.lpips);
+                file << ",";
+                write_value(file, record.render_ms);
+                file << "\n";
+            }
+        }
+
+        std::vector<ViewRecord> read_per_view_csv(const std::filesystem::path& path, int iteration) {
+            std::ifstream file(path);
+            if (!file) {
+                throw std::runtime_error("Failed to open " + path.string());
+            }
+
+            std::string line;
+            if (!std::getline(file, line)) {
+                throw std::runtime_error("Empty per-view metrics file: " + path.string());
+            }
+            // Columns are looked up by name, so files with extra columns still read
+            std::map<std::string, size_t> columns;
+            const auto header = split_csv_line(line);
+            for (size_t i = 0; i < header.size(); ++i) {
+                columns[header[i]] = i;
+            }
+            for (const char* required : {"iteration", "image", "psnr", "ssim"}) {
+                if (!columns.count(required)) {
+                    throw std::runtime_error(path.string() + " has no '" + required + "' column");
+                }
+            }
+            auto field = [&](const std::vector<std::string>& fields, const std::string& name) -> std::string {
+                const auto it = columns.find(name);
+                return it != columns.end() && it->second < fields.size() ? fields[it->second] : std::string();
+            };
+
+            std::vector<ViewRecord> records;
+            while (std::getline(file, line)) {
+                if (line.empty())
+                    continue;
+                const auto fields = split_csv_line(line);
+                ViewRecord record;
+                record.iteration = std::stoi(field(fields, "iteration"));
+                record.image = field(fields, "image");
+                record.psnr = parse_value(field(fields, "psnr"));
+                record.ssim = parse_value(field(fields, "ssim"));
+                record.lpips = parse_value(field(fields, "lpips"));
+                record.render_ms = parse_value(field(fields, "render_ms"));
+                records.push_back(std::move(record));
+            }
+
+            if (iteration < 0 && !records.empty()) {
+                iteration = std::max_element(records.begin(), records.end(), [](const auto& a, const auto& b) {
+                                return a.iteration < b.iteration;
+                            })->iteration;
+            }
+            records.erase(std::remove_if(records.begin(), records.end(),
+                                         [iteration](const ViewRecord& r) { return r.iteration != iteration; }),
+                          records.end());
+            return records;
+        }
+
+        double wilcoxon_signed_rank_p(const std::vector<double>& degradations) {
+            std::vector<double> d;
+            for (double v : degradations) {
+                if (v != 0.0 && std::isfinite(v))
+                    d.push_back(v);
+            }
+            const size_t n = d.size();
+            if (n == 0) {
+                return 1.0;
+            }
+
+            // Average ranks of |d|, with the tie correction term of the variance
+            std::vector<size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return std::abs(d[a]) < std::abs(d[b]); });
+            double w_plus = 0.0;
+            double tie_term = 0.0;
+            for (size_t i = 0; i < n;) {
+                size_t j = i;
+                while (j + 1 < n && std::abs(d[order[j + 1]]) == std::abs(d[order[i]]))
+                    ++j;
+                const double rank = 0.5 * static_cast<double>(i + j) + 1.0;
+                for (size_t k = i; k <= j; ++k) {
+                    if (d[order[k]] > 0.0)
+                        w_plus += rank;
+                }
+                const double t = static_cast<double>(j - i + 1);
+                tie_term += t * t * t - t;
+                i = j + 1;
+            }
+
+            const double nd = static_cast<double>(n);
+            const double mean = nd * (nd + 1.0) / 4.0;
+            const double var = nd * (nd + 1.0) * (2.0 * nd + 1.0) / 24.0 - tie_term / 48.0;
+            if (var <= 0.0) {
+                return w_plus > mean ? 0.0 : 1.0;
+            }
+            const double z = (w_plus - mean - 0.5) / std::sqrt(var);
+            return 0.5 * std::erfc(z / std::sqrt(2.0));
+        }
+
+        DiffReport diff_runs(const std::vector<ViewRecord>& baseline,
+                             const std::vector<ViewRecord>& candidate,
+                             const DiffOptions& options) {
+            std::map<std::string, const ViewRecord*> by_image;
+            for (const auto& record : baseline) {
+                by_image[record.image] = &record;
+            }
+
+            DiffReport report;
+            std::vector<std::pair<const ViewRecord*, const ViewRecord*>> pairs;
+            for (const auto& record : candidate) {
+                const auto it = by_image.find(record.image);
+                if (it == by_image.end()) {
+                    ++report.candidate_only;
+                } else {
+                    pairs.emplace_back(it->second, &record);
+                }
+            }
+            report.matched_views = pairs.size();
+            report.baseline_only = by_image.size() - pairs.size();
+
+            struct Metric {
+                const char* name;
+                double ViewRecord::*field;
+                double threshold;
+                bool higher_is_better;
+                bool relative;
+            };
+            const Metric metrics[] = {
+                {"psnr", &ViewRecord::psnr, options.min_psnr_drop, true, false},
+                {"ssim", &ViewRecord::ssim, options.min_ssim_drop, true, false},
+                {"lpips", &ViewRecord::lpips, options.min_lpips_rise, false, false},
+                {"render_ms", &ViewRecord::render_ms, options.min_time_rise, false, true}};
+
+            for (const auto& metric : metrics) {
+                MetricDiff diff;
+                diff.metric = metric.name;
+                std::vector<double> degradations;
+                std::vector<std::pair<double, std::string>> per_view;
+                for (const auto& [base, cand] : pairs) {
+                    const double b = base->*metric.field;
+                    const double c = cand->*metric.field;
+                    if (!std::isfinite(b) || !std::isfinite(c) || (metric.relative && b <= 0.0))
+                        continue;
+                    double degradation = metric.higher_is_better ? b - c : c - b;
+                    if (metric.relative)
+                        degradation /= b;
+                    degradations.push_back(degradation);
+                    per_view.emplace_back(degradation, cand->image);
+                    diff.baseline_mean += b;
+                    diff.candidate_mean += c;
+                }
+                diff.views = degradations.size();
+                if (diff.views == 0) {
+                    continue; // not recorded in one of the runs
+                }
+
+                const double n = static_cast<double>(diff.views);
+                diff.baseline_mean /= n;
+                diff.candidate_mean /= n;
+                diff.mean_degradation = std::accumulate(degradations.begin(), degradations.end(), 0.0) / n;
+                diff.p_value = wilcoxon_signed_rank_p(degradations);
+                diff.worse_views = std::count_if(degradations.begin(), degradations.end(),
+                                                 [&](double v) { return v > metric.threshold; });
+                std::sort(per_view.begin(), per_view.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+                for (size_t i = 0; i < std::min<size_t>(3, per_view.size()) && per_view[i].first > 0.0; ++i) {
+                    diff.worst.push_back(per_view[i].second);
+                }
+                diff.regression = diff.p_value < options.alpha && diff.mean_degradation > metric.threshold;
+                report.metrics.push_back(std::move(diff));
+            }
+            return report;
+        }
+
+        bool DiffReport::has_regression() const {
+            return std::any_of(metrics.begin(), metrics.end(), [](const MetricDiff& m) { return m.regression; });
+        }
+
+        std::string DiffReport::to_string() const {
+            std::ostringstream ss;
+            ss << "Matched views: " << matched_views;
+            if (baseline_only > 0 || candidate_only > 0) {
+                ss << " (" << baseline_only << " only in baseline, " << candidate_only << " only in candidate)";
+            }
+            ss << "\n";
+            ss << std::left << std::setw(11) << "metric" << std::right
+               << std::setw(12) << "baseline" << std::setw(12) << "candidate" << std::setw(13) << "degradation"
+               << std::setw(11) << "p-value" << std::setw(8) << "worse"
+               << "  verdict\n";
+            ss << std::string(80, '-') << "\n";
+            for (const auto& m : metrics) {
+                ss << std::left << std::setw(11) << m.metric << std::right << std::fixed << std::setprecision(4)
+                   << std::setw(12) << m.baseline_mean << std::setw(12) << m.candidate_mean
+                   << std::setw(13) << m.mean_degradation << std::setw(11) << m.p_value
+                   << std::setw(4) << m.worse_views << "/" << std::left << std::setw(3) << m.views << std::right
+                   << "  " << (m.regression ? "REGRESSION" : "ok");
+                if (m.regression && !m.worst.empty()) {
+                    ss << " (worst:";
+                    for (const auto& image : m.worst)
+                        ss << " " << image;
+                    ss << ")";
+                }
+                ss << "\n";
+            }
+            return ss.str();
+        }
+
+    } // namespace metrics
+} // namespace gs
@@ -0,0 +1,76 @@
+#include "core/metrics_diff.hpp"
+#include <args.hxx>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    // Distinct from 1 so a pipeline can tell a regression from a failed comparison
+    constexpr int kExitError = 2;
+} // namespace
+
+// Compares the per-view metrics of two runs and exits with 1 when the
+// candidate regressed significantly, so it can gate a pipeline.
+int main(int argc, char* argv[]) {
+    ::args::ArgumentParser parser(
+        "Per-view regression check between two evaluation runs\n",
+        "Reads metrics_per_view.csv (or *_views.csv of the eval binary) of a baseline and a candidate run. "
+        "Exit code: 0 no regression, 1 regression, 2 error.");
+    ::args::HelpFlag help(parser, "help", "Display help menu", {'h', "help"});
+    ::args::Positional<std::string> baseline_path(parser, "baseline", "Per-view CSV of the baseline run");
+    ::args::Positional<std::string> candidate_path(parser, "candidate", "Per-view CSV of the candidate run");
+    ::args::ValueFlag<int> iteration(parser, "iteration", "Iteration to compare in both files (default: last)", {"iteration"});
+    ::args::ValueFlag<double> alpha(parser, "alpha", "One-sided significance level (default: 0.01)", {"alpha"});
+    ::args::ValueFlag<double> min_psnr_drop(parser, "dB", "Smallest mean PSNR drop that counts (default: 0.05)", {"min-psnr-drop"});
+    ::args::ValueFlag<double> min_ssim_drop(parser, "value", "Smallest mean SSIM drop that counts (default: 0.001)", {"min-ssim-drop"});
+    ::args::ValueFlag<double> min_lpips_rise(parser, "value", "Smallest mean LPIPS rise that counts (default: 0.001)", {"min-lpips-rise"});
+    ::args::ValueFlag<double> min_time_rise(parser, "ratio", "Smallest mean relative render time rise that counts (default: 0.05)", {"min-time-rise"});
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const ::args::Help&) {
+        std::cout << parser;
+        return 0;
+    } catch (const ::args::ParseError& e) {
+        std::cerr << "ERROR: " << e.what() << "\n\n"
+                  << parser;
+        return kExitError;
+    }
+
+    if (!baseline_path || !candidate_path) {
+        std::cerr << "ERROR: Both a baseline and a candidate file are required\n\n"
+                  << parser;
+        return kExitError;
+    }
+
+    try {
+        gs::metrics::DiffOptions options;
+        if (alpha)
+            options.alpha = ::args::get(alpha);
+        if (min_psnr_drop)
+            options.min_psnr_drop = ::args::get(min_psnr_drop);
+        if (min_ssim_drop)
+            options.min_ssim_drop = ::args::get(min_ssim_drop);
+        if (min_lpips_rise)
+            options.min_lpips_rise = ::args::get(min_lpips_rise);
+        if (min_time_rise)
+            options.min_time_rise = ::args::get(min_time_rise);
+
+        const int iter = iteration ? ::args::get(iteration) : -1;
+        const auto baseline = gs::metrics::read_per_view_csv(::args::get(baseline_path), iter);
+        const auto candidate = gs::metrics::read_per_view_csv(::args::get(candidate_path), iter);
+        if (baseline.empty() || candidate.empty()) {
+            throw std::runtime_error("No per-view records to compare");
+        }
+
+        const auto report = gs::metrics::diff_runs(baseline, candidate, options);
+        if (report.matched_views == 0) {
+            throw std::runtime_error("The runs have no views in common");
+        }
+        std::cout << report.to_string();
+        return report.has_regression() ? 1 : 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return kExitError;
+    }
+}
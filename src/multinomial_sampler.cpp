@@ -0,0 +1,91 @@
+#include "core/multinomial_sampler.hpp"
+#include <ATen/Parallel.h>
+#include <algorithm>
+
+namespace gs {
+
+    namespace {
+        // Largest category count torch::multinomial accepts
+        constexpr int64_t kTorchMultinomialLimit = int64_t{1} << 24;
+
+        torch::Tensor sample_with_replacement_cuda(const torch::Tensor& cdf,
+                                                   int64_t n,
+                                                   c10::optional<at::Generator> generator) {
+            const auto total = cdf[-1];
+            const auto u = torch::rand({n}, generator, cdf.options()) * total;
+            // right=true skips zero-weight entries, whose CDF equals their predecessor's
+            auto idx = torch::searchsorted(cdf, u, /*out_int32=*/false, /*right=*/true);
+            return idx.clamp_max_(cdf.size(0) - 1);
+        }
+
+        torch::Tensor sample_with_replacement_cpu(const torch::Tensor& cdf,
+                                                  int64_t n,
+                                                  c10::optional<at::Generator> generator) {
+            const int64_t N = cdf.size(0);
+            const double* cdf_data = cdf.data_ptr<double>();
+
+            // Sorted uniforms scaled to the CDF: normalized partial sums of n + 1
+            // exponentials are distributed like the order statistics of n uniforms
+            auto spacings = torch::empty({n + 1}, cdf.options()).exponential_(1.0, generator);
+            auto sorted_u = spacings.cumsum(0);
+            sorted_u = (sorted_u.slice(0, 0, n) * (cdf_data[N - 1] / sorted_u[n].item<double>())).contiguous();
+            const double* u_data = sorted_u.data_ptr<double>();
+
+            // The merge yields indices in ascending order; a random permutation
+            // restores i.i.d. draw order
+            const auto order = torch::randperm(n, generator, torch::kInt64);
+            const int64_t* order_data = order.data_ptr<int64_t>();
+
+            auto out = torch::empty({n}, torch::kInt64);
+            int64_t* out_data = out.data_ptr<int64_t>();
+            at::parallel_for(0, n, 1 << 14, [&](int64_t begin, int64_t end) {
+                // Each chunk finds its start in the CDF once, then walks forward
+                int64_t i = std::upper_bound(cdf_data, cdf_data + N, u_data[begin]) - cdf_data;
+                for (int64_t k = begin; k < end; ++k) {
+                    while (i < N - 1 && cdf_data[i] <= u_data[k]) {
+                        ++i;
+                    }
+                    out_data[order_data[k]] = std::min(i, N - 1);
+                }
+            });
+            return out;
+        }
+
+        torch::Tensor sample_without_replacement(const torch::Tensor& weights,
+                                                 int64_t n,
+                                                 c10::optional<at::Generator> generator) {
+            const auto opts = weights.options().dtype(torch::kFloat64);
+            const auto u = torch::rand({weights.size(0)}, generator, opts).clamp_min_(1e-300);
+            const auto keys = weights.to(torch::kFloat64).log() - (-u.log()).log();
+            return std::get<1>(keys.topk(n, /*dim=*/0, /*largest=*/true, /*sorted=*/false));
+        }
+    } // namespace
+
+    torch::Tensor multinomial_sample(const torch::Tensor& weights,
+                                     int64_t n,
+                                     bool replacement,
+                                     c10::optional<at::Generator> generator) {
+        TORCH_CHECK(weights.dim() == 1, "multinomial_sample expects 1D weights, got ", weights.sizes());
+        TORCH_CHECK(n >= 0, "multinomial_sample: number of samples must be non-negative, got ", n);
+        const int64_t N = weights.size(0);
+        TORCH_CHECK(N > 0, "multinomial_sample: weights must not be empty");
+        TORCH_CHECK(replacement || n <= N, "multinomial_sample: cannot draw ", n,
+                    " samples without replacement from ", N, " weights");
+
+        if (N <= kTorchMultinomialLimit) {
+            return torch::multinomial(weights, n, replacement, generator);
+        }
+        if (n == 0) {
+            return torch::empty({0}, weights.options().dtype(torch::kInt64));
+        }
+        if (!replacement) {
+            return sample_without_replacement(weights, n, generator);
+        }
+
+        // float64 keeps the CDF exact enough to resolve single weights at 10^8 entries
+        const auto cdf = weights.to(torch::kFloat64).cumsum(0).contiguous();
+        return weights.is_cpu() ? sample_with_replacement_cpu(cdf, n, generator)
+                                : sample_with_replacement_cuda(cdf, n, generator);
+    }
+
+} // namespace gs
@@ -0,0 +1,206 @@
+#include "core/offline_eval.hpp"
+#include "core/dataset.hpp"
+#include "core/metrics.hpp"
+#include "core/profiler.hpp"
+#include "core/rasterizer.hpp"
+#include "core/splat_data.hpp"
+#include "core/strategy_utils.hpp"
+#include <algorithm>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace gs {
+    namespace metrics {
+
+        namespace {
+            double fps(double ms) {
+                return ms > 0.0 ? 1000.0 / ms : 0.0;
+            }
+        } // namespace
+
+        FrameTimeStats summarize_frame_times(std::vector<double> frame_times_ms) {
+            FrameTimeStats stats;
+            if (frame_times_ms.empty()) {
+                return stats;
+            }
+            std::sort(frame_times_ms.begin(), frame_times_ms.end());
+            stats.samples = static_cast<int64_t>(frame_times_ms.size());
+            stats.mean_ms = std::accumulate(frame_times_ms.begin(), frame_times_ms.end(), 0.0) / frame_times_ms.size();
+            stats.min_ms = frame_times_ms.front();
+            stats.p50_ms = percentile(frame_times_ms, 0.50);
+            stats.p90_ms = percentile(frame_times_ms, 0.90);
+            stats.p99_ms = percentile(frame_times_ms, 0.99);
+            stats.max_ms = frame_times_ms.back();
+            return stats;
+        }
+
+        nlohmann::json FrameTimeStats::to_json() const {
+            // Slow frames are the high time percentiles, i.e. the low FPS ones
+            return {
+                {"samples", samples},
+                {"render_ms", {{"mean", mean_ms}, {"min", min_ms}, {"p50", p50_ms}, {"p90", p90_ms}, {"p99", p99_ms}, {"max", max_ms}}},
+                {"fps", {{"mean", fps(mean_ms)}, {"p50", fps(p50_ms)}, {"p10", fps(p90_ms)}, {"p1", fps(p99_ms)}}}};
+        }
+
+        nlohmann::json OfflineEvalResult::to_json() const {
+            nlohmann::json json;
+            json["ply"] = ply_path;
+            json["data_path"] = data_path;
+            json["num_gaussians"] = num_gaussians;
+            json["sh_degree"] = sh_degree;
+            json["num_views"] = views.size();
+            json["metrics"] = {{"psnr", psnr}, {"ssim", ssim}, {"lpips", has_lpips ? nlohmann::json(lpips) : nlohmann::json()}};
+            json["timing"] = frame_times.to_json();
+            json["memory"] = {{"model_bytes", model_bytes},
+                              {"peak_allocated_bytes", peak_allocated_bytes},
+                              {"peak_reserved_bytes", peak_reserved_bytes}};
+
+            auto& view_json = json["views"] = nlohmann::json::array();
+            for (const auto& view : views) {
+                nlohmann::json entry = {{"image", view.image_name},
+                                        {"width", view.width},
+                                        {"height", view.height},
+                                        {"psnr", view.psnr},
+                                        {"ssim", view.ssim},
+                                        {"render_ms", view.render_ms}};
+                entry["lpips"] = has_lpips ? nlohmann::json(view.lpips) : nlohmann::json();
+                view_json.push_back(std::move(entry));
+            }
+            return json;
+        }
+
+        std::vector<ViewRecord> OfflineEvalResult::view_records() const {
+            std::vector<ViewRecord> records;
+            records.reserve(views.size());
+            for (const auto& view : views) {
+                ViewRecord record;
+                record.image = view.image_name;
+                record.psnr = view.psnr;
+                record.ssim = view.ssim;
+                record.lpips = has_lpips ? view.lpips : std::numeric_limits<double>::quiet_NaN();
+                record.render_ms = view.render_ms;
+                records.push_back(std::move(record));
+            }
+            return records;
+        }
+
+        OfflineEvalResult run_offline_eval(const OfflineEvalConfig& config) {
+            TORCH_CHECK(torch::cuda::is_available(), "Offline evaluation needs a CUDA device");
+            TORCH_CHECK(config.timing_repeats > 0, "timing_repeats must be positive");
+            const torch::NoGradGuard no_grad;
+            const auto render_mode = stringToRenderMode(config.render_mode);
+            TORCH_CHECK(render_mode == RenderMode::RGB || render_mode == RenderMode::RGB_D || render_mode == RenderMode::RGB_ED,
+                        "Offline evaluation needs a render mode with color, got ", config.render_mode);
+
+            OfflineEvalResult result;
+            result.ply_path = config.ply_path.string();
+            result.data_path = config.dataset.data_path.string();
+
+            auto splat = SplatData::load_ply(config.ply_path);
+            strategy::to_device(splat, torch::kCUDA);
+            result.num_gaussians = splat.size();
+            result.sh_degree = splat.get_active_sh_degree();
+            result.model_bytes = strategy::parameter_bytes(splat);
+            std::cout << "Loaded " << result.num_gaussians << " Gaussians (SH degree " << result.sh_degree
+                      << ") from " << config.ply_path << std::endl;
+
+            auto [all_cameras, scene_center] = create_dataset_from_colmap(config.dataset);
+            auto dataset = config.all_views
+                               ? all_cameras
+                               : std::make_shared<CameraDataset>(all_cameras->get_cameras(), config.dataset, CameraDataset::Split::VAL);
+            const size_t num_views = dataset->size().value();
+            TORCH_CHECK(num_views > 0, "No views to evaluate in ", config.dataset.data_path.string());
+
+            auto background = torch::zeros({3}, torch::TensorOptions().dtype(torch::kFloat32).device(torch::kCUDA));
+            RenderOutput buffers;
+            auto render = [&](Camera& cam) {
+                return rasterize_inference(cam, splat, background, 1.0f, render_mode, &buffers, nullptr, config.tile_size);
+            };
+
+            // Warm up kernels and the allocator on the first view, then measure from a clean peak
+            {
+                auto first = dataset->get(0).data;
+                for (int i = 0; i < config.warmup_frames; ++i) {
+                    render(*first.camera);
+                }
+            }
+            torch::cuda::synchronize();
+            const auto device_index = static_cast<c10::DeviceIndex>(splat.means().device().index());
+            c10::cuda::CUDACachingAllocator::resetPeakStats(device_index);
+
+            // Timed pass. The metric networks are not loaded yet, so the peak is the render's own
+            std::vector<double> frame_times;
+            frame_times.reserve(num_views * config.timing_repeats);
+            for (size_t i = 0; i < num_views; ++i) {
+                // Loading sets the camera's resolution; the image itself is not needed here
+                Camera& cam = *dataset->get(i).data.camera;
+
+                std::vector<double> view_times;
+                for (int r = 0; r < config.timing_repeats; ++r) {
+                    torch::cuda::synchronize();
+                    const auto start = std::chrono::steady_clock::now();
+                    render(cam);
+                    torch::cuda::synchronize();
+                    view_times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                }
+                frame_times.insert(frame_times.end(), view_times.begin(), view_times.end());
+
+                ViewEvalResult view;
+                view.image_name = cam.image_name();
+                view.width = cam.image_width();
+                view.height = cam.image_height();
+                view.render_ms = summarize_frame_times(std::move(view_times)).p50_ms;
+                result.views.push_back(std::move(view));
+            }
+
+            const auto stats = c10::cuda::CUDACachingAllocator::getDeviceStats(device_index);
+            const auto aggregate = static_cast<size_t>(c10::CachingAllocator::StatType::AGGREGATE);
+            result.peak_allocated_bytes = stats.allocated_bytes[aggregate].peak;
+            result.peak_reserved_bytes = stats.reserved_bytes[aggregate].peak;
+            result.frame_times = summarize_frame_times(std::move(frame_times));
+
+            // Scoring pass, one more render per view
+            const PSNR psnr_metric(1.0f);
+            SSIM ssim_metric(11, 3);
+            std::unique_ptr<LPIPS> lpips_metric;
+            if (config.compute_lpips) {
+                lpips_metric = std::make_unique<LPIPS>("", lpips_precision_from_string(config.lpips_precision));
+            }
+            result.has_lpips = static_cast<bool>(lpips_metric);
+
+            std::vector<torch::Tensor> psnr_values, ssim_values, lpips_values;
+            for (size_t i = 0; i < num_views; ++i) {
+                auto example = dataset->get(i).data;
+                const auto gt_image = example.image.unsqueeze(0);
+
+                auto image = torch::clamp(render(*example.camera).image, 0.0, 1.0);
+                if (image.dim() == 3)
+                    image = image.unsqueeze(0);
+                psnr_values.push_back(psnr_metric.compute_per_image(image, gt_image));
+                ssim_values.push_back(ssim_metric.compute_per_image(image, gt_image));
+                if (lpips_metric)
+                    lpips_values.push_back(lpips_metric->compute_per_image(image, gt_image));
+            }
+
+            // One read-back for all per-view scores
+            const auto psnr = torch::cat(psnr_values).cpu();
+            const auto ssim = torch::cat(ssim_values).cpu();
+            const auto lpips = lpips_metric ? torch::cat(lpips_values).cpu() : torch::zeros({static_cast<int64_t>(num_views)});
+            for (size_t i = 0; i < num_views; ++i) {
+                result.views[i].psnr = psnr[i].item<float>();
+                result.views[i].ssim = ssim[i].item<float>();
+                result.views[i].lpips = lpips[i].item<float>();
+            }
+            result.psnr = psnr.mean().item<float>();
+            result.ssim = ssim.mean().item<float>();
+            result.lpips = lpips_metric ? lpips.mean().item<float>() : 0.f;
+            return result;
+        }
+
+    } // namespace metrics
+} // namespace gs
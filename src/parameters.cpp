@@ -99,6 +99,10 @@ namespace gs {
                     {"opacity_lr", defaults.opacity_lr, "Learning rate for opacity updates"},
                     {"scaling_lr", defaults.scaling_lr, "Learning rate for scaling updates"},
                     {"rotation_lr", defaults.rotation_lr, "Learning rate for rotation updates"},
+                    {"lr_schedule", defaults.lr_schedule, "Means learning rate schedule: constant, exponential, cosine, step"},
+                    {"lr_final_factor", defaults.lr_final_factor, "Final means learning rate relative to means_lr"},
+                    {"lr_step_every", defaults.lr_step_every, "Iterations between learning rate drops (step schedule)"},
+                    {"lr_warmup_steps", defaults.lr_warmup_steps, "Linear learning rate warmup iterations"},
                     {"lambda_dssim", defaults.lambda_dssim, "DSSIM loss weight"},
                     {"min_opacity", defaults.min_opacity, "Minimum opacity threshold"},
                     {"refine_every", defaults.refine_every, "Interval between densification steps"},
@@ -111,9 +115,24 @@ namespace gs {
                     {"init_scaling", defaults.init_scaling, "Initial scaling value for new Gaussians"},
                     {"sh_degree", defaults.sh_degree, "Spherical harmonics degree"},
                     {"max_cap", defaults.max_cap, "Maximum number of Gaussians for MCMC strategy"},
+                    {"growth_mode", defaults.growth_mode, "MCMC growth schedule: fixed, vram, step_time, count"},
+                    {"vram_budget", defaults.vram_budget, "Fraction of device memory the vram growth mode may fill"},
+                    {"step_time_budget_ms", defaults.step_time_budget_ms, "Iteration time the step_time growth mode targets"},
+                    {"strategy", defaults.strategy, "Densification strategy: mcmc, default"},
+                    {"opacity_reset_every", defaults.opacity_reset_every, "Opacity reset interval (default strategy)"},
+                    {"grow_scale3d", defaults.grow_scale3d, "Clone/split scale threshold relative to scene scale"},
+                    {"prune_scale3d", defaults.prune_scale3d, "Prune scale threshold relative to scene scale"},
                     {"render_mode", defaults.render_mode, "Render mode: RGB, D, ED, RGB_D, RGB_ED"},
+                    {"tile_size", defaults.tile_size, "Rasterizer tile size in pixels, 0 to auto-tune"},
                     {"enable_eval", defaults.enable_eval, "Enable evaluation during training"},
                     {"enable_save_eval_images", defaults.enable_save_eval_images, "Save images during evaluation"},
+                    {"eval_batch_size", defaults.eval_batch_size, "Number of views scored together during evaluation"},
+                    {"lpips_precision", defaults.lpips_precision, "LPIPS network precision (fp32, fp16, bf16)"},
+                    {"depth_colormap", defaults.depth_colormap, "Colormap of saved depth maps (jet, turbo, viridis, inferno, gray)"},
+                    {"eval_image_format", defaults.eval_image_format, "File format of saved evaluation images (png, jpg, raw)"},
+                    {"png_compression_level", defaults.png_compression_level, "zlib compression level of saved PNG images (0-9)"},
+                    {"image_writer_threads", defaults.image_writer_threads, "Number of threads encoding saved images"},
+                    {"image_writer_queue", defaults.image_writer_queue, "Images queued before evaluation waits for the writers"},
                     {"use_bilateral_grid", defaults.use_bilateral_grid, "Enable bilateral grid for appearance modeling"},
                     {"bilateral_grid_X", defaults.bilateral_grid_X, "Bilateral grid X dimension"},
                     {"bilateral_grid_Y", defaults.bilateral_grid_Y, "Bilateral grid Y dimension"},
@@ -122,7 +141,21 @@ namespace gs {
                     {"tv_loss_weight", defaults.tv_loss_weight, "Weight for total variation loss"},
                     {"steps_scaler", defaults.steps_scaler, "Scales the training steps and values"},
                     {"sh_degree_interval", defaults.sh_degree_interval, "Interval for increasing SH degree"},
-                    {"selective_adam", defaults.selective_adam, "Selective Adam optimizer flag"}};
+                    {"selective_adam", defaults.selective_adam, "Selective Adam optimizer flag"},
+                    {"seed", defaults.seed, "Seed for all random number generators"},
+                    {"deterministic", defaults.deterministic, "Use deterministic kernels and data order"},
+                    {"enable_compaction", defaults.enable_compaction, "Remove low-contribution Gaussians at the end of training"},
+                    {"compaction_min_weight", defaults.compaction_min_weight, "Minimum total blending weight, in pixels, to survive compaction"},
+                    {"compaction_finetune_steps", defaults.compaction_finetune_steps, "Training iterations after compaction"},
+                    {"collect_contribution_stats", defaults.collect_contribution_stats, "Accumulate per-Gaussian contribution statistics during training"},
+                    {"enable_early_stopping", defaults.enable_early_stopping, "Stop training once the validation PSNR or smoothed loss plateaus"},
+                    {"early_stop_every", defaults.early_stop_every, "Iterations between convergence checks"},
+                    {"early_stop_patience", defaults.early_stop_patience, "Convergence checks without improvement before stopping"},
+                    {"early_stop_min_gain", defaults.early_stop_min_gain, "Smallest improvement in dB that resets the patience"},
+                    {"early_stop_views", defaults.early_stop_views, "Validation views rendered per convergence check"},
+                    {"enable_profiling", defaults.enable_profiling, "Time the training stages and print a summary"},
+                    {"profile_trace", defaults.profile_trace, "Write a Chrome trace of the profiled stages to this path"},
+                    {"memory_report", defaults.memory_report, "Print the memory breakdown before training and at refine steps"}};
 
                 // Check all expected parameters
                 for (const auto& param : expected_params) {
@@ -266,6 +299,27 @@ namespace gs {
             if (json.contains("max_cap")) {
                 params.max_cap = json["max_cap"];
             }
+            if (json.contains("growth_mode")) {
+                params.growth_mode = json["growth_mode"];
+            }
+            if (json.contains("vram_budget")) {
+                params.vram_budget = json["vram_budget"];
+            }
+            if (json.contains("step_time_budget_ms")) {
+                params.step_time_budget_ms = json["step_time_budget_ms"];
+            }
+            if (json.contains("strategy")) {
+                params.strategy = json["strategy"];
+            }
+            if (json.contains("opacity_reset_every")) {
+                params.opacity_reset_every = json["opacity_reset_every"];
+            }
+            if (json.contains("grow_scale3d")) {
+                params.grow_scale3d = json["grow_scale3d"];
+            }
+            if (json.contains("prune_scale3d")) {
+                params.prune_scale3d = json["prune_scale3d"];
+            }
 
             // Handle render mode
             if (json.contains("render_mode")) {
@@ -280,6 +334,14 @@ namespace gs {
                 }
             }
 
+            if (json.contains("tile_size")) {
+                const int size = json["tile_size"];
+                if (size < 0 || size > 32) {
+                    throw std::runtime_error("tile_size must be 0 (auto) or between 1 and 32, got " + std::to_string(size));
+                }
+                params.tile_size = size;
+            }
+
             if (json.contains("eval_steps")) {
                 params.eval_steps.clear();
                 for (const auto& step : json["eval_steps"]) {
@@ -300,6 +362,27 @@ namespace gs {
             if (json.contains("enable_save_eval_images")) {
                 params.enable_save_eval_images = json["enable_save_eval_images"];
             }
+            if (json.contains("eval_batch_size")) {
+                params.eval_batch_size = json["eval_batch_size"];
+            }
+            if (json.contains("lpips_precision")) {
+                params.lpips_precision = json["lpips_precision"];
+            }
+            if (json.contains("depth_colormap")) {
+                params.depth_colormap = json["depth_colormap"];
+            }
+            if (json.contains("eval_image_format")) {
+                params.eval_image_format = json["eval_image_format"];
+            }
+            if (json.contains("png_compression_level")) {
+                params.png_compression_level = json["png_compression_level"];
+            }
+            if (json.contains("image_writer_threads")) {
+                params.image_writer_threads = json["image_writer_threads"];
+            }
+            if (json.contains("image_writer_queue")) {
+                params.image_writer_queue = json["image_writer_queue"];
+            }
             if (json.contains("use_bilateral_grid")) {
                 params.use_bilateral_grid = json["use_bilateral_grid"];
             }
@@ -327,6 +410,60 @@ namespace gs {
             if (json.contains("selective_adam")) {
                 params.selective_adam = json["selective_adam"];
             }
+            if (json.contains("seed")) {
+                params.seed = json["seed"];
+            }
+            if (json.contains("deterministic")) {
+                params.deterministic = json["deterministic"];
+            }
+            if (json.contains("enable_compaction")) {
+                params.enable_compaction = json["enable_compaction"];
+            }
+            if (json.contains("compaction_min_weight")) {
+                params.compaction_min_weight = json["compaction_min_weight"];
+            }
+            if (json.contains("compaction_finetune_steps")) {
+                params.compaction_finetune_steps = json["compaction_finetune_steps"];
+            }
+            if (json.contains("collect_contribution_stats")) {
+                params.collect_contribution_stats = json["collect_contribution_stats"];
+            }
+            if (json.contains("enable_early_stopping")) {
+                params.enable_early_stopping = json["enable_early_stopping"];
+            }
+            if (json.contains("early_stop_every")) {
+                params.early_stop_every = json["early_stop_every"];
+            }
+            if (json.contains("early_stop_patience")) {
+                params.early_stop_patience = json["early_stop_patience"];
+            }
+            if (json.contains("early_stop_min_gain")) {
+                params.early_stop_min_gain = json["early_stop_min_gain"];
+            }
+            if (json.contains("early_stop_views")) {
+                params.early_stop_views = json["early_stop_views"];
+            }
+            if (json.contains("enable_profiling")) {
+                params.enable_profiling = json["enable_profiling"];
+            }
+            if (json.contains("profile_trace")) {
+                params.profile_trace = json["profile_trace"];
+            }
+            if (json.contains("memory_report")) {
+                params.memory_report = json["memory_report"];
+            }
+            if (json.contains("lr_schedule")) {
+                params.lr_schedule = json["lr_schedule"];
+            }
+            if (json.contains("lr_final_factor")) {
+                params.lr_final_factor = json["lr_final_factor"];
+            }
+            if (json.contains("lr_step_every")) {
+                params.lr_step_every = json["lr_step_every"];
+            }
+            if (json.contains("lr_warmup_steps")) {
+                params.lr_warmup_steps = json["lr_warmup_steps"];
+            }
             return params;
         }
 
@@ -373,6 +510,10 @@ namespace gs {
             opt_json["opacity_lr"] = params.optimization.opacity_lr;
             opt_json["scaling_lr"] = params.optimization.scaling_lr;
             opt_json["rotation_lr"] = params.optimization.rotation_lr;
+            opt_json["lr_schedule"] = params.optimization.lr_schedule;
+            opt_json["lr_final_factor"] = params.optimization.lr_final_factor;
+            opt_json["lr_step_every"] = params.optimization.lr_step_every;
+            opt_json["lr_warmup_steps"] = params.optimization.lr_warmup_steps;
             opt_json["lambda_dssim"] = params.optimization.lambda_dssim;
             opt_json["min_opacity"] = params.optimization.min_opacity;
             opt_json["refine_every"] = params.optimization.refine_every;
@@ -385,11 +526,26 @@ namespace gs {
             opt_json["init_opacity"] = params.optimization.init_opacity;
             opt_json["init_scaling"] = params.optimization.init_scaling;
             opt_json["max_cap"] = params.optimization.max_cap;
+            opt_json["growth_mode"] = params.optimization.growth_mode;
+            opt_json["vram_budget"] = params.optimization.vram_budget;
+            opt_json["step_time_budget_ms"] = params.optimization.step_time_budget_ms;
+            opt_json["strategy"] = params.optimization.strategy;
+            opt_json["opacity_reset_every"] = params.optimization.opacity_reset_every;
+            opt_json["grow_scale3d"] = params.optimization.grow_scale3d;
+            opt_json["prune_scale3d"] = params.optimization.prune_scale3d;
             opt_json["render_mode"] = params.optimization.render_mode;
+            opt_json["tile_size"] = params.optimization.tile_size;
             opt_json["eval_steps"] = params.optimization.eval_steps;
             opt_json["save_steps"] = params.optimization.save_steps;
             opt_json["enable_eval"] = params.optimization.enable_eval;
             opt_json["enable_save_eval_images"] = params.optimization.enable_save_eval_images;
+            opt_json["eval_batch_size"] = params.optimization.eval_batch_size;
+            opt_json["lpips_precision"] = params.optimization.lpips_precision;
+            opt_json["depth_colormap"] = params.optimization.depth_colormap;
+            opt_json["eval_image_format"] = params.optimization.eval_image_format;
+            opt_json["png_compression_level"] = params.optimization.png_compression_level;
+            opt_json["image_writer_threads"] = params.optimization.image_writer_threads;
+            opt_json["image_writer_queue"] = params.optimization.image_writer_queue;
             opt_json["use_bilateral_grid"] = params.optimization.use_bilateral_grid;
             opt_json["bilateral_grid_X"] = params.optimization.bilateral_grid_X;
             opt_json["bilateral_grid_Y"] = params.optimization.bilateral_grid_Y;
@@ -399,6 +555,20 @@ namespace gs {
             opt_json["steps_scaler"] = params.optimization.steps_scaler;
             opt_json["sh_degree_interval"] = params.optimization.sh_degree_interval;
             opt_json["selective_adam"] = params.optimization.selective_adam;
+            opt_json["seed"] = params.optimization.seed;
+            opt_json["deterministic"] = params.optimization.deterministic;
+            opt_json["enable_compaction"] = params.optimization.enable_compaction;
+            opt_json["compaction_min_weight"] = params.optimization.compaction_min_weight;
+            opt_json["compaction_finetune_steps"] = params.optimization.compaction_finetune_steps;
+            opt_json["collect_contribution_stats"] = params.optimization.collect_contribution_stats;
+            opt_json["enable_early_stopping"] = params.optimization.enable_early_stopping;
+            opt_json["early_stop_every"] = params.optimization.early_stop_every;
+            opt_json["early_stop_patience"] = params.optimization.early_stop_patience;
+            opt_json["early_stop_min_gain"] = params.optimization.early_stop_min_gain;
+            opt_json["early_stop_views"] = params.optimization.early_stop_views;
+            opt_json["enable_profiling"] = params.optimization.enable_profiling;
+            opt_json["profile_trace"] = params.optimization.profile_trace;
+            opt_json["memory_report"] = params.optimization.memory_report;
 
             json["optimization"] = opt_json;
 
@@ -0,0 +1,219 @@
+#include "core/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace gs {
+
+    namespace {
+        thread_local Profiler* current_profiler = nullptr;
+    } // namespace
+
+    double percentile(const std::vector<double>& sorted, double q) {
+        const double pos = q * static_cast<double>(sorted.size() - 1);
+        const size_t lo = static_cast<size_t>(std::floor(pos));
+        const size_t hi = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (pos - static_cast<double>(lo)) * (sorted[hi] - sorted[lo]);
+    }
+
+    Profiler::Scope::Scope(Profiler* profiler)
+        : previous_(current_profiler) {
+        current_profiler = profiler;
+    }
+
+    Profiler::Scope::~Scope() {
+        current_profiler = previous_;
+    }
+
+    Profiler* Profiler::current() {
+        return current_profiler;
+    }
+
+    Profiler::Profiler(std::unique_ptr<DeviceTimer> device_timer, bool keep_trace, size_t max_trace_events)
+        : device_timer_(std::move(device_timer)),
+          keep_trace_(keep_trace),
+          max_trace_events_(max_trace_events),
+          origin_(std::chrono::steady_clock::now()) {
+    }
+
+    Profiler::~Profiler() {
+        // Return outstanding marks to the timer
+        if (device_timer_) {
+            for (const auto& span : pending_) {
+                if (span.start_mark >= 0)
+                    device_timer_->release(span.start_mark);
+                if (span.end_mark >= 0)
+                    device_timer_->release(span.end_mark);
+            }
+            if (base_mark_ >= 0)
+                device_timer_->release(base_mark_);
+        }
+    }
+
+    double Profiler::now_us() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin_).count();
+    }
+
+    uint64_t Profiler::begin(const char* name) {
+        Span span{name, open_depth_++, now_us()};
+        if (device_timer_) {
+            if (base_mark_ < 0) {
+                base_mark_ = device_timer_->record();
+                base_host_us_ = now_us();
+            }
+            span.start_mark = device_timer_->record();
+        }
+        pending_.push_back(span);
+        return first_pending_ + pending_.size() - 1;
+    }
+
+    void Profiler::end(uint64_t id) {
+        auto& span = pending_.at(static_cast<size_t>(id - first_pending_));
+        if (device_timer_) {
+            span.end_mark = device_timer_->record();
+        }
+        span.host_end_us = now_us();
+        --open_depth_;
+    }
+
+    void Profiler::fold(const Span& span) {
+        const double host_ms = (span.host_end_us - span.host_start_us) / 1000.0;
+        double duration_ms = host_ms;
+        double device_start_us = 0.0;
+        if (device_timer_) {
+            duration_ms = device_timer_->elapsed_ms(span.start_mark, span.end_mark);
+            device_start_us = base_host_us_ + 1000.0 * device_timer_->elapsed_ms(base_mark_, span.start_mark);
+            device_timer_->release(span.start_mark);
+            device_timer_->release(span.end_mark);
+        }
+
+        auto stage = std::find_if(stages_.begin(), stages_.end(), [&](const Stage& s) { return s.name == span.name; });
+        if (stage == stages_.end()) {
+            stages_.push_back({span.name, span.depth, {}, 0.0});
+            stage = stages_.end() - 1;
+        }
+        stage->durations_ms.push_back(duration_ms);
+        stage->host_total_ms += host_ms;
+
+        if (keep_trace_) {
+            const size_t needed = device_timer_ ? 2 : 1;
+            if (trace_.size() + needed > max_trace_events_) {
+                trace_truncated_ = true;
+                return;
+            }
+            trace_.push_back({span.name, span.host_start_us, host_ms * 1000.0, false});
+            if (device_timer_) {
+                trace_.push_back({span.name, device_start_us, duration_ms * 1000.0, true});
+            }
+        }
+    }
+
+    void Profiler::collect() {
+        // Spans close in reverse order of opening, so an open outer span holds
+        // back the ones after it until the next call
+        while (!pending_.empty()) {
+            const auto& span = pending_.front();
+            if (span.host_end_us < 0.0)
+                break;
+            if (device_timer_ && !device_timer_->ready(span.end_mark))
+                break;
+            fold(span);
+            pending_.pop_front();
+            ++first_pending_;
+        }
+    }
+
+    void Profiler::flush() {
+        if (device_timer_) {
+            device_timer_->synchronize();
+        }
+        collect();
+    }
+
+    std::vector<StageStats> Profiler::summary() {
+        flush();
+        std::vector<StageStats> result;
+        result.reserve(stages_.size());
+        for (const auto& stage : stages_) {
+            auto sorted = stage.durations_ms;
+            std::sort(sorted.begin(), sorted.end());
+            StageStats stats;
+            stats.name = stage.name;
+            stats.depth = stage.depth;
+            stats.count = static_cast<int64_t>(sorted.size());
+            stats.total_ms = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+            stats.mean_ms = stats.total_ms / static_cast<double>(sorted.size());
+            stats.p50_ms = percentile(sorted, 0.50);
+            stats.p90_ms = percentile(sorted, 0.90);
+            stats.p99_ms = percentile(sorted, 0.99);
+            stats.max_ms = sorted.back();
+            stats.host_mean_ms = stage.host_total_ms / static_cast<double>(sorted.size());
+            result.push_back(std::move(stats));
+        }
+        return result;
+    }
+
+    std::string Profiler::format_summary() {
+        const auto stages = summary();
+        std::ostringstream ss;
+        ss << "Stage timings (" << (device_timer_ ? "device" : "wall clock") << ", ms):\n";
+        ss << std::left << std::setw(26) << "stage" << std::right
+           << std::setw(9) << "calls" << std::setw(11) << "total s"
+           << std::setw(9) << "mean" << std::setw(9) << "p50" << std::setw(9) << "p90"
+           << std::setw(9) << "p99" << std::setw(9) << "max";
+        if (device_timer_) {
+            ss << std::setw(10) << "host";
+        }
+        ss << "\n";
+        for (const auto& s : stages) {
+            ss << std::left << std::setw(26) << (std::string(2 * s.depth, ' ') + s.name) << std::right
+               << std::setw(9) << s.count << std::fixed << std::setprecision(2)
+               << std::setw(11) << s.total_ms / 1000.0 << std::setprecision(3)
+               << std::setw(9) << s.mean_ms << std::setw(9) << s.p50_ms << std::setw(9) << s.p90_ms
+               << std::setw(9) << s.p99_ms << std::setw(9) << s.max_ms;
+            if (device_timer_) {
+                ss << std::setw(10) << s.host_mean_ms;
+            }
+            ss << "\n";
+        }
+        return ss.str();
+    }
+
+    nlohmann::json Profiler::chrome_trace() {
+        flush();
+        auto events = nlohmann::json::array();
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 0}, {"tid", 0}, {"args", {{"name", "host"}}}});
+        if (device_timer_) {
+            events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 0}, {"tid", 1}, {"args", {{"name", "device"}}}});
+        }
+        for (const auto& e : trace_) {
+            events.push_back({{"name", e.name},
+                              {"ph", "X"},
+                              {"pid", 0},
+                              {"tid", e.device ? 1 : 0},
+                              {"ts", e.start_us},
+                              {"dur", e.duration_us}});
+        }
+        nlohmann::json trace = {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+        if (trace_truncated_) {
+            trace["otherData"] = {{"truncated", true}, {"max_events", max_trace_events_}};
+        }
+        return trace;
+    }
+
+    void Profiler::write_chrome_trace(const std::filesystem::path& path) {
+        if (!keep_trace_) {
+            throw std::logic_error("Profiler was created without trace recording");
+        }
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Failed to open " + path.string());
+        }
+        file << chrome_trace().dump() << std::endl;
+    }
+
+} // namespace gs
@@ -0,0 +1,70 @@
+#include "core/profiler.hpp"
+#include <c10/cuda/CUDAStream.h>
+#include <cuda_runtime.h>
+#include <torch/torch.h>
+
+namespace gs {
+
+    namespace {
+        void check(cudaError_t err) {
+            TORCH_CHECK(err == cudaSuccess, "CUDA event error: ", cudaGetErrorString(err));
+        }
+
+        // Pooled timing-only events; a mark is an index into the pool
+        class CudaEventTimer final : public DeviceTimer {
+        public:
+            ~CudaEventTimer() override {
+                for (auto event : events_) {
+                    cudaEventDestroy(event);
+                }
+            }
+
+            int record() override {
+                int mark;
+                if (free_.empty()) {
+                    cudaEvent_t event;
+                    check(cudaEventCreateWithFlags(&event, cudaEventDefault));
+                    events_.push_back(event);
+                    mark = static_cast<int>(events_.size()) - 1;
+                } else {
+                    mark = free_.back();
+                    free_.pop_back();
+                }
+                check(cudaEventRecord(events_[mark], c10::cuda::getCurrentCUDAStream().stream()));
+                return mark;
+            }
+
+            bool ready(int mark) override {
+                const auto status = cudaEventQuery(events_[mark]);
+                if (status == cudaErrorNotReady) {
+                    return false;
+                }
+                check(status);
+                return true;
+            }
+
+            double elapsed_ms(int from, int to) override {
+                float ms = 0.f;
+                check(cudaEventElapsedTime(&ms, events_[from], events_[to]));
+                return ms;
+            }
+
+            void release(int mark) override {
+                free_.push_back(mark);
+            }
+
+            void synchronize() override {
+                check(cudaDeviceSynchronize());
+            }
+
+        private:
+            std::vector<cudaEvent_t> events_;
+            std::vector<int> free_;
+        };
+    } // namespace
+
+    std::unique_ptr<DeviceTimer> make_cuda_event_timer() {
+        return std::make_unique<CudaEventTimer>();
+    }
+
+} // namespace gs
@@ -0,0 +1,112 @@
+#include "core/raster_workspace.hpp"
+#include "core/memory_report.hpp"
+#include <algorithm>
+#include <c10/util/accumulate.h>
+#include <sstream>
+
+namespace gs {
+
+    namespace {
+        // Headroom when a buffer has to grow, so a slowly growing Gaussian count
+        // (MCMC adds a few percent per refine) does not reallocate every time
+        constexpr double kGrowthFactor = 1.25;
+
+        // Model shrink that makes fit() give the buffers back
+        constexpr int64_t kShrinkFactor = 2;
+
+        thread_local RasterWorkspace* current_workspace = nullptr;
+    } // namespace
+
+    RasterWorkspace::Scope::Scope(RasterWorkspace* workspace)
+        : previous_(current_workspace) {
+        current_workspace = workspace;
+    }
+
+    RasterWorkspace::Scope::~Scope() {
+        current_workspace = previous_;
+    }
+
+    RasterWorkspace* RasterWorkspace::current() {
+        return current_workspace;
+    }
+
+    torch::Tensor& RasterWorkspace::reserve(Slot slot, int64_t numel, const torch::TensorOptions& options) {
+        auto& buffer = buffers_[static_cast<size_t>(slot)];
+        const bool compatible = buffer.defined() &&
+                                buffer.dtype() == options.dtype() &&
+                                buffer.device() == options.device();
+        if (compatible && buffer.numel() >= numel) {
+            ++total_reuses_;
+            return buffer;
+        }
+
+        const int64_t capacity = compatible ? static_cast<int64_t>(numel * kGrowthFactor) : numel;
+        buffer = torch::Tensor(); // release the old block before asking for a larger one
+        buffer = torch::empty({capacity}, options);
+        if (capacity > 0) {
+            ++step_allocations_;
+            ++total_allocations_;
+        }
+        return buffer;
+    }
+
+    torch::Tensor RasterWorkspace::get(Slot slot, c10::IntArrayRef sizes, const torch::TensorOptions& options) {
+        const auto& buffer = reserve(slot, c10::multiply_integers(sizes), options);
+
+        // set_ aliases the storage without creating a view, so autograd treats the
+        // result like any freshly allocated output
+        auto out = torch::empty({0}, options);
+        out.set_(buffer.storage(), 0, sizes);
+        return out;
+    }
+
+    torch::Tensor RasterWorkspace::isect_ids_buffer(const torch::Device& device) {
+        return get(Slot::IsectIds, {2, isect_capacity_}, torch::TensorOptions().dtype(torch::kInt64).device(device));
+    }
+
+    torch::Tensor RasterWorkspace::flatten_ids_buffer(const torch::Device& device) {
+        return get(Slot::FlattenIds, {2, isect_capacity_}, torch::TensorOptions().dtype(torch::kInt32).device(device));
+    }
+
+    void RasterWorkspace::record_isects(int64_t n_isects) {
+        if (n_isects <= isect_capacity_) {
+            return;
+        }
+        // intersect_tile could not use the buffers and allocated both id arrays itself
+        step_allocations_ += 2;
+        total_allocations_ += 2;
+        isect_capacity_ = static_cast<int64_t>(n_isects * kGrowthFactor);
+    }
+
+    void RasterWorkspace::release() {
+        for (auto& buffer : buffers_) {
+            buffer = torch::Tensor();
+        }
+        peak_gaussians_ = 0;
+    }
+
+    void RasterWorkspace::fit(int64_t n_gaussians) {
+        if (n_gaussians * kShrinkFactor < peak_gaussians_) {
+            release();
+        }
+        peak_gaussians_ = std::max(peak_gaussians_, n_gaussians);
+    }
+
+    std::string RasterWorkspace::summary() const {
+        std::ostringstream ss;
+        ss << "raster workspace: " << total_reuses_ << " reuses, " << total_allocations_ << " allocations ("
+           << step_allocations_ << " this step), " << format_bytes(static_cast<double>(reserved_bytes())) << " reserved";
+        return ss.str();
+    }
+
+    size_t RasterWorkspace::reserved_bytes() const {
+        size_t bytes = 0;
+        for (const auto& buffer : buffers_) {
+            if (buffer.defined()) {
+                bytes += buffer.nbytes();
+            }
+        }
+        return bytes;
+    }
+
+} // namespace gs
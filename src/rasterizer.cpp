@@ -1,6 +1,11 @@
 #include "core/rasterizer.hpp"
 #include "Ops.h"
 #include "core/rasterizer_autograd.hpp"
+#include "core/profiler.hpp"
+#include "core/rasterizer_cpu.hpp"
+#include "core/tile_size_tuner.hpp"
+#include <iostream>
+#include <mutex>
 #include <torch/torch.h>
 
 namespace gs {
@@ -40,6 +45,182 @@ namespace gs {
             masks.defined() ? masks.contiguous() : masks)[0];
     }
 
+    namespace {
+
+        // Picks the per-Gaussian features and background composited for render_mode.
+        // Returns render_colors [C, N, channels] and backgrounds [C, channels] (or empty).
+        std::tuple<torch::Tensor, torch::Tensor> prepare_render_features(
+            RenderMode render_mode,
+            const torch::Tensor& colors,
+            const torch::Tensor& depths,
+            const torch::Tensor& prepared_bg_color) {
+
+            torch::Tensor render_colors;
+            torch::Tensor final_bg;
+
+            switch (render_mode) {
+            case RenderMode::RGB:
+                render_colors = colors;
+                final_bg = prepared_bg_color;
+                break;
+
+            case RenderMode::D:
+            case RenderMode::ED:
+                render_colors = depths.unsqueeze(-1); // [C, N, 1]
+                if (prepared_bg_color.defined()) {
+                    final_bg = torch::zeros({1, 1}, prepared_bg_color.options());
+                } else {
+                    final_bg = torch::Tensor(); // Keep undefined
+                }
+                break;
+
+            case RenderMode::RGB_D:
+            case RenderMode::RGB_ED:
+                // Concatenate colors and depths
+                render_colors = torch::cat({colors, depths.unsqueeze(-1)}, -1); // [C, N, 4]
+                if (prepared_bg_color.defined()) {
+                    final_bg = torch::cat({prepared_bg_color, torch::zeros({1, 1}, prepared_bg_color.options())}, -1);
+                } else {
+                    final_bg = torch::Tensor(); // Keep undefined
+                }
+                break;
+            }
+
+            if (!final_bg.defined()) {
+                // Create empty tensor on CUDA - same pattern as compensations in projection
+                final_bg = at::empty({0}, colors.options().dtype(torch::kFloat32));
+            }
+
+            return {render_colors, final_bg};
+        }
+
+        // Copies src into buffer when the shapes match so the caller's storage is
+        // reused; otherwise src itself becomes the output.
+        torch::Tensor write_into(const torch::Tensor& src, const torch::Tensor& buffer) {
+            if (buffer.defined() && buffer.sizes() == src.sizes() &&
+                buffer.dtype() == src.dtype() && buffer.device() == src.device()) {
+                return buffer.copy_(src);
+            }
+            return src;
+        }
+
+        // Splits the composited [C, H, W, channels] output into image/alpha/depth [channels, H, W].
+        // With reuse, results are written into its buffers whenever they fit.
+        void finalize_render_output(
+            RenderMode render_mode,
+            const torch::Tensor& rendered_image,
+            const torch::Tensor& rendered_alpha,
+            const RenderOutput* reuse,
+            RenderOutput& result) {
+
+            torch::Tensor final_image, final_depth;
+
+            switch (render_mode) {
+            case RenderMode::RGB:
+                final_image = rendered_image;
+                final_depth = torch::Tensor(); // Empty
+                break;
+
+            case RenderMode::D:
+                final_depth = rendered_image;  // It's actually depth
+                final_image = torch::Tensor(); // Empty
+                break;
+
+            case RenderMode::ED:
+                // Normalize accumulated depth by alpha to get expected depth
+                final_depth = rendered_image / rendered_alpha.clamp_min(1e-10);
+                final_image = torch::Tensor(); // Empty
+                break;
+
+            case RenderMode::RGB_D:
+                final_image = rendered_image.index({Slice(), Slice(), Slice(), Slice(None, -1)});
+                final_depth = rendered_image.index({Slice(), Slice(), Slice(), Slice(-1, None)});
+                break;
+
+            case RenderMode::RGB_ED:
+                final_image = rendered_image.index({Slice(), Slice(), Slice(), Slice(None, -1)});
+                auto accum_depth = rendered_image.index({Slice(), Slice(), Slice(), Slice(-1, None)});
+                final_depth = accum_depth / rendered_alpha.clamp_min(1e-10);
+                break;
+            }
+
+            // Handle image output
+            if (final_image.defined() && final_image.numel() > 0) {
+                auto image = final_image.squeeze(0).permute({2, 0, 1});
+                if (reuse && reuse->image.defined() && reuse->image.sizes() == image.sizes() &&
+                    reuse->image.device() == image.device()) {
+                    result.image = reuse->image;
+                    torch::clamp_out(result.image, image, 0.0f, 1.0f);
+                } else {
+                    result.image = torch::clamp(image, 0.0f, 1.0f);
+                }
+            } else {
+                result.image = torch::Tensor();
+            }
+
+            // Handle alpha output - always present
+            auto alpha = rendered_alpha.squeeze(0).permute({2, 0, 1});
+            result.alpha = reuse ? write_into(alpha, reuse->alpha) : alpha;
+
+            // Handle depth output
+            if (final_depth.defined() && final_depth.numel() > 0) {
+                auto depth = final_depth.squeeze(0).permute({2, 0, 1});
+                result.depth = reuse ? write_into(depth, reuse->depth) : depth;
+            } else {
+                result.depth = torch::Tensor();
+            }
+        }
+
+        // gsplat tile binning into the workspace buffers when one is given.
+        // Returns tiles_per_gauss, isect_ids, flatten_ids and isect_offsets [1, tile_height, tile_width].
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor> intersect_tiles(
+            const torch::Tensor& means2d,
+            const torch::Tensor& radii,
+            const torch::Tensor& depths,
+            int tile_size,
+            int tile_width,
+            int tile_height,
+            RasterWorkspace* workspace) {
+
+            at::optional<at::Tensor> tiles_per_gauss_out, isect_ids_buffer, flatten_ids_buffer, offsets_out;
+            if (workspace) {
+                using Slot = RasterWorkspace::Slot;
+                tiles_per_gauss_out = workspace->get(Slot::TilesPerGauss, depths.sizes(), depths.options().dtype(torch::kInt32));
+                isect_ids_buffer = workspace->isect_ids_buffer(depths.device());
+                flatten_ids_buffer = workspace->flatten_ids_buffer(depths.device());
+                offsets_out = workspace->get(Slot::IsectOffsets, {1, tile_height, tile_width},
+                                             depths.options().dtype(torch::kInt32));
+            }
+
+            auto [tiles_per_gauss, isect_ids, flatten_ids] = gsplat::intersect_tile(
+                means2d, radii, depths, {}, {},
+                1, tile_size, tile_width, tile_height,
+                true,
+                tiles_per_gauss_out, isect_ids_buffer, flatten_ids_buffer);
+            if (workspace) {
+                workspace->record_isects(isect_ids.numel());
+            }
+
+            auto isect_offsets = gsplat::intersect_offset(isect_ids, 1, tile_width, tile_height, offsets_out)
+                                     .reshape({1, tile_height, tile_width});
+            return {tiles_per_gauss, isect_ids, flatten_ids, isect_offsets};
+        }
+
+        // Applies fit_tile_size and reports the first fallback it forces
+        int checked_tile_size(int tile_size, int image_width, int image_height) {
+            const int fitted = fit_tile_size(tile_size, image_width, image_height);
+            if (fitted != tile_size) {
+                static std::once_flag warned;
+                std::call_once(warned, [&] {
+                    std::cerr << "Warning: tile_size " << tile_size << " gives too many tiles for "
+                              << image_width << "x" << image_height << ", using " << fitted << std::endl;
+                });
+            }
+            return fitted;
+        }
+
+    } // namespace
+
     // Main render function
     RenderOutput rasterize(
         Camera& viewpoint_camera,
@@ -48,7 +229,9 @@ namespace gs {
         float scaling_modifier,
         bool packed,
         bool antialiased,
-        RenderMode render_mode) {
+        RenderMode render_mode,
+        RasterWorkspace* workspace,
+        int tile_size) {
 
         // Ensure we don't use packed mode (not supported in this implementation)
         TORCH_CHECK(!packed, "Packed mode is not supported in this implementation");
@@ -57,23 +240,35 @@ namespace gs {
         const int image_height = static_cast<int>(viewpoint_camera.image_height());
         const int image_width = static_cast<int>(viewpoint_camera.image_width());
 
+        // The backend follows the Gaussians: CUDA kernels, or the CPU reference backend
+        const auto device = gaussian_model.get_means().device();
+        const bool use_cpu = device.is_cpu();
+
+        // The workspace only backs the CUDA kernels' buffers
+        if (use_cpu) {
+            TORCH_CHECK(!antialiased, "Antialiased rendering is not supported by the CPU backend");
+            workspace = nullptr;
+        }
+        RasterWorkspace::Scope workspace_scope(workspace);
+
         // Prepare viewmat and K
-        auto viewmat = viewpoint_camera.world_view_transform().to(torch::kCUDA);
+        auto viewmat = viewpoint_camera.world_view_transform().to(device);
         TORCH_CHECK(viewmat.dim() == 3 && viewmat.size(0) == 1 && viewmat.size(1) == 4 && viewmat.size(2) == 4,
                     "viewmat must be [1, 4, 4] after transpose and unsqueeze, got ", viewmat.sizes());
-        TORCH_CHECK(viewmat.is_cuda(), "viewmat must be on CUDA");
 
-        const auto K = viewpoint_camera.K().to(torch::kCUDA);
-        TORCH_CHECK(K.is_cuda(), "K must be on CUDA");
+        const auto K = viewpoint_camera.K().to(device);
 
-        // Get Gaussian parameters
+        // Get Gaussian parameters. Opacity, scale (with the scaling modifier folded in)
+        // and rotation activations run as one fused pass instead of three getters.
         auto means3D = gaussian_model.get_means();
-        auto opacities = gaussian_model.get_opacity();
-        if (opacities.dim() == 2 && opacities.size(1) == 1) {
-            opacities = opacities.squeeze(-1);
-        }
-        const auto scales = gaussian_model.get_scaling();
-        const auto rotations = gaussian_model.get_rotation();
+        auto activated = FusedActivationFunction::apply(
+            gaussian_model.opacity_raw(),
+            gaussian_model.scaling_raw(),
+            gaussian_model.rotation_raw(),
+            static_cast<double>(scaling_modifier));
+        const auto opacities = activated[0];
+        const auto scales = activated[1];
+        const auto rotations = activated[2];
         const auto sh_coeffs = gaussian_model.get_shs();
         const int sh_degree = gaussian_model.get_active_sh_degree();
 
@@ -97,11 +292,10 @@ namespace gs {
                     " but got ", sh_coeffs.size(1));
 
         // Device checks for Gaussian parameters
-        TORCH_CHECK(means3D.is_cuda(), "means3D must be on CUDA");
-        TORCH_CHECK(opacities.is_cuda(), "opacities must be on CUDA");
-        TORCH_CHECK(scales.is_cuda(), "scales must be on CUDA");
-        TORCH_CHECK(rotations.is_cuda(), "rotations must be on CUDA");
-        TORCH_CHECK(sh_coeffs.is_cuda(), "sh_coeffs must be on CUDA");
+        TORCH_CHECK(opacities.device() == device, "opacities must be on ", device);
+        TORCH_CHECK(scales.device() == device, "scales must be on ", device);
+        TORCH_CHECK(rotations.device() == device, "rotations must be on ", device);
+        TORCH_CHECK(sh_coeffs.device() == device, "sh_coeffs must be on ", device);
 
         // Handle background color - can be undefined
         torch::Tensor prepared_bg_color;
@@ -109,44 +303,56 @@ namespace gs {
             // Keep it undefined
             prepared_bg_color = torch::Tensor();
         } else {
-            prepared_bg_color = bg_color.view({1, -1}).to(torch::kCUDA);
+            prepared_bg_color = bg_color.view({1, -1}).to(device);
             TORCH_CHECK(prepared_bg_color.size(0) == 1 && prepared_bg_color.size(1) == 3,
                         "bg_color must be reshapeable to [1, 3], got ", prepared_bg_color.sizes());
-            TORCH_CHECK(prepared_bg_color.is_cuda(), "bg_color must be on CUDA");
         }
 
         const float eps2d = 0.3f;
         const float near_plane = 0.01f;
         const float far_plane = 10000.0f;
         const float radius_clip = 0.0f;
-        const int tile_size = 16;
+        tile_size = checked_tile_size(tile_size, image_width, image_height);
         const bool calc_compensations = antialiased;
 
         // Step 1: Projection
-        auto proj_settings = torch::tensor({(float)image_width,
-                                            (float)image_height,
-                                            eps2d,
-                                            near_plane,
-                                            far_plane,
-                                            radius_clip,
-                                            scaling_modifier},
-                                           torch::TensorOptions().dtype(torch::kFloat32).device(torch::kCUDA));
-
-        auto proj_outputs = ProjectionFunction::apply(
-            means3D, rotations, scales, opacities, viewmat, K, proj_settings);
-
-        auto radii = proj_outputs[0];
-        auto means2d = proj_outputs[1];
-        auto depths = proj_outputs[2];
-        auto conics = proj_outputs[3];
-        auto compensations = proj_outputs[4];
-
-        // Create means2d with gradient tracking for backward compatibility
-        auto means2d_with_grad = means2d.squeeze(0).contiguous();
-        means2d_with_grad.set_requires_grad(true);
-        means2d_with_grad.retain_grad();
+        Profiler::ScopedTimer projection_timer("projection");
+        torch::Tensor radii, means2d, depths, conics, compensations;
+        if (use_cpu) {
+            std::tie(radii, means2d, depths, conics) = cpu::projection(
+                means3D, rotations, scales, opacities, viewmat, K,
+                image_width, image_height, eps2d, near_plane, far_plane, radius_clip);
+        } else {
+            auto proj_settings = torch::tensor({(float)image_width,
+                                                (float)image_height,
+                                                eps2d,
+                                                near_plane,
+                                                far_plane,
+                                                radius_clip,
+                                                1.0f}, // scaling_modifier already applied
+                                               torch::TensorOptions().dtype(torch::kFloat32).device(torch::kCUDA));
+
+            auto proj_outputs = ProjectionFunction::apply(
+                means3D, rotations, scales, opacities, viewmat, K, proj_settings);
+
+            radii = proj_outputs[0];
+            means2d = proj_outputs[1];
+            depths = proj_outputs[2];
+            conics = proj_outputs[3];
+            compensations = proj_outputs[4];
+        }
+
+        // Route the rasterizer input through an [N, 2] view that keeps its gradient,
+        // so densification strategies can read the screen-space gradients
+        auto means2d_with_grad = means2d.squeeze(0);
+        if (means2d_with_grad.requires_grad()) {
+            means2d_with_grad.retain_grad();
+        }
+        means2d = means2d_with_grad.unsqueeze(0);
+        projection_timer.stop();
 
         // Step 2: Compute colors from SH
+        Profiler::ScopedTimer sh_timer("sh");
         // First, compute camera position from inverse viewmat
         auto viewmat_inv = torch::inverse(viewmat);
         auto campos = viewmat_inv.index({Slice(), Slice(None, 3), 3}); // [C, 3]
@@ -161,47 +367,15 @@ namespace gs {
         auto shs = sh_coeffs.unsqueeze(0); // [1, N, K, 3]
 
         // Now call spherical harmonics with proper directions
-        auto colors = spherical_harmonics(sh_degree, dirs, shs, masks); // [C, N, 3]
+        auto colors = use_cpu ? cpu::spherical_harmonics(sh_degree, dirs, shs, masks)
+                              : spherical_harmonics(sh_degree, dirs, shs, masks); // [C, N, 3]
 
         // Apply the SH offset and clamping for rendering (shift from [-0.5, 0.5] to [0, 1])
         colors = torch::clamp_min(colors + 0.5f, 0.0f);
+        sh_timer.stop();
 
         // Step 3: Handle depth based on render mode
-        torch::Tensor render_colors;
-        torch::Tensor final_bg;
-
-        switch (render_mode) {
-        case RenderMode::RGB:
-            render_colors = colors;
-            final_bg = prepared_bg_color;
-            break;
-
-        case RenderMode::D:
-        case RenderMode::ED:
-            render_colors = depths.unsqueeze(-1); // [C, N, 1]
-            if (prepared_bg_color.defined()) {
-                final_bg = torch::zeros({1, 1}, prepared_bg_color.options());
-            } else {
-                final_bg = torch::Tensor(); // Keep undefined
-            }
-            break;
-
-        case RenderMode::RGB_D:
-        case RenderMode::RGB_ED:
-            // Concatenate colors and depths
-            render_colors = torch::cat({colors, depths.unsqueeze(-1)}, -1); // [C, N, 4]
-            if (prepared_bg_color.defined()) {
-                final_bg = torch::cat({prepared_bg_color, torch::zeros({1, 1}, prepared_bg_color.options())}, -1);
-            } else {
-                final_bg = torch::Tensor(); // Keep undefined
-            }
-            break;
-        }
-
-        if (!final_bg.defined()) {
-            // Create empty tensor on CUDA - same pattern as compensations in projection
-            final_bg = at::empty({0}, colors.options().dtype(torch::kFloat32));
-        }
+        auto [render_colors, final_bg] = prepare_render_features(render_mode, colors, depths, prepared_bg_color);
 
         // Step 4: Apply opacity with compensations
         torch::Tensor final_opacities;
@@ -210,116 +384,190 @@ namespace gs {
         } else {
             final_opacities = opacities.unsqueeze(0);
         }
-        TORCH_CHECK(final_opacities.is_cuda(), "final_opacities must be on CUDA");
+        TORCH_CHECK(final_opacities.device() == device, "final_opacities must be on ", device);
 
         // Step 5: Tile intersection
+        Profiler::ScopedTimer intersect_timer("intersect");
         const int tile_width = (image_width + tile_size - 1) / tile_size;
         const int tile_height = (image_height + tile_size - 1) / tile_size;
 
-        const auto isect_results = gsplat::intersect_tile(
-            means2d, radii, depths, {}, {},
-            1, tile_size, tile_width, tile_height,
-            true);
-
-        const auto tiles_per_gauss = std::get<0>(isect_results);
-        const auto isect_ids = std::get<1>(isect_results);
-        const auto flatten_ids = std::get<2>(isect_results);
-
-        auto isect_offsets = gsplat::intersect_offset(
-            isect_ids, 1, tile_width, tile_height);
-        isect_offsets = isect_offsets.reshape({1, tile_height, tile_width});
+        torch::Tensor tiles_per_gauss, isect_ids, flatten_ids, isect_offsets;
+        if (use_cpu) {
+            std::tie(tiles_per_gauss, isect_ids, flatten_ids) =
+                cpu::intersect_tile(means2d, radii, depths, tile_size, tile_width, tile_height);
+            isect_offsets = cpu::intersect_offset(isect_ids, 1, tile_width, tile_height)
+                                .reshape({1, tile_height, tile_width});
+        } else {
+            std::tie(tiles_per_gauss, isect_ids, flatten_ids, isect_offsets) =
+                intersect_tiles(means2d, radii, depths, tile_size, tile_width, tile_height, workspace);
+        }
 
-        TORCH_CHECK(tiles_per_gauss.is_cuda(), "tiles_per_gauss must be on CUDA");
-        TORCH_CHECK(isect_ids.is_cuda(), "isect_ids must be on CUDA");
-        TORCH_CHECK(flatten_ids.is_cuda(), "flatten_ids must be on CUDA");
-        TORCH_CHECK(isect_offsets.is_cuda(), "isect_offsets must be on CUDA");
+        TORCH_CHECK(tiles_per_gauss.device() == device, "tiles_per_gauss must be on ", device);
+        TORCH_CHECK(isect_ids.device() == device, "isect_ids must be on ", device);
+        TORCH_CHECK(flatten_ids.device() == device, "flatten_ids must be on ", device);
+        TORCH_CHECK(isect_offsets.device() == device, "isect_offsets must be on ", device);
+        intersect_timer.stop();
 
         // Step 6: Rasterization
-        auto raster_settings = torch::tensor({(float)image_width,
-                                              (float)image_height,
-                                              (float)tile_size},
-                                             torch::TensorOptions().dtype(torch::kFloat32).device(torch::kCUDA));
-
-        auto raster_outputs = RasterizationFunction::apply(
-            means2d, conics, render_colors, final_opacities, final_bg,
-            isect_offsets, flatten_ids, raster_settings);
-
-        auto rendered_image = raster_outputs[0];
-        auto rendered_alpha = raster_outputs[1];
-
-        // Step 7: Post-process based on render mode
-        torch::Tensor final_image, final_depth;
-
-        switch (render_mode) {
-        case RenderMode::RGB:
-            final_image = rendered_image;
-            final_depth = torch::Tensor(); // Empty
-            break;
-
-        case RenderMode::D:
-            final_depth = rendered_image;  // It's actually depth
-            final_image = torch::Tensor(); // Empty
-            break;
-
-        case RenderMode::ED:
-            // Normalize accumulated depth by alpha to get expected depth
-            final_depth = rendered_image / rendered_alpha.clamp_min(1e-10);
-            final_image = torch::Tensor(); // Empty
-            break;
-
-        case RenderMode::RGB_D:
-            final_image = rendered_image.index({Slice(), Slice(), Slice(), Slice(None, -1)});
-            final_depth = rendered_image.index({Slice(), Slice(), Slice(), Slice(-1, None)});
-            break;
-
-        case RenderMode::RGB_ED:
-            final_image = rendered_image.index({Slice(), Slice(), Slice(), Slice(None, -1)});
-            auto accum_depth = rendered_image.index({Slice(), Slice(), Slice(), Slice(-1, None)});
-            final_depth = accum_depth / rendered_alpha.clamp_min(1e-10);
-            break;
-        }
+        Profiler::ScopedTimer rasterize_timer("rasterize");
+        torch::Tensor rendered_image, rendered_alpha;
+        if (use_cpu) {
+            auto raster_outputs = cpu::RasterizationFunction::apply(
+                means2d, conics, render_colors, final_opacities, final_bg,
+                isect_offsets, flatten_ids,
+                static_cast<int64_t>(image_width), static_cast<int64_t>(image_height), static_cast<int64_t>(tile_size));
+            rendered_image = raster_outputs[0];
+            rendered_alpha = raster_outputs[1];
+        } else {
+            auto raster_settings = torch::tensor({(float)image_width,
+                                                  (float)image_height,
+                                                  (float)tile_size},
+                                                 torch::TensorOptions().dtype(torch::kFloat32).device(torch::kCUDA));
 
-        // Prepare output
-        RenderOutput result;
+            auto raster_outputs = RasterizationFunction::apply(
+                means2d, conics, render_colors, final_opacities, final_bg,
+                isect_offsets, flatten_ids, raster_settings);
 
-        // Handle image output
-        if (final_image.defined() && final_image.numel() > 0) {
-            result.image = torch::clamp(final_image.squeeze(0).permute({2, 0, 1}), 0.0f, 1.0f);
-        } else {
-            result.image = torch::Tensor();
+            rendered_image = raster_outputs[0];
+            rendered_alpha = raster_outputs[1];
         }
 
-        // Handle alpha output - always present
-        result.alpha = rendered_alpha.squeeze(0).permute({2, 0, 1});
+        rasterize_timer.stop();
 
-        // Handle depth output
-        if (final_depth.defined() && final_depth.numel() > 0) {
-            result.depth = final_depth.squeeze(0).permute({2, 0, 1});
-        } else {
-            result.depth = torch::Tensor();
-        }
+        // Step 7: Post-process based on render mode
+        RenderOutput result;
+        finalize_render_output(render_mode, rendered_image, rendered_alpha, nullptr, result);
 
         result.means2d = means2d_with_grad;
         result.depths = depths.squeeze(0);
         result.radii = std::get<0>(radii.squeeze(0).max(-1));
         result.visibility = (result.radii > 0);
+        result.isect_offsets = isect_offsets;
+        result.n_isects = isect_ids.numel();
+        result.tile_size = tile_size;
         result.width = image_width;
         result.height = image_height;
 
         // Final device checks for outputs
         if (result.image.defined() && result.image.numel() > 0) {
-            TORCH_CHECK(result.image.is_cuda(), "result.image must be on CUDA");
+            TORCH_CHECK(result.image.device() == device, "result.image must be on ", device);
         }
-        TORCH_CHECK(result.alpha.is_cuda(), "result.alpha must be on CUDA");
+        TORCH_CHECK(result.alpha.device() == device, "result.alpha must be on ", device);
         if (result.depth.defined() && result.depth.numel() > 0) {
-            TORCH_CHECK(result.depth.is_cuda(), "result.depth must be on CUDA");
+            TORCH_CHECK(result.depth.device() == device, "result.depth must be on ", device);
+        }
+        TORCH_CHECK(result.means2d.device() == device, "result.means2d must be on ", device);
+        TORCH_CHECK(result.depths.device() == device, "result.depths must be on ", device);
+        TORCH_CHECK(result.radii.device() == device, "result.radii must be on ", device);
+        TORCH_CHECK(result.visibility.device() == device, "result.visibility must be on ", device);
+
+        return result;
+    }
+
+    RenderOutput rasterize_inference(
+        Camera& viewpoint_camera,
+        const SplatData& gaussian_model,
+        torch::Tensor& bg_color,
+        float scaling_modifier,
+        RenderMode render_mode,
+        RenderOutput* reuse,
+        RasterWorkspace* workspace,
+        int tile_size) {
+
+        torch::NoGradGuard no_grad;
+
+        const auto device = gaussian_model.get_means().device();
+        if (device.is_cpu()) {
+            // The CPU backend has no separate forward entry point; without grad mode
+            // its autograd wrappers record nothing anyway.
+            auto result = rasterize(viewpoint_camera, gaussian_model, bg_color, scaling_modifier,
+                                    false, false, render_mode, workspace, tile_size);
+            if (reuse) {
+                *reuse = result;
+            }
+            return result;
+        }
+
+        const int image_height = static_cast<int>(viewpoint_camera.image_height());
+        const int image_width = static_cast<int>(viewpoint_camera.image_width());
+        tile_size = checked_tile_size(tile_size, image_width, image_height);
+        const int tile_width = (image_width + tile_size - 1) / tile_size;
+        const int tile_height = (image_height + tile_size - 1) / tile_size;
+
+        const auto viewmat = viewpoint_camera.world_view_transform().to(device);
+        const auto K = viewpoint_camera.K().to(device);
+
+        torch::Tensor prepared_bg_color;
+        if (bg_color.defined() && bg_color.numel() > 0) {
+            prepared_bg_color = bg_color.view({1, -1}).to(device);
+            TORCH_CHECK(prepared_bg_color.size(1) == 3,
+                        "bg_color must be reshapeable to [1, 3], got ", prepared_bg_color.sizes());
         }
-        TORCH_CHECK(result.means2d.is_cuda(), "result.means2d must be on CUDA");
-        TORCH_CHECK(result.depths.is_cuda(), "result.depths must be on CUDA");
-        TORCH_CHECK(result.radii.is_cuda(), "result.radii must be on CUDA");
-        TORCH_CHECK(result.visibility.is_cuda(), "result.visibility must be on CUDA");
 
+        // Same kernels as rasterize(), called directly: nothing is saved for
+        // backward and means2d carries no gradient.
+        const auto means3D = gaussian_model.get_means();
+        const auto [opacities, scales, rotations] = gsplat::activation_fwd(
+            gaussian_model.opacity_raw().reshape({-1}).contiguous(),
+            gaussian_model.scaling_raw().contiguous(),
+            gaussian_model.rotation_raw().contiguous(),
+            scaling_modifier);
+
+        const int N = static_cast<int>(means3D.size(0));
+        using Slot = RasterWorkspace::Slot;
+        auto output = [&](Slot slot, c10::IntArrayRef sizes, const torch::TensorOptions& options) {
+            return workspace ? at::optional<at::Tensor>(workspace->get(slot, sizes, options)) : at::nullopt;
+        };
+        const auto float_opts = means3D.options();
+        const auto int_opts = means3D.options().dtype(torch::kInt32);
+
+        const auto [radii, means2d, depths, conics, compensations] = gsplat::projection_ewa_3dgs_fused_fwd(
+            means3D.contiguous(), {}, rotations, scales, opacities, viewmat, K,
+            image_width, image_height, 0.3f, 0.01f, 10000.0f, 0.0f,
+            false, gsplat::CameraModelType::PINHOLE,
+            output(Slot::Radii, {1, N, 2}, int_opts),
+            output(Slot::Means2d, {1, N, 2}, float_opts),
+            output(Slot::Depths, {1, N}, float_opts),
+            output(Slot::Conics, {1, N, 3}, float_opts));
+
+        const auto campos = torch::inverse(viewmat).index({0, Slice(None, 3), 3}); // [3]
+        const auto dirs = (means3D - campos).contiguous();                      // [N, 3]
+        const auto masks = (radii[0] > 0).all(-1);                              // [N]
+        auto colors = gsplat::spherical_harmonics_fwd(
+            gaussian_model.get_active_sh_degree(), dirs, gaussian_model.get_shs().contiguous(), masks);
+        colors = colors.add_(0.5f).clamp_min_(0.0f).unsqueeze(0); // [1, N, 3]
+
+        auto [render_colors, final_bg] = prepare_render_features(render_mode, colors, depths, prepared_bg_color);
+
+        const auto [tiles_per_gauss, isect_ids, flatten_ids, isect_offsets] =
+            intersect_tiles(means2d, radii, depths, tile_size, tile_width, tile_height, workspace);
+
+        const int channels = static_cast<int>(render_colors.size(-1));
+        const auto [rendered_image, rendered_alpha, last_ids] = gsplat::rasterize_to_pixels_3dgs_fwd(
+            means2d, conics, render_colors.contiguous(), opacities.unsqueeze(0).contiguous(),
+            final_bg.numel() > 0 ? at::optional<at::Tensor>(final_bg) : at::nullopt, at::nullopt,
+            image_width, image_height, tile_size, isect_offsets, flatten_ids,
+            output(Slot::Renders, {1, image_height, image_width, channels}, float_opts),
+            output(Slot::Alphas, {1, image_height, image_width, 1}, float_opts),
+            output(Slot::LastIds, {1, image_height, image_width}, int_opts));
+
+        RenderOutput result;
+        finalize_render_output(render_mode, rendered_image, rendered_alpha, reuse, result);
+
+        result.means2d = means2d.squeeze(0);
+        result.depths = depths.squeeze(0);
+        result.radii = std::get<0>(radii.squeeze(0).max(-1));
+        result.visibility = (result.radii > 0);
+        result.isect_offsets = isect_offsets;
+        result.n_isects = isect_ids.numel();
+        result.tile_size = tile_size;
+        result.width = image_width;
+        result.height = image_height;
+
+        if (reuse) {
+            *reuse = result;
+        }
         return result;
     }
 
-} // namespace gs
\ No newline at end of file
+} // namespace gs
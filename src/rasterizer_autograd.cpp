@@ -1,9 +1,95 @@
 #include "core/rasterizer_autograd.hpp"
+#include "core/contribution_stats.hpp"
+#include "core/raster_workspace.hpp"
 
 namespace gs {
 
     using namespace torch::indexing;
 
+    // FusedActivationFunction implementation
+    torch::autograd::tensor_list FusedActivationFunction::forward(
+        torch::autograd::AutogradContext* ctx,
+        torch::Tensor opacity_raw,  // [N, 1] or [N]
+        torch::Tensor scaling_raw,  // [N, 3]
+        torch::Tensor rotation_raw, // [N, 4]
+        double scaling_modifier) {
+
+        const int64_t N = scaling_raw.size(0);
+
+        TORCH_CHECK(opacity_raw.numel() == N,
+                    "opacity_raw must have N elements, got ", opacity_raw.sizes());
+        TORCH_CHECK(scaling_raw.dim() == 2 && scaling_raw.size(1) == 3,
+                    "scaling_raw must be [N, 3], got ", scaling_raw.sizes());
+        TORCH_CHECK(rotation_raw.dim() == 2 && rotation_raw.size(0) == N && rotation_raw.size(1) == 4,
+                    "rotation_raw must be [N, 4], got ", rotation_raw.sizes());
+        TORCH_CHECK(opacity_raw.device() == scaling_raw.device() &&
+                        rotation_raw.device() == scaling_raw.device(),
+                    "opacity_raw, scaling_raw and rotation_raw must be on the same device");
+
+        const auto opacity_flat = opacity_raw.reshape({N}).contiguous();
+        scaling_raw = scaling_raw.contiguous();
+        rotation_raw = rotation_raw.contiguous();
+
+        torch::Tensor opacities, scales, quats;
+        if (scaling_raw.is_cuda()) {
+            std::tie(opacities, scales, quats) = gsplat::activation_fwd(
+                opacity_flat, scaling_raw, rotation_raw, static_cast<float>(scaling_modifier));
+        } else {
+            // CPU reference path, same math as the CUDA kernel
+            opacities = torch::sigmoid(opacity_flat);
+            scales = torch::exp(scaling_raw) * scaling_modifier;
+            quats = rotation_raw / (rotation_raw * rotation_raw).sum(-1, true).sqrt().clamp_min(1e-12);
+        }
+
+        ctx->save_for_backward({opacities, scales, rotation_raw});
+        ctx->saved_data["opacity_shape"] = opacity_raw.sizes().vec();
+
+        return {opacities, scales, quats};
+    }
+
+    torch::autograd::tensor_list FusedActivationFunction::backward(
+        torch::autograd::AutogradContext* ctx,
+        torch::autograd::tensor_list grad_outputs) {
+
+        auto saved = ctx->get_saved_variables();
+        const auto& opacities = saved[0];
+        const auto& scales = saved[1];
+        const auto& rotation_raw = saved[2];
+        const auto opacity_shape = ctx->saved_data["opacity_shape"].toIntVector();
+
+        // Outputs that did not take part in the loss come back undefined
+        auto v_opacities = grad_outputs[0].defined() ? grad_outputs[0].contiguous() : torch::zeros_like(opacities);
+        auto v_scales = grad_outputs[1].defined() ? grad_outputs[1].contiguous() : torch::zeros_like(scales);
+        auto v_quats = grad_outputs[2].defined() ? grad_outputs[2].contiguous() : torch::zeros_like(rotation_raw);
+
+        torch::Tensor v_opacity_raw, v_scaling_raw, v_rotation_raw;
+        if (opacities.is_cuda()) {
+            std::tie(v_opacity_raw, v_scaling_raw, v_rotation_raw) = gsplat::activation_bwd(
+                opacities, scales, rotation_raw, v_opacities, v_scales, v_quats);
+        } else {
+            v_opacity_raw = v_opacities * opacities * (1.0f - opacities);
+            v_scaling_raw = v_scales * scales;
+            const auto norm = (rotation_raw * rotation_raw).sum(-1, true).sqrt();
+            const auto quats = rotation_raw / norm.clamp_min(1e-12);
+            const auto projected = (v_quats - quats * (quats * v_quats).sum(-1, true)) / norm;
+            v_rotation_raw = torch::where(norm > 1e-12, projected, v_quats / 1e-12);
+        }
+
+        if (!ctx->needs_input_grad(0)) {
+            v_opacity_raw = torch::Tensor();
+        } else {
+            v_opacity_raw = v_opacity_raw.reshape(opacity_shape);
+        }
+        if (!ctx->needs_input_grad(1)) {
+            v_scaling_raw = torch::Tensor();
+        }
+        if (!ctx->needs_input_grad(2)) {
+            v_rotation_raw = torch::Tensor();
+        }
+
+        return {v_opacity_raw, v_scaling_raw, v_rotation_raw, torch::Tensor()};
+    }
+
     // ProjectionFunction implementation
     torch::autograd::tensor_list ProjectionFunction::forward(
         torch::autograd::AutogradContext* ctx,
@@ -69,8 +155,18 @@ namespace gs {
         viewmat = viewmat.contiguous();
         K = K.contiguous();
 
-        // Apply scaling modifier
-        auto scaled_scales = scales * scaling_modifier;
+        // Apply scaling modifier (the rasterizer folds it into the fused activation and passes 1)
+        auto scaled_scales = scaling_modifier == 1.0f ? scales : scales * scaling_modifier;
+
+        // Outputs land in the caller's workspace buffers when one is active
+        at::optional<at::Tensor> radii_out, means2d_out, depths_out, conics_out;
+        if (auto* workspace = RasterWorkspace::current()) {
+            using Slot = RasterWorkspace::Slot;
+            radii_out = workspace->get(Slot::Radii, {C, N, 2}, means3D.options().dtype(torch::kInt32));
+            means2d_out = workspace->get(Slot::Means2d, {C, N, 2}, means3D.options());
+            depths_out = workspace->get(Slot::Depths, {C, N}, means3D.options());
+            conics_out = workspace->get(Slot::Conics, {C, N, 3}, means3D.options());
+        }
 
         // Call projection - pass undefined tensor if opacities not provided
         auto proj_results = gsplat::projection_ewa_3dgs_fused_fwd(
@@ -88,7 +184,11 @@ namespace gs {
             far_plane,
             radius_clip,
             false, // calc_compensations
-            gsplat::CameraModelType::PINHOLE);
+            gsplat::CameraModelType::PINHOLE,
+            radii_out,
+            means2d_out,
+            depths_out,
+            conics_out);
 
         auto radii = std::get<0>(proj_results).contiguous();
         auto means2d = std::get<1>(proj_results).contiguous();
@@ -192,7 +292,7 @@ namespace gs {
         // v_scales is gradient w.r.t. scaled_scales, but we need gradient w.r.t. original scales
         // Since scaled_scales = scales * scaling_modifier, by chain rule:
         // d/d(scales) = d/d(scaled_scales) * scaling_modifier
-        if (v_scales.defined()) {
+        if (v_scales.defined() && scaling_modifier != 1.0f) {
             v_scales = v_scales * scaling_modifier;
         }
 
@@ -410,12 +510,32 @@ namespace gs {
         }
         // else bg_color_opt remains empty optional
 
+        // Outputs land in the caller's workspace buffers when one is active
+        at::optional<at::Tensor> renders_out, alphas_out, last_ids_out;
+        if (auto* workspace = RasterWorkspace::current()) {
+            using Slot = RasterWorkspace::Slot;
+            renders_out = workspace->get(Slot::Renders, {C, height, width, channels}, means2d.options());
+            alphas_out = workspace->get(Slot::Alphas, {C, height, width, 1}, means2d.options());
+            last_ids_out = workspace->get(Slot::LastIds, {C, height, width}, means2d.options().dtype(torch::kInt32));
+        }
+
+        // Per-Gaussian contribution accumulates into the active stats (single camera only)
+        at::optional<at::Tensor> gauss_weights, gauss_hits;
+        if (auto* stats = ContributionStats::current(); stats && C == 1) {
+            if (auto weights = stats->weight_buffer(N); weights.defined()) {
+                gauss_weights = weights;
+                gauss_hits = stats->hit_buffer(N);
+            }
+        }
+
         // Call rasterization with optional background
         auto raster_results = gsplat::rasterize_to_pixels_3dgs_fwd(
             means2d, conics, colors, opacities,
             bg_color_opt, {}, // bg_color_opt might not have value, masks is empty optional
             width, height, tile_size,
-            isect_offsets, flatten_ids);
+            isect_offsets, flatten_ids,
+            renders_out, alphas_out, last_ids_out,
+            gauss_weights, gauss_hits);
 
         auto rendered_image = std::get<0>(raster_results).contiguous();
         auto rendered_alpha = std::get<1>(raster_results).to(torch::kFloat32).contiguous();
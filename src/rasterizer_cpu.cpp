@@ -0,0 +1,840 @@
+#include "core/rasterizer_cpu.hpp"
+#include "core/contribution_stats.hpp"
+#include <ATen/Parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace gs {
+    namespace cpu {
+
+        using torch::indexing::None;
+        using torch::indexing::Slice;
+
+        namespace {
+            // Same constants as the gsplat kernels
+            constexpr float kAlphaThreshold = 1.f / 255.f;
+            constexpr float kMaxAlpha = 0.999f;
+            constexpr float kTransmittanceEps = 1e-4f;
+            constexpr float kMaxExtend = 3.33f;
+
+            void check_cpu_float(const torch::Tensor& t, const char* name) {
+                TORCH_CHECK(t.device().is_cpu(), name, " must be on CPU");
+                TORCH_CHECK(t.scalar_type() == torch::kFloat32, name, " must be float32, got ", t.scalar_type());
+            }
+
+            uint32_t tile_bits(int64_t n) {
+                return static_cast<uint32_t>(std::floor(std::log2(static_cast<double>(n)))) + 1;
+            }
+
+            // Per-thread scratch for one tile, laid out structure-of-arrays so the
+            // per-Gaussian loops over pixels vectorize.
+            struct TileScratch {
+                int64_t x0 = 0, y0 = 0, bw = 0, bh = 0, P = 0;
+                std::vector<float> px, py;
+
+                explicit TileScratch(int tile_size)
+                    : px(tile_size * tile_size),
+                      py(tile_size * tile_size) {}
+
+                void setup(int64_t tile_x, int64_t tile_y, int tile_size, int width, int height) {
+                    x0 = tile_x * tile_size;
+                    y0 = tile_y * tile_size;
+                    bw = std::min<int64_t>(tile_size, width - x0);
+                    bh = std::min<int64_t>(tile_size, height - y0);
+                    P = bw * bh;
+                    for (int64_t p = 0; p < P; ++p) {
+                        px[p] = static_cast<float>(x0 + p % bw) + 0.5f;
+                        py[p] = static_cast<float>(y0 + p / bw) + 0.5f;
+                    }
+                }
+
+                int64_t pixel_index(int64_t cid, int64_t p, int width, int height) const {
+                    return (cid * height + y0 + p / bw) * width + x0 + p % bw;
+                }
+            };
+
+            std::pair<int64_t, int64_t> tile_range(const int32_t* offsets, int64_t flat_tile,
+                                                   int64_t n_tiles_total, int64_t n_isects) {
+                const int64_t begin = offsets[flat_tile];
+                const int64_t end = flat_tile + 1 < n_tiles_total ? offsets[flat_tile + 1] : n_isects;
+                return {begin, end};
+            }
+
+            // Real SH bases up to degree 4, same constants as the gsplat kernel
+            std::vector<torch::Tensor> sh_bases(int degree, const torch::Tensor& dirs) {
+                const auto x = dirs.select(-1, 0);
+                const auto y = dirs.select(-1, 1);
+                const auto z = dirs.select(-1, 2);
+
+                std::vector<torch::Tensor> b;
+                b.push_back(torch::full_like(x, 0.2820947917738781f));
+                if (degree < 1)
+                    return b;
+
+                b.push_back(-0.48860251190292f * y);
+                b.push_back(0.48860251190292f * z);
+                b.push_back(-0.48860251190292f * x);
+                if (degree < 2)
+                    return b;
+
+                const auto z2 = z * z;
+                const auto fC1 = x * x - y * y;
+                const auto fS1 = 2.f * x * y;
+                const auto fTmpB2 = -1.092548430592079f * z;
+                b.push_back(0.5462742152960395f * fS1);
+                b.push_back(fTmpB2 * y);
+                b.push_back(0.9461746957575601f * z2 - 0.3153915652525201f);
+                b.push_back(fTmpB2 * x);
+                b.push_back(0.5462742152960395f * fC1);
+                if (degree < 3)
+                    return b;
+
+                const auto fTmpC3 = -2.285228997322329f * z2 + 0.4570457994644658f;
+                const auto fTmpB3 = 1.445305721320277f * z;
+                const auto fC2 = x * fC1 - y * fS1;
+                const auto fS2 = x * fS1 + y * fC1;
+                b.push_back(-0.5900435899266435f * fS2);
+                b.push_back(fTmpB3 * fS1);
+                b.push_back(fTmpC3 * y);
+                b.push_back(z * (1.865881662950577f * z2 - 1.119528997770346f));
+                b.push_back(fTmpC3 * x);
+                b.push_back(fTmpB3 * fC1);
+                b.push_back(-0.5900435899266435f * fC2);
+                if (degree < 4)
+                    return b;
+
+                const auto fTmpD4 = z * (-4.683325804901025f * z2 + 2.007139630671868f);
+                const auto fTmpC4 = 3.31161143515146f * z2 - 0.47308734787878f;
+                const auto fTmpB4 = -1.770130769779931f * z;
+                const auto fC3 = x * fC2 - y * fS2;
+                const auto fS3 = x * fS2 + y * fC2;
+                b.push_back(0.6258357354491763f * fS3);
+                b.push_back(fTmpB4 * fS2);
+                b.push_back(fTmpC4 * fS1);
+                b.push_back(fTmpD4 * y);
+                b.push_back(1.984313483298443f * z2 * (1.865881662950577f * z2 - 1.119528997770346f) -
+                            1.006230589874905f * (0.9461746957575601f * z2 - 0.3153915652525201f));
+                b.push_back(fTmpD4 * x);
+                b.push_back(fTmpC4 * fC1);
+                b.push_back(fTmpB4 * fC2);
+                b.push_back(0.6258357354491763f * fC3);
+                return b;
+            }
+        } // namespace
+
+        torch::Tensor quat_to_rotmat(const torch::Tensor& quats) {
+            const auto q = quats / (quats * quats).sum(-1, true).sqrt().clamp_min(1e-12);
+            const auto w = q.select(-1, 0), x = q.select(-1, 1), y = q.select(-1, 2), z = q.select(-1, 3);
+            return torch::stack({1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+                                 2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+                                 2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)},
+                                -1)
+                .reshape({quats.size(0), 3, 3});
+        }
+
+        torch::Tensor quat_scale_to_covar(const torch::Tensor& quats, const torch::Tensor& scales) {
+            // R S S^T R^T
+            const auto M = quat_to_rotmat(quats) * scales.unsqueeze(-2);
+            return torch::matmul(M, M.transpose(-1, -2));
+        }
+
+        std::tuple<torch::Tensor, torch::Tensor> relocation(
+            const torch::Tensor& opacities,
+            const torch::Tensor& scales,
+            const torch::Tensor& ratios,
+            const torch::Tensor& binoms,
+            int n_max) {
+
+            check_cpu_float(opacities, "opacities");
+            check_cpu_float(scales, "scales");
+            const auto opacities_c = opacities.contiguous();
+            const auto scales_c = scales.contiguous();
+            const auto ratios_c = ratios.to(torch::kInt32).contiguous();
+            const auto binoms_c = binoms.to(torch::kCPU, torch::kFloat32).contiguous();
+
+            auto new_opacities = torch::empty_like(opacities_c);
+            auto new_scales = torch::empty_like(scales_c);
+            const float* o = opacities_c.data_ptr<float>();
+            const float* s = scales_c.data_ptr<float>();
+            const int* r = ratios_c.data_ptr<int>();
+            const float* b = binoms_c.data_ptr<float>();
+            float* new_o = new_opacities.data_ptr<float>();
+            float* new_s = new_scales.data_ptr<float>();
+
+            // Same evaluation order as the CUDA kernel (equation (9) of the MCMC paper)
+            at::parallel_for(0, opacities_c.numel(), 1024, [&](int64_t begin, int64_t end) {
+                for (int64_t idx = begin; idx < end; ++idx) {
+                    const int n_idx = r[idx];
+                    new_o[idx] = 1.0f - std::pow(1.0f - o[idx], 1.0f / n_idx);
+
+                    float denom_sum = 0.0f;
+                    for (int i = 1; i <= n_idx; ++i) {
+                        for (int k = 0; k <= i - 1; ++k) {
+                            const float term = (std::pow(-1.0f, k) / std::sqrt(static_cast<float>(k + 1))) *
+                                               std::pow(new_o[idx], k + 1);
+                            denom_sum += b[(i - 1) * n_max + k] * term;
+                        }
+                    }
+                    const float coeff = o[idx] / denom_sum;
+                    for (int i = 0; i < 3; ++i) {
+                        new_s[idx * 3 + i] = coeff * s[idx * 3 + i];
+                    }
+                }
+            });
+            return {new_opacities, new_scales};
+        }
+
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor> projection(
+            const torch::Tensor& means,
+            const torch::Tensor& quats,
+            const torch::Tensor& scales,
+            const torch::Tensor& opacities,
+            const torch::Tensor& viewmats,
+            const torch::Tensor& Ks,
+            int width,
+            int height,
+            float eps2d,
+            float near_plane,
+            float far_plane,
+            float radius_clip) {
+
+            check_cpu_float(means, "means");
+            check_cpu_float(viewmats, "viewmats");
+            const auto N = means.size(0);
+            const auto covars = quat_scale_to_covar(quats, scales); // [N, 3, 3]
+
+            // World to camera
+            const auto Rv = viewmats.index({Slice(), Slice(None, 3), Slice(None, 3)}); // [C, 3, 3]
+            const auto tv = viewmats.index({Slice(), Slice(None, 3), 3});              // [C, 3]
+            const auto means_c = torch::einsum("cij,nj->cni", {Rv, means}) + tv.unsqueeze(1);
+            const auto covars_c = torch::einsum("cij,njk,clk->cnil", {Rv, covars, Rv});
+
+            const auto mx = means_c.select(-1, 0);
+            const auto my = means_c.select(-1, 1);
+            const auto mz = means_c.select(-1, 2);
+            const auto depth_valid = (mz >= near_plane) & (mz <= far_plane);
+            // Keep culled entries finite so that their (zero) gradients stay finite
+            const auto z_safe = torch::where(depth_valid, mz, torch::ones_like(mz));
+
+            const auto fx = Ks.index({Slice(), 0, 0}).unsqueeze(-1); // [C, 1]
+            const auto fy = Ks.index({Slice(), 1, 1}).unsqueeze(-1);
+            const auto cx = Ks.index({Slice(), 0, 2}).unsqueeze(-1);
+            const auto cy = Ks.index({Slice(), 1, 2}).unsqueeze(-1);
+
+            // Perspective Jacobian with the same frustum clamping as persp_proj
+            const auto tan_fovx = 0.5f * width / fx;
+            const auto tan_fovy = 0.5f * height / fy;
+            const auto lim_x_pos = (width - cx) / fx + 0.3f * tan_fovx;
+            const auto lim_x_neg = cx / fx + 0.3f * tan_fovx;
+            const auto lim_y_pos = (height - cy) / fy + 0.3f * tan_fovy;
+            const auto lim_y_neg = cy / fy + 0.3f * tan_fovy;
+            const auto tx = z_safe * torch::minimum(lim_x_pos, torch::maximum(-lim_x_neg, mx / z_safe));
+            const auto ty = z_safe * torch::minimum(lim_y_pos, torch::maximum(-lim_y_neg, my / z_safe));
+
+            const auto zeros = torch::zeros_like(mz);
+            const auto rz = 1.f / z_safe;
+            const auto J = torch::stack({fx * rz, zeros, -fx * tx * rz * rz,
+                                         zeros, fy * rz, -fy * ty * rz * rz},
+                                        -1)
+                               .reshape({viewmats.size(0), N, 2, 3});
+            const auto cov2d = torch::matmul(torch::matmul(J, covars_c), J.transpose(-1, -2));
+
+            auto means2d = torch::stack({fx * mx * rz + cx, fy * my * rz + cy}, -1);
+
+            // Low-pass blur and inverse
+            const auto a = cov2d.index({"...", 0, 0}) + eps2d;
+            const auto b = cov2d.index({"...", 0, 1});
+            const auto c = cov2d.index({"...", 1, 1}) + eps2d;
+            const auto det = a * c - b * b;
+            const auto det_valid = det > 0.f;
+            const auto det_safe = torch::where(det_valid, det, torch::ones_like(det));
+            auto conics = torch::stack({c / det_safe, -b / det_safe, a / det_safe}, -1);
+
+            // Opacity-aware bounding box (non differentiable)
+            torch::Tensor radii;
+            {
+                torch::NoGradGuard no_grad;
+                auto extend = torch::full_like(a, kMaxExtend);
+                auto valid = depth_valid & det_valid;
+                if (opacities.defined() && opacities.numel() > 0) {
+                    const auto opac = opacities.detach().unsqueeze(0).expand_as(a);
+                    valid = valid & (opac >= kAlphaThreshold);
+                    extend = torch::minimum(
+                        extend, torch::sqrt(2.f * torch::log(opac.clamp_min(kAlphaThreshold) / kAlphaThreshold)));
+                }
+                const auto radius_x = torch::ceil(extend * torch::sqrt(a.detach().clamp_min(0.f)));
+                const auto radius_y = torch::ceil(extend * torch::sqrt(c.detach().clamp_min(0.f)));
+                valid = valid & ~((radius_x <= radius_clip) & (radius_y <= radius_clip));
+
+                const auto m2d = means2d.detach();
+                const auto u = m2d.select(-1, 0);
+                const auto v = m2d.select(-1, 1);
+                valid = valid & (u + radius_x > 0) & (u - radius_x < width) &
+                        (v + radius_y > 0) & (v - radius_y < height);
+
+                radii = (torch::stack({radius_x, radius_y}, -1) * valid.unsqueeze(-1)).to(torch::kInt32);
+            }
+
+            return {radii.contiguous(), means2d, mz, conics};
+        }
+
+        torch::Tensor spherical_harmonics(
+            int sh_degree,
+            const torch::Tensor& dirs,
+            const torch::Tensor& coeffs,
+            const torch::Tensor& masks) {
+
+            const int K = (sh_degree + 1) * (sh_degree + 1);
+            TORCH_CHECK(sh_degree >= 0 && sh_degree <= 4, "CPU SH supports degrees 0-4, got ", sh_degree);
+            TORCH_CHECK(coeffs.size(-2) >= K, "coeffs K dimension must be at least ", K, ", got ", coeffs.size(-2));
+
+            const auto unit_dirs = dirs / (dirs * dirs).sum(-1, true).sqrt().clamp_min(1e-12);
+            const auto bases = torch::stack(sh_bases(sh_degree, unit_dirs), -1); // [..., K]
+            auto colors = (bases.unsqueeze(-1) * coeffs.narrow(-2, 0, K)).sum(-2);
+
+            if (masks.defined() && masks.numel() > 0) {
+                colors = colors * masks.unsqueeze(-1).to(colors.scalar_type());
+            }
+            return colors;
+        }
+
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> intersect_tile(
+            const torch::Tensor& means2d,
+            const torch::Tensor& radii,
+            const torch::Tensor& depths,
+            int tile_size,
+            int tile_width,
+            int tile_height) {
+
+            TORCH_CHECK(means2d.dim() == 3 && means2d.size(2) == 2, "means2d must be [C, N, 2], got ", means2d.sizes());
+            const int64_t C = means2d.size(0);
+            const int64_t N = means2d.size(1);
+            const int64_t n_tiles = static_cast<int64_t>(tile_width) * tile_height;
+            const uint32_t tile_n_bits = tile_bits(n_tiles);
+            TORCH_CHECK(tile_bits(C) + tile_n_bits <= 32,
+                        "Too many cameras/tiles to encode intersection ids: C=", C, ", tiles=", n_tiles);
+
+            const auto m2d = means2d.detach().to(torch::kFloat32).contiguous();
+            const auto rad = radii.to(torch::kInt32).contiguous();
+            const auto dep = depths.detach().to(torch::kFloat32).contiguous();
+            const float* m2d_ptr = m2d.data_ptr<float>();
+            const int32_t* rad_ptr = rad.data_ptr<int32_t>();
+            const float* dep_ptr = dep.data_ptr<float>();
+
+            auto tiles_per_gauss = torch::zeros({C, N}, torch::TensorOptions().dtype(torch::kInt32));
+            int32_t* tpg_ptr = tiles_per_gauss.data_ptr<int32_t>();
+
+            // Tile rectangle of every Gaussian: [min_x, min_y, max_x, max_y), max exclusive
+            std::vector<int32_t> rects(C * N * 4, 0);
+            at::parallel_for(0, C * N, 4096, [&](int64_t begin, int64_t end) {
+                for (int64_t idx = begin; idx < end; ++idx) {
+                    const float rx = static_cast<float>(rad_ptr[idx * 2]);
+                    const float ry = static_cast<float>(rad_ptr[idx * 2 + 1]);
+                    if (rx <= 0.f || ry <= 0.f) {
+                        continue;
+                    }
+                    const float tx = m2d_ptr[idx * 2] / tile_size;
+                    const float ty = m2d_ptr[idx * 2 + 1] / tile_size;
+                    const float trx = rx / tile_size;
+                    const float try_ = ry / tile_size;
+                    int32_t* r = rects.data() + idx * 4;
+                    r[0] = std::clamp(static_cast<int32_t>(std::floor(tx - trx)), 0, tile_width);
+                    r[1] = std::clamp(static_cast<int32_t>(std::floor(ty - try_)), 0, tile_height);
+                    r[2] = std::clamp(static_cast<int32_t>(std::ceil(tx + trx)), 0, tile_width);
+                    r[3] = std::clamp(static_cast<int32_t>(std::ceil(ty + try_)), 0, tile_height);
+                    tpg_ptr[idx] = (r[2] - r[0]) * (r[3] - r[1]);
+                }
+            });
+
+            // Bin directly into tile-major order; a stable per-tile depth sort then
+            // reproduces the radix sort ordering of the CUDA path.
+            std::vector<int64_t> tile_starts(C * n_tiles + 1, 0);
+            for (int64_t idx = 0; idx < C * N; ++idx) {
+                const int32_t* r = rects.data() + idx * 4;
+                const int64_t base = (idx / N) * n_tiles;
+                for (int32_t ty = r[1]; ty < r[3]; ++ty) {
+                    for (int32_t tx = r[0]; tx < r[2]; ++tx) {
+                        ++tile_starts[base + ty * tile_width + tx + 1];
+                    }
+                }
+            }
+            for (size_t t = 1; t < tile_starts.size(); ++t) {
+                tile_starts[t] += tile_starts[t - 1];
+            }
+            const int64_t n_isects = tile_starts.back();
+
+            auto isect_ids = torch::empty({n_isects}, torch::TensorOptions().dtype(torch::kInt64));
+            auto flatten_ids = torch::empty({n_isects}, torch::TensorOptions().dtype(torch::kInt32));
+            int64_t* ids_ptr = isect_ids.data_ptr<int64_t>();
+            int32_t* fids_ptr = flatten_ids.data_ptr<int32_t>();
+
+            std::vector<int64_t> cursor(tile_starts.begin(), tile_starts.end() - 1);
+            for (int64_t idx = 0; idx < C * N; ++idx) {
+                const int32_t* r = rects.data() + idx * 4;
+                const int64_t cid = idx / N;
+                int32_t depth_bits;
+                std::memcpy(&depth_bits, dep_ptr + idx, sizeof(float));
+                const int64_t depth_enc = static_cast<uint32_t>(depth_bits);
+                for (int32_t ty = r[1]; ty < r[3]; ++ty) {
+                    for (int32_t tx = r[0]; tx < r[2]; ++tx) {
+                        const int64_t tile_id = static_cast<int64_t>(ty) * tile_width + tx;
+                        const int64_t pos = cursor[cid * n_tiles + tile_id]++;
+                        ids_ptr[pos] = (cid << (32 + tile_n_bits)) | (tile_id << 32) | depth_enc;
+                        fids_ptr[pos] = static_cast<int32_t>(idx);
+                    }
+                }
+            }
+
+            at::parallel_for(0, C * n_tiles, 16, [&](int64_t begin, int64_t end) {
+                std::vector<std::pair<int64_t, int32_t>> entries;
+                for (int64_t t = begin; t < end; ++t) {
+                    const int64_t s = tile_starts[t];
+                    const int64_t e = tile_starts[t + 1];
+                    if (e - s < 2) {
+                        continue;
+                    }
+                    entries.clear();
+                    for (int64_t i = s; i < e; ++i) {
+                        entries.emplace_back(ids_ptr[i], fids_ptr[i]);
+                    }
+                    std::stable_sort(entries.begin(), entries.end(),
+                                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+                    for (int64_t i = s; i < e; ++i) {
+                        ids_ptr[i] = entries[i - s].first;
+                        fids_ptr[i] = entries[i - s].second;
+                    }
+                }
+            });
+
+            return {tiles_per_gauss, isect_ids, flatten_ids};
+        }
+
+        torch::Tensor intersect_offset(
+            const torch::Tensor& isect_ids,
+            int C,
+            int tile_width,
+            int tile_height) {
+
+            const int64_t n_tiles = static_cast<int64_t>(tile_width) * tile_height;
+            const uint32_t tile_n_bits = tile_bits(n_tiles);
+            const auto ids = isect_ids.to(torch::kInt64).contiguous();
+            const int64_t* ids_ptr = ids.data_ptr<int64_t>();
+
+            // isect_ids are sorted, so each tile's start is the count of ids before it
+            std::vector<int32_t> counts(C * n_tiles + 1, 0);
+            for (int64_t i = 0; i < ids.numel(); ++i) {
+                const int64_t cid = ids_ptr[i] >> (32 + tile_n_bits);
+                const int64_t tile_id = (ids_ptr[i] >> 32) & ((1LL << tile_n_bits) - 1);
+                ++counts[cid * n_tiles + tile_id + 1];
+            }
+            auto offsets = torch::empty({C, tile_height, tile_width}, torch::TensorOptions().dtype(torch::kInt32));
+            int32_t* off_ptr = offsets.data_ptr<int32_t>();
+            int32_t running = 0;
+            for (int64_t t = 0; t < C * n_tiles; ++t) {
+                running += counts[t];
+                off_ptr[t] = running;
+            }
+            return offsets;
+        }
+
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> rasterize_to_pixels_fwd(
+            const torch::Tensor& means2d,
+            const torch::Tensor& conics,
+            const torch::Tensor& colors,
+            const torch::Tensor& opacities,
+            const torch::Tensor& backgrounds,
+            int width,
+            int height,
+            int tile_size,
+            const torch::Tensor& tile_offsets,
+            const torch::Tensor& flatten_ids,
+            const torch::Tensor& gauss_weights,
+            const torch::Tensor& gauss_hits) {
+
+            check_cpu_float(means2d, "means2d");
+            check_cpu_float(colors, "colors");
+            const bool accumulate = gauss_weights.defined();
+            if (accumulate) {
+                TORCH_CHECK(gauss_hits.defined(), "gauss_weights and gauss_hits must be given together");
+                TORCH_CHECK(gauss_weights.numel() == opacities.numel() && gauss_hits.numel() == opacities.numel(),
+                            "gauss_weights and gauss_hits must have one entry per Gaussian");
+            }
+            const int64_t C = tile_offsets.size(0);
+            const int64_t tile_height = tile_offsets.size(1);
+            const int64_t tile_width = tile_offsets.size(2);
+            const int64_t n_tiles = tile_width * tile_height;
+            const int64_t channels = colors.size(-1);
+            const int64_t n_isects = flatten_ids.size(0);
+
+            const auto m2d = means2d.contiguous();
+            const auto con = conics.contiguous();
+            const auto col = colors.contiguous();
+            const auto opa = opacities.contiguous();
+            const auto offs = tile_offsets.contiguous();
+            const auto fids = flatten_ids.contiguous();
+            const bool has_bg = backgrounds.defined() && backgrounds.numel() > 0;
+            const auto bg = has_bg ? backgrounds.contiguous() : torch::Tensor();
+
+            auto renders = torch::empty({C, height, width, channels}, colors.options());
+            auto alphas = torch::empty({C, height, width, 1}, colors.options());
+            auto last_ids = torch::empty({C, height, width}, torch::TensorOptions().dtype(torch::kInt32));
+
+            const float* m2d_ptr = m2d.data_ptr<float>();
+            const float* con_ptr = con.data_ptr<float>();
+            const float* col_ptr = col.data_ptr<float>();
+            const float* opa_ptr = opa.data_ptr<float>();
+            const float* bg_ptr = has_bg ? bg.data_ptr<float>() : nullptr;
+            const int32_t* off_ptr = offs.data_ptr<int32_t>();
+            const int32_t* fid_ptr = fids.data_ptr<int32_t>();
+            float* render_ptr = renders.data_ptr<float>();
+            float* alpha_ptr = alphas.data_ptr<float>();
+            int32_t* last_ptr = last_ids.data_ptr<int32_t>();
+
+            // Contribution per intersection; each one belongs to a single tile, so
+            // threads never share an entry and the reduction to Gaussians happens after
+            std::vector<float> isect_weight(accumulate ? n_isects : 0);
+            std::vector<int64_t> isect_hits(accumulate ? n_isects : 0);
+
+            at::parallel_for(0, C * n_tiles, 1, [&](int64_t begin, int64_t end) {
+                const int64_t max_P = static_cast<int64_t>(tile_size) * tile_size;
+                TileScratch tile(tile_size);
+                std::vector<float> T(max_P), vis(max_P), accum(max_P * channels);
+                std::vector<int32_t> last(max_P), done(max_P);
+
+                for (int64_t flat_tile = begin; flat_tile < end; ++flat_tile) {
+                    const int64_t cid = flat_tile / n_tiles;
+                    const int64_t tile_id = flat_tile % n_tiles;
+                    tile.setup(tile_id % tile_width, tile_id / tile_width, tile_size, width, height);
+                    const int64_t P = tile.P;
+                    const float* px = tile.px.data();
+                    const float* py = tile.py.data();
+
+                    std::fill_n(T.begin(), P, 1.f);
+                    std::fill_n(last.begin(), P, 0);
+                    std::fill_n(done.begin(), P, 0);
+                    std::fill_n(accum.begin(), P * channels, 0.f);
+
+                    const auto [range_begin, range_end] = tile_range(off_ptr, flat_tile, C * n_tiles, n_isects);
+                    int64_t n_done = 0;
+                    for (int64_t i = range_begin; i < range_end && n_done < P; ++i) {
+                        const int64_t g = fid_ptr[i];
+                        const float mx = m2d_ptr[g * 2], my = m2d_ptr[g * 2 + 1];
+                        const float ca = con_ptr[g * 3], cb = con_ptr[g * 3 + 1], cc = con_ptr[g * 3 + 2];
+                        const float op = opa_ptr[g];
+                        float* Tp = T.data();
+                        float* visp = vis.data();
+                        int32_t* lastp = last.data();
+                        int32_t* donep = done.data();
+                        const int32_t cur = static_cast<int32_t>(i);
+
+                        int64_t done_count = 0;
+#pragma omp simd reduction(+ : done_count)
+                        for (int64_t p = 0; p < P; ++p) {
+                            const float dx = mx - px[p];
+                            const float dy = my - py[p];
+                            const float sigma = 0.5f * (ca * dx * dx + cc * dy * dy) + cb * dx * dy;
+                            const float alpha = std::min(kMaxAlpha, op * std::exp(-sigma));
+                            const bool valid = donep[p] == 0 && sigma >= 0.f && alpha >= kAlphaThreshold;
+                            const float next_T = Tp[p] * (1.f - alpha);
+                            const bool terminate = valid && next_T <= kTransmittanceEps;
+                            const bool contribute = valid && !terminate;
+                            visp[p] = contribute ? alpha * Tp[p] : 0.f;
+                            Tp[p] = contribute ? next_T : Tp[p];
+                            lastp[p] = contribute ? cur : lastp[p];
+                            donep[p] = terminate ? 1 : donep[p];
+                            done_count += donep[p];
+                        }
+                        n_done = done_count;
+
+                        if (accumulate) {
+                            float weight = 0.f;
+                            int64_t hits = 0;
+                            for (int64_t p = 0; p < P; ++p) {
+                                weight += visp[p];
+                                hits += visp[p] > 0.f;
+                            }
+                            isect_weight[i] = weight;
+                            isect_hits[i] = hits;
+                        }
+
+                        for (int64_t k = 0; k < channels; ++k) {
+                            const float ck = col_ptr[g * channels + k];
+                            float* acc = accum.data() + k * max_P;
+#pragma omp simd
+                            for (int64_t p = 0; p < P; ++p) {
+                                acc[p] += visp[p] * ck;
+                            }
+                        }
+                    }
+
+                    for (int64_t p = 0; p < P; ++p) {
+                        const int64_t pix = tile.pixel_index(cid, p, width, height);
+                        for (int64_t k = 0; k < channels; ++k) {
+                            const float bk = bg_ptr ? bg_ptr[cid * channels + k] : 0.f;
+                            render_ptr[pix * channels + k] = accum[k * max_P + p] + T[p] * bk;
+                        }
+                        alpha_ptr[pix] = 1.f - T[p];
+                        last_ptr[pix] = last[p];
+                    }
+                }
+            });
+
+            if (accumulate && n_isects > 0) {
+                const auto ids = fids.to(torch::kInt64);
+                const auto weights = torch::from_blob(isect_weight.data(), {n_isects}, torch::kFloat32);
+                const auto hits = torch::from_blob(isect_hits.data(), {n_isects}, torch::kInt64);
+                gauss_weights.view({-1}).index_add_(0, ids, weights);
+                gauss_hits.view({-1}).index_add_(0, ids, hits);
+            }
+
+            return {renders, alphas, last_ids};
+        }
+
+        std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor> rasterize_to_pixels_bwd(
+            const torch::Tensor& means2d,
+            const torch::Tensor& conics,
+            const torch::Tensor& colors,
+            const torch::Tensor& opacities,
+            const torch::Tensor& backgrounds,
+            int width,
+            int height,
+            int tile_size,
+            const torch::Tensor& tile_offsets,
+            const torch::Tensor& flatten_ids,
+            const torch::Tensor& render_alphas,
+            const torch::Tensor& last_ids,
+            const torch::Tensor& v_render_colors,
+            const torch::Tensor& v_render_alphas) {
+
+            const int64_t C = tile_offsets.size(0);
+            const int64_t tile_height = tile_offsets.size(1);
+            const int64_t tile_width = tile_offsets.size(2);
+            const int64_t n_tiles = tile_width * tile_height;
+            const int64_t channels = colors.size(-1);
+            const int64_t n_isects = flatten_ids.size(0);
+            // Per-intersection gradient row: xy(2), conic(3), color(channels), opacity(1)
+            const int64_t row = 6 + channels;
+
+            const auto m2d = means2d.contiguous();
+            const auto con = conics.contiguous();
+            const auto col = colors.contiguous();
+            const auto opa = opacities.contiguous();
+            const auto offs = tile_offsets.contiguous();
+            const auto fids = flatten_ids.contiguous();
+            const auto ralpha = render_alphas.contiguous();
+            const auto lids = last_ids.contiguous();
+            const auto v_rc = v_render_colors.contiguous();
+            const auto v_ra = v_render_alphas.contiguous();
+            const bool has_bg = backgrounds.defined() && backgrounds.numel() > 0;
+            const auto bg = has_bg ? backgrounds.contiguous() : torch::Tensor();
+
+            auto v_isect = torch::zeros({n_isects, row}, colors.options());
+
+            const float* m2d_ptr = m2d.data_ptr<float>();
+            const float* con_ptr = con.data_ptr<float>();
+            const float* col_ptr = col.data_ptr<float>();
+            const float* opa_ptr = opa.data_ptr<float>();
+            const float* bg_ptr = has_bg ? bg.data_ptr<float>() : nullptr;
+            const int32_t* off_ptr = offs.data_ptr<int32_t>();
+            const int32_t* fid_ptr = fids.data_ptr<int32_t>();
+            const float* ralpha_ptr = ralpha.data_ptr<float>();
+            const int32_t* lids_ptr = lids.data_ptr<int32_t>();
+            const float* v_rc_ptr = v_rc.data_ptr<float>();
+            const float* v_ra_ptr = v_ra.data_ptr<float>();
+            float* v_isect_ptr = v_isect.data_ptr<float>();
+
+            at::parallel_for(0, C * n_tiles, 1, [&](int64_t begin, int64_t end) {
+                const int64_t max_P = static_cast<int64_t>(tile_size) * tile_size;
+                TileScratch tile(tile_size);
+                std::vector<float> T(max_P), T_final(max_P), dot_bv(max_P), v_a(max_P), bg_dot(max_P), fac(max_P);
+                std::vector<float> v_c(max_P * channels);
+                std::vector<int32_t> last(max_P);
+
+                for (int64_t flat_tile = begin; flat_tile < end; ++flat_tile) {
+                    const int64_t cid = flat_tile / n_tiles;
+                    const int64_t tile_id = flat_tile % n_tiles;
+                    tile.setup(tile_id % tile_width, tile_id / tile_width, tile_size, width, height);
+                    const int64_t P = tile.P;
+                    const float* px = tile.px.data();
+                    const float* py = tile.py.data();
+
+                    int32_t max_last = -1;
+                    for (int64_t p = 0; p < P; ++p) {
+                        const int64_t pix = tile.pixel_index(cid, p, width, height);
+                        T_final[p] = 1.f - ralpha_ptr[pix];
+                        T[p] = T_final[p];
+                        dot_bv[p] = 0.f;
+                        v_a[p] = v_ra_ptr[pix];
+                        last[p] = lids_ptr[pix];
+                        max_last = std::max(max_last, last[p]);
+                        float bd = 0.f;
+                        for (int64_t k = 0; k < channels; ++k) {
+                            v_c[k * max_P + p] = v_rc_ptr[pix * channels + k];
+                            bd += bg_ptr ? bg_ptr[cid * channels + k] * v_c[k * max_P + p] : 0.f;
+                        }
+                        bg_dot[p] = bd;
+                    }
+
+                    const auto [range_begin, range_end] = tile_range(off_ptr, flat_tile, C * n_tiles, n_isects);
+                    const int64_t first = std::min<int64_t>(range_end - 1, max_last);
+                    // Back to front, undoing the transmittance of each Gaussian
+                    for (int64_t i = first; i >= range_begin; --i) {
+                        const int64_t g = fid_ptr[i];
+                        const float mx = m2d_ptr[g * 2], my = m2d_ptr[g * 2 + 1];
+                        const float ca = con_ptr[g * 3], cb = con_ptr[g * 3 + 1], cc = con_ptr[g * 3 + 2];
+                        const float op = opa_ptr[g];
+                        const float* cg = col_ptr + g * channels;
+                        const float* vc = v_c.data();
+                        const int32_t* lastp = last.data();
+                        float* Tp = T.data();
+                        float* dbv = dot_bv.data();
+                        float* facp = fac.data();
+                        const float* Tf = T_final.data();
+                        const float* va = v_a.data();
+                        const float* bgd = bg_dot.data();
+                        const int32_t cur = static_cast<int32_t>(i);
+
+                        float g_x = 0.f, g_y = 0.f, g_a = 0.f, g_b = 0.f, g_c = 0.f, g_op = 0.f;
+#pragma omp simd reduction(+ : g_x, g_y, g_a, g_b, g_c, g_op)
+                        for (int64_t p = 0; p < P; ++p) {
+                            const float dx = mx - px[p];
+                            const float dy = my - py[p];
+                            const float sigma = 0.5f * (ca * dx * dx + cc * dy * dy) + cb * dx * dy;
+                            const float vis = std::exp(-sigma);
+                            const float alpha = std::min(kMaxAlpha, op * vis);
+                            const bool valid = cur <= lastp[p] && sigma >= 0.f && alpha >= kAlphaThreshold;
+
+                            const float ra = 1.f / (1.f - alpha);
+                            const float T_new = Tp[p] * ra;
+                            const float f = alpha * T_new;
+                            float cv = 0.f;
+                            for (int64_t k = 0; k < channels; ++k) {
+                                cv += cg[k] * vc[k * max_P + p];
+                            }
+                            const float v_alpha = cv * T_new - dbv[p] * ra + Tf[p] * ra * va[p] - Tf[p] * ra * bgd[p];
+
+                            const bool gate = valid && op * vis <= kMaxAlpha;
+                            const float v_sigma = gate ? -op * vis * v_alpha : 0.f;
+                            g_a += 0.5f * v_sigma * dx * dx;
+                            g_b += v_sigma * dx * dy;
+                            g_c += 0.5f * v_sigma * dy * dy;
+                            g_x += v_sigma * (ca * dx + cb * dy);
+                            g_y += v_sigma * (cb * dx + cc * dy);
+                            g_op += gate ? vis * v_alpha : 0.f;
+
+                            facp[p] = valid ? f : 0.f;
+                            dbv[p] += valid ? cv * f : 0.f;
+                            Tp[p] = valid ? T_new : Tp[p];
+                        }
+
+                        float* out = v_isect_ptr + i * row;
+                        out[0] = g_x;
+                        out[1] = g_y;
+                        out[2] = g_a;
+                        out[3] = g_b;
+                        out[4] = g_c;
+                        for (int64_t k = 0; k < channels; ++k) {
+                            const float* vck = vc + k * max_P;
+                            float s = 0.f;
+#pragma omp simd reduction(+ : s)
+                            for (int64_t p = 0; p < P; ++p) {
+                                s += facp[p] * vck[p];
+                            }
+                            out[5 + k] = s;
+                        }
+                        out[5 + channels] = g_op;
+                    }
+                }
+            });
+
+            // Scatter the per-intersection rows back to the Gaussians
+            const int64_t CN = means2d.size(0) * means2d.size(1);
+            auto v_all = torch::zeros({CN, row}, colors.options());
+            v_all.index_add_(0, fids.to(torch::kInt64), v_isect);
+
+            auto v_means2d = v_all.narrow(1, 0, 2).reshape(means2d.sizes());
+            auto v_conics = v_all.narrow(1, 2, 3).reshape(conics.sizes());
+            auto v_colors = v_all.narrow(1, 5, channels).reshape(colors.sizes());
+            auto v_opacities = v_all.select(1, 5 + channels).reshape(opacities.sizes());
+            return {v_means2d, v_conics, v_colors, v_opacities};
+        }
+
+        torch::autograd::tensor_list RasterizationFunction::forward(
+            torch::autograd::AutogradContext* ctx,
+            torch::Tensor means2d,
+            torch::Tensor conics,
+            torch::Tensor colors,
+            torch::Tensor opacities,
+            torch::Tensor bg_color,
+            torch::Tensor isect_offsets,
+            torch::Tensor flatten_ids,
+            int64_t width,
+            int64_t height,
+            int64_t tile_size) {
+
+            // Per-Gaussian contribution accumulates into the active stats (single camera only)
+            torch::Tensor gauss_weights, gauss_hits;
+            if (auto* stats = ContributionStats::current(); stats && means2d.size(0) == 1) {
+                gauss_weights = stats->weight_buffer(means2d.size(1));
+                gauss_hits = stats->hit_buffer(means2d.size(1));
+            }
+
+            auto [renders, alphas, last_ids] = rasterize_to_pixels_fwd(
+                means2d, conics, colors, opacities, bg_color,
+                static_cast<int>(width), static_cast<int>(height), static_cast<int>(tile_size),
+                isect_offsets, flatten_ids, gauss_weights, gauss_hits);
+
+            ctx->save_for_backward({means2d, conics, colors, opacities, bg_color,
+                                    isect_offsets, flatten_ids, alphas, last_ids});
+            ctx->saved_data["width"] = width;
+            ctx->saved_data["height"] = height;
+            ctx->saved_data["tile_size"] = tile_size;
+
+            return {renders, alphas};
+        }
+
+        torch::autograd::tensor_list RasterizationFunction::backward(
+            torch::autograd::AutogradContext* ctx,
+            torch::autograd::tensor_list grad_outputs) {
+
+            auto saved = ctx->get_saved_variables();
+            const auto& means2d = saved[0];
+            const auto& conics = saved[1];
+            const auto& colors = saved[2];
+            const auto& opacities = saved[3];
+            const auto& bg_color = saved[4];
+            const auto& isect_offsets = saved[5];
+            const auto& flatten_ids = saved[6];
+            const auto& alphas = saved[7];
+            const auto& last_ids = saved[8];
+            const int width = static_cast<int>(ctx->saved_data["width"].toInt());
+            const int height = static_cast<int>(ctx->saved_data["height"].toInt());
+            const int tile_size = static_cast<int>(ctx->saved_data["tile_size"].toInt());
+
+            auto v_renders = grad_outputs[0].defined()
+                                 ? grad_outputs[0].contiguous()
+                                 : torch::zeros({alphas.size(0), height, width, colors.size(-1)}, alphas.options());
+            auto v_alphas = grad_outputs[1].defined() ? grad_outputs[1].contiguous() : torch::zeros_like(alphas);
+
+            auto [v_means2d, v_conics, v_colors, v_opacities] = rasterize_to_pixels_bwd(
+                means2d, conics, colors, opacities, bg_color,
+                width, height, tile_size, isect_offsets, flatten_ids,
+                alphas, last_ids, v_renders, v_alphas);
+
+            torch::Tensor v_bg_color;
+            if (ctx->needs_input_grad(4) && bg_color.defined() && bg_color.numel() > 0) {
+                v_bg_color = (v_renders * (1.0f - alphas)).sum({1, 2});
+            }
+
+            return {ctx->needs_input_grad(0) ? v_means2d : torch::Tensor(),
+                    ctx->needs_input_grad(1) ? v_conics : torch::Tensor(),
+                    ctx->needs_input_grad(2) ? v_colors : torch::Tensor(),
+                    ctx->needs_input_grad(3) ? v_opacities : torch::Tensor(),
+                    v_bg_color,
+                    torch::Tensor(), torch::Tensor(), torch::Tensor(), torch::Tensor(), torch::Tensor()};
+        }
+
+    } // namespace cpu
+} // namespace gs
@@ -1,5 +1,6 @@
 #include "core/selective_adam.hpp"
 #include "Ops.h"
+#include "core/profiler.hpp"
 #include <torch/torch.h>
 
 namespace gs {
@@ -10,6 +11,7 @@ namespace gs {
     }
 
     void SelectiveAdam::step(const torch::Tensor& visibility_mask) {
+        Profiler::ScopedTimer timer("selective_adam");
         torch::NoGradGuard no_grad;
 
         TORCH_CHECK(visibility_mask.dim() == 1, "visibility_mask must be 1D tensor");
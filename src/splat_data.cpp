@@ -139,6 +139,15 @@ namespace {
 
         write_output_ply(root / ("splat_" + std::to_string(iteration) + ".ply"), tensors, pc.attribute_names);
     }
+
+    // Contribution statistics go next to the PLY with matching rows
+    void write_stats_impl(const gs::ContributionStats& stats,
+                          const std::filesystem::path& root,
+                          int iteration) {
+        if (stats.enabled()) {
+            stats.save(root / ("splat_" + std::to_string(iteration) + "_contribution.pt"));
+        }
+    }
 } // namespace
 
 SplatData::~SplatData() {
@@ -162,7 +171,8 @@ SplatData::SplatData(SplatData&& other) noexcept
       _scaling(std::move(other._scaling)),
       _rotation(std::move(other._rotation)),
       _opacity(std::move(other._opacity)),
-      _max_radii2D(std::move(other._max_radii2D)) {
+      _max_radii2D(std::move(other._max_radii2D)),
+      _contribution_stats(std::move(other._contribution_stats)) {
     // Move threads under lock
     std::lock_guard<std::mutex> lock(other._threads_mutex);
     _save_threads = std::move(other._save_threads);
@@ -194,6 +204,7 @@ SplatData& SplatData::operator=(SplatData&& other) noexcept {
         _rotation = std::move(other._rotation);
         _opacity = std::move(other._opacity);
         _max_radii2D = std::move(other._max_radii2D);
+        _contribution_stats = std::move(other._contribution_stats);
 
         // Move threads under lock
         std::lock_guard<std::mutex> lock(other._threads_mutex);
@@ -220,7 +231,7 @@ SplatData::SplatData(int sh_degree,
       _scaling{std::move(scaling)},
       _rotation{std::move(rotation)},
       _opacity{std::move(opacity)},
-      _max_radii2D{torch::zeros({_means.size(0)}).to(torch::kCUDA)} {}
+      _max_radii2D{torch::zeros({_means.size(0)}, torch::TensorOptions().device(_means.device()))} {}
 
 // Computed getters
 torch::Tensor SplatData::get_means() const {
@@ -257,7 +268,7 @@ std::vector<std::string> SplatData::get_attribute_names() const {
 
     for (int i = 0; i < _sh0.size(1) * _sh0.size(2); ++i)
         a.emplace_back("f_dc_" + std::to_string(i));
-    for (int i = 0; i < _shN.size(1) * _shN.size(2); ++i)
+    for (int i = 0; i < shN_coeffs(_max_sh_degree) * 3; ++i)
         a.emplace_back("f_rest_" + std::to_string(i));
 
     a.emplace_back("opacity");
@@ -290,22 +301,81 @@ void SplatData::cleanup_finished_threads() const {
 // Export to PLY
 void SplatData::save_ply(const std::filesystem::path& root, int iteration, bool join_thread) const {
     auto pc = to_point_cloud();
+    auto stats = _contribution_stats.cpu();
 
     if (join_thread) {
         // Synchronous save
         write_ply_impl(pc, root, iteration);
+        write_stats_impl(stats, root, iteration);
     } else {
         // Clean up any finished threads first
         cleanup_finished_threads();
 
         // Asynchronous save with thread tracking
         std::lock_guard<std::mutex> lock(_threads_mutex);
-        _save_threads.emplace_back([pc = std::move(pc), root, iteration]() {
+        _save_threads.emplace_back([pc = std::move(pc), stats = std::move(stats), root, iteration]() {
             write_ply_impl(pc, root, iteration);
+            write_stats_impl(stats, root, iteration);
         });
     }
 }
 
+SplatData SplatData::load_ply(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open PLY file: " + path.string());
+    }
+
+    tinyply::PlyFile ply;
+    if (!ply.parse_header(file)) {
+        throw std::runtime_error("Invalid PLY header in " + path.string());
+    }
+
+    int64_t num_rest = 0;
+    for (const auto& element : ply.get_elements()) {
+        if (element.name != "vertex")
+            continue;
+        for (const auto& property : element.properties) {
+            num_rest += property.name.rfind("f_rest_", 0) == 0 ? 1 : 0;
+        }
+    }
+    TORCH_CHECK(num_rest % 3 == 0, "PLY has ", num_rest, " f_rest properties, expected a multiple of 3");
+    const int64_t rest_coeffs = num_rest / 3;
+    const int sh_degree = static_cast<int>(std::lround(std::sqrt(static_cast<double>(rest_coeffs + 1)))) - 1;
+    TORCH_CHECK(shN_coeffs(sh_degree) == rest_coeffs, "PLY has ", rest_coeffs, " SH coefficients per channel, which is not a full SH degree");
+
+    auto names = [](const std::string& prefix, int64_t count) {
+        std::vector<std::string> result;
+        for (int64_t i = 0; i < count; ++i)
+            result.push_back(prefix + std::to_string(i));
+        return result;
+    };
+    auto means_data = ply.request_properties_from_element("vertex", {"x", "y", "z"});
+    auto sh0_data = ply.request_properties_from_element("vertex", names("f_dc_", 3));
+    auto shN_data = num_rest > 0 ? ply.request_properties_from_element("vertex", names("f_rest_", num_rest)) : nullptr;
+    auto opacity_data = ply.request_properties_from_element("vertex", {"opacity"});
+    auto scaling_data = ply.request_properties_from_element("vertex", names("scale_", 3));
+    auto rotation_data = ply.request_properties_from_element("vertex", names("rot_", 4));
+    ply.read(file);
+
+    auto to_tensor = [&path](const std::shared_ptr<tinyply::PlyData>& data, int64_t cols) {
+        TORCH_CHECK(data->t == tinyply::Type::FLOAT32, "Expected float32 properties in ", path.string());
+        return torch::from_blob(data->buffer.get(), {static_cast<int64_t>(data->count), cols}, torch::kFloat32).clone();
+    };
+
+    const auto means = to_tensor(means_data, 3);
+    const int64_t N = means.size(0);
+    // Stored channel-major, as written by to_point_cloud
+    const auto sh0 = to_tensor(sh0_data, 3).view({N, 3, 1}).transpose(1, 2).contiguous();
+    const auto shN = shN_data ? to_tensor(shN_data, num_rest).view({N, 3, rest_coeffs}).transpose(1, 2).contiguous()
+                              : torch::zeros({N, 0, 3}, torch::kFloat32);
+
+    SplatData splat(sh_degree, means, sh0, shN, to_tensor(scaling_data, 3), to_tensor(rotation_data, 4),
+                    to_tensor(opacity_data, 1), 1.0f);
+    splat._active_sh_degree = sh_degree;
+    return splat;
+}
+
 PointCloud SplatData::to_point_cloud() const {
     PointCloud pc;
 
@@ -315,7 +385,13 @@ PointCloud SplatData::to_point_cloud() const {
 
     // Gaussian attributes
     pc.sh0 = _sh0.transpose(1, 2).flatten(1).cpu();
-    pc.shN = _shN.transpose(1, 2).flatten(1).cpu();
+    // Dormant coefficients are zero; the PLY always carries the full max-degree set
+    auto shN = _shN.detach();
+    const int64_t full_width = shN_coeffs(_max_sh_degree);
+    if (shN.size(1) < full_width) {
+        shN = torch::cat({shN, torch::zeros({shN.size(0), full_width - shN.size(1), 3}, shN.options())}, 1);
+    }
+    pc.shN = shN.transpose(1, 2).flatten(1).cpu();
     pc.opacity = _opacity.cpu();
     pc.scaling = _scaling.cpu();
     pc.rotation = _rotation.cpu();
@@ -370,27 +446,11 @@ SplatData SplatData::init_model_from_pointcloud(const gs::param::TrainingParamet
     auto fused_color = rgb_to_sh(colors_float);
 
     const int64_t feature_shape = static_cast<int64_t>(std::pow(params.optimization.sh_degree + 1, 2));
-    auto shs = torch::zeros({fused_color.size(0), 3, feature_shape}, f32_cuda);
-
-    // Set DC coefficients
-    shs.index_put_({torch::indexing::Slice(),
-                    torch::indexing::Slice(),
-                    0},
-                   fused_color);
-
-    auto sh0 = shs.index({torch::indexing::Slice(),
-                          torch::indexing::Slice(),
-                          torch::indexing::Slice(0, 1)})
-                   .transpose(1, 2)
-                   .contiguous()
-                   .set_requires_grad(true);
-
-    auto shN = shs.index({torch::indexing::Slice(),
-                          torch::indexing::Slice(),
-                          torch::indexing::Slice(1, torch::indexing::None)})
-                   .transpose(1, 2)
-                   .contiguous()
-                   .set_requires_grad(true);
+
+    // Only the DC coefficients are allocated: training starts at SH degree 0
+    // and shN grows as higher degrees are activated
+    auto sh0 = fused_color.unsqueeze(1).contiguous().set_requires_grad(true);                 // [N, 1, 3]
+    auto shN = torch::zeros({fused_color.size(0), 0, 3}, f32_cuda).set_requires_grad(true); // [N, 0, 3]
 
     std::cout << "Scene scale: " << scene_scale << std::endl;
     std::cout << "Initialized SplatData with:" << std::endl;
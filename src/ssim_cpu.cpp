@@ -0,0 +1,145 @@
+#include "core/ssim_cpu.hpp"
+#include <ATen/Parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gs {
+    namespace metrics {
+
+        namespace {
+            // Rows of one plane handled by a single task
+            constexpr int64_t kBandRows = 32;
+
+            // The five filtered moments: mu1, mu2, E[x1^2], E[x2^2], E[x1 x2]
+            constexpr int kMoments = 5;
+
+            // out[x] += w * src[x + offset] for every x whose source lies inside [0, W)
+            inline void axpy_shifted(float* out, const float* src, float w, int64_t offset, int64_t W) {
+                const int64_t begin = std::max<int64_t>(0, -offset);
+                const int64_t end = std::min<int64_t>(W, W - offset);
+                for (int64_t x = begin; x < end; ++x) {
+                    out[x] += w * src[x + offset];
+                }
+            }
+
+            void ssim_band(const float* img1, const float* img2, float* ssim_map,
+                           int64_t H, int64_t W, int64_t y0, int64_t y1,
+                           const std::vector<float>& window, float C1, float C2,
+                           std::vector<float>& scratch) {
+                const int64_t K = static_cast<int64_t>(window.size());
+                const int64_t r = K / 2;
+
+                // Rows of the horizontal pass needed by the vertical pass
+                const int64_t h0 = std::max<int64_t>(0, y0 - r);
+                const int64_t h1 = std::min<int64_t>(H, y1 + (K - 1 - r));
+                const int64_t rows = h1 - h0;
+
+                scratch.assign(kMoments * rows * W + kMoments * W + 3 * W, 0.0f);
+                float* horizontal = scratch.data();
+                float* vertical = horizontal + kMoments * rows * W;
+                float* products = vertical + kMoments * W;
+                float* p11 = products;
+                float* p22 = products + W;
+                float* p12 = products + 2 * W;
+
+                // Horizontal pass over the image rows and their products
+                for (int64_t y = h0; y < h1; ++y) {
+                    const float* a = img1 + y * W;
+                    const float* b = img2 + y * W;
+                    for (int64_t x = 0; x < W; ++x) {
+                        p11[x] = a[x] * a[x];
+                        p22[x] = b[x] * b[x];
+                        p12[x] = a[x] * b[x];
+                    }
+                    const float* sources[kMoments] = {a, b, p11, p22, p12};
+                    for (int m = 0; m < kMoments; ++m) {
+                        float* out = horizontal + (m * rows + (y - h0)) * W;
+                        for (int64_t k = 0; k < K; ++k) {
+                            axpy_shifted(out, sources[m], window[k], k - r, W);
+                        }
+                    }
+                }
+
+                // Vertical pass, fused with the SSIM formula
+                for (int64_t y = y0; y < y1; ++y) {
+                    std::fill(vertical, vertical + kMoments * W, 0.0f);
+                    for (int64_t k = 0; k < K; ++k) {
+                        const int64_t src_y = y + k - r;
+                        if (src_y < 0 || src_y >= H) {
+                            continue;
+                        }
+                        const float w = window[k];
+                        for (int m = 0; m < kMoments; ++m) {
+                            const float* src = horizontal + (m * rows + (src_y - h0)) * W;
+                            float* out = vertical + m * W;
+                            for (int64_t x = 0; x < W; ++x) {
+                                out[x] += w * src[x];
+                            }
+                        }
+                    }
+
+                    const float* mu1 = vertical;
+                    const float* mu2 = vertical + W;
+                    const float* e11 = vertical + 2 * W;
+                    const float* e22 = vertical + 3 * W;
+                    const float* e12 = vertical + 4 * W;
+                    float* out = ssim_map + y * W;
+                    for (int64_t x = 0; x < W; ++x) {
+                        const float mu1_sq = mu1[x] * mu1[x];
+                        const float mu2_sq = mu2[x] * mu2[x];
+                        const float mu1_mu2 = mu1[x] * mu2[x];
+                        const float sigma1_sq = e11[x] - mu1_sq;
+                        const float sigma2_sq = e22[x] - mu2_sq;
+                        const float sigma12 = e12[x] - mu1_mu2;
+                        out[x] = ((2.f * mu1_mu2 + C1) * (2.f * sigma12 + C2)) /
+                                 ((mu1_sq + mu2_sq + C1) * (sigma1_sq + sigma2_sq + C2));
+                    }
+                }
+            }
+        } // namespace
+
+        std::vector<float> gaussian_window(int window_size, float sigma) {
+            if (window_size <= 0 || sigma <= 0.f) {
+                throw std::invalid_argument("gaussian_window: window size and sigma must be positive");
+            }
+            std::vector<float> window(window_size);
+            double sum = 0.0;
+            for (int x = 0; x < window_size; ++x) {
+                const double d = x - window_size / 2;
+                window[x] = static_cast<float>(std::exp(-d * d / (2.0 * sigma * sigma)));
+                sum += window[x];
+            }
+            for (auto& w : window) {
+                w = static_cast<float>(w / sum);
+            }
+            return window;
+        }
+
+        void ssim_map_cpu(const float* img1, const float* img2, float* ssim_map,
+                          int64_t planes, int64_t H, int64_t W,
+                          const std::vector<float>& window, float C1, float C2) {
+            if (window.empty()) {
+                throw std::invalid_argument("ssim_map_cpu: empty window");
+            }
+            if (planes <= 0 || H <= 0 || W <= 0) {
+                return;
+            }
+
+            const int64_t bands_per_plane = (H + kBandRows - 1) / kBandRows;
+            const int64_t num_tasks = planes * bands_per_plane;
+            at::parallel_for(0, num_tasks, 1, [&](int64_t begin, int64_t end) {
+                std::vector<float> scratch;
+                for (int64_t task = begin; task < end; ++task) {
+                    const int64_t plane = task / bands_per_plane;
+                    const int64_t y0 = (task % bands_per_plane) * kBandRows;
+                    const int64_t y1 = std::min(H, y0 + kBandRows);
+                    const int64_t offset = plane * H * W;
+                    ssim_band(img1 + offset, img2 + offset, ssim_map + offset,
+                              H, W, y0, y1, window, C1, C2, scratch);
+                }
+            });
+        }
+
+    } // namespace metrics
+} // namespace gs
@@ -0,0 +1,63 @@
+#include "core/strategy_registry.hpp"
+#include "core/default_strategy.hpp"
+#include "core/mcmc.hpp"
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace gs {
+
+    namespace {
+        // Built-ins are added here rather than through static registrars, which
+        // the linker drops from a static library when nothing references them
+        std::map<std::string, StrategyFactory>& registry() {
+            static std::map<std::string, StrategyFactory> factories = {
+                {"mcmc", [](SplatData&& splat_data) -> std::unique_ptr<IStrategy> {
+                     return std::make_unique<MCMC>(std::move(splat_data));
+                 }},
+                {"default", [](SplatData&& splat_data) -> std::unique_ptr<IStrategy> {
+                     return std::make_unique<DefaultStrategy>(std::move(splat_data));
+                 }}};
+            return factories;
+        }
+
+        std::mutex registry_mutex;
+    } // namespace
+
+    std::unique_ptr<IStrategy> create_strategy(const std::string& name, SplatData&& splat_data) {
+        StrategyFactory factory;
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            const auto it = registry().find(name);
+            if (it == registry().end()) {
+                std::string names;
+                for (const auto& [known, _] : registry()) {
+                    names += (names.empty() ? "" : ", ") + known;
+                }
+                throw std::invalid_argument("Unknown strategy '" + name + "'. Available: " + names);
+            }
+            factory = it->second;
+        }
+        return factory(std::move(splat_data));
+    }
+
+    void register_strategy(const std::string& name, StrategyFactory factory) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        registry()[name] = std::move(factory);
+    }
+
+    bool has_strategy(const std::string& name) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        return registry().count(name) > 0;
+    }
+
+    std::vector<std::string> available_strategies() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        std::vector<std::string> names;
+        for (const auto& [name, _] : registry()) {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+} // namespace gs
@@ -0,0 +1,222 @@
+#include "core/strategy_utils.hpp"
+#include "core/selective_adam.hpp"
+#include <iostream>
+#include <stdexcept>
+
+namespace gs::strategy {
+
+    namespace {
+        double get_lr(torch::optim::OptimizerParamGroup& group) {
+            if (auto* selective_adam_options = dynamic_cast<gs::SelectiveAdam::Options*>(&group.options())) {
+                return selective_adam_options->lr();
+            } else if (auto* adam_options = dynamic_cast<torch::optim::AdamOptions*>(&group.options())) {
+                return adam_options->lr();
+            }
+            return 0.0;
+        }
+    } // namespace
+
+    int64_t tensor_bytes(const torch::Tensor& tensor) {
+        return tensor.defined() ? static_cast<int64_t>(tensor.nbytes()) : 0;
+    }
+
+    int64_t parameter_bytes(SplatData& splat_data) {
+        int64_t bytes = 0;
+        for (auto* param : parameters(splat_data)) {
+            bytes += tensor_bytes(*param);
+        }
+        return bytes;
+    }
+
+    std::array<torch::Tensor*, NumParamGroups> parameters(SplatData& splat_data) {
+        return {&splat_data.means(), &splat_data.sh0(), &splat_data.shN(),
+                &splat_data.scaling_raw(), &splat_data.rotation_raw(), &splat_data.opacity_raw()};
+    }
+
+    void to_device(SplatData& splat_data, const torch::Device& device) {
+        for (auto* param : parameters(splat_data)) {
+            *param = param->to(device).detach().set_requires_grad(true);
+        }
+    }
+
+    std::unique_ptr<torch::optim::Optimizer> create_optimizer(SplatData& splat_data,
+                                                              const param::OptimizationParameters& params) {
+        const std::array<double, NumParamGroups> lrs = {
+            params.means_lr * splat_data.get_scene_scale(),
+            params.shs_lr,
+            params.shs_lr / 20.f,
+            params.scaling_lr,
+            params.rotation_lr,
+            params.opacity_lr};
+        const auto all_params = parameters(splat_data);
+
+        if (params.selective_adam) {
+            std::cout << "Using SelectiveAdam optimizer" << std::endl;
+
+            using Options = gs::SelectiveAdam::Options;
+            std::vector<torch::optim::OptimizerParamGroup> groups;
+            for (int i = 0; i < NumParamGroups; ++i) {
+                auto options = std::make_unique<Options>(lrs[i]);
+                options->eps(1e-15).betas(std::make_tuple(0.9, 0.999));
+                groups.emplace_back(
+                    std::vector<torch::Tensor>{*all_params[i]},
+                    std::unique_ptr<torch::optim::OptimizerOptions>(std::move(options)));
+            }
+
+            auto global_options = std::make_unique<Options>(0.f);
+            global_options->eps(1e-15);
+            return std::make_unique<gs::SelectiveAdam>(std::move(groups), std::move(global_options));
+        }
+
+        using torch::optim::AdamOptions;
+        std::vector<torch::optim::OptimizerParamGroup> groups;
+        for (int i = 0; i < NumParamGroups; ++i) {
+            groups.emplace_back(torch::optim::OptimizerParamGroup(
+                {*all_params[i]}, std::make_unique<AdamOptions>(AdamOptions(lrs[i]).eps(1e-15))));
+        }
+        return std::make_unique<torch::optim::Adam>(groups, AdamOptions(0.f).eps(1e-15));
+    }
+
+    void update_param_with_optimizer(SplatData& splat_data,
+                                     torch::optim::Optimizer& optimizer,
+                                     const TensorFn& param_fn,
+                                     const TensorFn& state_fn,
+                                     const std::vector<int>& groups) {
+        torch::NoGradGuard no_grad;
+        const auto all_params = parameters(splat_data);
+
+        for (int i : groups) {
+            if (i < 0 || i >= NumParamGroups) {
+                throw std::out_of_range("Invalid parameter group " + std::to_string(i));
+            }
+            auto& group_param = optimizer.param_groups()[i].params()[0];
+            void* old_key = group_param.unsafeGetTensorImpl();
+            auto new_param = param_fn(i, *all_params[i]).detach().set_requires_grad(true);
+
+            // Re-key the state under the new parameter, transforming its tensors
+            auto& state = optimizer.state();
+            auto state_it = state.find(old_key);
+            std::unique_ptr<torch::optim::OptimizerParamState> param_state;
+            if (state_it != state.end()) {
+                param_state = std::move(state_it->second);
+                state.erase(state_it);
+
+                if (auto* adam_state = dynamic_cast<torch::optim::AdamParamState*>(param_state.get())) {
+                    adam_state->exp_avg(state_fn(i, adam_state->exp_avg()));
+                    adam_state->exp_avg_sq(state_fn(i, adam_state->exp_avg_sq()));
+                    if (adam_state->max_exp_avg_sq().defined()) {
+                        adam_state->max_exp_avg_sq(state_fn(i, adam_state->max_exp_avg_sq()));
+                    }
+                } else if (auto* selective_adam_state = dynamic_cast<gs::SelectiveAdam::AdamParamState*>(param_state.get())) {
+                    selective_adam_state->exp_avg = state_fn(i, selective_adam_state->exp_avg);
+                    selective_adam_state->exp_avg_sq = state_fn(i, selective_adam_state->exp_avg_sq);
+                    if (selective_adam_state->max_exp_avg_sq.defined()) {
+                        selective_adam_state->max_exp_avg_sq = state_fn(i, selective_adam_state->max_exp_avg_sq);
+                    }
+                }
+            }
+
+            group_param = new_param;
+            if (param_state) {
+                state[new_param.unsafeGetTensorImpl()] = std::move(param_state);
+            }
+            *all_params[i] = new_param;
+        }
+    }
+
+    void increment_sh_degree(SplatData& splat_data, torch::optim::Optimizer& optimizer) {
+        splat_data.increment_sh_degree();
+
+        const int64_t stored = splat_data.shN().size(1);
+        const int64_t needed = SplatData::shN_coeffs(splat_data.get_active_sh_degree());
+        if (needed <= stored) {
+            return;
+        }
+
+        torch::NoGradGuard no_grad;
+        const auto widen = [stored, needed](int, const torch::Tensor& t) {
+            auto shape = t.sizes().vec();
+            shape[1] = needed - stored;
+            return torch::cat({t, torch::zeros(shape, t.options())}, 1);
+        };
+        // The gradient of this iteration still has to be applied by the next step
+        const auto grad = splat_data.shN().grad();
+        update_param_with_optimizer(splat_data, optimizer, widen, widen, {ShN});
+        if (grad.defined()) {
+            splat_data.shN().mutable_grad() = widen(ShN, grad);
+        }
+    }
+
+    std::unique_ptr<LRScheduler> create_scheduler(torch::optim::Optimizer& optimizer,
+                                                  const param::OptimizationParameters& params) {
+        auto scheduler = std::make_unique<LRScheduler>(optimizer, static_cast<int>(params.iterations));
+
+        LRScheduleConfig config;
+        config.warmup_steps = static_cast<int>(params.lr_warmup_steps);
+        for (int group = 0; group < NumParamGroups; ++group) {
+            if (group == Means) {
+                LRScheduleConfig means_config = config;
+                means_config.type = lr_schedule_from_string(params.lr_schedule);
+                means_config.final_factor = params.lr_final_factor;
+                means_config.step_size = static_cast<int>(params.lr_step_every);
+                scheduler->set_schedule(group, means_config);
+            } else if (config.warmup_steps > 0) {
+                scheduler->set_schedule(group, config);
+            }
+        }
+        return scheduler;
+    }
+
+    double learning_rate(torch::optim::Optimizer& optimizer, int group) {
+        return get_lr(optimizer.param_groups()[group]);
+    }
+
+    const char* param_group_name(int group) {
+        static const char* names[NumParamGroups] = {"means", "sh0", "shN", "scaling", "rotation", "opacity"};
+        if (group < 0 || group >= NumParamGroups) {
+            throw std::out_of_range("Invalid param group " + std::to_string(group));
+        }
+        return names[group];
+    }
+
+    int64_t optimizer_state_bytes(const torch::optim::Optimizer& optimizer, int group) {
+        const auto& param = optimizer.param_groups().at(group).params()[0];
+        auto state_it = optimizer.state().find(param.unsafeGetTensorImpl());
+        if (state_it == optimizer.state().end()) {
+            return 0;
+        }
+        const auto& param_state = *state_it->second;
+        if (const auto* adam_state = dynamic_cast<const torch::optim::AdamParamState*>(&param_state)) {
+            return tensor_bytes(adam_state->exp_avg()) + tensor_bytes(adam_state->exp_avg_sq()) +
+                   tensor_bytes(adam_state->max_exp_avg_sq());
+        }
+        if (const auto* selective_adam_state = dynamic_cast<const gs::SelectiveAdam::AdamParamState*>(&param_state)) {
+            return tensor_bytes(selective_adam_state->exp_avg) + tensor_bytes(selective_adam_state->exp_avg_sq) +
+                   tensor_bytes(selective_adam_state->max_exp_avg_sq);
+        }
+        return 0;
+    }
+
+    void report_model_memory(const SplatData& splat_data,
+                             const torch::optim::Optimizer& optimizer,
+                             MemoryReport& report) {
+        namespace cat = memory_category;
+        // The optimizer holds the same tensors as splat_data, in ParamGroup order
+        const auto& groups = optimizer.param_groups();
+        for (int i = 0; i < NumParamGroups && i < static_cast<int>(groups.size()); ++i) {
+            const auto& param = groups[i].params()[0];
+            report.add(cat::Parameters, param_group_name(i), tensor_bytes(param));
+            report.add(cat::Gradients, param_group_name(i), tensor_bytes(param.grad()));
+            report.add(cat::AdamMoments, param_group_name(i), optimizer_state_bytes(optimizer, i));
+        }
+
+        report.add(cat::StrategyState, "max_radii2D", tensor_bytes(splat_data.max_radii2D()));
+        const auto& stats = splat_data.contribution_stats();
+        if (stats.enabled()) {
+            report.add(cat::StrategyState, "contribution stats",
+                       tensor_bytes(stats.weight_sum()) + tensor_bytes(stats.hit_count()) +
+                           tensor_bytes(stats.last_visible()));
+        }
+    }
+
+} // namespace gs::strategy
@@ -0,0 +1,153 @@
+#include "core/tile_size_tuner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace gs {
+
+    namespace {
+        // Same encoding width gsplat uses for tile and camera ids
+        int id_bits(int64_t n) {
+            return static_cast<int>(std::floor(std::log2(static_cast<double>(n)))) + 1;
+        }
+
+        // Relative costs for the tuner's model (see header)
+        constexpr double kIsectCost = 128.0;
+        constexpr double kTileCost = 256.0;
+        // Pixel evaluations the device runs concurrently: a block that is still
+        // walking its list after the others finished idles about this many lanes
+        constexpr double kDeviceWidth = 16384.0;
+        constexpr double kTailQuantile = 0.99;
+        constexpr int kHistogramBuckets = 16;
+    } // namespace
+
+    int fit_tile_size(int tile_size, int image_width, int image_height, int num_cameras) {
+        if (tile_size <= 0) {
+            throw std::invalid_argument("tile_size must be positive, got " + std::to_string(tile_size));
+        }
+        for (int size = tile_size; size <= kMaxTileSize; size *= 2) {
+            const int64_t tiles_x = (image_width + size - 1) / size;
+            const int64_t tiles_y = (image_height + size - 1) / size;
+            if (id_bits(tiles_x * tiles_y) + id_bits(num_cameras) <= 32) {
+                return size;
+            }
+        }
+        throw std::runtime_error("Image of " + std::to_string(image_width) + "x" + std::to_string(image_height) +
+                                 " has too many tiles to encode intersection ids, even with tile_size " +
+                                 std::to_string(kMaxTileSize));
+    }
+
+    TileSizeTuner::TileSizeTuner(std::vector<int> candidates, int rounds)
+        : candidates_(std::move(candidates)),
+          rounds_(std::max(1, rounds)) {
+        if (candidates_.empty()) {
+            throw std::invalid_argument("TileSizeTuner needs at least one candidate tile size");
+        }
+        for (int size : candidates_) {
+            if (size <= 0 || size > kMaxTileSize) {
+                throw std::invalid_argument("Tile size candidates must be in [1, " + std::to_string(kMaxTileSize) +
+                                            "], got " + std::to_string(size));
+            }
+        }
+        stats_.resize(candidates_.size());
+        if (candidates_.size() == 1) {
+            chosen_ = candidates_.front();
+        }
+    }
+
+    int TileSizeTuner::index_of(int tile_size) const {
+        const auto it = std::find(candidates_.begin(), candidates_.end(), tile_size);
+        return it == candidates_.end() ? -1 : static_cast<int>(it - candidates_.begin());
+    }
+
+    int TileSizeTuner::next_tile_size() const {
+        if (is_tuned()) {
+            return chosen_;
+        }
+        return candidates_[observed_ % candidates_.size()];
+    }
+
+    void TileSizeTuner::observe(int tile_size, const torch::Tensor& isect_offsets, int64_t n_isects) {
+        const int idx = index_of(tile_size);
+        if (is_tuned() || idx < 0) {
+            return; // e.g. a fallback size forced by fit_tile_size
+        }
+
+        // Per-tile list lengths from the start offsets of consecutive tiles
+        torch::NoGradGuard no_grad;
+        const auto starts = isect_offsets.flatten().to(torch::kInt64);
+        const auto ends = torch::cat({starts.slice(0, 1), torch::full({1}, n_isects, starts.options())});
+        const auto counts = (ends - starts).cpu();
+
+        auto& stats = stats_[idx];
+        stats.renders += 1;
+        stats.isects += static_cast<double>(n_isects);
+        stats.tiles += static_cast<double>(counts.numel());
+        stats.histogram.resize(kHistogramBuckets, 0);
+        const auto* count_ptr = counts.data_ptr<int64_t>();
+        for (int64_t t = 0; t < counts.numel(); ++t) {
+            const int64_t c = count_ptr[t];
+            stats.max_per_tile = std::max(stats.max_per_tile, static_cast<double>(c));
+            const int bucket = c == 0 ? 0 : std::min(kHistogramBuckets - 1, id_bits(c));
+            stats.histogram[bucket] += 1;
+        }
+        if (counts.numel() > 0) {
+            std::vector<int64_t> sorted(count_ptr, count_ptr + counts.numel());
+            const auto nth = sorted.begin() + static_cast<int64_t>(kTailQuantile * static_cast<double>(sorted.size() - 1));
+            std::nth_element(sorted.begin(), nth, sorted.end());
+            stats.tail += static_cast<double>(*nth);
+        }
+
+        ++observed_;
+        if (observed_ < rounds_ * static_cast<int>(candidates_.size())) {
+            return;
+        }
+
+        double best_cost = std::numeric_limits<double>::max();
+        for (int size : candidates_) {
+            const double cost = estimated_cost(size);
+            if (cost > 0.0 && cost < best_cost) {
+                best_cost = cost;
+                chosen_ = size;
+            }
+        }
+    }
+
+    double TileSizeTuner::estimated_cost(int tile_size) const {
+        const int idx = index_of(tile_size);
+        if (idx < 0 || stats_[idx].renders == 0) {
+            return 0.0;
+        }
+        const auto& stats = stats_[idx];
+        const double pixels_per_tile = static_cast<double>(tile_size) * tile_size;
+        return (stats.isects * (kIsectCost + pixels_per_tile) + stats.tiles * kTileCost + stats.tail * kDeviceWidth) /
+               stats.renders;
+    }
+
+    std::string TileSizeTuner::summary() const {
+        std::ostringstream ss;
+        for (size_t i = 0; i < candidates_.size(); ++i) {
+            const auto& stats = stats_[i];
+            ss << "tile " << std::setw(2) << candidates_[i] << ": ";
+            if (stats.renders == 0) {
+                ss << "not observed\n";
+                continue;
+            }
+            ss << std::fixed << std::setprecision(1)
+               << "isects/tile " << stats.isects / stats.tiles
+               << ", p99 " << stats.tail / stats.renders
+               << ", max " << stats.max_per_tile
+               << ", histogram [";
+            for (size_t b = 0; b < stats.histogram.size(); ++b) {
+                ss << (b ? " " : "") << stats.histogram[b];
+            }
+            ss << "], cost " << std::setprecision(3) << std::scientific << estimated_cost(candidates_[i])
+               << std::defaultfloat << (candidates_[i] == chosen_ ? "  <- chosen" : "") << "\n";
+        }
+        return ss.str();
+    }
+
+} // namespace gs
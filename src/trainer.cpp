@@ -1,7 +1,12 @@
 #include "core/trainer.hpp"
+#include "core/compaction.hpp"
 #include "core/rasterizer.hpp"
+#include "core/strategy_utils.hpp"
 #include "kernels/fused_ssim.cuh"
 #include "visualizer/detail.hpp"
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAFunctions.h>
+#include <cuda_runtime_api.h>
 #include <chrono>
 #include <iostream>
 #include <numeric>
@@ -9,6 +14,10 @@
 
 namespace gs {
 
+    // Dataloader threads. Each keeps up to two decoded images on the device
+    // ahead of training (libtorch's default of 2 * workers outstanding jobs).
+    static constexpr int kLoaderWorkers = 4;
+
     static inline torch::Tensor ensure_4d(const torch::Tensor& image) {
         return image.dim() == 3 ? image.unsqueeze(0) : image;
     }
@@ -74,8 +83,21 @@ namespace gs {
         : strategy_(std::move(strategy)),
           params_(params) {
 
+        // The CPU backend covers rendering; the training loss (fused SSIM), image
+        // loading and the bilateral grid still run on CUDA only
         if (!torch::cuda::is_available()) {
-            throw std::runtime_error("CUDA is not available – aborting.");
+            throw std::runtime_error("CUDA is not available – aborting. Training needs a GPU; "
+                                     "the CPU backend only renders.");
+        }
+
+        // Seed the global generators (data order and anything outside the strategy,
+        // which keeps its own generator seeded from the same value)
+        torch::manual_seed(params.optimization.seed);
+        if (params.optimization.deterministic) {
+            // Also selects the fixed-point accumulation in gsplat's rasterization backward
+            at::globalContext().setDeterministicAlgorithms(true, /*warn_only=*/true);
+            at::globalContext().setDeterministicCuDNN(true);
+            at::globalContext().setBenchmarkCuDNN(false);
         }
 
         // Handle dataset split based on evaluation flag
@@ -102,6 +124,11 @@ namespace gs {
 
         strategy_->initialize(params.optimization);
 
+        if (params.optimization.collect_contribution_stats) {
+            auto& model = strategy_->get_model();
+            model.contribution_stats().enable(model.size(), model.means().device());
+        }
+
         // Initialize bilateral grid if enabled
         initialize_bilateral_grid();
 
@@ -110,7 +137,27 @@ namespace gs {
 
         progress_ = std::make_unique<TrainingProgress>(
             params.optimization.iterations,
-            /*bar_width=*/100);
+            /*bar_width=*/100,
+            params.optimization.enable_early_stopping);
+
+        if (params.optimization.enable_early_stopping) {
+            ConvergenceMonitor::Config config;
+            config.check_every = static_cast<int>(params.optimization.early_stop_every);
+            config.patience = params.optimization.early_stop_patience;
+            config.min_gain_db = params.optimization.early_stop_min_gain;
+            // Higher SH bands only start training later; don't stop before all are active
+            config.min_iterations = params.optimization.sh_degree * params.optimization.sh_degree_interval;
+            convergence_ = std::make_unique<ConvergenceMonitor>(config);
+            std::cout << "Early stopping: every " << config.check_every << " iterations on "
+                      << (val_dataset_ ? "validation PSNR" : "smoothed training loss") << std::endl;
+        }
+
+        if (params.optimization.enable_profiling || !params.optimization.profile_trace.empty()) {
+            // Device stages are timed with CUDA events so profiling adds no synchronization
+            const bool on_gpu = strategy_->get_model().means().is_cuda();
+            profiler_ = std::make_unique<Profiler>(on_gpu ? make_cuda_event_timer() : nullptr,
+                                                   !params.optimization.profile_trace.empty());
+        }
 
         // Initialize the evaluator - it handles all metrics internally
         evaluator_ = std::make_unique<metrics::MetricsEvaluator>(params);
@@ -118,7 +165,18 @@ namespace gs {
         // Print render mode configuration
         std::cout << "Render mode: " << params.optimization.render_mode << std::endl;
 
+        if (params.optimization.tile_size == 0) {
+            tile_tuner_ = std::make_unique<TileSizeTuner>();
+            std::cout << "Tile size: auto" << std::endl;
+        } else {
+            std::cout << "Tile size: " << params.optimization.tile_size << std::endl;
+        }
+
+        std::cout << "Seed: " << params.optimization.seed
+                  << (params.optimization.deterministic ? " (deterministic)" : "") << std::endl;
         std::cout << "Visualization: " << (params.optimization.enable_viz ? "enabled" : "disabled") << std::endl;
+
+        print_memory_prediction();
     }
 
     Trainer::~Trainer() {
@@ -169,6 +227,161 @@ namespace gs {
         }
     }
 
+    void Trainer::compact_model(int iter) {
+        std::vector<Camera*> views;
+        views.reserve(train_dataset_size_);
+        for (size_t i = 0; i < train_dataset_size_; ++i) {
+            views.push_back(train_dataset_->get_camera(i));
+        }
+        const int tile_size = tile_tuner_ ? tile_tuner_->next_tile_size() : params_.optimization.tile_size;
+
+        std::cout << "\nCompacting model at iteration " << iter << " over " << views.size() << " views..." << std::endl;
+        if (iter < static_cast<int>(params_.optimization.stop_refine)) {
+            std::cout << "Warning: compacting before stop_refine, densification will continue afterwards" << std::endl;
+        }
+        auto run = [&]() {
+            return compact(*strategy_, views, params_.optimization.min_opacity,
+                           params_.optimization.compaction_min_weight, tile_size);
+        };
+        CompactionReport report;
+        if (viewer_) {
+            std::lock_guard<std::mutex> lock(viewer_->splat_mtx_);
+            report = run();
+        } else {
+            report = run();
+        }
+        std::cout << report.to_string() << std::endl;
+
+        // The workspace buffers were sized for the larger model
+        raster_workspace_.release();
+    }
+
+    double Trainer::validation_psnr() {
+        torch::NoGradGuard no_grad;
+        const size_t num_views = val_dataset_->size().value();
+        const size_t count = std::min(num_views, static_cast<size_t>(params_.optimization.early_stop_views));
+        const metrics::PSNR psnr_metric;
+        const RenderMode render_mode = stringToRenderMode(params_.optimization.render_mode);
+
+        // Rotate through the split so every view is scored over successive checks
+        double psnr_sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            auto example = val_dataset_->get(convergence_view_);
+            convergence_view_ = (convergence_view_ + 1) % num_views;
+
+            auto r_output = gs::rasterize_inference(*example.data.camera, strategy_->get_model(),
+                                                    background_, 1.0f, render_mode);
+            auto image = torch::clamp(r_output.image, 0.0, 1.0).unsqueeze(0);
+            psnr_sum += psnr_metric.compute(image, example.data.image.unsqueeze(0));
+        }
+        return psnr_sum / static_cast<double>(count);
+    }
+
+    bool Trainer::check_convergence(int iter) {
+        const auto render_mode = stringToRenderMode(params_.optimization.render_mode);
+        const bool has_rgb = render_mode != RenderMode::D && render_mode != RenderMode::ED;
+        const bool use_validation = val_dataset_ && val_dataset_->size().value() > 0 && has_rgb;
+
+        const bool converged = use_validation ? convergence_->check(iter, validation_psnr())
+                                              : convergence_->check_loss(iter);
+        std::cout << "\nEarly stopping " << convergence_->summary() << std::endl;
+        return converged;
+    }
+
+    MemoryReport Trainer::memory_report() const {
+        namespace cat = memory_category;
+        MemoryReport report;
+        strategy_->report_memory(report);
+
+        if (bilateral_grid_) {
+            const auto& grids = bilateral_grid_->parameters();
+            report.add(cat::BilateralGrid, "grids", static_cast<int64_t>(grids.nbytes()));
+            report.add(cat::BilateralGrid, "gradient",
+                       grids.grad().defined() ? static_cast<int64_t>(grids.grad().nbytes()) : 0);
+            report.add(cat::BilateralGrid, "adam moments",
+                       strategy::optimizer_state_bytes(*bilateral_grid_optimizer_, 0));
+        }
+
+        report.add(cat::Rasterizer, "workspace", static_cast<int64_t>(raster_workspace_.reserved_bytes()));
+
+        // Images are not cached; the ones in flight are the loader's prefetch
+        // plus the one being trained on, all the size of the last one
+        const int64_t image_bytes = last_image_width_ * last_image_height_ * 3 * static_cast<int64_t>(sizeof(float));
+        report.add(cat::DatasetImages, "prefetched (estimated)", image_bytes * (2 * kLoaderWorkers + 1));
+
+        const auto& device = strategy_->get_model().means().device();
+        if (device.is_cuda()) {
+            // Index 0 is the aggregate over the small and large pools
+            const auto device_index = device.has_index() ? device.index() : c10::cuda::current_device();
+            const auto stats = c10::cuda::CUDACachingAllocator::getDeviceStats(device_index);
+            report.allocated_bytes = stats.allocated_bytes[0].current;
+            report.peak_allocated_bytes = stats.allocated_bytes[0].peak;
+            report.reserved_bytes = stats.reserved_bytes[0].current;
+        }
+        return report;
+    }
+
+    MemoryModelConfig Trainer::memory_model_config(int64_t num_gaussians) const {
+        const auto& opt = params_.optimization;
+        MemoryModelConfig config;
+        config.num_gaussians = num_gaussians;
+        config.sh_degree = opt.sh_degree;
+        config.default_strategy = opt.strategy == "default";
+        config.contribution_stats = opt.collect_contribution_stats;
+        config.tile_size = opt.tile_size > 0 ? opt.tile_size : 16;
+        config.num_images = static_cast<int64_t>(train_dataset_size_);
+        config.bilateral_grid = opt.use_bilateral_grid;
+        config.grid_X = opt.bilateral_grid_X;
+        config.grid_Y = opt.bilateral_grid_Y;
+        config.grid_W = opt.bilateral_grid_W;
+        config.prefetched_images = 2 * kLoaderWorkers + 1;
+
+        if (last_image_width_ > 0) {
+            config.image_width = last_image_width_;
+            config.image_height = last_image_height_;
+        } else {
+            // Cameras still hold the full size until their image is loaded
+            const int res_div = params_.dataset.resolution;
+            const int div = (res_div == 2 || res_div == 4 || res_div == 8) ? res_div : 1;
+            for (size_t i = 0; i < train_dataset_size_; ++i) {
+                const auto* cam = train_dataset_->get_camera(i);
+                const int64_t w = cam->image_width() / div, h = cam->image_height() / div;
+                if (w * h > config.image_width * config.image_height) {
+                    config.image_width = w;
+                    config.image_height = h;
+                }
+            }
+        }
+
+        const int64_t current_n = strategy_->get_model().size();
+        if (last_n_isects_ > 0 && current_n > 0) {
+            config.isects_per_gaussian = static_cast<double>(last_n_isects_) / static_cast<double>(current_n);
+        }
+        return config;
+    }
+
+    MemoryReport Trainer::predict_memory(int64_t num_gaussians) const {
+        return gs::predict_memory(memory_model_config(num_gaussians));
+    }
+
+    void Trainer::print_memory_prediction() const {
+        const int64_t max_cap = params_.optimization.max_cap;
+        const auto prediction = predict_memory(max_cap);
+        std::cout << "Predicted memory at max_cap (" << max_cap << " Gaussians): "
+                  << format_bytes(static_cast<double>(prediction.total())) << std::endl;
+        if (params_.optimization.memory_report) {
+            std::cout << prediction.to_string();
+        }
+
+        size_t free_bytes = 0, total_bytes = 0;
+        if (strategy_->get_model().means().is_cuda() && cudaMemGetInfo(&free_bytes, &total_bytes) == cudaSuccess &&
+            prediction.total() > static_cast<int64_t>(total_bytes)) {
+            const int64_t fits = max_gaussians_for_budget(memory_model_config(0), static_cast<int64_t>(total_bytes));
+            std::cout << "Warning: this exceeds the " << format_bytes(static_cast<double>(total_bytes))
+                      << " of the device, which fits about " << fits << " Gaussians" << std::endl;
+        }
+    }
+
     bool Trainer::train_step(int iter, Camera* cam, torch::Tensor gt_image, RenderMode render_mode) {
         current_iteration_ = iter;
 
@@ -181,6 +394,9 @@ namespace gs {
         }
 
         // If paused, wait
+        if (is_paused_) {
+            strategy_->skip_next_step_time();
+        }
         while (is_paused_ && !stop_requested_) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
             handle_control_requests(iter);
@@ -191,8 +407,15 @@ namespace gs {
             return false;
         }
 
+        Profiler::ScopedTimer step_timer("train_step");
+
         // Use the render mode from parameters
-        auto render_fn = [this, &cam, render_mode]() {
+        raster_workspace_.begin_step();
+        const int tile_size = tile_tuner_ ? tile_tuner_->next_tile_size() : params_.optimization.tile_size;
+        auto render_fn = [this, &cam, render_mode, tile_size]() {
+            // Training renders feed the per-Gaussian contribution stats when enabled
+            auto& stats = strategy_->get_model().contribution_stats();
+            ContributionStats::Scope stats_scope(stats.enabled() ? &stats : nullptr);
             return gs::rasterize(
                 *cam,
                 strategy_->get_model(),
@@ -200,56 +423,101 @@ namespace gs {
                 1.0f,
                 false,
                 false,
-                render_mode);
+                render_mode,
+                &raster_workspace_,
+                tile_size);
         };
 
         RenderOutput r_output;
 
+        Profiler::ScopedTimer render_timer("render");
         if (viewer_) {
             std::lock_guard<std::mutex> lock(viewer_->splat_mtx_);
             r_output = render_fn();
         } else {
             r_output = render_fn();
         }
+        render_timer.stop();
+        strategy_->get_model().contribution_stats().mark_visible(r_output.visibility, iter);
+        last_n_isects_ = r_output.n_isects;
+        last_image_width_ = gt_image.size(-1);
+        last_image_height_ = gt_image.size(-2);
+
+        if (tile_tuner_ && !tile_tuner_->is_tuned()) {
+            tile_tuner_->observe(r_output.tile_size, r_output.isect_offsets, r_output.n_isects);
+            if (tile_tuner_->is_tuned()) {
+                std::cout << "\nTile size auto-tuned to " << tile_tuner_->chosen_tile_size() << ":\n"
+                          << tile_tuner_->summary() << std::flush;
+            }
+        }
 
         // Apply bilateral grid if enabled
         if (bilateral_grid_ && params_.optimization.use_bilateral_grid) {
             r_output.image = bilateral_grid_->apply(r_output.image, cam->uid());
         }
         // Compute loss using the factored-out function
+        Profiler::ScopedTimer loss_timer("loss");
         torch::Tensor loss = compute_loss(r_output,
                                           gt_image,
                                           strategy_->get_model(),
                                           params_.optimization);
 
         current_loss_ = loss.item<float>();
+        if (convergence_) {
+            convergence_->observe_loss(current_loss_);
+        }
+        loss_timer.stop();
 
-        loss.backward();
+        {
+            Profiler::ScopedTimer backward_timer("backward");
+            loss.backward();
+        }
 
         {
             torch::NoGradGuard no_grad;
 
             // Clean evaluation - let the evaluator handle everything
             if (evaluator_->is_enabled() && evaluator_->should_evaluate(iter)) {
+                Profiler::ScopedTimer eval_timer("eval");
+                strategy_->skip_next_step_time();
                 evaluator_->print_evaluation_header(iter);
                 auto metrics = evaluator_->evaluate(iter,
                                                     strategy_->get_model(),
                                                     val_dataset_,
                                                     background_);
                 std::cout << metrics.to_string() << std::endl;
+                std::cout << raster_workspace_.summary() << std::endl;
             }
 
             // Save model at specified steps
             for (size_t save_step : params_.optimization.save_steps) {
                 if (iter == static_cast<int>(save_step) && iter != params_.optimization.iterations) {
+                    Profiler::ScopedTimer save_timer("save");
+                    strategy_->skip_next_step_time();
                     const bool join_threads = (iter == params_.optimization.save_steps.back());
                     strategy_->get_model().save_ply(params_.dataset.output_path, iter, /*join=*/join_threads);
                 }
             }
 
+            // Taken before the strategy clears the gradients; the peak covers the steps since the last refine
+            if (params_.optimization.memory_report && strategy_->is_refining(iter)) {
+                const auto report = memory_report();
+                const int64_t max_cap = params_.optimization.max_cap;
+                std::cout << "\nIteration " << iter << ", " << strategy_->get_model().size() << " Gaussians. "
+                          << report.to_string()
+                          << "  predicted at max_cap (" << max_cap << "): "
+                          << format_bytes(static_cast<double>(predict_memory(max_cap).total())) << std::endl;
+            }
+
             auto do_strategy = [&]() {
-                strategy_->post_backward(iter, r_output);
+                {
+                    Profiler::ScopedTimer post_backward_timer("post_backward");
+                    strategy_->post_backward(iter, r_output);
+                }
+                Profiler::ScopedTimer optimizer_timer("optimizer");
                 strategy_->step(iter);
+                // Refines keep the buffers; a large prune gives them back
+                raster_workspace_.fit(strategy_->get_model().size());
             };
 
             if (viewer_) {
@@ -265,6 +533,25 @@ namespace gs {
             }
         }
 
+        const int compaction_iter = static_cast<int>(params_.optimization.iterations) -
+                                    params_.optimization.compaction_finetune_steps;
+        if (params_.optimization.enable_compaction && iter == compaction_iter) {
+            Profiler::ScopedTimer compaction_timer("compaction");
+            compact_model(iter);
+            strategy_->skip_next_step_time();
+        }
+
+        bool converged = false;
+        if (convergence_ && convergence_->is_check(iter) && iter < params_.optimization.iterations) {
+            Profiler::ScopedTimer convergence_timer("early_stop_check");
+            converged = check_convergence(iter);
+            strategy_->skip_next_step_time();
+            // The final model is still compacted when the scheduled pass was never reached
+            if (converged && params_.optimization.enable_compaction && iter < compaction_iter) {
+                compact_model(iter);
+            }
+        }
+
         progress_->update(iter, loss.item<float>(),
                           static_cast<int>(strategy_->get_model().size()),
                           strategy_->is_refining(iter));
@@ -286,7 +573,7 @@ namespace gs {
         }
 
         // Return true if we should continue training
-        return iter < params_.optimization.iterations && !stop_requested_;
+        return iter < params_.optimization.iterations && !stop_requested_ && !converged;
     }
 
     void Trainer::train() {
@@ -305,14 +592,16 @@ namespace gs {
         int iter = 1;
         const int epochs_needed = (params_.optimization.iterations + train_dataset_size_ - 1) / train_dataset_size_;
 
-        const int num_workers = 4;
-
         const RenderMode render_mode = stringToRenderMode(params_.optimization.render_mode);
 
         bool should_continue = true;
 
+        // Stage timers anywhere below report to profiler_ (no-ops when it is null)
+        Profiler::Scope profile_scope(profiler_.get());
+
         for (int epoch = 0; epoch < epochs_needed && should_continue; ++epoch) {
-            auto train_dataloader = create_dataloader_from_dataset(train_dataset_, num_workers);
+            auto train_dataloader = create_dataloader_from_dataset(train_dataset_, kLoaderWorkers,
+                                                                   params_.optimization.deterministic);
 
             for (auto& batch : *train_dataloader) {
                 auto camera_with_image = batch[0].data;
@@ -320,6 +609,9 @@ namespace gs {
                 torch::Tensor gt_image = std::move(camera_with_image.image);
 
                 should_continue = train_step(iter, cam, gt_image, render_mode);
+                if (profiler_) {
+                    profiler_->collect();
+                }
 
                 if (!should_continue) {
                     break;
@@ -336,7 +628,19 @@ namespace gs {
 
         progress_->complete();
         evaluator_->save_report();
-        progress_->print_final_summary(static_cast<int>(strategy_->get_model().size()));
+        progress_->print_final_summary(static_cast<int>(strategy_->get_model().size()), iter);
+
+        if (profiler_) {
+            std::cout << profiler_->format_summary();
+            if (!params_.optimization.profile_trace.empty()) {
+                try {
+                    profiler_->write_chrome_trace(params_.optimization.profile_trace);
+                    std::cout << "Chrome trace saved to: " << params_.optimization.profile_trace << std::endl;
+                } catch (const std::exception& e) {
+                    std::cerr << "Failed to write the Chrome trace: " << e.what() << std::endl;
+                }
+            }
+        }
 
         is_running_ = false;
         training_complete_ = true;
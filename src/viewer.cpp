@@ -286,14 +286,15 @@ namespace gs {
         {
             std::lock_guard<std::mutex> lock(splat_mtx_);
 
-            output = gs::rasterize(
+            // Forward-only path; frame buffers are reused while the window size is unchanged
+            output = gs::rasterize_inference(
                 cam,
                 trainer_->get_strategy().get_model(),
                 background,
                 config_->scaling_modifier,
-                false,
-                false,
-                RenderMode::RGB);
+                RenderMode::RGB,
+                &frame_output_,
+                &frame_workspace_);
         }
 
 #ifdef CUDA_GL_INTEROP_ENABLED
@@ -0,0 +1,176 @@
+#include "core/benchmark.hpp"
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+
+namespace {
+    // Device clock that the timed function advances by hand
+    class StepDeviceTimer : public gs::DeviceTimer {
+    public:
+        int record() override {
+            times_[next_] = now_ms;
+            return next_++;
+        }
+        bool ready(int) override { return synchronized_; }
+        double elapsed_ms(int from, int to) override { return times_.at(to) - times_.at(from); }
+        void release(int mark) override { times_.erase(mark); }
+        void synchronize() override { synchronized_ = true; }
+
+        double now_ms = 0.0;
+        size_t live_marks() const { return times_.size(); }
+
+    private:
+        int next_ = 0;
+        bool synchronized_ = false;
+        std::map<int, double> times_;
+    };
+} // namespace
+
+TEST(BenchmarkTest, GridDropsUnusedParameters) {
+    const auto grid = gs::bench::make_grid({1000, 2000}, {{640, 480}, {1920, 1080}}, {0, 3});
+    ASSERT_EQ(grid.size(), 8u);
+    EXPECT_EQ(grid[0].num_gaussians, 1000);
+    EXPECT_EQ(grid[1].sh_degree, 3);
+    EXPECT_EQ(grid[2].width, 1920);
+
+    const auto covar = gs::bench::stage_grid(grid, gs::bench::UsesGaussians);
+    ASSERT_EQ(covar.size(), 2u);
+    EXPECT_EQ(covar[1].num_gaussians, 2000);
+    EXPECT_EQ(covar[1].width, -1);
+    EXPECT_EQ(covar[1].sh_degree, -1);
+
+    const auto decode = gs::bench::stage_grid(grid, gs::bench::UsesResolution);
+    ASSERT_EQ(decode.size(), 2u);
+    EXPECT_EQ(decode[0].height, 480);
+
+    EXPECT_EQ(gs::bench::stage_grid(grid, gs::bench::UsesGaussians | gs::bench::UsesShDegree).size(), 4u);
+}
+
+TEST(BenchmarkTest, ParsesLists) {
+    EXPECT_EQ(gs::bench::parse_counts("100000, 1e6"), (std::vector<int64_t>{100000, 1000000}));
+    const auto res = gs::bench::parse_resolutions("1920x1080,640x480");
+    ASSERT_EQ(res.size(), 2u);
+    EXPECT_EQ(res[0], std::make_pair(1920, 1080));
+
+    EXPECT_THROW(gs::bench::parse_counts("1.5e0"), std::invalid_argument);
+    EXPECT_THROW(gs::bench::parse_counts("-4"), std::invalid_argument);
+    EXPECT_THROW(gs::bench::parse_counts(""), std::invalid_argument);
+    EXPECT_THROW(gs::bench::parse_resolutions("1920"), std::invalid_argument);
+    EXPECT_THROW(gs::bench::parse_resolutions("0x10"), std::invalid_argument);
+}
+
+TEST(BenchmarkTest, MeasureUsesDeviceMarks) {
+    StepDeviceTimer timer;
+    int calls = 0;
+    gs::bench::TimingOptions options;
+    options.warmup = 3;
+    options.min_iterations = 4;
+    options.min_time_ms = 0.0;
+    const auto timing = gs::bench::measure([&] {
+        ++calls;
+        timer.now_ms += static_cast<double>(calls); // later calls are slower
+    },
+                                           options, &timer);
+
+    EXPECT_EQ(calls, 7);
+    ASSERT_EQ(timing.iterations, 4);
+    // Timed calls take 4, 5, 6 and 7 ms
+    EXPECT_DOUBLE_EQ(timing.min_ms, 4.0);
+    EXPECT_DOUBLE_EQ(timing.max_ms, 7.0);
+    EXPECT_DOUBLE_EQ(timing.mean_ms, 5.5);
+    EXPECT_DOUBLE_EQ(timing.p50_ms, 5.5);
+    EXPECT_NEAR(timing.stddev_ms, 1.2910, 1e-4);
+    EXPECT_EQ(timer.live_marks(), 0u);
+
+    // The wall clock bounds the run, max_iterations caps it
+    options.min_iterations = 1;
+    options.max_iterations = 50;
+    options.min_time_ms = 1e9;
+    EXPECT_EQ(gs::bench::measure([] {}, options).iterations, 50);
+}
+
+TEST(BenchmarkTest, JsonIsSortedWithFixedKeys) {
+    gs::bench::BenchResult sh;
+    sh.stage = "sh";
+    sh.device = "cuda";
+    sh.config = {100000, -1, -1, 0};
+    sh.timing = gs::bench::summarize({2.0, 1.0, 3.0});
+    sh.counters["bytes"] = 42.0;
+
+    gs::bench::BenchResult decode;
+    decode.stage = "image_decode_png";
+    decode.device = "cpu";
+    decode.config = {-1, 640, 480, -1};
+    decode.skipped = "no encoder";
+
+    auto small = sh;
+    small.config.num_gaussians = 1000;
+
+    const auto json = gs::bench::results_to_json({sh, decode, small}, {{"tag", "test"}});
+    EXPECT_EQ(json.at("schema_version"), 1);
+    EXPECT_EQ(json.at("context").at("tag"), "test");
+    const auto& results = json.at("results");
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].at("id"), "image_decode_png/cpu/640x480");
+    EXPECT_TRUE(results[0].at("num_gaussians").is_null());
+    EXPECT_TRUE(results[0].at("timing").is_null());
+    EXPECT_EQ(results[1].at("id"), "sh/cuda/n=1000/sh=0");
+    EXPECT_EQ(results[2].at("num_gaussians"), 100000);
+    EXPECT_EQ(results[2].at("sh_degree"), 0);
+    EXPECT_EQ(results[2].at("skipped"), "");
+    EXPECT_DOUBLE_EQ(results[2].at("timing").at("p50_ms").get<double>(), 2.0);
+    EXPECT_DOUBLE_EQ(results[2].at("counters").at("bytes").get<double>(), 42.0);
+
+    // Every result carries the same keys
+    for (const auto& r : results) {
+        EXPECT_EQ(r.size(), results[0].size());
+    }
+
+    const auto table = gs::bench::format_results({sh, decode});
+    EXPECT_NE(table.find("skipped: no encoder"), std::string::npos);
+}
+
+TEST(BenchmarkTest, RunnerSkipsWhatCannotRun) {
+    int setups = 0;
+    gs::bench::Stage op;
+    op.name = "op";
+    op.uses = gs::bench::UsesGaussians;
+    op.has_cuda = true;
+    op.setup = [&](const gs::bench::BenchConfig& config, bool cuda, gs::bench::Stage::Counters& counters) {
+        ++setups;
+        EXPECT_FALSE(cuda);
+        counters["n"] = static_cast<double>(config.num_gaussians);
+        return std::function<void()>([] {});
+    };
+    gs::bench::Stage failing;
+    failing.name = "decode";
+    failing.uses = gs::bench::UsesResolution;
+    failing.setup = [](const gs::bench::BenchConfig&, bool, gs::bench::Stage::Counters& counters) {
+        counters["partial"] = 1.0;
+        throw std::runtime_error("no codec");
+        return std::function<void()>();
+    };
+
+    gs::bench::RunOptions options;
+    options.devices = {"cuda", "cpu"};
+    options.cuda_available = false;
+    options.timing.warmup = 0;
+    options.timing.min_iterations = 2;
+    options.timing.min_time_ms = 0.0;
+
+    int seen = 0;
+    const auto grid = gs::bench::make_grid({10, 20}, {{8, 8}}, {3});
+    const auto results = gs::bench::run_stages({op, failing}, grid, options, nullptr,
+                                               [&](const gs::bench::BenchResult&) { ++seen; });
+    // op: 2 counts x 2 devices, decode: one resolution on the CPU only
+    ASSERT_EQ(results.size(), 5u);
+    EXPECT_EQ(seen, 5);
+    EXPECT_EQ(setups, 2);
+    EXPECT_EQ(results[0].skipped, "no CUDA device");
+    EXPECT_TRUE(results[1].skipped.empty());
+    EXPECT_EQ(results[1].timing.iterations, 2);
+    EXPECT_DOUBLE_EQ(results[1].counters.at("n"), 10.0);
+    EXPECT_EQ(results[4].device, "cpu");
+    EXPECT_EQ(results[4].skipped, "no codec");
+    EXPECT_TRUE(results[4].counters.empty());
+}
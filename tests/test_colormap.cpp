@@ -0,0 +1,84 @@
+#include "core/colormap.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using image_io::Colormap;
+
+TEST(ColormapTest, JetMatchesPiecewiseDefinition) {
+    const auto& lut = image_io::colormap_lut(Colormap::Jet);
+    EXPECT_EQ(lut[0][0], 0);
+    EXPECT_EQ(lut[0][1], 0);
+    EXPECT_EQ(lut[0][2], 255);
+    EXPECT_EQ(lut[255][0], 255);
+    EXPECT_EQ(lut[255][1], 0);
+    EXPECT_EQ(lut[255][2], 0);
+    // 128 / 255 is just past 0.5: pure green with a touch of red
+    EXPECT_EQ(lut[128][1], 255);
+    EXPECT_EQ(lut[128][2], 0);
+    EXPECT_LE(lut[128][0], 5);
+}
+
+TEST(ColormapTest, PalettesAreDistinctAndNamed) {
+    for (const auto* name : {"jet", "turbo", "viridis", "inferno", "gray"}) {
+        EXPECT_EQ(image_io::to_string(image_io::colormap_from_string(name)), name);
+    }
+    EXPECT_THROW(image_io::colormap_from_string("rainbow"), std::invalid_argument);
+
+    const auto& gray = image_io::colormap_lut(Colormap::Gray);
+    for (int i = 0; i < 256; ++i) {
+        EXPECT_EQ(gray[i][0], i);
+        EXPECT_EQ(gray[i][2], i);
+    }
+    // Viridis runs from dark purple to yellow
+    const auto& viridis = image_io::colormap_lut(Colormap::Viridis);
+    EXPECT_EQ(viridis[0][0], 68);
+    EXPECT_EQ(viridis[255][1], 231);
+    EXPECT_NE(image_io::colormap_lut(Colormap::Turbo)[100], viridis[100]);
+}
+
+TEST(ColormapTest, WritesIntoStridedBufferAndClamps) {
+    const int H = 2, W = 3;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const std::vector<float> values = {0.0f, 0.5f, 1.0f, -3.0f, 7.0f, nan};
+
+    // Target is the right half of a 2 x 7 RGB canvas with a 1-pixel gap
+    const size_t stride = 7 * 3;
+    std::vector<uint8_t> canvas(H * stride, 42);
+    image_io::apply_colormap(values.data(), H, W, 0.0f, 1.0f, Colormap::Gray, canvas.data() + 4 * 3, stride);
+
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < 4 * 3; ++x) {
+            EXPECT_EQ(canvas[y * stride + x], 42) << "left part was overwritten";
+        }
+    }
+    auto pixel = [&](int y, int x) { return canvas[y * stride + (4 + x) * 3]; };
+    EXPECT_EQ(pixel(0, 0), 0);
+    EXPECT_EQ(pixel(0, 1), 128);
+    EXPECT_EQ(pixel(0, 2), 255);
+    EXPECT_EQ(pixel(1, 0), 0);   // below the range
+    EXPECT_EQ(pixel(1, 1), 255); // above the range
+    EXPECT_EQ(pixel(1, 2), 0);   // NaN
+}
+
+TEST(ColormapTest, FiniteRangeAndFlatImages) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const std::vector<float> values = {2.0f, -inf, 5.0f, std::nanf(""), 3.0f, inf};
+    const auto [lo, hi] = image_io::finite_range(values.data(), values.size());
+    EXPECT_FLOAT_EQ(lo, 2.0f);
+    EXPECT_FLOAT_EQ(hi, 5.0f);
+
+    // Wider than one chunk, constant: everything maps to the first entry
+    const int W = 600;
+    const std::vector<float> flat(W, 4.0f);
+    std::vector<uint8_t> out(W * 3, 0);
+    image_io::apply_colormap(flat.data(), 1, W, 4.0f, 4.0f, Colormap::Jet, out.data(), W * 3);
+    for (int x = 0; x < W; ++x) {
+        EXPECT_EQ(out[x * 3 + 2], 255);
+        EXPECT_EQ(out[x * 3 + 1], 0);
+    }
+    EXPECT_THROW(image_io::apply_colormap(flat.data(), 1, W, 0.0f, 1.0f, Colormap::Jet, out.data(), 10),
+                 std::invalid_argument);
+}
@@ -0,0 +1,78 @@
+#include "core/camera.hpp"
+#include "core/compaction.hpp"
+#include "core/default_strategy.hpp"
+#include "core/rasterizer.hpp"
+#include "core/strategy_utils.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+// Runs on the CPU backend, so no GPU is needed
+class CompactionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto R = torch::eye(3, torch::kFloat32);
+        auto T = torch::tensor({0.0f, 0.0f, 5.0f}, torch::kFloat32);
+        const float fov = M_PI / 3.0f;
+        camera = std::make_unique<Camera>(R, T, fov, fov, "compaction_camera", "", 64, 48, 0);
+        views = {camera.get()};
+    }
+
+    // 0 and 3 visible, 1 transparent, 2 behind the camera
+    static SplatData createSplatData() {
+        torch::NoGradGuard no_grad;
+        auto means = torch::tensor({{0.0f, 0.0f, 0.0f}, {0.1f, 0.0f, 0.0f}, {0.0f, 0.0f, -10.0f}, {0.5f, 0.3f, 0.0f}});
+        auto sh0 = torch::rand({4, 1, 3});
+        auto shN = torch::rand({4, 3, 3});
+        auto scaling = torch::full({4, 3}, std::log(0.2f));
+        auto rotation = torch::tensor({1.0f, 0.0f, 0.0f, 0.0f}).repeat({4, 1});
+        auto opacity = torch::tensor({{2.0f}, {-10.0f}, {2.0f}, {1.0f}});
+        auto to = [](const torch::Tensor& t) { return t.set_requires_grad(true); };
+        return SplatData(1, to(means), to(sh0), to(shN), to(scaling), to(rotation), to(opacity), 1.0f);
+    }
+
+    std::unique_ptr<Camera> camera;
+    std::vector<Camera*> views;
+};
+
+TEST_F(CompactionTest, ScoresAreBlendingWeights) {
+    auto splats = createSplatData();
+    const auto sh0 = splats.sh0();
+    const auto shN = splats.shN();
+
+    const auto scores = gs::contribution_scores(splats, views);
+    ASSERT_EQ(scores.size(0), 4);
+    EXPECT_GT(scores[0].item<float>(), 1.0f);
+    EXPECT_GT(scores[3].item<float>(), 1.0f);
+    EXPECT_EQ(scores[2].item<float>(), 0.0f);
+
+    // The weights of all Gaussians add up to the rendered alpha
+    auto bg = torch::zeros({3});
+    const auto output = gs::rasterize(*camera, splats, bg);
+    EXPECT_NEAR(scores.sum().item<float>(), output.alpha.sum().item<float>(), 1e-2f);
+
+    // The model's colours are restored
+    EXPECT_TRUE(splats.sh0().is_same(sh0));
+    EXPECT_TRUE(splats.shN().is_same(shN));
+}
+
+TEST_F(CompactionTest, RemovesTransparentAndInvisibleGaussians) {
+    DefaultStrategy strategy(createSplatData(), torch::kCPU);
+    gs::param::OptimizationParameters params;
+    params.sh_degree = 1;
+    strategy.initialize(params);
+
+    const auto report = gs::compact(strategy, views, params.min_opacity, 1.0f);
+    EXPECT_EQ(report.gaussians_before, 4);
+    EXPECT_EQ(report.gaussians_after, 2);
+    EXPECT_EQ(strategy.get_model().size(), 2);
+    EXPECT_LT(report.bytes_after, report.bytes_before);
+    EXPECT_NE(report.to_string().find("4 -> 2"), std::string::npos);
+
+    // Parameters were physically shrunk and training can continue on them
+    for (auto* param : gs::strategy::parameters(strategy.get_model())) {
+        EXPECT_EQ(param->size(0), 2);
+        param->mutable_grad() = torch::ones_like(*param);
+    }
+    EXPECT_NO_THROW(strategy.step(1));
+}
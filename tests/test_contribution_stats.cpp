@@ -0,0 +1,163 @@
+#include "core/camera.hpp"
+#include "core/compaction.hpp"
+#include "core/contribution_stats.hpp"
+#include "core/default_strategy.hpp"
+#include "core/rasterizer.hpp"
+#include <cmath>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+// Runs on the CPU backend, so no GPU is needed
+class ContributionStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto R = torch::eye(3, torch::kFloat32);
+        auto T = torch::tensor({0.0f, 0.0f, 5.0f}, torch::kFloat32);
+        const float fov = M_PI / 3.0f;
+        camera = std::make_unique<Camera>(R, T, fov, fov, "stats_camera", "", 64, 48, 0);
+    }
+
+    // 0 and 3 visible, 1 transparent, 2 behind the camera
+    static SplatData createSplatData() {
+        torch::NoGradGuard no_grad;
+        auto means = torch::tensor({{0.0f, 0.0f, 0.0f}, {0.1f, 0.0f, 0.0f}, {0.0f, 0.0f, -10.0f}, {0.5f, 0.3f, 0.0f}});
+        auto sh0 = torch::rand({4, 1, 3});
+        auto shN = torch::rand({4, 3, 3});
+        auto scaling = torch::full({4, 3}, std::log(0.2f));
+        auto rotation = torch::tensor({1.0f, 0.0f, 0.0f, 0.0f}).repeat({4, 1});
+        auto opacity = torch::tensor({{2.0f}, {-10.0f}, {2.0f}, {1.0f}});
+        auto to = [](const torch::Tensor& t) { return t.set_requires_grad(true); };
+        return SplatData(1, to(means), to(sh0), to(shN), to(scaling), to(rotation), to(opacity), 1.0f);
+    }
+
+    gs::RenderOutput render(SplatData& splats) {
+        auto bg = torch::zeros({3});
+        auto& stats = splats.contribution_stats();
+        gs::ContributionStats::Scope scope(stats.enabled() ? &stats : nullptr);
+        return gs::rasterize(*camera, splats, bg);
+    }
+
+    // Independent reference for the forward accumulator: with every SH
+    // coefficient zero each Gaussian has colour 0.5, so the gradient of the
+    // image sum w.r.t. sh0 is C0 times its blending weight summed over pixels
+    torch::Tensor gradient_weights(SplatData& splats) {
+        constexpr float kC0 = 0.28209479177387814f;
+        auto sh0 = splats.sh0();
+        auto shN = splats.shN();
+        auto probe = torch::zeros(sh0.sizes()).requires_grad_(true);
+        splats.sh0() = probe;
+        splats.shN() = torch::zeros(shN.sizes());
+        auto output = gs::rasterize(*camera, splats, torch::zeros({3}));
+        auto grad = torch::autograd::grad({output.image.sum()}, {probe})[0];
+        splats.sh0() = sh0;
+        splats.shN() = shN;
+        return grad.select(1, 0).select(-1, 0) / kC0;
+    }
+
+    std::unique_ptr<Camera> camera;
+};
+
+TEST_F(ContributionStatsTest, ForwardPassAccumulatesWeightsAndHits) {
+    auto splats = createSplatData();
+    const auto expected = gradient_weights(splats);
+    auto& stats = splats.contribution_stats();
+    stats.enable(splats.size(), torch::kCPU);
+
+    const auto output = render(splats);
+    stats.mark_visible(output.visibility, 7);
+
+    // The forward accumulator and the compaction scores both match the sh0 gradient
+    EXPECT_TRUE(torch::allclose(stats.weight_sum(), expected, 1e-3, 1e-3));
+    EXPECT_TRUE(torch::allclose(gs::contribution_scores(splats, {camera.get()}), expected, 1e-3, 1e-3));
+    EXPECT_NEAR(stats.weight_sum().sum().item<float>(), output.alpha.sum().item<float>(), 1e-2f);
+
+    const auto hits = stats.hit_count();
+    EXPECT_GT(hits[0].item<int64_t>(), 0);
+    EXPECT_GT(hits[3].item<int64_t>(), 0);
+    EXPECT_EQ(hits[1].item<int64_t>(), 0);
+    EXPECT_EQ(hits[2].item<int64_t>(), 0);
+    EXPECT_LE(hits.max().item<int64_t>(), 64 * 48);
+
+    EXPECT_EQ(stats.last_visible()[0].item<int>(), 7);
+    EXPECT_EQ(stats.last_visible()[2].item<int>(), -1);
+
+    // A second render adds to the first
+    render(splats);
+    EXPECT_TRUE(torch::allclose(stats.weight_sum(), 2 * expected, 1e-3, 1e-3));
+    EXPECT_TRUE(torch::equal(stats.hit_count(), 2 * hits));
+}
+
+TEST_F(ContributionStatsTest, NothingCollectedOutsideScope) {
+    auto splats = createSplatData();
+    auto& stats = splats.contribution_stats();
+    stats.enable(splats.size(), torch::kCPU);
+
+    auto bg = torch::zeros({3});
+    gs::rasterize(*camera, splats, bg);
+    EXPECT_EQ(stats.weight_sum().sum().item<float>(), 0.0f);
+    EXPECT_EQ(stats.hit_count().sum().item<int64_t>(), 0);
+
+    // Stats for a different number of Gaussians are skipped rather than corrupted
+    gs::ContributionStats other;
+    other.enable(3, torch::kCPU);
+    gs::ContributionStats::Scope scope(&other);
+    EXPECT_NO_THROW(gs::rasterize(*camera, splats, bg));
+    EXPECT_EQ(other.weight_sum().sum().item<float>(), 0.0f);
+}
+
+TEST_F(ContributionStatsTest, RowBookkeeping) {
+    gs::ContributionStats stats;
+    EXPECT_FALSE(stats.enabled());
+    stats.append(2); // no-op while disabled
+    EXPECT_EQ(stats.size(), 0);
+
+    stats.enable(4, torch::kCPU);
+    stats.weight_buffer(4).copy_(torch::tensor({1.0f, 2.0f, 3.0f, 4.0f}));
+    stats.hit_buffer(4).copy_(torch::tensor({10, 20, 30, 40}, torch::kInt64));
+    stats.mark_visible(torch::tensor({true, false, true, true}), 5);
+    EXPECT_FALSE(stats.weight_buffer(3).defined());
+
+    stats.select(torch::tensor({3, 0, 2}, torch::kInt64));
+    stats.append(2);
+    stats.reset(torch::tensor({2}, torch::kInt64));
+
+    EXPECT_TRUE(torch::equal(stats.weight_sum(), torch::tensor({4.0f, 1.0f, 0.0f, 0.0f, 0.0f})));
+    EXPECT_TRUE(torch::equal(stats.hit_count(), torch::tensor({40, 10, 0, 0, 0}, torch::kInt64)));
+    EXPECT_TRUE(torch::equal(stats.last_visible(), torch::tensor({5, 5, -1, -1, -1}, torch::kInt32)));
+}
+
+TEST_F(ContributionStatsTest, SaveAndLoadRoundTrip) {
+    gs::ContributionStats stats;
+    stats.enable(3, torch::kCPU);
+    stats.weight_buffer(3).copy_(torch::tensor({0.5f, 1.5f, 2.5f}));
+    stats.hit_buffer(3).copy_(torch::tensor({1, 2, 3}, torch::kInt64));
+    stats.mark_visible(torch::tensor({false, true, false}), 9);
+
+    const auto path = std::filesystem::temp_directory_path() / "contribution_stats_test.pt";
+    stats.save(path);
+
+    gs::ContributionStats loaded;
+    loaded.load(path, torch::kCPU);
+    std::filesystem::remove(path);
+
+    EXPECT_TRUE(torch::equal(loaded.weight_sum(), stats.weight_sum()));
+    EXPECT_TRUE(torch::equal(loaded.hit_count(), stats.hit_count()));
+    EXPECT_TRUE(torch::equal(loaded.last_visible(), stats.last_visible()));
+    EXPECT_THROW(gs::ContributionStats().save(path), std::runtime_error);
+}
+
+TEST_F(ContributionStatsTest, StrategyKeepsRowsAligned) {
+    DefaultStrategy strategy(createSplatData(), torch::kCPU);
+    gs::param::OptimizationParameters params;
+    params.sh_degree = 1;
+    strategy.initialize(params);
+
+    auto& stats = strategy.get_model().contribution_stats();
+    stats.enable(strategy.get_model().size(), torch::kCPU);
+    stats.weight_buffer(4).copy_(torch::tensor({1.0f, 2.0f, 3.0f, 4.0f}));
+
+    strategy.remove_gaussians(torch::tensor({false, true, false, true}));
+    EXPECT_EQ(stats.size(), strategy.get_model().size());
+    EXPECT_TRUE(torch::equal(stats.weight_sum(), torch::tensor({1.0f, 3.0f})));
+}
@@ -0,0 +1,86 @@
+#include "core/convergence_monitor.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace {
+    gs::ConvergenceMonitor::Config make_config() {
+        gs::ConvergenceMonitor::Config config;
+        config.check_every = 100;
+        config.min_iterations = 0;
+        config.patience = 2;
+        config.min_gain_db = 0.1;
+        return config;
+    }
+} // namespace
+
+TEST(ConvergenceMonitorTest, ChecksOnSchedule) {
+    gs::ConvergenceMonitor monitor(make_config());
+    EXPECT_FALSE(monitor.is_check(0));
+    EXPECT_FALSE(monitor.is_check(50));
+    EXPECT_TRUE(monitor.is_check(100));
+    EXPECT_TRUE(monitor.is_check(300));
+}
+
+TEST(ConvergenceMonitorTest, ConvergesAfterPatienceChecksWithoutGain) {
+    gs::ConvergenceMonitor monitor(make_config());
+    EXPECT_FALSE(monitor.check(100, 20.0));
+    EXPECT_FALSE(monitor.check(200, 22.0));
+    EXPECT_FALSE(monitor.check(300, 22.05)); // below min gain
+    EXPECT_EQ(monitor.stale_checks(), 1);
+    EXPECT_FALSE(monitor.check(400, 22.5)); // real gain resets patience
+    EXPECT_EQ(monitor.stale_checks(), 0);
+    EXPECT_FALSE(monitor.check(500, 22.3)); // regression
+    EXPECT_TRUE(monitor.check(600, 22.55));
+    EXPECT_TRUE(monitor.converged());
+    EXPECT_EQ(monitor.last_gain_iteration(), 400);
+    EXPECT_DOUBLE_EQ(monitor.best_db(), 22.55);
+    EXPECT_NE(monitor.summary().find("converged at 600"), std::string::npos);
+}
+
+TEST(ConvergenceMonitorTest, SlowClimbCountsAsConverged) {
+    // Each check gains less than min_gain_db, even though the total exceeds it
+    gs::ConvergenceMonitor monitor(make_config());
+    monitor.check(100, 25.0);
+    EXPECT_FALSE(monitor.check(200, 25.06));
+    EXPECT_TRUE(monitor.check(300, 25.12));
+}
+
+TEST(ConvergenceMonitorTest, NeverConvergesBeforeMinIterations) {
+    auto config = make_config();
+    config.min_iterations = 500;
+    gs::ConvergenceMonitor monitor(config);
+    monitor.check(100, 30.0);
+    monitor.check(200, 30.0);
+    EXPECT_FALSE(monitor.check(300, 30.0));
+    EXPECT_FALSE(monitor.check(400, 30.0));
+    EXPECT_TRUE(monitor.check(500, 30.0));
+}
+
+TEST(ConvergenceMonitorTest, SmoothedLossIsBiasCorrected) {
+    auto config = make_config();
+    config.loss_smoothing = 0.9;
+    gs::ConvergenceMonitor monitor(config);
+    EXPECT_EQ(monitor.smoothed_loss_db(), 0.0);
+
+    monitor.observe_loss(0.1f);
+    EXPECT_NEAR(monitor.smoothed_loss_db(), 10.0, 1e-5);
+    monitor.observe_loss(std::nanf(""));
+    for (int i = 0; i < 200; ++i) {
+        monitor.observe_loss(0.01f);
+    }
+    EXPECT_NEAR(monitor.smoothed_loss_db(), 20.0, 1e-3);
+
+    // A flat loss converges
+    EXPECT_FALSE(monitor.check_loss(100));
+    EXPECT_FALSE(monitor.check_loss(200));
+    EXPECT_TRUE(monitor.check_loss(300));
+}
+
+TEST(ConvergenceMonitorTest, RejectsInvalidConfig) {
+    auto config = make_config();
+    config.check_every = 0;
+    EXPECT_THROW(gs::ConvergenceMonitor{config}, std::invalid_argument);
+    config = make_config();
+    config.patience = 0;
+    EXPECT_THROW(gs::ConvergenceMonitor{config}, std::invalid_argument);
+}
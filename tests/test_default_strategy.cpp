@@ -0,0 +1,239 @@
+#include "core/default_strategy.hpp"
+#include "core/parameters.hpp"
+#include "core/rasterizer.hpp"
+#include "core/strategy_registry.hpp"
+#include "core/strategy_utils.hpp"
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+namespace {
+    // Four Gaussians: 0 and 1 small, 2 and 3 large (scene scale 1)
+    SplatData make_splats(int sh_degree = 1) {
+        torch::NoGradGuard no_grad;
+        const int N = 4;
+        auto means = torch::randn({N, 3});
+        auto sh0 = torch::randn({N, 1, 3});
+        auto shN = torch::randn({N, (sh_degree + 1) * (sh_degree + 1) - 1, 3});
+        auto scaling = torch::log(torch::tensor({0.001f, 0.001f, 0.5f, 0.5f})).unsqueeze(-1).repeat({1, 3});
+        auto rotation = torch::tensor({1.0f, 0.0f, 0.0f, 0.0f}).repeat({N, 1});
+        auto opacity = torch::zeros({N, 1});
+        return SplatData(sh_degree, means, sh0, shN, scaling, rotation, opacity, 1.0f);
+    }
+
+    gs::param::OptimizationParameters make_params() {
+        gs::param::OptimizationParameters params;
+        params.sh_degree = 1;
+        params.grad_threshold = 0.0002f;
+        params.min_opacity = 0.005f;
+        return params;
+    }
+
+    // Unit gradients on every parameter, then an optimizer step so Adam has state
+    void take_step(DefaultStrategy& strategy, int iter) {
+        for (auto* param : gs::strategy::parameters(strategy.get_model())) {
+            param->mutable_grad() = torch::ones_like(*param);
+        }
+        strategy.step(iter);
+    }
+
+    // Render output whose screen-space gradients are large for the given rows
+    gs::RenderOutput fake_render(int64_t n, const std::vector<int64_t>& high_grad_rows,
+                                 torch::Device device = torch::kCPU) {
+        gs::RenderOutput output;
+        output.means2d = torch::zeros({n, 2}, torch::TensorOptions().device(device).requires_grad(true));
+        auto grad = torch::zeros({n, 2});
+        for (auto row : high_grad_rows) {
+            grad[row].fill_(1.0f);
+        }
+        output.means2d.mutable_grad() = grad.to(device);
+        output.radii = torch::ones({n}, torch::TensorOptions().dtype(torch::kInt32).device(device));
+        output.visibility = output.radii > 0;
+        output.width = 2;
+        output.height = 2;
+        return output;
+    }
+} // namespace
+
+TEST(StrategyRegistryTest, BuiltinsAreRegistered) {
+    const auto names = gs::available_strategies();
+    EXPECT_NE(std::find(names.begin(), names.end(), "mcmc"), names.end());
+    EXPECT_NE(std::find(names.begin(), names.end(), "default"), names.end());
+    EXPECT_FALSE(gs::has_strategy("no-such-strategy"));
+    EXPECT_THROW(gs::create_strategy("no-such-strategy", make_splats()), std::invalid_argument);
+
+    auto strategy = gs::create_strategy("default", make_splats());
+    ASSERT_NE(dynamic_cast<DefaultStrategy*>(strategy.get()), nullptr);
+    EXPECT_EQ(strategy->get_model().size(), 4);
+}
+
+TEST(StrategyRegistryTest, CustomStrategiesCanBeRegistered) {
+    gs::register_strategy("test-default", [](SplatData&& splat_data) -> std::unique_ptr<IStrategy> {
+        return std::make_unique<DefaultStrategy>(std::move(splat_data), torch::kCPU);
+    });
+    EXPECT_TRUE(gs::has_strategy("test-default"));
+    auto strategy = gs::create_strategy("test-default", make_splats());
+    strategy->initialize(make_params());
+    EXPECT_TRUE(strategy->get_model().means().device().is_cpu());
+}
+
+TEST(StrategyUtilsTest, UpdateParamKeepsOptimizerStateInSync) {
+    auto splats = make_splats();
+    gs::strategy::to_device(splats, torch::kCPU);
+    auto optimizer = gs::strategy::create_optimizer(splats, make_params());
+    for (auto* param : gs::strategy::parameters(splats)) {
+        param->mutable_grad() = torch::ones_like(*param);
+    }
+    optimizer->step();
+
+    const auto keep = torch::tensor({0, 2}, torch::kInt64);
+    const auto select = [&keep](int, const torch::Tensor& t) { return t.index_select(0, keep); };
+    gs::strategy::update_param_with_optimizer(splats, *optimizer, select, select);
+
+    const auto all_params = gs::strategy::parameters(splats);
+    for (int i = 0; i < gs::strategy::NumParamGroups; ++i) {
+        const auto& param = optimizer->param_groups()[i].params()[0];
+        EXPECT_TRUE(param.is_same(*all_params[i]));
+        EXPECT_TRUE(param.is_leaf() && param.requires_grad());
+        auto& state = static_cast<torch::optim::AdamParamState&>(*optimizer->state().at(param.unsafeGetTensorImpl()));
+        EXPECT_EQ(state.exp_avg().sizes(), param.sizes());
+        EXPECT_EQ(state.exp_avg_sq().sizes(), param.sizes());
+    }
+    EXPECT_EQ(optimizer->state().size(), static_cast<size_t>(gs::strategy::NumParamGroups));
+}
+
+TEST(StrategyUtilsTest, IncrementShDegreeWidensShN) {
+    torch::NoGradGuard no_grad;
+    const int N = 4;
+    SplatData splats(3, torch::randn({N, 3}), torch::randn({N, 1, 3}), torch::zeros({N, 0, 3}),
+                     torch::zeros({N, 3}), torch::tensor({1.0f, 0.0f, 0.0f, 0.0f}).repeat({N, 1}),
+                     torch::zeros({N, 1}), 1.0f);
+    gs::strategy::to_device(splats, torch::kCPU);
+    auto params = make_params();
+    params.sh_degree = 3;
+    auto optimizer = gs::strategy::create_optimizer(splats, params);
+    for (auto* param : gs::strategy::parameters(splats)) {
+        param->mutable_grad() = torch::ones_like(*param);
+    }
+    optimizer->step();
+
+    // Exported PLYs keep the full max-degree layout while storage is narrow
+    EXPECT_EQ(splats.get_attribute_names().size(), 6u + 3u + 45u + 1u + 3u + 4u);
+
+    const std::vector<int64_t> widths = {3, 8, 15, 15};
+    for (size_t step = 0; step < widths.size(); ++step) {
+        splats.shN().mutable_grad() = torch::ones_like(splats.shN());
+        const auto before = splats.shN().clone();
+        const int64_t previous = before.size(1);
+        gs::strategy::increment_sh_degree(splats, *optimizer);
+        EXPECT_EQ(splats.get_active_sh_degree(), std::min<int>(step + 1, 3));
+
+        // Added coefficients start at zero, trained ones are kept
+        const auto& shN = splats.shN();
+        ASSERT_EQ(shN.sizes().vec(), std::vector<int64_t>({N, widths[step], 3}));
+        EXPECT_TRUE(shN.is_same(optimizer->param_groups()[gs::strategy::ShN].params()[0]));
+        EXPECT_EQ(shN.grad().sizes(), shN.sizes());
+        EXPECT_EQ(shN.narrow(1, previous, widths[step] - previous).abs().sum().item<float>(), 0.0f);
+        EXPECT_TRUE(torch::equal(shN.narrow(1, 0, previous), before));
+        auto& state = static_cast<torch::optim::AdamParamState&>(*optimizer->state().at(shN.unsafeGetTensorImpl()));
+        EXPECT_EQ(state.exp_avg().sizes(), shN.sizes());
+        EXPECT_EQ(state.exp_avg_sq().sizes(), shN.sizes());
+        optimizer->step();
+    }
+}
+
+TEST(DefaultStrategyTest, GrowClonesSmallAndSplitsLargeGaussians) {
+    torch::manual_seed(0);
+    DefaultStrategy strategy(make_splats(), torch::kCPU);
+    strategy.initialize(make_params());
+    take_step(strategy, 1);
+
+    // Gaussian 0 (small) and 2 (large) see large gradients
+    const auto split_scale = strategy.get_model().get_scaling()[2].clone();
+    strategy.update_state(fake_render(4, {0, 2}));
+    const auto [n_dupli, n_split] = strategy.grow_gs();
+    EXPECT_EQ(n_dupli, 1);
+    EXPECT_EQ(n_split, 1);
+
+    // 4 - 1 split + 2 samples + 1 clone
+    auto& model = strategy.get_model();
+    ASSERT_EQ(model.size(), 6);
+    for (auto* param : gs::strategy::parameters(model)) {
+        EXPECT_EQ(param->size(0), 6);
+    }
+
+    // Samples of the split Gaussian are appended last, with scales divided by 1.6
+    const auto scales = model.get_scaling();
+    EXPECT_TRUE(torch::allclose(scales.slice(0, 4), (split_scale / 1.6f).expand({2, 3})));
+
+    // Optimizer state follows the new sizes, so another step succeeds
+    EXPECT_NO_THROW(take_step(strategy, 2));
+}
+
+TEST(DefaultStrategyTest, PruneRemovesTransparentAndOversizedGaussians) {
+    auto params = make_params();
+    params.opacity_reset_every = 10;
+    params.prune_scale3d = 0.1f;
+
+    DefaultStrategy strategy(make_splats(), torch::kCPU);
+    strategy.initialize(params);
+    take_step(strategy, 1);
+
+    {
+        torch::NoGradGuard no_grad;
+        strategy.get_model().opacity_raw()[1].fill_(-10.0f); // sigmoid < min_opacity
+    }
+
+    // Before the first opacity reset only transparent Gaussians go
+    EXPECT_EQ(strategy.prune_gs(5), 1);
+    EXPECT_EQ(strategy.get_model().size(), 3);
+
+    // Afterwards the two large ones (scale 0.5 > 0.1) go as well
+    EXPECT_EQ(strategy.prune_gs(20), 2);
+    EXPECT_EQ(strategy.get_model().size(), 1);
+    EXPECT_NO_THROW(take_step(strategy, 2));
+}
+
+TEST(DefaultStrategyTest, ResetOpacityClampsToTwiceMinOpacity) {
+    DefaultStrategy strategy(make_splats(), torch::kCPU);
+    const auto params = make_params();
+    strategy.initialize(params);
+    take_step(strategy, 1);
+
+    strategy.reset_opacity();
+    const auto opacity = strategy.get_model().get_opacity();
+    EXPECT_LE(opacity.max().item<float>(), 2.0f * params.min_opacity + 1e-6f);
+    EXPECT_NO_THROW(take_step(strategy, 2));
+}
+
+TEST(DefaultStrategyTest, SelectiveAdamStepsAcrossRefinement) {
+    if (!torch::cuda::is_available()) {
+        GTEST_SKIP() << "CUDA not available";
+    }
+    auto params = make_params();
+    params.selective_adam = true;
+    params.start_refine = 0;
+    params.refine_every = 1;
+
+    DefaultStrategy strategy(make_splats(), torch::kCUDA);
+    strategy.initialize(params);
+    // No visibility mask yet: every Gaussian is stepped
+    EXPECT_NO_THROW(take_step(strategy, 1));
+
+    {
+        torch::NoGradGuard no_grad;
+        strategy.get_model().opacity_raw()[1].fill_(-10.0f);
+    }
+
+    // Clone 0, split 2, prune 1: the stored mask has to follow the rows
+    auto render = fake_render(4, {0, 2}, torch::kCUDA);
+    strategy.post_backward(2, render);
+    ASSERT_EQ(strategy.get_model().size(), 5);
+    EXPECT_NO_THROW(take_step(strategy, 2));
+
+    // A prune on its own keeps the mask in sync as well
+    render = fake_render(5, {}, torch::kCUDA);
+    strategy.post_backward(3, render);
+    strategy.remove_gaussians(torch::tensor({true, false, false, false, false}).to(torch::kCUDA));
+    ASSERT_EQ(strategy.get_model().size(), 4);
+    EXPECT_NO_THROW(take_step(strategy, 3));
+}
@@ -0,0 +1,107 @@
+#include "core/growth_controller.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+    // Runs refines_total refines against a synthetic linear resource model and
+    // returns the final count, checking the budget is never exceeded
+    int64_t simulate(gs::GrowthController& controller, int64_t n, int refines_total,
+                     double bytes_base, double bytes_per_gaussian,
+                     double ms_base, double ms_per_gaussian) {
+        const auto& config = controller.config();
+        for (int r = 0; r < refines_total; ++r) {
+            const double bytes = bytes_base + bytes_per_gaussian * n;
+            const double ms = ms_base + ms_per_gaussian * n;
+            if (config.mode == gs::GrowthMode::MemoryBudget) {
+                EXPECT_LE(bytes, config.memory_budget_bytes) << "at refine " << r;
+            }
+            if (config.mode == gs::GrowthMode::StepTimeBudget) {
+                EXPECT_LE(ms, config.step_time_budget_ms) << "at refine " << r;
+            }
+            controller.observe({n, bytes, ms});
+            n += controller.decide(n, refines_total - r).n_new;
+        }
+        return n;
+    }
+} // namespace
+
+TEST(GrowthControllerTest, ParsesModes) {
+    EXPECT_EQ(gs::growth_mode_from_string("fixed"), gs::GrowthMode::Fixed);
+    EXPECT_EQ(gs::growth_mode_from_string("vram"), gs::GrowthMode::MemoryBudget);
+    EXPECT_EQ(gs::growth_mode_from_string("step_time"), gs::GrowthMode::StepTimeBudget);
+    EXPECT_EQ(gs::growth_mode_from_string("count"), gs::GrowthMode::FinalCount);
+    EXPECT_EQ(gs::to_string(gs::GrowthMode::MemoryBudget), "vram");
+    EXPECT_THROW(gs::growth_mode_from_string("fast"), std::invalid_argument);
+
+    gs::GrowthController::Config config;
+    config.mode = gs::GrowthMode::MemoryBudget;
+    EXPECT_THROW(gs::GrowthController{config}, std::invalid_argument);
+}
+
+TEST(GrowthControllerTest, FixedModeMatchesFivePercentUpToCap) {
+    gs::GrowthController::Config config;
+    config.max_cap = 1000;
+    gs::GrowthController controller(config);
+
+    EXPECT_EQ(controller.decide(500, 10).n_new, 25);
+    EXPECT_EQ(controller.decide(990, 10).n_new, 10);
+    EXPECT_EQ(controller.decide(1000, 10).n_new, 0);
+    EXPECT_EQ(controller.decide(1000, 10).reason, "max cap");
+}
+
+TEST(GrowthControllerTest, FinalCountReachesCapAtLastRefine) {
+    gs::GrowthController::Config config;
+    config.mode = gs::GrowthMode::FinalCount;
+    config.max_cap = 1'000'000;
+    gs::GrowthController controller(config);
+
+    const int64_t n = simulate(controller, 10'000, 50, 0, 0, 0, 0);
+    EXPECT_EQ(n, config.max_cap);
+}
+
+TEST(GrowthControllerTest, MemoryBudgetFillsWithoutExceeding) {
+    // 1 GB of fixed cost plus 2 KB per Gaussian under a 4 GB budget: room for ~1.4M
+    gs::GrowthController::Config config;
+    config.mode = gs::GrowthMode::MemoryBudget;
+    config.max_cap = 100'000'000;
+    config.memory_budget_bytes = 4e9;
+    gs::GrowthController controller(config);
+
+    const int64_t n = simulate(controller, 100'000, 200, 1e9, 2048, 0, 0);
+    const double fit_limit = (config.safety * 4e9 - 1e9) / 2048;
+    EXPECT_LE(n, static_cast<int64_t>(fit_limit) + 1);
+    EXPECT_GT(n, static_cast<int64_t>(0.99 * fit_limit));
+    EXPECT_NEAR(controller.bytes_per_gaussian(), 2048, 1.0);
+    EXPECT_EQ(controller.decide(n, 1).reason, "memory budget");
+}
+
+TEST(GrowthControllerTest, StepTimeBudgetFillsWithoutExceeding) {
+    // 10 ms of fixed cost plus 20 ms per million Gaussians under a 30 ms budget
+    gs::GrowthController::Config config;
+    config.mode = gs::GrowthMode::StepTimeBudget;
+    config.max_cap = 100'000'000;
+    config.step_time_budget_ms = 30.0;
+    gs::GrowthController controller(config);
+
+    const int64_t n = simulate(controller, 50'000, 200, 0, 0, 10.0, 2e-5);
+    const double fit_limit = (config.safety * 30.0 - 10.0) / 2e-5;
+    EXPECT_LE(n, static_cast<int64_t>(fit_limit) + 1);
+    EXPECT_GT(n, static_cast<int64_t>(0.99 * fit_limit));
+}
+
+TEST(GrowthControllerTest, BudgetModesGrowAtMostMaxRate) {
+    gs::GrowthController::Config config;
+    config.mode = gs::GrowthMode::MemoryBudget;
+    config.memory_budget_bytes = 1e12;
+    config.max_cap = 100'000'000;
+    gs::GrowthController controller(config);
+
+    // Before any measurement the base rate applies
+    EXPECT_EQ(controller.decide(1000, 10).n_new, 50);
+    EXPECT_EQ(controller.decide(1000, 10).reason, "warm-up");
+
+    controller.observe({1000, 1e6, 0});
+    const auto decision = controller.decide(1000, 10);
+    EXPECT_EQ(decision.n_new, 50);
+    EXPECT_EQ(decision.reason, "max rate");
+    EXPECT_GT(decision.limit, 1000);
+}
@@ -62,6 +62,78 @@ TEST_F(GsplatOpsTest, RelocationTest) {
     EXPECT_TRUE((new_scales > 0).all().item<bool>());
 }
 
+// relocate_rows_ against the per-parameter index_select / index_put_ sequence
+// MCMC::relocate_gs used before. Runs on CPU, and on CUDA when available.
+TEST(GsplatRelocateRowsTest, MatchesPerParameterIndexPut) {
+    std::vector<torch::Device> devices{torch::kCPU};
+    if (torch::cuda::is_available()) {
+        devices.emplace_back(torch::kCUDA);
+    }
+
+    for (const auto& device : devices) {
+        torch::manual_seed(7);
+        const int64_t N = 1000;
+        const auto opts = torch::TensorOptions().dtype(torch::kFloat32).device(device);
+        std::vector<torch::Tensor> params = {
+            torch::randn({N, 3}, opts),     // means
+            torch::randn({N, 1, 3}, opts),  // sh0
+            torch::randn({N, 15, 3}, opts), // shN
+            torch::randn({N, 3}, opts),     // scaling
+            torch::randn({N, 4}, opts),     // rotation
+            torch::randn({N, 1}, opts)};    // opacity
+        std::vector<torch::Tensor> moments;
+        for (const auto& p : params) {
+            moments.push_back(torch::randn_like(p));
+            moments.push_back(torch::rand_like(p));
+        }
+
+        // Dead rows are the odd ones, sources are drawn (with repeats) from the even ones
+        const auto idx_opts = torch::TensorOptions().dtype(torch::kInt64).device(device);
+        const auto dead = torch::arange(1, N, 2, idx_opts);
+        const auto sampled = torch::randint(0, N / 2, {dead.numel()}, idx_opts) * 2;
+
+        std::vector<torch::Tensor> expected_params, expected_moments;
+        for (const auto& p : params) {
+            auto e = p.clone();
+            e.index_put_({dead}, e.index_select(0, sampled));
+            expected_params.push_back(e);
+        }
+        for (const auto& m : moments) {
+            auto e = m.clone();
+            e.index_put_({sampled}, 0);
+            expected_moments.push_back(e);
+        }
+
+        gsplat::relocate_rows_(params, moments, sampled, dead, sampled);
+
+        for (size_t i = 0; i < params.size(); ++i) {
+            EXPECT_TRUE(torch::equal(params[i], expected_params[i])) << "param " << i << " on " << device;
+        }
+        for (size_t i = 0; i < moments.size(); ++i) {
+            EXPECT_TRUE(torch::equal(moments[i], expected_moments[i])) << "moment " << i << " on " << device;
+        }
+    }
+}
+
+// At SH degree 0 shN is [N, 0, 3]; its rows are empty and must be skipped
+TEST(GsplatRelocateRowsTest, SkipsEmptyRows) {
+    auto means = torch::arange(12, torch::kFloat32).reshape({4, 3});
+    auto shN = torch::empty({4, 0, 3});
+    auto moment = torch::ones({4, 0, 3});
+    const auto src = torch::tensor({0}, torch::kInt64);
+    const auto dst = torch::tensor({2}, torch::kInt64);
+    gsplat::relocate_rows_({means, shN}, {moment}, src, dst, src);
+    EXPECT_TRUE(torch::equal(means[2], means[0]));
+}
+
+TEST(GsplatRelocateRowsTest, RejectsMismatchedInputs) {
+    auto params = std::vector<torch::Tensor>{torch::zeros({4, 3}), torch::zeros({5, 3})};
+    auto ids = torch::tensor({0}, torch::kInt64);
+    EXPECT_THROW(gsplat::relocate_rows_(params, {}, ids, ids + 1, ids), c10::Error);
+    EXPECT_THROW(gsplat::relocate_rows_({torch::zeros({4, 3})}, {}, ids.to(torch::kInt32), ids, ids), c10::Error);
+    EXPECT_THROW(gsplat::relocate_rows_({torch::zeros({4, 3}, torch::kFloat64)}, {}, ids, ids + 1, ids), c10::Error);
+}
+
 TEST_F(GsplatOpsTest, QuatScaleToCovarPreciGradientTest) {
     torch::manual_seed(42);
 
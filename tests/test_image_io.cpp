@@ -0,0 +1,99 @@
+#include "core/image_io.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+namespace {
+    std::filesystem::path make_temp_dir(const std::string& name) {
+        auto dir = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+} // namespace
+
+TEST(ImageIOTest, ToRGB8ConvertsLayoutAndRange) {
+    auto image = torch::zeros({3, 4, 5});
+    image[0].fill_(0.5f);
+    image[1].fill_(2.0f);  // clamped to 255
+    image[2].fill_(-1.0f); // clamped to 0
+
+    const auto rgb8 = image_io::to_rgb8(image.unsqueeze(0));
+    ASSERT_EQ(rgb8.sizes(), torch::IntArrayRef({4, 5, 3}));
+    EXPECT_EQ(rgb8.scalar_type(), torch::kUInt8);
+    EXPECT_TRUE(rgb8.is_contiguous());
+    EXPECT_EQ(rgb8[2][3][0].item<uint8_t>(), 127);
+    EXPECT_EQ(rgb8[2][3][1].item<uint8_t>(), 255);
+    EXPECT_EQ(rgb8[2][3][2].item<uint8_t>(), 0);
+
+    // Contiguous uint8 buffers pass through without a copy
+    const auto again = image_io::to_rgb8(rgb8);
+    EXPECT_EQ(again.data_ptr(), rgb8.data_ptr());
+}
+
+TEST(ImageIOTest, ComposeAddsWhiteSeparators) {
+    const auto a = torch::zeros({3, 6, 4});
+    const auto b = torch::zeros({3, 6, 5});
+    const auto composed = image_io::compose_rgb8({a, b}, true, 2);
+    ASSERT_EQ(composed.sizes(), torch::IntArrayRef({6, 11, 3}));
+    EXPECT_EQ(composed.narrow(1, 0, 4).max().item<uint8_t>(), 0);
+    EXPECT_EQ(composed.narrow(1, 4, 2).min().item<uint8_t>(), 255);
+    EXPECT_EQ(composed.narrow(1, 6, 5).max().item<uint8_t>(), 0);
+
+    // Stacking vertically needs equal widths
+    EXPECT_THROW(image_io::compose_rgb8({a, b}, false, 2), c10::Error);
+    EXPECT_EQ(image_io::compose_rgb8({a, a}, false, 0).sizes(), torch::IntArrayRef({12, 4, 3}));
+}
+
+TEST(ImageIOTest, RawFormatWritesNetpbm) {
+    const auto dir = make_temp_dir("gs_image_io_raw");
+    const auto rgb8 = torch::arange(2 * 3 * 3, torch::kInt32).to(torch::kUInt8).view({2, 3, 3});
+
+    const auto written = image_io::write_rgb8(dir / "frame.png", rgb8, image_io::ImageFormat::Raw);
+    EXPECT_EQ(written, dir / "frame.ppm");
+
+    std::ifstream file(written, std::ios::binary);
+    std::string magic;
+    int width = 0, height = 0, maxval = 0;
+    file >> magic >> width >> height >> maxval;
+    file.get();
+    EXPECT_EQ(magic, "P6");
+    EXPECT_EQ(width, 3);
+    EXPECT_EQ(height, 2);
+    EXPECT_EQ(maxval, 255);
+    std::vector<char> pixels(18);
+    file.read(pixels.data(), pixels.size());
+    ASSERT_TRUE(file);
+    EXPECT_EQ(static_cast<uint8_t>(pixels[17]), 17);
+
+    EXPECT_EQ(image_io::image_format_from_string("jpeg"), image_io::ImageFormat::JPEG);
+    EXPECT_THROW(image_io::image_format_from_string("tiff"), std::invalid_argument);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ImageIOTest, BoundedQueueSavesEveryImage) {
+    const auto dir = make_temp_dir("gs_image_io_queue");
+    auto& saver = image_io::BatchImageSaver::instance();
+    const auto previous = saver.config();
+
+    image_io::ImageWriterConfig config;
+    config.num_workers = 2;
+    config.max_queue = 1; // producers block on almost every image
+    config.format = image_io::ImageFormat::PNG;
+    config.png_compression_level = 1;
+    saver.configure(config);
+
+    const auto image = torch::rand({3, 16, 16});
+    for (int i = 0; i < 12; ++i) {
+        image_io::save_images_async(dir / (std::to_string(i) + ".jpg"), {image, image}, true, 4);
+    }
+    image_io::wait_for_pending_saves();
+    EXPECT_EQ(saver.pending_count(), 0u);
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_TRUE(std::filesystem::exists(dir / (std::to_string(i) + ".png"))) << i;
+    }
+
+    saver.configure(previous);
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,166 @@
+#include "core/lr_scheduler.hpp"
+#include "core/parameters.hpp"
+#include "core/strategy_utils.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <torch/torch.h>
+
+namespace {
+    // Two Adam groups with learning rates 1 and 0.5
+    std::unique_ptr<torch::optim::Adam> make_optimizer(std::vector<torch::Tensor>& params) {
+        using torch::optim::AdamOptions;
+        params = {torch::zeros({2}, torch::requires_grad()), torch::zeros({3}, torch::requires_grad())};
+        std::vector<torch::optim::OptimizerParamGroup> groups;
+        groups.emplace_back(std::vector<torch::Tensor>{params[0]}, std::make_unique<AdamOptions>(1.0));
+        groups.emplace_back(std::vector<torch::Tensor>{params[1]}, std::make_unique<AdamOptions>(0.5));
+        return std::make_unique<torch::optim::Adam>(std::move(groups), AdamOptions(0.0));
+    }
+
+    double lr(torch::optim::Optimizer& optimizer, int group) {
+        return static_cast<torch::optim::AdamOptions&>(optimizer.param_groups()[group].options()).lr();
+    }
+} // namespace
+
+TEST(LRScheduleTest, ClosedFormValues) {
+    const int T = 100;
+    gs::LRScheduleConfig config;
+    EXPECT_DOUBLE_EQ(gs::lr_factor(config, 37, T), 1.0);
+
+    config.type = gs::LRSchedule::Exponential;
+    config.final_factor = 0.01;
+    EXPECT_DOUBLE_EQ(gs::lr_factor(config, 0, T), 1.0);
+    EXPECT_NEAR(gs::lr_factor(config, 50, T), 0.1, 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, T, T), 0.01, 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, 2 * T, T), 0.01, 1e-12); // clamped past the end
+
+    config.type = gs::LRSchedule::Cosine;
+    EXPECT_DOUBLE_EQ(gs::lr_factor(config, 0, T), 1.0);
+    EXPECT_NEAR(gs::lr_factor(config, 50, T), 0.505, 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, 25, T), 0.01 + 0.99 * 0.5 * (1.0 + std::cos(M_PI / 4)), 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, T, T), 0.01, 1e-12);
+
+    config.type = gs::LRSchedule::Step;
+    config.step_size = 50;
+    EXPECT_DOUBLE_EQ(gs::lr_factor(config, 49, T), 1.0);
+    EXPECT_NEAR(gs::lr_factor(config, 50, T), 0.1, 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, 99, T), 0.1, 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, T, T), 0.01, 1e-12);
+}
+
+TEST(LRScheduleTest, WarmupMultipliesSchedule) {
+    gs::LRScheduleConfig config;
+    config.type = gs::LRSchedule::Exponential;
+    config.final_factor = 0.01;
+    config.warmup_steps = 10;
+    config.warmup_start = 0.2;
+    EXPECT_NEAR(gs::lr_factor(config, 0, 100), 0.2, 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, 5, 100), 0.6 * std::pow(0.01, 0.05), 1e-12);
+    EXPECT_NEAR(gs::lr_factor(config, 10, 100), std::pow(0.01, 0.1), 1e-12);
+}
+
+TEST(LRScheduleTest, NamesRoundTrip) {
+    for (auto schedule : {gs::LRSchedule::Constant, gs::LRSchedule::Exponential, gs::LRSchedule::Cosine, gs::LRSchedule::Step}) {
+        EXPECT_EQ(gs::lr_schedule_from_string(gs::to_string(schedule)), schedule);
+    }
+    EXPECT_THROW(gs::lr_schedule_from_string("linear"), std::invalid_argument);
+}
+
+TEST(LRSchedulerTest, AppliesTablePerGroup) {
+    std::vector<torch::Tensor> params;
+    auto optimizer = make_optimizer(params);
+    gs::LRScheduler scheduler(*optimizer, 10);
+
+    gs::LRScheduleConfig config;
+    config.type = gs::LRSchedule::Cosine;
+    config.final_factor = 0.0;
+    scheduler.set_schedule(0, config);
+
+    for (int t = 1; t <= 12; ++t) {
+        scheduler.step();
+        const int clamped = std::min(t, 10);
+        EXPECT_NEAR(lr(*optimizer, 0), 0.5 * (1.0 + std::cos(M_PI * clamped / 10.0)), 1e-12);
+        EXPECT_DOUBLE_EQ(lr(*optimizer, 1), 0.5); // unscheduled groups keep their rate
+    }
+    EXPECT_EQ(scheduler.current_step(), 12);
+    EXPECT_THROW(scheduler.set_schedule(2, config), std::out_of_range);
+}
+
+TEST(LRSchedulerTest, MatchesPerStepExponentialDecay) {
+    std::vector<torch::Tensor> params;
+    auto optimizer = make_optimizer(params);
+    gs::param::OptimizationParameters opt;
+    opt.iterations = 1000;
+
+    // Scheduled like the means group in create_scheduler
+    gs::LRScheduler scheduler(*optimizer, static_cast<int>(opt.iterations));
+    gs::LRScheduleConfig config;
+    config.type = gs::lr_schedule_from_string(opt.lr_schedule);
+    config.final_factor = opt.lr_final_factor;
+    scheduler.set_schedule(0, config);
+
+    // Same rates as multiplying by gamma = 0.01^(1/iterations) after every step
+    const double gamma = std::pow(0.01, 1.0 / opt.iterations);
+    double expected = 1.0;
+    for (int t = 0; t < 1000; ++t) {
+        scheduler.step();
+        expected *= gamma;
+    }
+    EXPECT_NEAR(lr(*optimizer, 0), expected, 1e-9);
+    EXPECT_NEAR(lr(*optimizer, 0), 0.01, 1e-9);
+}
+
+TEST(LRSchedulerTest, SaveAndLoadRestoresRates) {
+    std::vector<torch::Tensor> params;
+    auto optimizer = make_optimizer(params);
+    gs::LRScheduler scheduler(*optimizer, 100);
+    gs::LRScheduleConfig config;
+    config.type = gs::LRSchedule::Step;
+    config.final_factor = 0.25;
+    config.step_size = 50;
+    config.warmup_steps = 20;
+    scheduler.set_schedule(0, config);
+    scheduler.set_schedule(1, config);
+    for (int t = 0; t < 60; ++t) {
+        scheduler.step();
+    }
+
+    std::stringstream stream;
+    torch::serialize::OutputArchive out;
+    scheduler.save(out);
+    out.save_to(stream);
+
+    // A fresh optimizer at its initial rates picks up where the saved one was
+    std::vector<torch::Tensor> restored_params;
+    auto restored_optimizer = make_optimizer(restored_params);
+    gs::LRScheduler restored(*restored_optimizer, 1);
+    torch::serialize::InputArchive in;
+    in.load_from(stream);
+    restored.load(in);
+
+    EXPECT_EQ(restored.current_step(), 60);
+    EXPECT_EQ(restored.total_steps(), 100);
+    EXPECT_NEAR(lr(*restored_optimizer, 0), 0.5, 1e-12);
+    EXPECT_NEAR(lr(*restored_optimizer, 1), 0.25, 1e-12);
+    restored.step();
+    scheduler.step();
+    EXPECT_DOUBLE_EQ(lr(*restored_optimizer, 0), lr(*optimizer, 0));
+}
+
+TEST(LRSchedulerTest, StrategySchedulesOnlyMeansWithoutWarmup) {
+    const int N = 2;
+    SplatData splats(0, torch::zeros({N, 3}), torch::zeros({N, 1, 3}), torch::zeros({N, 0, 3}), torch::zeros({N, 3}),
+                     torch::tensor({1.0f, 0.0f, 0.0f, 0.0f}).repeat({N, 1}), torch::zeros({N, 1}), 1.0f);
+    gs::strategy::to_device(splats, torch::kCPU);
+    gs::param::OptimizationParameters opt;
+    opt.iterations = 100;
+    opt.lr_schedule = "cosine";
+    auto optimizer = gs::strategy::create_optimizer(splats, opt);
+    auto scheduler = gs::strategy::create_scheduler(*optimizer, opt);
+
+    for (int t = 0; t < 50; ++t) {
+        scheduler->step();
+    }
+    EXPECT_NEAR(gs::strategy::learning_rate(*optimizer, gs::strategy::Means), opt.means_lr * 0.505, 1e-9);
+    EXPECT_NEAR(gs::strategy::learning_rate(*optimizer, gs::strategy::Opacity), opt.opacity_lr, 1e-9);
+}
@@ -0,0 +1,92 @@
+#include "core/memory_report.hpp"
+#include <gtest/gtest.h>
+
+namespace cat = gs::memory_category;
+
+TEST(MemoryReportTest, EntriesAccumulateByCategory) {
+    gs::MemoryReport report;
+    report.add(cat::Parameters, "means", 100);
+    report.add(cat::Parameters, "sh0", 50);
+    report.add(cat::AdamMoments, "means", 200);
+    report.add(cat::Parameters, "means", 20);
+
+    ASSERT_EQ(report.entries().size(), 3u);
+    EXPECT_EQ(report.entries()[0].bytes, 120);
+    EXPECT_EQ(report.category_bytes(cat::Parameters), 170);
+    EXPECT_EQ(report.category_bytes(cat::Rasterizer), 0);
+    EXPECT_EQ(report.total(), 370);
+
+    report.allocated_bytes = 2048;
+    const auto text = report.to_string();
+    EXPECT_NE(text.find("370 B accounted, 2.00 KiB allocated"), std::string::npos);
+    EXPECT_LT(text.find("parameters"), text.find("adam moments"));
+    EXPECT_EQ(text.find("peak"), std::string::npos);
+
+    EXPECT_EQ(gs::format_bytes(1023), "1023 B");
+    EXPECT_EQ(gs::format_bytes(1536), "1.50 KiB");
+    EXPECT_EQ(gs::format_bytes(3.0 * 1024 * 1024 * 1024), "3.00 GiB");
+}
+
+TEST(MemoryReportTest, ModelStateIsExactForFloat32) {
+    gs::MemoryModelConfig config;
+    config.num_gaussians = 1000;
+    config.sh_degree = 3;
+    const auto report = gs::predict_memory(config);
+
+    // 3 + 3 + 45 + 3 + 4 + 1 floats per Gaussian
+    EXPECT_EQ(report.category_bytes(cat::Parameters), 1000 * 59 * 4);
+    EXPECT_EQ(report.category_bytes(cat::Gradients), 1000 * 59 * 4);
+    EXPECT_EQ(report.category_bytes(cat::AdamMoments), 2 * 1000 * 59 * 4);
+    EXPECT_EQ(report.category_bytes(cat::BilateralGrid), 0);
+
+    // No image: nothing per pixel
+    EXPECT_EQ(report.category_bytes(cat::DatasetImages), 0);
+
+    config.sh_degree = 0;
+    EXPECT_EQ(gs::predict_memory(config).category_bytes(cat::Parameters), 1000 * 14 * 4);
+}
+
+TEST(MemoryReportTest, OptionalStateAndImages) {
+    gs::MemoryModelConfig config;
+    config.num_gaussians = 10;
+    config.image_width = 100;
+    config.image_height = 50;
+    config.prefetched_images = 2;
+    const auto base = gs::predict_memory(config);
+    EXPECT_EQ(base.category_bytes(cat::DatasetImages), 2 * 100 * 50 * 3 * 4);
+    EXPECT_EQ(base.category_bytes(cat::StrategyState), 10 * 4);
+
+    config.default_strategy = true;
+    config.contribution_stats = true;
+    config.bilateral_grid = true;
+    config.num_images = 3;
+    const auto full = gs::predict_memory(config);
+    EXPECT_EQ(full.category_bytes(cat::StrategyState), 10 * (4 + 4 + 4 + 16));
+    EXPECT_EQ(full.category_bytes(cat::BilateralGrid), 4 * 3 * 12 * 8 * 16 * 16 * 4);
+    // The grid output is an extra image in the step
+    EXPECT_GT(full.category_bytes(cat::Activations), base.category_bytes(cat::Activations));
+
+    // More intersections per Gaussian only grow the rasterizer buffers
+    config.isects_per_gaussian *= 2;
+    const auto denser = gs::predict_memory(config);
+    EXPECT_GT(denser.category_bytes(cat::Rasterizer), full.category_bytes(cat::Rasterizer));
+    EXPECT_EQ(denser.total() - denser.category_bytes(cat::Rasterizer),
+              full.total() - full.category_bytes(cat::Rasterizer));
+}
+
+TEST(MemoryReportTest, BudgetInvertsThePrediction) {
+    gs::MemoryModelConfig config;
+    config.image_width = 1920;
+    config.image_height = 1080;
+    const int64_t budget = int64_t{8} << 30;
+
+    const int64_t n = gs::max_gaussians_for_budget(config, budget);
+    ASSERT_GT(n, 0);
+    config.num_gaussians = n;
+    EXPECT_LE(gs::predict_memory(config).total(), budget);
+    config.num_gaussians = n + 1;
+    EXPECT_GT(gs::predict_memory(config).total(), budget);
+
+    // Not even the images fit
+    EXPECT_EQ(gs::max_gaussians_for_budget(config, 1024), 0);
+}
@@ -0,0 +1,78 @@
+#include "core/metrics.hpp"
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+namespace {
+    // Two images of the batch with different error levels
+    std::pair<torch::Tensor, torch::Tensor> make_batch() {
+        torch::manual_seed(0);
+        auto target = torch::rand({2, 3, 32, 24});
+        auto noise = torch::randn_like(target) * torch::tensor({0.02f, 0.1f}).view({2, 1, 1, 1});
+        return {torch::clamp(target + noise, 0.0, 1.0), target};
+    }
+} // namespace
+
+TEST(MetricsTest, PSNRPerImageMatchesSingleImages) {
+    const auto [pred, target] = make_batch();
+    const gs::metrics::PSNR psnr;
+    const auto per_image = psnr.compute_per_image(pred, target);
+    ASSERT_EQ(per_image.sizes(), torch::IntArrayRef({2}));
+    for (int64_t i = 0; i < 2; ++i) {
+        EXPECT_NEAR(per_image[i].item<float>(), psnr.compute(pred.narrow(0, i, 1), target.narrow(0, i, 1)), 1e-4);
+    }
+    EXPECT_GT(per_image[0].item<float>(), per_image[1].item<float>());
+    EXPECT_NEAR(psnr.compute(pred, target), per_image.mean().item<float>(), 1e-4);
+}
+
+TEST(MetricsTest, SSIMPerImageMatchesSingleImages) {
+    const auto [pred, target] = make_batch();
+    gs::metrics::SSIM ssim(11, 3);
+    const auto per_image = ssim.compute_per_image(pred, target);
+    ASSERT_EQ(per_image.sizes(), torch::IntArrayRef({2}));
+    for (int64_t i = 0; i < 2; ++i) {
+        EXPECT_NEAR(per_image[i].item<float>(), ssim.compute(pred.narrow(0, i, 1), target.narrow(0, i, 1)), 1e-5);
+    }
+    EXPECT_NEAR(ssim.compute(target, target), 1.0f, 1e-5);
+}
+
+TEST(MetricsTest, SSIMMatchesConv2dReference) {
+    const auto [pred, target] = make_batch();
+    namespace F = torch::nn::functional;
+    const auto window = gs::metrics::create_window(11, 3);
+    auto filter = [&](const torch::Tensor& x) {
+        return F::conv2d(x, window, F::Conv2dFuncOptions().padding(5).groups(3));
+    };
+    const auto mu1 = filter(pred), mu2 = filter(target);
+    const auto sigma1_sq = filter(pred * pred) - mu1 * mu1;
+    const auto sigma2_sq = filter(target * target) - mu2 * mu2;
+    const auto sigma12 = filter(pred * target) - mu1 * mu2;
+    const float C1 = 0.01f * 0.01f, C2 = 0.03f * 0.03f;
+    const auto reference = ((2.f * mu1 * mu2 + C1) * (2.f * sigma12 + C2)) /
+                           ((mu1 * mu1 + mu2 * mu2 + C1) * (sigma1_sq + sigma2_sq + C2));
+
+    gs::metrics::SSIM ssim(11, 3);
+    EXPECT_NEAR(ssim.compute(pred, target), reference.mean().item<float>(), 1e-5);
+    EXPECT_TRUE(torch::allclose(ssim.compute_per_image(pred, target), reference.mean({1, 2, 3}), 1e-5, 1e-5));
+}
+
+TEST(MetricsTest, GaussianWindowIsCentered) {
+    const auto window = gs::metrics::gaussian(11, 1.5f);
+    EXPECT_NEAR(window.sum().item<float>(), 1.0f, 1e-6);
+    EXPECT_EQ(window.argmax().item<int64_t>(), 5);
+    EXPECT_TRUE(torch::allclose(window, window.flip(0)));
+}
+
+TEST(MetricsTest, LPIPSPrecisionNames) {
+    using gs::metrics::LPIPSPrecision;
+    for (auto precision : {LPIPSPrecision::Float32, LPIPSPrecision::Float16, LPIPSPrecision::BFloat16}) {
+        EXPECT_EQ(gs::metrics::lpips_precision_from_string(gs::metrics::to_string(precision)), precision);
+    }
+    EXPECT_THROW(gs::metrics::lpips_precision_from_string("int8"), std::invalid_argument);
+}
+
+TEST(MetricsTest, LPIPSRejectsUnusableConfigurations) {
+    EXPECT_THROW(gs::metrics::LPIPS("missing/lpips_vgg.pt", gs::metrics::LPIPSPrecision::Float32, torch::Device(torch::kCPU)),
+                 std::runtime_error);
+    // fp16 convolutions are only supported on CUDA
+    EXPECT_THROW(gs::metrics::LPIPS("", gs::metrics::LPIPSPrecision::Float16, torch::Device(torch::kCPU)), c10::Error);
+}
@@ -0,0 +1,107 @@
+#include "core/metrics_diff.hpp"
+#include <cmath>
+#include <filesystem>
+#include <gtest/gtest.h>
+
+namespace {
+    std::vector<gs::metrics::ViewRecord> make_run(int views, double psnr_offset, double time_scale) {
+        std::vector<gs::metrics::ViewRecord> run;
+        for (int i = 0; i < views; ++i) {
+            gs::metrics::ViewRecord record;
+            record.iteration = 30000;
+            record.image = "view_" + std::to_string(i) + ".jpg";
+            // Views differ a lot from each other, the runs differ only by the offset
+            record.psnr = 24.0 + (i % 7) + psnr_offset + 0.01 * ((i * 37) % 5 - 2);
+            record.ssim = 0.8 + 0.01 * (i % 5);
+            record.lpips = std::nan("");
+            record.render_ms = (5.0 + i % 3) * time_scale;
+            run.push_back(record);
+        }
+        return run;
+    }
+
+    const gs::metrics::MetricDiff* find(const gs::metrics::DiffReport& report, const std::string& metric) {
+        for (const auto& m : report.metrics) {
+            if (m.metric == metric)
+                return &m;
+        }
+        return nullptr;
+    }
+} // namespace
+
+TEST(MetricsDiffTest, WilcoxonPValues) {
+    // All positive: strong evidence of degradation
+    std::vector<double> worse(20, 0.0);
+    for (int i = 0; i < 20; ++i)
+        worse[i] = 0.1 + 0.01 * i;
+    EXPECT_LT(gs::metrics::wilcoxon_signed_rank_p(worse), 1e-4);
+
+    // All negative: none at all
+    for (auto& v : worse)
+        v = -v;
+    EXPECT_GT(gs::metrics::wilcoxon_signed_rank_p(worse), 0.999);
+
+    // Symmetric around zero: undecided
+    std::vector<double> symmetric;
+    for (int i = 1; i <= 10; ++i) {
+        symmetric.push_back(i);
+        symmetric.push_back(-i);
+    }
+    EXPECT_NEAR(gs::metrics::wilcoxon_signed_rank_p(symmetric), 0.5, 0.05);
+    EXPECT_DOUBLE_EQ(gs::metrics::wilcoxon_signed_rank_p({0.0, 0.0}), 1.0);
+}
+
+TEST(MetricsDiffTest, FlagsConsistentPsnrDrop) {
+    const auto baseline = make_run(30, 0.0, 1.0);
+    const auto candidate = make_run(30, -0.2, 1.0);
+    const auto report = gs::metrics::diff_runs(baseline, candidate);
+
+    EXPECT_EQ(report.matched_views, 30u);
+    const auto* psnr = find(report, "psnr");
+    ASSERT_NE(psnr, nullptr);
+    EXPECT_NEAR(psnr->mean_degradation, 0.2, 1e-9);
+    EXPECT_TRUE(psnr->regression);
+    EXPECT_EQ(psnr->worse_views, 30u);
+    EXPECT_FALSE(find(report, "ssim")->regression);
+    EXPECT_EQ(find(report, "lpips"), nullptr); // not recorded
+    EXPECT_TRUE(report.has_regression());
+    EXPECT_NE(report.to_string().find("REGRESSION"), std::string::npos);
+}
+
+TEST(MetricsDiffTest, IgnoresImprovementsAndTinyChanges) {
+    const auto baseline = make_run(30, 0.0, 1.0);
+    EXPECT_FALSE(gs::metrics::diff_runs(baseline, make_run(30, 0.3, 1.0)).has_regression());
+    // Significant but below the 0.05 dB threshold
+    EXPECT_FALSE(gs::metrics::diff_runs(baseline, make_run(30, -0.02, 1.0)).has_regression());
+}
+
+TEST(MetricsDiffTest, FlagsSlowerRendering) {
+    const auto report = gs::metrics::diff_runs(make_run(20, 0.0, 1.0), make_run(20, 0.0, 1.2));
+    const auto* time = find(report, "render_ms");
+    ASSERT_NE(time, nullptr);
+    EXPECT_NEAR(time->mean_degradation, 0.2, 1e-9);
+    EXPECT_TRUE(time->regression);
+}
+
+TEST(MetricsDiffTest, CsvRoundTripSelectsIteration) {
+    const auto path = std::filesystem::temp_directory_path() / "gs_metrics_diff_test.csv";
+    std::filesystem::remove(path);
+
+    auto early = make_run(3, 0.0, 1.0);
+    for (auto& r : early)
+        r.iteration = 7000;
+    gs::metrics::append_per_view_csv(path, early);
+    gs::metrics::append_per_view_csv(path, make_run(4, 1.0, 1.0));
+
+    const auto last = gs::metrics::read_per_view_csv(path);
+    ASSERT_EQ(last.size(), 4u);
+    EXPECT_EQ(last[0].iteration, 30000);
+    EXPECT_EQ(last[1].image, "view_1.jpg");
+    EXPECT_NEAR(last[1].psnr, make_run(4, 1.0, 1.0)[1].psnr, 1e-6);
+    EXPECT_TRUE(std::isnan(last[1].lpips));
+
+    EXPECT_EQ(gs::metrics::read_per_view_csv(path, 7000).size(), 3u);
+    EXPECT_TRUE(gs::metrics::read_per_view_csv(path, 123).empty());
+    std::filesystem::remove(path);
+    EXPECT_THROW(gs::metrics::read_per_view_csv(path), std::runtime_error);
+}
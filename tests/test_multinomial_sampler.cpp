@@ -0,0 +1,112 @@
+#include "core/multinomial_sampler.hpp"
+#include <ATen/CPUGeneratorImpl.h>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <torch/torch.h>
+
+namespace {
+    // Just above torch::multinomial's limit, so the scalable paths are taken
+    constexpr int64_t kLargeN = (int64_t{1} << 24) + 1;
+
+    std::vector<torch::Device> test_devices() {
+        std::vector<torch::Device> devices{torch::kCPU};
+        if (torch::cuda::is_available()) {
+            devices.emplace_back(torch::kCUDA);
+        }
+        return devices;
+    }
+
+    // Mostly zero weights with mass 1 : 2 : 5 at the start, middle and end
+    torch::Tensor sparse_weights(const torch::Device& device) {
+        auto weights = torch::zeros({kLargeN}, torch::kFloat32);
+        weights[3] = 1.0f;
+        weights[kLargeN / 2] = 2.0f;
+        weights[kLargeN - 1] = 5.0f;
+        return weights.to(device);
+    }
+} // namespace
+
+TEST(MultinomialSamplerTest, SmallInputsMatchTorchMultinomial) {
+    const auto weights = torch::rand({1000});
+    auto gen_a = at::detail::createCPUGenerator(11);
+    auto gen_b = at::detail::createCPUGenerator(11);
+    EXPECT_TRUE(torch::equal(gs::multinomial_sample(weights, 500, true, gen_a),
+                             torch::multinomial(weights, 500, true, gen_b)));
+}
+
+TEST(MultinomialSamplerTest, LargeWithReplacementFollowsWeights) {
+    for (const auto& device : test_devices()) {
+        torch::manual_seed(0);
+        const int64_t n = 80000;
+        const auto samples = gs::multinomial_sample(sparse_weights(device), n, true).cpu();
+        ASSERT_EQ(samples.numel(), n);
+        EXPECT_EQ(samples.device(), torch::Device(torch::kCPU));
+
+        const auto count = [&](int64_t idx) { return (samples == idx).sum().item<int64_t>(); };
+        const int64_t c0 = count(3), c1 = count(kLargeN / 2), c2 = count(kLargeN - 1);
+        EXPECT_EQ(c0 + c1 + c2, n) << "zero-weight index drawn on " << device;
+        EXPECT_NEAR(static_cast<double>(c0) / n, 1.0 / 8.0, 0.01) << device;
+        EXPECT_NEAR(static_cast<double>(c1) / n, 2.0 / 8.0, 0.01) << device;
+        EXPECT_NEAR(static_cast<double>(c2) / n, 5.0 / 8.0, 0.01) << device;
+
+        // Draw order is i.i.d., not sorted by index
+        EXPECT_FALSE(torch::equal(samples, std::get<0>(samples.sort()))) << device;
+    }
+}
+
+TEST(MultinomialSamplerTest, LargeWithoutReplacementDrawsDistinctNonZero) {
+    for (const auto& device : test_devices()) {
+        torch::manual_seed(0);
+        auto weights = torch::zeros({kLargeN});
+        weights.slice(0, 0, 1000).fill_(1.0f);
+        const auto samples = gs::multinomial_sample(weights.to(device), 500, false).cpu();
+        ASSERT_EQ(samples.numel(), 500);
+        EXPECT_EQ(std::get<0>(at::_unique(samples)).numel(), 500) << device;
+        EXPECT_TRUE((samples < 1000).all().item<bool>()) << device;
+    }
+}
+
+TEST(MultinomialSamplerTest, DeterministicUnderSeed) {
+    const auto weights = torch::rand({kLargeN});
+    auto gen_a = at::detail::createCPUGenerator(123);
+    auto gen_b = at::detail::createCPUGenerator(123);
+    auto gen_c = at::detail::createCPUGenerator(124);
+    const auto a = gs::multinomial_sample(weights, 10000, true, gen_a);
+    const auto b = gs::multinomial_sample(weights, 10000, true, gen_b);
+    const auto c = gs::multinomial_sample(weights, 10000, true, gen_c);
+    EXPECT_TRUE(torch::equal(a, b));
+    EXPECT_FALSE(torch::equal(a, c));
+}
+
+TEST(MultinomialSamplerTest, RejectsInvalidArguments) {
+    EXPECT_THROW(gs::multinomial_sample(torch::ones({2, 2}), 1), c10::Error);
+    EXPECT_THROW(gs::multinomial_sample(torch::ones({4}), 5, false), c10::Error);
+    EXPECT_THROW(gs::multinomial_sample(torch::ones({0}), 1), c10::Error);
+}
+
+// Timing sweep from 1M to 100M weights, drawing 5% as MCMC's add_new_gs does.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST(MultinomialSamplerTest, DISABLED_BenchmarkScaling) {
+    for (const auto& device : test_devices()) {
+        for (const int64_t N : {int64_t{1'000'000}, int64_t{10'000'000}, int64_t{30'000'000}, int64_t{100'000'000}}) {
+            const auto weights = torch::rand({N}, torch::TensorOptions().device(device));
+            const int64_t n = N / 20;
+            gs::multinomial_sample(weights, n); // warm-up
+            if (device.is_cuda()) {
+                torch::cuda::synchronize();
+            }
+
+            const int reps = 3;
+            const auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < reps; ++r) {
+                gs::multinomial_sample(weights, n);
+            }
+            if (device.is_cuda()) {
+                torch::cuda::synchronize();
+            }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / reps;
+            std::cout << device << " N=" << N << " n=" << n << ": " << ms << " ms" << std::endl;
+        }
+    }
+}
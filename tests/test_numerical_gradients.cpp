@@ -8,6 +8,7 @@
 #include <vector>
 
 // Using the exposed autograd functions from gs namespace
+using gs::FusedActivationFunction;
 using gs::ProjectionFunction;
 using gs::QuatScaleToCovarPreciFunction;
 using gs::SphericalHarmonicsFunction;
@@ -459,6 +460,44 @@ TEST_F(NumericalGradientTest, CompareWithReferenceImplementation) {
     }
 }
 
+TEST_F(NumericalGradientTest, FusedActivationGradientTest) {
+    torch::manual_seed(42);
+
+    const int N = 257;
+    const float scaling_modifier = 0.7f;
+
+    // The CUDA kernel and the CPU path must both match the unfused reference
+    for (const auto& dev : {torch::Device(torch::kCUDA), torch::Device(torch::kCPU)}) {
+        auto opacity_raw = torch::randn({N, 1}, dev).requires_grad_(true);
+        auto scaling_raw = (torch::randn({N, 3}, dev) - 3.0f).requires_grad_(true);
+        auto rotation_raw = torch::randn({N, 4}, dev).requires_grad_(true);
+
+        auto fused = FusedActivationFunction::apply(opacity_raw, scaling_raw, rotation_raw, scaling_modifier);
+        auto [ref_opacities, ref_scales, ref_quats] = reference::activate_gaussians(
+            opacity_raw, scaling_raw, rotation_raw, scaling_modifier);
+
+        EXPECT_EQ(fused[0].sizes(), torch::IntArrayRef({N}));
+        EXPECT_TRUE(torch::allclose(fused[0], ref_opacities, 1e-5, 1e-6)) << "opacities mismatch on " << dev;
+        EXPECT_TRUE(torch::allclose(fused[1], ref_scales, 1e-5, 1e-6)) << "scales mismatch on " << dev;
+        EXPECT_TRUE(torch::allclose(fused[2], ref_quats, 1e-5, 1e-6)) << "quats mismatch on " << dev;
+
+        auto v_opacities = torch::randn_like(ref_opacities);
+        auto v_scales = torch::randn_like(ref_scales);
+        auto v_quats = torch::randn_like(ref_quats);
+
+        auto grads = torch::autograd::grad(
+            {(fused[0] * v_opacities).sum() + (fused[1] * v_scales).sum() + (fused[2] * v_quats).sum()},
+            {opacity_raw, scaling_raw, rotation_raw});
+        auto ref_grads = torch::autograd::grad(
+            {(ref_opacities * v_opacities).sum() + (ref_scales * v_scales).sum() + (ref_quats * v_quats).sum()},
+            {opacity_raw, scaling_raw, rotation_raw});
+
+        compare_gradients(grads[0], ref_grads[0], "fused opacity_raw", 1e-4, 1e-5);
+        compare_gradients(grads[1], ref_grads[1], "fused scaling_raw", 1e-4, 1e-5);
+        compare_gradients(grads[2], ref_grads[2], "fused rotation_raw", 1e-4, 1e-5);
+    }
+}
+
 TEST_F(NumericalGradientTest, StressTestGradients) {
     torch::manual_seed(42);
 
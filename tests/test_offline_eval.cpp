@@ -0,0 +1,50 @@
+#include "core/offline_eval.hpp"
+#include "core/splat_data.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+TEST(OfflineEvalTest, FrameTimePercentiles) {
+    std::vector<double> times;
+    for (int i = 100; i >= 1; --i) {
+        times.push_back(static_cast<double>(i));
+    }
+    const auto stats = gs::metrics::summarize_frame_times(times);
+    EXPECT_EQ(stats.samples, 100);
+    EXPECT_DOUBLE_EQ(stats.min_ms, 1.0);
+    EXPECT_DOUBLE_EQ(stats.max_ms, 100.0);
+    EXPECT_DOUBLE_EQ(stats.mean_ms, 50.5);
+    EXPECT_DOUBLE_EQ(stats.p50_ms, 50.5);
+    EXPECT_NEAR(stats.p90_ms, 90.1, 1e-9);
+    EXPECT_NEAR(stats.p99_ms, 99.01, 1e-9);
+
+    const auto json = stats.to_json();
+    EXPECT_NEAR(json["fps"]["p50"].get<double>(), 1000.0 / 50.5, 1e-9);
+    EXPECT_EQ(gs::metrics::summarize_frame_times({}).samples, 0);
+}
+
+TEST(OfflineEvalTest, PlyRoundTrip) {
+    const int N = 5;
+    const int degree = 2;
+    torch::manual_seed(0);
+    SplatData splat(degree, torch::randn({N, 3}), torch::randn({N, 1, 3}),
+                    torch::randn({N, SplatData::shN_coeffs(degree), 3}), torch::randn({N, 3}),
+                    torch::randn({N, 4}), torch::randn({N, 1}), 1.0f);
+
+    const auto dir = std::filesystem::temp_directory_path() / "gs_offline_eval_test";
+    std::filesystem::remove_all(dir);
+    splat.save_ply(dir, 7, /*join_thread=*/true);
+
+    auto loaded = SplatData::load_ply(dir / "splat_7.ply");
+    EXPECT_EQ(loaded.get_max_sh_degree(), degree);
+    EXPECT_EQ(loaded.get_active_sh_degree(), degree);
+    EXPECT_TRUE(torch::equal(loaded.means(), splat.means()));
+    EXPECT_TRUE(torch::equal(loaded.sh0(), splat.sh0()));
+    EXPECT_TRUE(torch::equal(loaded.shN(), splat.shN()));
+    EXPECT_TRUE(torch::equal(loaded.scaling_raw(), splat.scaling_raw()));
+    EXPECT_TRUE(torch::equal(loaded.rotation_raw(), splat.rotation_raw()));
+    EXPECT_TRUE(torch::equal(loaded.opacity_raw(), splat.opacity_raw()));
+    std::filesystem::remove_all(dir);
+
+    EXPECT_THROW(SplatData::load_ply(dir / "missing.ply"), std::runtime_error);
+}
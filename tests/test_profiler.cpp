@@ -0,0 +1,159 @@
+#include "core/profiler.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+#include <thread>
+
+namespace {
+    // Device clock that advances by a fixed step per mark and only completes
+    // marks when told to
+    class FakeDeviceTimer : public gs::DeviceTimer {
+    public:
+        FakeDeviceTimer(double step_ms, int* live_marks)
+            : step_ms_(step_ms),
+              live_marks_(live_marks) {}
+
+        int record() override {
+            now_ms_ += step_ms_;
+            times_[next_] = now_ms_;
+            ++*live_marks_;
+            return next_++;
+        }
+        bool ready(int mark) override { return mark < completed_; }
+        double elapsed_ms(int from, int to) override { return times_.at(to) - times_.at(from); }
+        void release(int mark) override {
+            times_.erase(mark);
+            --*live_marks_;
+        }
+        void synchronize() override { completed_ = next_; }
+
+    private:
+        double step_ms_;
+        int* live_marks_;
+        double now_ms_ = 0.0;
+        int next_ = 0;
+        int completed_ = 0;
+        std::map<int, double> times_;
+    };
+} // namespace
+
+TEST(ProfilerTest, TimersAreNoOpsWithoutScope) {
+    gs::Profiler profiler;
+    {
+        gs::Profiler::ScopedTimer timer("orphan");
+    }
+    EXPECT_TRUE(profiler.summary().empty());
+    EXPECT_EQ(gs::Profiler::current(), nullptr);
+}
+
+TEST(ProfilerTest, WallClockNestingAndStop) {
+    gs::Profiler profiler;
+    {
+        gs::Profiler::Scope scope(&profiler);
+        for (int i = 0; i < 3; ++i) {
+            gs::Profiler::ScopedTimer step("step");
+            gs::Profiler::ScopedTimer first("first");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            first.stop();
+            gs::Profiler::ScopedTimer second("second");
+        }
+        profiler.collect();
+    }
+    EXPECT_EQ(gs::Profiler::current(), nullptr);
+
+    const auto stages = profiler.summary();
+    ASSERT_EQ(stages.size(), 3u);
+    // Stages are listed in the order their first span was opened
+    EXPECT_EQ(stages[0].name, "step");
+    EXPECT_EQ(stages[0].depth, 0);
+    EXPECT_EQ(stages[1].name, "first");
+    EXPECT_EQ(stages[1].depth, 1);
+    EXPECT_EQ(stages[2].name, "second");
+    EXPECT_EQ(stages[2].depth, 1);
+    for (const auto& s : stages) {
+        EXPECT_EQ(s.count, 3);
+        EXPECT_LE(s.p50_ms, s.max_ms);
+    }
+    EXPECT_GE(stages[1].p50_ms, 1.5);
+    EXPECT_GE(stages[0].mean_ms, stages[1].mean_ms);
+    EXPECT_NE(profiler.format_summary().find("  first"), std::string::npos);
+}
+
+TEST(ProfilerTest, DeviceSpansWaitForTheirMarks) {
+    int live_marks = 0;
+    {
+        gs::Profiler profiler(std::make_unique<FakeDeviceTimer>(1.0, &live_marks));
+        gs::Profiler::Scope scope(&profiler);
+        {
+            gs::Profiler::ScopedTimer outer("outer"); // marks 1 and 4, base mark 0
+            gs::Profiler::ScopedTimer inner("inner"); // marks 2 and 3
+        }
+
+        // Nothing has completed on the device yet
+        profiler.collect();
+        EXPECT_EQ(live_marks, 5);
+
+        const auto stages = profiler.summary(); // synchronizes
+        ASSERT_EQ(stages.size(), 2u);
+        EXPECT_DOUBLE_EQ(stages[0].mean_ms, 3.0);
+        EXPECT_DOUBLE_EQ(stages[1].mean_ms, 1.0);
+        EXPECT_EQ(live_marks, 1); // only the base mark is kept
+    }
+    EXPECT_EQ(live_marks, 0);
+}
+
+TEST(ProfilerTest, PercentilesInterpolate) {
+    int live_marks = 0;
+    // Each span is 1 ms on the fake device, so vary the count of nested marks instead
+    gs::Profiler profiler(std::make_unique<FakeDeviceTimer>(1.0, &live_marks));
+    gs::Profiler::Scope scope(&profiler);
+    for (int n = 0; n < 5; ++n) {
+        gs::Profiler::ScopedTimer stage("stage");
+        for (int k = 0; k < n; ++k) {
+            gs::Profiler::ScopedTimer filler("filler"); // adds 2 ms to the stage
+        }
+    }
+    const auto stages = profiler.summary();
+    ASSERT_EQ(stages[0].name, "stage");
+    EXPECT_EQ(stages[0].count, 5);
+    // Durations 1, 3, 5, 7, 9 ms
+    EXPECT_DOUBLE_EQ(stages[0].p50_ms, 5.0);
+    EXPECT_DOUBLE_EQ(stages[0].p90_ms, 8.2);
+    EXPECT_DOUBLE_EQ(stages[0].max_ms, 9.0);
+    EXPECT_DOUBLE_EQ(stages[0].total_ms, 25.0);
+}
+
+TEST(ProfilerTest, ChromeTraceHasHostAndDeviceTracks) {
+    int live_marks = 0;
+    gs::Profiler profiler(std::make_unique<FakeDeviceTimer>(0.5, &live_marks), true, 3);
+    {
+        gs::Profiler::Scope scope(&profiler);
+        gs::Profiler::ScopedTimer a("a");
+        a.stop();
+        gs::Profiler::ScopedTimer b("b"); // does not fit into 3 events
+    }
+    const auto trace = profiler.chrome_trace();
+    const auto& events = trace.at("traceEvents");
+    int complete = 0, device = 0;
+    for (const auto& e : events) {
+        if (e.at("ph") == "X") {
+            ++complete;
+            EXPECT_EQ(e.at("name"), "a");
+            device += e.at("tid").get<int>();
+            EXPECT_GE(e.at("dur").get<double>(), 0.0);
+        }
+    }
+    EXPECT_EQ(complete, 2);
+    EXPECT_EQ(device, 1);
+    EXPECT_TRUE(trace.at("otherData").at("truncated").get<bool>());
+
+    const auto path = std::filesystem::temp_directory_path() / "gs_profiler_trace.json";
+    profiler.write_chrome_trace(path);
+    std::ifstream file(path);
+    EXPECT_EQ(nlohmann::json::parse(file).at("displayTimeUnit"), "ms");
+    std::filesystem::remove(path);
+
+    gs::Profiler no_trace;
+    EXPECT_THROW(no_trace.write_chrome_trace(path), std::logic_error);
+}
@@ -834,4 +834,129 @@ TEST_F(RasterizationComparisonTest, TestEdgeCases) {
         EXPECT_TRUE((ref_render <= 1.1f).all().item<bool>()) << "Values too large in render";
         EXPECT_FALSE(ref_render.isnan().any().item<bool>()) << "NaN in render";
     }
-}
\ No newline at end of file
+}
+
+TEST_F(RasterizationComparisonTest, InferenceMatchesTrainingPath) {
+    torch::manual_seed(42);
+
+    const int N = 2000;
+    const int width = 96;
+    const int height = 64;
+    const int sh_degree = 2;
+    const int num_sh_coeffs = (sh_degree + 1) * (sh_degree + 1);
+
+    auto means = torch::randn({N, 3}, device) * 0.8f;
+    means.select(1, 2) += 4.0f;
+    auto gaussians = SplatData(
+        sh_degree, means,
+        torch::randn({N, 1, 3}, device) * 0.3f,
+        torch::randn({N, num_sh_coeffs - 1, 3}, device) * 0.1f,
+        torch::randn({N, 3}, device) * 0.3f - 3.0f,
+        torch::randn({N, 4}, device),
+        torch::randn({N, 1}, device), 1.0f);
+    while (gaussians.get_active_sh_degree() < sh_degree) {
+        gaussians.increment_sh_degree();
+    }
+
+    auto R = torch::eye(3, torch::kCPU);
+    auto T = torch::zeros({3}, torch::kCPU);
+    Camera camera(R, T, 1.0f, 0.7f, "test_camera", "", width, height, 0);
+    auto bg = torch::tensor({0.1f, 0.2f, 0.3f}, device);
+
+    for (auto mode : {gs::RenderMode::RGB, gs::RenderMode::RGB_ED, gs::RenderMode::D}) {
+        auto expected = gs::rasterize(camera, gaussians, bg, 0.8f, false, false, mode);
+
+        gs::RenderOutput buffers;
+        auto first = gs::rasterize_inference(camera, gaussians, bg, 0.8f, mode, &buffers);
+        auto second = gs::rasterize_inference(camera, gaussians, bg, 0.8f, mode, &buffers);
+
+        EXPECT_FALSE(second.means2d.requires_grad());
+        EXPECT_TRUE(torch::equal(second.radii, expected.radii));
+        EXPECT_TRUE(torch::allclose(second.alpha, expected.alpha, 1e-5, 1e-6));
+        if (expected.image.defined()) {
+            EXPECT_TRUE(torch::allclose(second.image, expected.image, 1e-5, 1e-6));
+            // The second render must land in the first render's storage
+            EXPECT_EQ(second.image.data_ptr(), first.image.data_ptr());
+        }
+        if (expected.depth.defined()) {
+            EXPECT_TRUE(torch::allclose(second.depth, expected.depth, 1e-4, 1e-5));
+        }
+    }
+}
+
+TEST_F(RasterizationComparisonTest, WorkspaceReusesBuffersAcrossSteps) {
+    torch::manual_seed(7);
+
+    const int N = 3000;
+    const int width = 128;
+    const int height = 96;
+
+    auto make_gaussians = [&]() {
+        auto means = torch::randn({N, 3}, device) * 0.8f;
+        means.select(1, 2) += 4.0f;
+        return std::vector<torch::Tensor>{
+            means,
+            torch::randn({N, 1, 3}, device) * 0.3f,
+            torch::zeros({N, 0, 3}, device),
+            torch::randn({N, 3}, device) * 0.3f - 3.0f,
+            torch::randn({N, 4}, device),
+            torch::randn({N, 1}, device)};
+    };
+    const auto init = make_gaussians();
+    auto make_splats = [&]() {
+        std::vector<torch::Tensor> params;
+        for (const auto& t : init) {
+            params.push_back(t.clone().set_requires_grad(true));
+        }
+        return SplatData(0, params[0], params[1], params[2], params[3], params[4], params[5], 1.0f);
+    };
+    auto plain = make_splats();
+    auto buffered = make_splats();
+
+    auto R = torch::eye(3, torch::kCPU);
+    auto T = torch::zeros({3}, torch::kCPU);
+    Camera camera(R, T, 1.0f, 0.8f, "test_camera", "", width, height, 0);
+    auto bg = torch::zeros({3}, device);
+
+    gs::RasterWorkspace workspace;
+    for (int step = 0; step < 3; ++step) {
+        workspace.begin_step();
+        auto expected = gs::rasterize(camera, plain, bg);
+        auto output = gs::rasterize(camera, buffered, bg, 1.0f, false, false, gs::RenderMode::RGB, &workspace);
+
+        EXPECT_TRUE(torch::equal(output.radii, expected.radii));
+        EXPECT_TRUE(torch::allclose(output.image, expected.image, 1e-5, 1e-6));
+
+        expected.image.sum().backward();
+        output.image.sum().backward();
+        EXPECT_TRUE(torch::allclose(buffered.means().grad(), plain.means().grad(), 1e-4, 1e-5));
+
+        if (step > 0) {
+            EXPECT_EQ(workspace.step_allocations(), 0) << "step " << step;
+        }
+    }
+    EXPECT_GT(workspace.reserved_bytes(), 0u);
+
+    // Fewer Gaussians fit in the existing buffers
+    workspace.begin_step();
+    auto pruned = SplatData(0,
+                            init[0].slice(0, 0, N / 2), init[1].slice(0, 0, N / 2), init[2].slice(0, 0, N / 2),
+                            init[3].slice(0, 0, N / 2), init[4].slice(0, 0, N / 2), init[5].slice(0, 0, N / 2),
+                            1.0f);
+    gs::rasterize_inference(camera, pruned, bg, 1.0f, gs::RenderMode::RGB, nullptr, &workspace);
+    EXPECT_EQ(workspace.step_allocations(), 0);
+    EXPECT_GT(workspace.total_reuses(), workspace.total_allocations());
+    EXPECT_NE(workspace.summary().find("(0 this step)"), std::string::npos);
+
+    // Halving the model keeps the buffers, a larger drop releases them
+    workspace.fit(N);
+    workspace.fit(N / 2);
+    EXPECT_GT(workspace.reserved_bytes(), 0u);
+    workspace.fit(N / 4);
+    EXPECT_EQ(workspace.reserved_bytes(), 0u);
+
+    // Released buffers are allocated again on the next render
+    workspace.begin_step();
+    gs::rasterize_inference(camera, pruned, bg, 1.0f, gs::RenderMode::RGB, nullptr, &workspace);
+    EXPECT_GT(workspace.step_allocations(), 0);
+}
@@ -0,0 +1,185 @@
+#include "Ops.h"
+#include "core/camera.hpp"
+#include "core/rasterizer.hpp"
+#include "core/rasterizer_cpu.hpp"
+#include "core/splat_data.hpp"
+#include "torch_impl.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+// The CPU backend must run without a GPU, so only the CUDA comparison skips.
+class RasterizerCPUTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        torch::manual_seed(42);
+
+        auto R = torch::eye(3, torch::kFloat32);
+        auto T = torch::tensor({0.0f, 0.0f, 5.0f}, torch::kFloat32);
+        const float fov = M_PI / 3.0f;
+        camera = std::make_unique<Camera>(R, T, fov, fov, "cpu_test_camera", "", 64, 48, 0);
+    }
+
+    SplatData createSplatData(int N, int sh_degree, torch::Device dev) {
+        torch::NoGradGuard no_grad;
+        const int K = (sh_degree + 1) * (sh_degree + 1);
+        auto means = torch::randn({N, 3}) * 0.8f;
+        auto sh0 = torch::randn({N, 1, 3}) * 0.3f;
+        auto shN = torch::randn({N, K - 1, 3}) * 0.1f;
+        auto scaling = torch::randn({N, 3}) * 0.3f - 2.5f;
+        auto rotation = torch::randn({N, 4});
+        auto opacity = torch::randn({N, 1});
+        auto to = [&](const torch::Tensor& t) { return t.to(dev).set_requires_grad(true); };
+        return SplatData(sh_degree, to(means), to(sh0), to(shN), to(scaling), to(rotation), to(opacity), 1.0f);
+    }
+
+    // Loss with a fixed random weighting so every pixel contributes a gradient
+    static torch::Tensor weighted_loss(const torch::Tensor& image, const torch::Tensor& weights) {
+        return (image * weights.to(image.device())).sum();
+    }
+
+    std::unique_ptr<Camera> camera;
+};
+
+TEST_F(RasterizerCPUTest, IntersectTileMatchesReference) {
+    const int C = 1, N = 200, tile_size = 16, tile_width = 5, tile_height = 4;
+    auto means2d = torch::rand({C, N, 2}) * torch::tensor({80.0f, 64.0f});
+    auto radii = torch::randint(0, 20, {C, N, 2}, torch::kInt32);
+    auto depths = torch::rand({C, N}) * 10.0f + 0.1f;
+
+    auto [tiles_per_gauss, isect_ids, flatten_ids] =
+        gs::cpu::intersect_tile(means2d, radii, depths, tile_size, tile_width, tile_height);
+    auto [ref_tiles_per_gauss, ref_isect_ids, ref_flatten_ids] =
+        reference::isect_tiles(means2d, radii, depths, tile_size, tile_width, tile_height, true);
+
+    EXPECT_TRUE(torch::equal(tiles_per_gauss, ref_tiles_per_gauss.to(torch::kInt32)));
+    ASSERT_EQ(flatten_ids.numel(), ref_flatten_ids.numel());
+    EXPECT_TRUE(torch::equal(flatten_ids, ref_flatten_ids));
+
+    // Offsets must delimit non-decreasing, contiguous tile ranges
+    auto offsets = gs::cpu::intersect_offset(isect_ids, C, tile_width, tile_height).flatten();
+    EXPECT_EQ(offsets[0].item<int>(), 0);
+    EXPECT_TRUE((offsets.slice(0, 1) >= offsets.slice(0, 0, -1)).all().item<bool>());
+}
+
+TEST_F(RasterizerCPUTest, CompositingGradientsMatchFiniteDifferences) {
+    const int width = 20, height = 18, tile_size = 8;
+    const int tile_width = (width + tile_size - 1) / tile_size;
+    const int tile_height = (height + tile_size - 1) / tile_size;
+
+    auto means2d = torch::tensor({{{6.0f, 7.0f}, {12.5f, 9.0f}, {9.0f, 12.0f}}});
+    auto conics = torch::tensor({{{0.08f, 0.01f, 0.06f}, {0.05f, -0.02f, 0.09f}, {0.1f, 0.0f, 0.1f}}});
+    auto colors = torch::rand({1, 3, 3});
+    auto opacities = torch::tensor({{0.7f, 0.5f, 0.6f}});
+    auto depths = torch::tensor({{1.0f, 2.0f, 3.0f}});
+    auto radii = torch::full({1, 3, 2}, 9, torch::kInt32);
+    auto bg = torch::tensor({{0.2f, 0.3f, 0.4f}});
+
+    auto [tiles_per_gauss, isect_ids, flatten_ids] =
+        gs::cpu::intersect_tile(means2d, radii, depths, tile_size, tile_width, tile_height);
+    auto offsets = gs::cpu::intersect_offset(isect_ids, 1, tile_width, tile_height);
+
+    auto weights = torch::rand({1, height, width, 3});
+    auto alpha_weights = torch::rand({1, height, width, 1});
+    auto loss_fn = [&](const torch::Tensor& m, const torch::Tensor& c, const torch::Tensor& col,
+                       const torch::Tensor& op) {
+        auto out = gs::cpu::RasterizationFunction::apply(
+            m, c, col, op, bg, offsets, flatten_ids,
+            static_cast<int64_t>(width), static_cast<int64_t>(height), static_cast<int64_t>(tile_size));
+        return (out[0] * weights).sum() + (out[1] * alpha_weights).sum();
+    };
+
+    std::vector<torch::Tensor> inputs = {means2d, conics, colors, opacities};
+    for (auto& t : inputs) {
+        t.set_requires_grad(true);
+    }
+    auto analytical = torch::autograd::grad({loss_fn(inputs[0], inputs[1], inputs[2], inputs[3])}, inputs);
+
+    const float eps = 1e-3f;
+    const std::vector<float> atols = {2e-3f, 5e-2f, 2e-3f, 2e-3f};
+    for (size_t which = 0; which < inputs.size(); ++which) {
+        auto base = inputs[which].detach().clone();
+        auto numerical = torch::zeros_like(base);
+        auto flat = base.view(-1);
+        for (int64_t i = 0; i < flat.numel(); ++i) {
+            torch::NoGradGuard no_grad;
+            const float orig = flat[i].item<float>();
+            std::vector<torch::Tensor> probe = {inputs[0].detach(), inputs[1].detach(),
+                                                inputs[2].detach(), inputs[3].detach()};
+            flat[i] = orig + eps;
+            probe[which] = base.clone();
+            const float f_plus = loss_fn(probe[0], probe[1], probe[2], probe[3]).item<float>();
+            flat[i] = orig - eps;
+            probe[which] = base.clone();
+            const float f_minus = loss_fn(probe[0], probe[1], probe[2], probe[3]).item<float>();
+            flat[i] = orig;
+            numerical.view(-1)[i] = (f_plus - f_minus) / (2.0f * eps);
+        }
+        EXPECT_TRUE(torch::allclose(analytical[which], numerical, 5e-2, atols[which]))
+            << "input " << which << " max diff " << (analytical[which] - numerical).abs().max().item<float>();
+    }
+}
+
+TEST_F(RasterizerCPUTest, FullRasterizeRunsOnCPU) {
+    auto splats = createSplatData(500, 1, torch::kCPU);
+    auto bg = torch::zeros({3});
+
+    auto output = gs::rasterize(*camera, splats, bg, 1.0f, false, false, gs::RenderMode::RGB_ED);
+
+    ASSERT_TRUE(output.image.defined());
+    EXPECT_TRUE(output.image.device().is_cpu());
+    EXPECT_EQ(output.image.sizes(), torch::IntArrayRef({3, 48, 64}));
+    EXPECT_EQ(output.depth.sizes(), torch::IntArrayRef({1, 48, 64}));
+    EXPECT_GT(output.visibility.sum().item<int64_t>(), 0);
+    EXPECT_FALSE(output.image.isnan().any().item<bool>());
+
+    auto weights = torch::rand_like(output.image);
+    weighted_loss(output.image, weights).backward();
+    for (auto* t : {&splats.means(), &splats.opacity_raw(), &splats.scaling_raw(),
+                    &splats.rotation_raw(), &splats.sh0(), &splats.shN()}) {
+        ASSERT_TRUE(t->grad().defined());
+        EXPECT_FALSE(t->grad().isnan().any().item<bool>());
+    }
+    EXPECT_GT(splats.means().grad().abs().sum().item<float>(), 0.0f);
+
+    // No compensations on the CPU, so antialiasing is refused rather than ignored
+    EXPECT_THROW(gs::rasterize(*camera, splats, bg, 1.0f, false, true), c10::Error);
+}
+
+TEST_F(RasterizerCPUTest, MatchesCUDABackend) {
+    if (!torch::cuda::is_available()) {
+        GTEST_SKIP() << "CUDA not available";
+    }
+
+    auto cpu_splats = createSplatData(1000, 2, torch::kCPU);
+    auto cuda_splats = SplatData(2,
+                                 cpu_splats.means().detach().cuda().set_requires_grad(true),
+                                 cpu_splats.sh0().detach().cuda().set_requires_grad(true),
+                                 cpu_splats.shN().detach().cuda().set_requires_grad(true),
+                                 cpu_splats.scaling_raw().detach().cuda().set_requires_grad(true),
+                                 cpu_splats.rotation_raw().detach().cuda().set_requires_grad(true),
+                                 cpu_splats.opacity_raw().detach().cuda().set_requires_grad(true),
+                                 1.0f);
+    cpu_splats.increment_sh_degree();
+    cpu_splats.increment_sh_degree();
+    cuda_splats.increment_sh_degree();
+    cuda_splats.increment_sh_degree();
+
+    auto bg_cpu = torch::tensor({0.1f, 0.2f, 0.3f});
+    auto bg_cuda = bg_cpu.cuda();
+    auto out_cpu = gs::rasterize(*camera, cpu_splats, bg_cpu);
+    auto out_cuda = gs::rasterize(*camera, cuda_splats, bg_cuda);
+
+    EXPECT_TRUE(torch::equal(out_cpu.radii, out_cuda.radii.cpu()));
+    EXPECT_TRUE(torch::allclose(out_cpu.image, out_cuda.image.cpu(), 1e-3, 1e-4))
+        << "max image diff " << (out_cpu.image - out_cuda.image.cpu()).abs().max().item<float>();
+
+    auto weights = torch::rand_like(out_cpu.image);
+    weighted_loss(out_cpu.image, weights).backward();
+    weighted_loss(out_cuda.image, weights).backward();
+
+    EXPECT_TRUE(torch::allclose(cpu_splats.means().grad(), cuda_splats.means().grad().cpu(), 1e-2, 1e-3));
+    EXPECT_TRUE(torch::allclose(cpu_splats.opacity_raw().grad(), cuda_splats.opacity_raw().grad().cpu(), 1e-2, 1e-3));
+    EXPECT_TRUE(torch::allclose(cpu_splats.sh0().grad(), cuda_splats.sh0().grad().cpu(), 1e-2, 1e-3));
+    EXPECT_TRUE(torch::allclose(cpu_splats.scaling_raw().grad(), cuda_splats.scaling_raw().grad().cpu(), 1e-2, 1e-3));
+}
@@ -0,0 +1,101 @@
+#include "core/ssim_cpu.hpp"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+namespace {
+    constexpr float C1 = 0.01f * 0.01f;
+    constexpr float C2 = 0.03f * 0.03f;
+
+    // Direct 2D evaluation with zero padding, as conv2d computes it
+    std::vector<float> reference_ssim(const std::vector<float>& img1, const std::vector<float>& img2,
+                                      int64_t planes, int64_t H, int64_t W, const std::vector<float>& window) {
+        const int64_t K = static_cast<int64_t>(window.size());
+        const int64_t r = K / 2;
+        std::vector<float> out(planes * H * W);
+        for (int64_t p = 0; p < planes; ++p) {
+            for (int64_t y = 0; y < H; ++y) {
+                for (int64_t x = 0; x < W; ++x) {
+                    double m[5] = {0, 0, 0, 0, 0};
+                    for (int64_t ky = 0; ky < K; ++ky) {
+                        for (int64_t kx = 0; kx < K; ++kx) {
+                            const int64_t sy = y + ky - r, sx = x + kx - r;
+                            if (sy < 0 || sy >= H || sx < 0 || sx >= W)
+                                continue;
+                            const double w = window[ky] * window[kx];
+                            const double a = img1[(p * H + sy) * W + sx], b = img2[(p * H + sy) * W + sx];
+                            m[0] += w * a, m[1] += w * b, m[2] += w * a * a, m[3] += w * b * b, m[4] += w * a * b;
+                        }
+                    }
+                    const double s1 = m[2] - m[0] * m[0], s2 = m[3] - m[1] * m[1], s12 = m[4] - m[0] * m[1];
+                    out[(p * H + y) * W + x] = static_cast<float>(
+                        ((2 * m[0] * m[1] + C1) * (2 * s12 + C2)) /
+                        ((m[0] * m[0] + m[1] * m[1] + C1) * (s1 + s2 + C2)));
+                }
+            }
+        }
+        return out;
+    }
+
+    void expect_matches_reference(int64_t planes, int64_t H, int64_t W, int window_size) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(0.f, 1.f);
+        std::vector<float> img1(planes * H * W), img2(planes * H * W);
+        for (size_t i = 0; i < img1.size(); ++i) {
+            img1[i] = dist(rng);
+            img2[i] = std::clamp(img1[i] + 0.2f * (dist(rng) - 0.5f), 0.f, 1.f);
+        }
+        const auto window = gs::metrics::gaussian_window(window_size, 1.5f);
+
+        std::vector<float> out(img1.size(), -1.f);
+        gs::metrics::ssim_map_cpu(img1.data(), img2.data(), out.data(), planes, H, W, window, C1, C2);
+        const auto expected = reference_ssim(img1, img2, planes, H, W, window);
+        for (size_t i = 0; i < out.size(); ++i) {
+            ASSERT_NEAR(out[i], expected[i], 1e-4) << "at " << i;
+        }
+    }
+} // namespace
+
+TEST(SSIMCpuTest, GaussianWindowIsCenteredAndNormalized) {
+    const auto window = gs::metrics::gaussian_window(11, 1.5f);
+    ASSERT_EQ(window.size(), 11u);
+    EXPECT_NEAR(std::accumulate(window.begin(), window.end(), 0.0), 1.0, 1e-6);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FLOAT_EQ(window[i], window[10 - i]);
+        EXPECT_LT(window[i], window[i + 1]);
+    }
+    // Same coefficients as the fused CUDA kernel
+    EXPECT_NEAR(window[5], 0.26601171f, 1e-6);
+    EXPECT_NEAR(window[0], 0.00102838f, 1e-6);
+    EXPECT_THROW(gs::metrics::gaussian_window(0, 1.5f), std::invalid_argument);
+}
+
+TEST(SSIMCpuTest, MatchesDirectConvolution) {
+    expect_matches_reference(3, 70, 45, 11);
+}
+
+TEST(SSIMCpuTest, MatchesDirectConvolutionAcrossBands) {
+    // Several 32-row bands per plane, so the parallel_for chunks split planes
+    expect_matches_reference(6, 100, 37, 11);
+}
+
+TEST(SSIMCpuTest, HandlesImagesSmallerThanTheWindow) {
+    expect_matches_reference(2, 4, 7, 11);
+    expect_matches_reference(1, 9, 9, 7);
+}
+
+TEST(SSIMCpuTest, IdenticalImagesGiveOne) {
+    const int64_t H = 33, W = 20;
+    std::vector<float> img(H * W);
+    for (size_t i = 0; i < img.size(); ++i) {
+        img[i] = static_cast<float>(i % 17) / 16.f;
+    }
+    std::vector<float> out(img.size());
+    gs::metrics::ssim_map_cpu(img.data(), img.data(), out.data(), 1, H, W,
+                              gs::metrics::gaussian_window(11, 1.5f), C1, C2);
+    for (float v : out) {
+        EXPECT_NEAR(v, 1.f, 1e-5);
+    }
+}
@@ -0,0 +1,78 @@
+#include "core/tile_size_tuner.hpp"
+#include <gtest/gtest.h>
+#include <torch/torch.h>
+
+namespace {
+    // Offsets for tiles that each hold `per_tile` intersections
+    torch::Tensor uniform_offsets(int tiles_x, int tiles_y, int per_tile) {
+        return (torch::arange(tiles_x * tiles_y, torch::kInt32) * per_tile).reshape({1, tiles_y, tiles_x});
+    }
+} // namespace
+
+TEST(TileSizeTunerTest, FitTileSizeKeepsSizesThatFit) {
+    EXPECT_EQ(gs::fit_tile_size(16, 1920, 1080), 16);
+    EXPECT_EQ(gs::fit_tile_size(8, 7680, 4320), 8);
+}
+
+TEST(TileSizeTunerTest, FitTileSizeFallsBackToLargerTiles) {
+    // 2^19 x 2^19 pixels: 2^32 tiles of 8 px overflow the 31 bits left next to the camera id
+    EXPECT_EQ(gs::fit_tile_size(8, 1 << 19, 1 << 19), 16);
+    EXPECT_THROW(gs::fit_tile_size(8, 1 << 22, 1 << 22), std::runtime_error);
+    EXPECT_THROW(gs::fit_tile_size(0, 64, 64), std::invalid_argument);
+}
+
+TEST(TileSizeTunerTest, CyclesCandidatesThenPicksCheapest) {
+    gs::TileSizeTuner tuner({8, 16}, /*rounds=*/2);
+
+    // Large splats: halving the tile size quadruples the intersections
+    for (int i = 0; i < 4; ++i) {
+        const int size = tuner.next_tile_size();
+        EXPECT_EQ(size, i % 2 == 0 ? 8 : 16);
+        EXPECT_FALSE(tuner.is_tuned());
+        if (size == 8) {
+            tuner.observe(8, uniform_offsets(2, 2, 100), 400);
+        } else {
+            tuner.observe(16, uniform_offsets(1, 1, 100), 100);
+        }
+    }
+
+    ASSERT_TRUE(tuner.is_tuned());
+    EXPECT_EQ(tuner.chosen_tile_size(), 16);
+    EXPECT_EQ(tuner.next_tile_size(), 16);
+    EXPECT_LT(tuner.estimated_cost(16), tuner.estimated_cost(8));
+    EXPECT_NE(tuner.summary().find("<- chosen"), std::string::npos);
+}
+
+TEST(TileSizeTunerTest, PrefersSmallTilesForSmallSplats) {
+    gs::TileSizeTuner tuner({8, 16}, /*rounds=*/1);
+
+    // Small splats: smaller tiles barely add intersections but composite far fewer pixels
+    tuner.observe(8, uniform_offsets(2, 2, 30), 120);
+    tuner.observe(16, uniform_offsets(1, 1, 100), 100);
+
+    ASSERT_TRUE(tuner.is_tuned());
+    EXPECT_EQ(tuner.chosen_tile_size(), 8);
+}
+
+TEST(TileSizeTunerTest, ChargesLongTileLists) {
+    // Same totals, once spread evenly and once packed into a tenth of the tiles
+    gs::TileSizeTuner uniform({8, 16}, /*rounds=*/1);
+    uniform.observe(16, uniform_offsets(10, 10, 10), 1000);
+
+    gs::TileSizeTuner skewed({8, 16}, /*rounds=*/1);
+    auto counts = torch::zeros({100}, torch::kInt32);
+    counts.slice(0, 90).fill_(100);
+    const auto offsets = (torch::cumsum(counts, 0) - counts).to(torch::kInt32).reshape({1, 10, 10});
+    skewed.observe(16, offsets, 1000);
+
+    EXPECT_GT(skewed.estimated_cost(16), uniform.estimated_cost(16));
+    EXPECT_NE(skewed.summary().find("p99 100.0"), std::string::npos);
+}
+
+TEST(TileSizeTunerTest, IgnoresSizesOutsideCandidates) {
+    gs::TileSizeTuner tuner({8, 16}, /*rounds=*/1);
+    tuner.observe(32, uniform_offsets(1, 1, 10), 10);
+    EXPECT_FALSE(tuner.is_tuned());
+    EXPECT_EQ(tuner.estimated_cost(32), 0.0);
+    EXPECT_THROW(gs::TileSizeTuner({64}), std::invalid_argument);
+}
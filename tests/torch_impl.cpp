@@ -4,6 +4,20 @@
 
 namespace reference {
 
+    // Unfused parameter activations, mirrors the SplatData getters
+    std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> activate_gaussians(
+        const torch::Tensor& opacity_raw,  // [N, 1]
+        const torch::Tensor& scaling_raw,  // [N, 3]
+        const torch::Tensor& rotation_raw, // [N, 4]
+        float scaling_modifier) {
+
+        auto opacities = torch::sigmoid(opacity_raw).reshape({-1});
+        auto scales = torch::exp(scaling_raw) * scaling_modifier;
+        auto quats = torch::nn::functional::normalize(
+            rotation_raw, torch::nn::functional::NormalizeFuncOptions().dim(-1));
+        return {opacities, scales, quats};
+    }
+
     // Convert quaternion to rotation matrix
     torch::Tensor quat_to_rotmat(const torch::Tensor& quats) {
         // Normalize quaternions
@@ -6,6 +6,14 @@
 
 namespace reference {
 
+    // Unfused parameter activations: sigmoid(opacity).squeeze(-1),
+    // exp(scaling) * scaling_modifier and normalize(rotation)
+    std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> activate_gaussians(
+        const torch::Tensor& opacity_raw,
+        const torch::Tensor& scaling_raw,
+        const torch::Tensor& rotation_raw,
+        float scaling_modifier = 1.0f);
+
     // Convert quaternion to rotation matrix
     torch::Tensor quat_to_rotmat(const torch::Tensor& quats);
 